@@ -0,0 +1,90 @@
+#include "boot_profile.hpp"
+
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <algorithm>
+#include <atomic>
+
+namespace boot_profile {
+
+namespace {
+constexpr char TAG[] = "BOOT";
+
+Stage stages[MAX_STAGES];
+size_t stage_count = 0;
+uint32_t dropped = 0;
+portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+std::atomic<FirstFrameFn> pending_first_frame{nullptr};
+std::atomic<int64_t> first_frame_at{0};
+} // namespace
+
+Scope::Scope(const char *name) : name_(name), start_us_(esp_timer_get_time()) {}
+
+Scope::~Scope() {
+    record(name_, start_us_, esp_timer_get_time());
+}
+
+void record(const char *name, int64_t start_us, int64_t end_us) {
+    const uint8_t core = static_cast<uint8_t>(esp_cpu_get_core_id());
+    portENTER_CRITICAL(&lock);
+    if (stage_count < MAX_STAGES) {
+        stages[stage_count++] = {name, start_us, end_us, core};
+    } else {
+        dropped++;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void arm_first_frame(FirstFrameFn on_first_frame) {
+    pending_first_frame.store(on_first_frame, std::memory_order_release);
+}
+
+void on_frame() {
+    if (pending_first_frame.load(std::memory_order_relaxed) == nullptr) {
+        return;
+    }
+    const FirstFrameFn callback = pending_first_frame.exchange(nullptr, std::memory_order_acq_rel);
+    if (callback == nullptr) {
+        return;
+    }
+    const int64_t now = esp_timer_get_time();
+    first_frame_at.store(now, std::memory_order_relaxed);
+    callback(now);
+}
+
+int64_t first_frame_us() {
+    return first_frame_at.load(std::memory_order_relaxed);
+}
+
+void log_timeline() {
+    Stage copy[MAX_STAGES];
+    portENTER_CRITICAL(&lock);
+    const size_t count = stage_count;
+    const uint32_t lost = dropped;
+    std::copy(stages, stages + count, copy);
+    portEXIT_CRITICAL(&lock);
+
+    std::sort(copy, copy + count, [](const Stage &a, const Stage &b) { return a.start_us < b.start_us; });
+
+    const int64_t frame_us = first_frame_us();
+    ESP_LOGI(TAG, "Linha do tempo do boot (ms desde o início da aplicação, boot rápido %s):",
+             FAST_BOOT ? "ligado" : "desligado");
+    for (size_t i = 0; i < count; ++i) {
+        const Stage &stage = copy[i];
+        // Etapas adiadas terminam depois do quadro interativo e não o atrasam
+        const bool deferred = frame_us != 0 && stage.start_us >= frame_us;
+        ESP_LOGI(TAG, "  %7.1f %7.1f ms  core %u  %s%s", stage.start_us / 1000.0f,
+                 (stage.end_us - stage.start_us) / 1000.0f, stage.core, stage.name, deferred ? " (adiada)" : "");
+    }
+    if (lost > 0) {
+        ESP_LOGW(TAG, "  %lu etapas sem espaço na tabela", static_cast<unsigned long>(lost));
+    }
+    if (frame_us != 0) {
+        ESP_LOGI(TAG, "Primeiro quadro interativo em %.1f ms", frame_us / 1000.0f);
+    }
+}
+
+} // namespace boot_profile
@@ -1,8 +1,12 @@
 #include "display_driver.hpp"
+#include "boot_profile.hpp"
+#include "lvgl_lock.hpp"
+#include "trace.hpp"
+#include "Xpt2046GpioTransports.hpp"
 
 #include "driver/gpio.h"
 #include "driver/ledc.h"
-#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_check.h"
@@ -17,10 +21,10 @@
 #include "nvs.h"
 #include "nvs.h"
 #include "lvgl.h"
+#include "soc/soc_caps.h"
 #include <new>
 #include <cstring>
 #include <algorithm>
-#include <cmath>
 #include <cstdlib>
 
 namespace {
@@ -44,6 +48,9 @@ constexpr gpio_num_t PIN_NUM_TOUCH_MOSI = GPIO_NUM_32;  // XPT2046_MOSI - IO32
 constexpr gpio_num_t PIN_NUM_TOUCH_CLK = GPIO_NUM_25;  // XPT2046_CLK - IO25
 constexpr gpio_num_t PIN_NUM_TOUCH_CS = GPIO_NUM_33;   // XPT2046_CS - IO33
 constexpr gpio_num_t PIN_NUM_TOUCH_MISO = GPIO_NUM_39; // XPT2046_MISO - IO39
+constexpr gpio_num_t PIN_NUM_TOUCH_IRQ = GPIO_NUM_36;  // XPT2046_IRQ (PENIRQ, ativo em nível baixo) - IO36
+constexpr uint32_t TOUCH_SPI_CLOCK_HZ = 2 * 1000 * 1000;  // 2 MHz (bit-bang por registradores; XPT2046 máx. 2,5 MHz)
+constexpr bool TOUCH_REGISTER_TRANSPORT = true;  // false: fallback via gpio_set_level() (~125 kHz)
 constexpr uint32_t LCD_PIXEL_CLOCK_HZ = 26 * 1000 * 1000; // 26 MHz
 constexpr int LCD_H_RES = 320;
 constexpr int LCD_V_RES = 240;
@@ -57,6 +64,17 @@ constexpr bool TOUCH_INVERT_X = true;   // X precisa ser invertido
 constexpr bool TOUCH_INVERT_Y = true;   // Touch está invertido em Y - valores maiores = topo
 constexpr char TOUCH_CALIB_NVS_NAMESPACE[] = "touch_cal";
 constexpr char TOUCH_CALIB_NVS_KEY[] = "cal";
+constexpr char TOUCH_TRACE_TAG[] = "TOUCH_TRACE";  // Tag das linhas lidas por tools/host/touch_trace_player
+
+// Amostragem do touch: task dormindo até o PENIRQ e amostrando em taxa fixa só enquanto pressionado
+constexpr uint32_t TOUCH_SAMPLE_PERIOD_MS = 10;     // 100 Hz durante o toque
+constexpr uint32_t TOUCH_IDLE_POLL_MS = 50;         // Usado apenas se o PENIRQ não puder ser configurado
+constexpr uint32_t TOUCH_TASK_STACK_SIZE = 3072;
+constexpr UBaseType_t TOUCH_TASK_PRIORITY = 2;      // Acima do task do LVGL para não perder amostras
+
+// Task de brilho: inicia o ADC contínuo (driver, DMA e ISR) e aplica os ajustes manuais
+constexpr uint32_t BRIGHTNESS_TASK_STACK_SIZE = 3072;
+constexpr UBaseType_t BRIGHTNESS_TASK_PRIORITY = 1;
 
 // Configuração LEDC para PWM do backlight
 constexpr ledc_timer_t LEDC_TIMER = LEDC_TIMER_0;
@@ -71,11 +89,44 @@ constexpr adc_unit_t ADC_UNIT = ADC_UNIT_1;
 constexpr adc_channel_t ADC_LDR_CHANNEL = ADC_CHANNEL_6;  // GPIO34 = ADC1_CH6
 constexpr adc_atten_t ADC_ATTEN = ADC_ATTEN_DB_12;  // 0-3.9V (DB_12 no ESP32)
 constexpr adc_bitwidth_t ADC_BITWIDTH = ADC_BITWIDTH_12;  // 12 bits
-constexpr uint32_t BRIGHTNESS_UPDATE_INTERVAL_MS = 500;  // Atualizar brilho a cada 500ms
+
+// Amostragem contínua do LDR (DMA). O controlador digital do ESP32 não converte abaixo
+// de 20 kHz, então a taxa é reduzida no callback: só um quadro a cada
+// LDR_FRAMES_PER_UPDATE é lido, e dele só LDR_SAMPLES_PER_UPDATE conversões espaçadas
+// (o quadro de 25,6 ms cobre um ciclo inteiro da cintilação de 50/60 Hz das lâmpadas)
+constexpr uint32_t LDR_SAMPLE_FREQ_HZ = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+constexpr uint32_t LDR_FRAME_BYTES = 1024;      // 512 conversões por quadro, ~39 quadros/s
+constexpr uint8_t LDR_FRAMES_PER_UPDATE = 4;    // ~10 atualizações do filtro por segundo
+constexpr uint32_t LDR_SAMPLES_PER_UPDATE = 64;
+constexpr int32_t LDR_FILTER_SHIFT = 2;         // Passa-baixa de 1/4 por atualização (~0,4 s)
+constexpr int32_t LDR_WAKE_DELTA = 24;          // Variação do nível filtrado que acorda o task (~0,6%)
+constexpr int BRIGHTNESS_FADE_MS = 600;         // Fade do LEDC no brilho automático
+// A soma de um quadro em Q8 precisa caber em 32 bits
+static_assert((LDR_FRAME_BYTES / sizeof(adc_digi_output_data_t)) * 4095ULL * 256 <= UINT32_MAX, "quadro do LDR grande demais");
+
+// Brilho (%) por nível do LDR >> 4: MIN_BRIGHTNESS + 95 * (i / 255)^(1/2.2), truncado.
+// A curva deixa perceptíveis as mudanças pequenas em ambientes escuros.
+constexpr uint8_t LDR_GAMMA_LUT[256] = {
+      5,  12,  15,  17,  19,  20,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,
+     31,  32,  33,  34,  34,  35,  36,  36,  37,  38,  38,  39,  39,  40,  40,  41,
+     41,  42,  43,  43,  44,  44,  44,  45,  45,  46,  46,  47,  47,  48,  48,  49,
+     49,  49,  50,  50,  51,  51,  51,  52,  52,  53,  53,  53,  54,  54,  54,  55,
+     55,  56,  56,  56,  57,  57,  57,  58,  58,  58,  59,  59,  59,  60,  60,  60,
+     61,  61,  61,  62,  62,  62,  62,  63,  63,  63,  64,  64,  64,  65,  65,  65,
+     65,  66,  66,  66,  67,  67,  67,  67,  68,  68,  68,  69,  69,  69,  69,  70,
+     70,  70,  70,  71,  71,  71,  71,  72,  72,  72,  72,  73,  73,  73,  73,  74,
+     74,  74,  74,  75,  75,  75,  75,  76,  76,  76,  76,  77,  77,  77,  77,  78,
+     78,  78,  78,  78,  79,  79,  79,  79,  80,  80,  80,  80,  80,  81,  81,  81,
+     81,  82,  82,  82,  82,  82,  83,  83,  83,  83,  84,  84,  84,  84,  84,  85,
+     85,  85,  85,  85,  86,  86,  86,  86,  86,  87,  87,  87,  87,  87,  88,  88,
+     88,  88,  88,  89,  89,  89,  89,  89,  90,  90,  90,  90,  90,  91,  91,  91,
+     91,  91,  91,  92,  92,  92,  92,  92,  93,  93,  93,  93,  93,  94,  94,  94,
+     94,  94,  94,  95,  95,  95,  95,  95,  96,  96,  96,  96,  96,  96,  97,  97,
+     97,  97,  97,  97,  98,  98,  98,  98,  98,  98,  99,  99,  99,  99,  99, 100,
+};
 } // namespace
 
-// Mutex para proteger acesso ao LVGL (substitui lvgl_port_lock) - precisa estar fora do namespace
-SemaphoreHandle_t lvgl_mutex = nullptr;
+// Task do LVGL - precisa estar fora do namespace (usado por lvgl_lock e ui::jobs)
 TaskHandle_t lvgl_task_handle = nullptr;
 esp_timer_handle_t lvgl_tick_timer = nullptr;
 
@@ -84,21 +135,22 @@ void lvgl_timer_task(void *pvParameters) {
     lvgl_task_handle = xTaskGetCurrentTaskHandle();
     const TickType_t delay_ms = pdMS_TO_TICKS(10); // 10ms = 100Hz (balance entre responsividade e CPU)
     static uint32_t handler_count = 0;
+    auto &driver = DisplayDriver::instance();
     while (1) {
-        if (lvgl_mutex != nullptr) {
-            // Tentar adquirir mutex sem timeout - se não conseguir, pular este ciclo
-            // Isso garante que eventos sejam processados mesmo se houver bloqueio temporário
-            if (xSemaphoreTake(lvgl_mutex, 0) == pdTRUE) {
-                lv_timer_handler();
-                xSemaphoreGive(lvgl_mutex);
-                handler_count++;
-            }
-        } else {
+        // Espera o lock com prazo; atrasos e passadas perdidas vão para lvgl_lock_stats()
+        if (lvgl_frame_lock()) {
+            const int64_t pass_start_us = esp_timer_get_time();
+            trace::emit(trace::Event::LVGL_HANDLER_BEGIN);
+            driver.process_touch_events();
             lv_timer_handler();
+            trace::emit(trace::Event::LVGL_HANDLER_END);
+            lvgl_frame_unlock();
+            driver.frame_times().on_pass(pass_start_us, esp_timer_get_time());
             handler_count++;
         }
-        // Dar tempo ao IDLE task para evitar watchdog
-        vTaskDelay(delay_ms);
+        // Dar tempo ao IDLE task para evitar watchdog; o task do touch acorda antes
+        // (notificação) quando publica uma amostra nova
+        ulTaskNotifyTake(pdTRUE, delay_ms);
     }
 }
 
@@ -110,9 +162,6 @@ static void lvgl_tick_cb(void *arg) {
 // Flush callback para LVGL - envia dados para o painel LCD
 // Precisa estar fora do namespace para ser acessível como callback
 void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
-    static int flush_count = 0;
-    flush_count++;
-    
     DisplayDriver *driver = static_cast<DisplayDriver *>(lv_display_get_user_data(disp));
     if (driver == nullptr) {
         ESP_LOGE("DisplayDriver", "Flush callback: driver é nullptr");
@@ -133,14 +182,8 @@ void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
     int32_t x2 = area->x2;
     int32_t y2 = area->y2;
     
-    int32_t width = x2 - x1 + 1;
-    int32_t height = y2 - y1 + 1;
-    
-    // Log mais frequente para debug inicial
-    if (flush_count <= 20 || flush_count % 50 == 0) {
-        ESP_LOGI("DisplayDriver", "Flush #%d: área (%d,%d) a (%d,%d), tamanho=%dx%d, px_map=%p", 
-                 flush_count, x1, y1, x2, y2, width, height, px_map);
-    }
+    // Área no trace binário (o log por flush custava milissegundos de UART por frame)
+    trace::emit(trace::Event::FLUSH_BEGIN, trace::pack_xy(x1, y1), trace::pack_xy(x2, y2));
 
     // Painel configurado como RGB, então podemos usar os dados diretamente do LVGL
     // LVGL gera RGB565, que é compatível com o painel RGB
@@ -153,6 +196,12 @@ void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
     if (err != ESP_OK) {
         ESP_LOGE("DisplayDriver", "Erro ao desenhar bitmap: %s", esp_err_to_name(err));
     }
+    trace::emit(trace::Event::FLUSH_END);
+    driver->frame_times().mark_rendered();
+    boot_profile::on_frame();
+
+    // Medições de latência fecham quando a área invalidada pelo evento chega ao painel
+    driver->input_latency().on_flush(*area, lv_display_flush_is_last(disp), esp_timer_get_time());
 
     // Informar LVGL que o flush está completo
     lv_display_flush_ready(disp);
@@ -179,7 +228,10 @@ esp_err_t DisplayDriver::init() {
     ESP_LOGI(TAG, "  SPI Host: SPI2 (VSPI) - pinos remapeados para HSPI (SPI1 em uso pela flash)");
 
     ESP_RETURN_ON_ERROR(init_backlight(), TAG, "Backlight init failed");
+#if !FAST_BOOT
+    // Diagnóstico: leituras do LDR no log antes do painel (no boot rápido o task de brilho inicia o LDR)
     ESP_RETURN_ON_ERROR(init_ldr(), TAG, "LDR init failed");
+#endif
     
     // Carregar configurações de brilho do NVS
     load_brightness_settings();
@@ -192,28 +244,46 @@ esp_err_t DisplayDriver::init() {
     }
     
     ESP_RETURN_ON_ERROR(init_panel_io(), TAG, "Panel IO init failed");
-    ESP_RETURN_ON_ERROR(init_panel_device(), TAG, "Panel device init failed");
+    ESP_RETURN_ON_ERROR(reset_panel(), TAG, "Panel reset failed");
     
+    // Touch e LVGL não dependem do painel: rodam durante a espera pós-reset dele
     // Inicializar touch usando software SPI (bit-banging)
     // Isso resolve o problema de não poder usar SPI1 com pinos diferentes
     ESP_RETURN_ON_ERROR(init_touch(), TAG, "Touch init failed");
     
     ESP_RETURN_ON_ERROR(init_lvgl(), TAG, "LVGL init failed");
+    ESP_RETURN_ON_ERROR(init_panel_device(), TAG, "Panel device init failed");
     ESP_RETURN_ON_ERROR(create_lvgl_display(), TAG, "LVGL display creation failed");
     
     // Adicionar touch ao LVGL
     ESP_RETURN_ON_ERROR(add_touch_to_lvgl(), TAG, "LVGL touch registration failed");
 
-    // Criar task para atualizar brilho automaticamente
+    // Criar task de amostragem do touch (após o indev existir)
+    BaseType_t touch_task_result = xTaskCreatePinnedToCore(
+        touch_sampling_task,
+        "touch_task",
+        TOUCH_TASK_STACK_SIZE,
+        this,
+        TOUCH_TASK_PRIORITY,
+        &touch_task_handle_,
+        1      // Core 1 (mesmo core do LVGL)
+    );
+    if (touch_task_result != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar task do touch");
+        return ESP_FAIL;
+    }
+
+    // Criar task para atualizar brilho automaticamente (inicia o ADC do LDR: o ISR
+    // fica no core de quem instala, então o task fica longe do core do LVGL)
     TaskHandle_t created_task_handle = nullptr;
     BaseType_t task_result = xTaskCreatePinnedToCore(
         brightness_update_task,
         "brightness_task",
-        2048,  // Stack size
+        BRIGHTNESS_TASK_STACK_SIZE,
         this,
-        1,     // Priority
+        BRIGHTNESS_TASK_PRIORITY,
         &created_task_handle,
-        1      // Core 1
+        0      // Core 0
     );
     
     if (task_result != pdPASS) {
@@ -233,6 +303,7 @@ lv_display_t *DisplayDriver::lvgl_display() const {
 }
 
 esp_err_t DisplayDriver::init_backlight() {
+    const boot_profile::Scope stage("backlight");
     ESP_LOGI(TAG, "Inicializando backlight com PWM (LEDC)...");
     
     // Configurar timer LEDC
@@ -253,6 +324,9 @@ esp_err_t DisplayDriver::init_backlight() {
     ledc_channel.timer_sel = LEDC_TIMER;
     ledc_channel.hpoint = 0;
     ESP_RETURN_ON_ERROR(ledc_channel_config(&ledc_channel), TAG, "LEDC channel config failed");
+
+    // Fades em hardware para o brilho automático (o LEDC interpola o duty sozinho)
+    ESP_RETURN_ON_ERROR(ledc_fade_func_install(0), TAG, "LEDC fade install failed");
     
     // Definir brilho inicial (100% - padrão manual)
     current_brightness_ = 100;
@@ -264,63 +338,72 @@ esp_err_t DisplayDriver::init_backlight() {
 }
 
 esp_err_t DisplayDriver::init_ldr() {
-    ESP_LOGI(TAG, "Inicializando sensor LDR (GPIO %d, ADC1_CH6)...", PIN_NUM_LDR);
-    
-    // Configurar GPIO34 como input (necessário antes de usar ADC)
-    // OBS: Para ADC, geralmente não configuramos como GPIO digital input, pois isso ativa o buffer digital.
-    // O driver ADC cuida da configuração do pino. Configurar como GPIO input pode causar conflitos ou leitura incorreta.
-    // Removendo configuração explícita de GPIO para ver se resolve o problema de leitura 0.
-    /*
-    gpio_config_t io_conf = {};
-    io_conf.pin_bit_mask = (1ULL << PIN_NUM_LDR);
-    io_conf.mode = GPIO_MODE_INPUT;
-    io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
-    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
-    io_conf.intr_type = GPIO_INTR_DISABLE;
-    ESP_RETURN_ON_ERROR(gpio_config(&io_conf), TAG, "GPIO config failed");
-    ESP_LOGI(TAG, "GPIO %d configurado como input", PIN_NUM_LDR);
-    */
-    
-    // Configurar ADC oneshot
-    adc_oneshot_unit_init_cfg_t init_config = {};
-    init_config.unit_id = ADC_UNIT;
-    init_config.clk_src = ADC_RTC_CLK_SRC_DEFAULT;
-    init_config.ulp_mode = ADC_ULP_MODE_DISABLE;
-    ESP_RETURN_ON_ERROR(adc_oneshot_new_unit(&init_config, &this->adc1_handle_), TAG, "ADC oneshot unit init failed");
-    ESP_LOGI(TAG, "ADC oneshot unit criado (unit_id=%d)", ADC_UNIT);
-    
-    // Configurar canal do ADC
-    adc_oneshot_chan_cfg_t channel_config = {};
-    channel_config.bitwidth = ADC_BITWIDTH;
-    channel_config.atten = ADC_ATTEN;
-    ESP_RETURN_ON_ERROR(adc_oneshot_config_channel(this->adc1_handle_, ADC_LDR_CHANNEL, &channel_config), 
-                        TAG, "ADC channel config failed");
-    ESP_LOGI(TAG, "ADC channel %d configurado (bitwidth=%d, atten=%d, gpio=%d)", 
-             ADC_LDR_CHANNEL, ADC_BITWIDTH, ADC_ATTEN, PIN_NUM_LDR);
-    
-    // Aguardar um pouco para estabilizar
-    vTaskDelay(pdMS_TO_TICKS(200));
-    
-    // Fazer múltiplas leituras para verificar
-    int adc_raw = 0;
-    ESP_LOGI(TAG, "Fazendo leituras iniciais do LDR...");
+    if (ldr_adc_handle_ != nullptr) {
+        return ESP_OK;
+    }
+    const boot_profile::Scope stage("ldr");
+    ESP_LOGI(TAG, "Inicializando sensor LDR (GPIO %d, ADC1_CH6, contínuo)...", PIN_NUM_LDR);
+    
+    // O driver ADC cuida da configuração do pino: configurar GPIO34 como input digital
+    // ativa o buffer digital e atrapalha a leitura (dava leitura 0)
+    
+    // Conversões por DMA; ninguém chama adc_continuous_read: o callback de cada quadro
+    // faz a média e o filtro, e o pool interno é descartado quando enche
+    adc_continuous_handle_cfg_t handle_config = {};
+    handle_config.max_store_buf_size = LDR_FRAME_BYTES;
+    handle_config.conv_frame_size = LDR_FRAME_BYTES;
+    handle_config.flags.flush_pool = 1;
+    ESP_RETURN_ON_ERROR(adc_continuous_new_handle(&handle_config, &ldr_adc_handle_), TAG,
+                        "ADC continuous handle init failed");
+    
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN;
+    pattern.channel = ADC_LDR_CHANNEL;
+    pattern.unit = ADC_UNIT;
+    pattern.bit_width = ADC_BITWIDTH;
+    
+    adc_continuous_config_t adc_config = {};
+    adc_config.pattern_num = 1;
+    adc_config.adc_pattern = &pattern;
+    adc_config.sample_freq_hz = LDR_SAMPLE_FREQ_HZ;
+    adc_config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    adc_config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+    
+    adc_continuous_evt_cbs_t callbacks = {};
+    callbacks.on_conv_done = ldr_conv_done_isr;
+    
+    esp_err_t ret = adc_continuous_config(ldr_adc_handle_, &adc_config);
+    if (ret == ESP_OK) {
+        ret = adc_continuous_register_event_callbacks(ldr_adc_handle_, &callbacks, this);
+    }
+    if (ret == ESP_OK) {
+        ret = adc_continuous_start(ldr_adc_handle_);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao configurar ADC contínuo do LDR: %s", esp_err_to_name(ret));
+        adc_continuous_deinit(ldr_adc_handle_);
+        ldr_adc_handle_ = nullptr;
+        return ret;
+    }
+    ESP_LOGI(TAG, "ADC contínuo do LDR a %lu Hz (%lu conversões por quadro; filtro a cada %u quadros com %lu delas, atten=%d)",
+             static_cast<unsigned long>(LDR_SAMPLE_FREQ_HZ),
+             static_cast<unsigned long>(LDR_FRAME_BYTES / sizeof(adc_digi_output_data_t)),
+             static_cast<unsigned>(LDR_FRAMES_PER_UPDATE), static_cast<unsigned long>(LDR_SAMPLES_PER_UPDATE),
+             ADC_ATTEN);
+    
+#if !FAST_BOOT
+    // Diagnóstico: nível filtrado no log enquanto o filtro assenta
     for (int i = 0; i < 10; i++) {
-        esp_err_t ret = adc_oneshot_read(this->adc1_handle_, ADC_LDR_CHANNEL, &adc_raw);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Erro ao ler LDR (tentativa %d): %s", i+1, esp_err_to_name(ret));
-        } else {
-            ESP_LOGI(TAG, "Leitura %d: %d", i+1, adc_raw);
-        }
         vTaskDelay(pdMS_TO_TICKS(100));
+        ESP_LOGI(TAG, "LDR filtrado após %d ms: %u", (i + 1) * 100, get_ldr_value());
     }
-    
-    // Usar a última leitura válida
-    last_ldr_value_ = static_cast<uint16_t>(adc_raw);
+#endif
     
     return ESP_OK;
 }
 
 esp_err_t DisplayDriver::init_spi_bus() {
+    const boot_profile::Scope stage("spi");
     if (spi_initialized_) {
         return ESP_OK;
     }
@@ -357,6 +440,7 @@ esp_err_t DisplayDriver::init_spi_bus() {
 }
 
 esp_err_t DisplayDriver::init_panel_io() {
+    const boot_profile::Scope stage("painel_io");
     if (panel_io_ != nullptr) {
         return ESP_OK;
     }
@@ -395,10 +479,11 @@ esp_err_t DisplayDriver::init_panel_io() {
     return ESP_OK;
 }
 
-esp_err_t DisplayDriver::init_panel_device() {
+esp_err_t DisplayDriver::reset_panel() {
     if (panel_handle_ != nullptr) {
         return ESP_OK;
     }
+    const boot_profile::Scope stage("painel_reset");
 
     esp_lcd_panel_dev_config_t panel_config = {};
     panel_config.reset_gpio_num = PIN_NUM_RST;
@@ -410,7 +495,22 @@ esp_err_t DisplayDriver::init_panel_device() {
     ESP_RETURN_ON_ERROR(esp_lcd_new_panel_ili9341(panel_io_, &panel_config, &panel_handle_),
                         TAG, "esp_lcd_new_panel_ili9341 failed");
     ESP_RETURN_ON_ERROR(esp_lcd_panel_reset(panel_handle_), TAG, "panel reset failed");
-    vTaskDelay(pdMS_TO_TICKS(120));  // Aguardar estabilização após reset
+    panel_reset_us_ = esp_timer_get_time();
+    return ESP_OK;
+}
+
+esp_err_t DisplayDriver::init_panel_device() {
+    if (panel_configured_) {
+        return ESP_OK;
+    }
+    const boot_profile::Scope stage("painel_init");
+
+    // Aguardar estabilização após reset (só o que sobrou depois do touch e do LVGL)
+    const int64_t settled_us = panel_reset_us_ + PANEL_RESET_SETTLE_MS * 1000;
+    const int64_t now_us = esp_timer_get_time();
+    if (now_us < settled_us) {
+        vTaskDelay(pdMS_TO_TICKS((settled_us - now_us + 999) / 1000));
+    }
     ESP_RETURN_ON_ERROR(esp_lcd_panel_init(panel_handle_), TAG, "panel init failed");
     
     // Habilitar gamma correction (GAMMASET 0x26) - curva 1 (G2.2) para melhor qualidade visual
@@ -425,7 +525,9 @@ esp_err_t DisplayDriver::init_panel_device() {
     esp_lcd_panel_mirror(panel_handle_, true, false);
     
     ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_on_off(panel_handle_, true), TAG, "panel on failed");
+    panel_configured_ = true;
     
+#if !FAST_BOOT
     // Teste básico: preencher tela com cor vermelha para verificar se o display funciona
     ESP_LOGI(TAG, "Testando display com cor sólida...");
     uint16_t test_color = 0xF800; // Vermelho em RGB565 (R=31, G=0, B=0)
@@ -445,11 +547,13 @@ esp_err_t DisplayDriver::init_panel_device() {
     } else {
         ESP_LOGW(TAG, "Não foi possível alocar buffer para teste");
     }
+#endif
     
     return ESP_OK;
 }
 
 esp_err_t DisplayDriver::init_touch() {
+    const boot_profile::Scope stage("touch");
     if (touch_controller_ != nullptr) {
         return ESP_OK;
     }
@@ -460,20 +564,33 @@ esp_err_t DisplayDriver::init_touch() {
     ESP_LOGI(TAG, "  Touch CS: GPIO %d", PIN_NUM_TOUCH_CS);
     ESP_LOGI(TAG, "  Touch MISO: GPIO %d", PIN_NUM_TOUCH_MISO);
 
-    touch_controller_ = new (std::nothrow) Xpt2046Bitbang(
-        PIN_NUM_TOUCH_MOSI,
-        PIN_NUM_TOUCH_MISO,
-        PIN_NUM_TOUCH_CLK,
-        PIN_NUM_TOUCH_CS,
-        LCD_H_RES,
-        LCD_V_RES);
+    const Xpt2046Pins touch_pins = {PIN_NUM_TOUCH_MOSI, PIN_NUM_TOUCH_MISO, PIN_NUM_TOUCH_CLK, PIN_NUM_TOUCH_CS};
+    Xpt2046RegisterTransport *register_transport = nullptr;
+    if (TOUCH_REGISTER_TRANSPORT) {
+        register_transport = new (std::nothrow) Xpt2046RegisterTransport(touch_pins, TOUCH_SPI_CLOCK_HZ);
+        touch_transport_ = register_transport;
+    } else {
+        touch_transport_ = new (std::nothrow) Xpt2046GpioTransport(touch_pins);
+    }
+    if (touch_transport_ != nullptr) {
+        touch_controller_ = new (std::nothrow) Xpt2046Bitbang(*touch_transport_, LCD_H_RES, LCD_V_RES);
+    }
 
     if (touch_controller_ == nullptr) {
         ESP_LOGE(TAG, "Falha ao alocar Xpt2046Bitbang");
+        delete touch_transport_;
+        touch_transport_ = nullptr;
         return ESP_ERR_NO_MEM;
     }
 
     touch_controller_->begin();
+    if (register_transport != nullptr) {
+        ESP_LOGI(TAG, "  Transporte por registradores: clock alvo %lu Hz (%lu ciclos por meio período)",
+                 static_cast<unsigned long>(register_transport->clockHz()),
+                 static_cast<unsigned long>(register_transport->halfPeriodCycles()));
+    } else {
+        ESP_LOGI(TAG, "  Transporte gpio_set_level()");
+    }
     // Configurar inversão antes da calibração para que a inversão seja aplicada nos valores RAW
     touch_controller_->setInversion(TOUCH_INVERT_X, TOUCH_INVERT_Y);
     touch_controller_->setCalibration(
@@ -481,26 +598,55 @@ esp_err_t DisplayDriver::init_touch() {
         TOUCH_CALIB.yMin, TOUCH_CALIB.yMax);
     current_touch_calibration_ = TOUCH_CALIB;
     touch_calibration_loaded_ = false;
+    if (touch_calibration_queue_ == nullptr) {
+        touch_calibration_queue_ = xQueueCreate(1, sizeof(TouchCalibration));
+        if (touch_calibration_queue_ == nullptr) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
     load_touch_calibration_from_nvs();
 
-    ESP_LOGI(TAG, "Touch screen XPT2046 pronto (bit-bang)");
+    // PENIRQ: interrupção por nível baixo, desabilitada no ISR e rearmada pelo task
+    gpio_config_t irq_cfg = {};
+    irq_cfg.mode = GPIO_MODE_INPUT;
+    irq_cfg.pin_bit_mask = BIT64(PIN_NUM_TOUCH_IRQ);
+    irq_cfg.pull_up_en = GPIO_PULLUP_DISABLE;   // GPIO36 não tem pull-up interno (pull-up no XPT2046)
+    irq_cfg.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    irq_cfg.intr_type = GPIO_INTR_LOW_LEVEL;
+    esp_err_t irq_err = gpio_config(&irq_cfg);
+    if (irq_err == ESP_OK) {
+        irq_err = gpio_install_isr_service(0);
+        if (irq_err == ESP_ERR_INVALID_STATE) {
+            irq_err = ESP_OK; // Serviço já instalado por outro componente
+        }
+    }
+    if (irq_err == ESP_OK) {
+        gpio_intr_disable(PIN_NUM_TOUCH_IRQ);
+        irq_err = gpio_isr_handler_add(PIN_NUM_TOUCH_IRQ, touch_irq_isr, this);
+    }
+    touch_irq_enabled_ = (irq_err == ESP_OK);
+    if (!touch_irq_enabled_) {
+        ESP_LOGW(TAG, "PENIRQ indisponível (%s) - touch será consultado a cada %u ms",
+                 esp_err_to_name(irq_err), static_cast<unsigned>(TOUCH_IDLE_POLL_MS));
+    }
+
+    ESP_LOGI(TAG, "Touch screen XPT2046 pronto (bit-bang, PENIRQ GPIO %d)", PIN_NUM_TOUCH_IRQ);
     return ESP_OK;
 }
 
 esp_err_t DisplayDriver::init_lvgl() {
+    const boot_profile::Scope stage("lvgl");
     if (lvgl_port_initialized_) {
         ESP_LOGI(TAG, "LVGL já inicializado");
         return ESP_OK;
     }
 
-    ESP_LOGI(TAG, "Criando mutex para LVGL...");
-    // Criar mutex para proteger acesso ao LVGL
-    lvgl_mutex = xSemaphoreCreateMutex();
-    if (lvgl_mutex == nullptr) {
-        ESP_LOGE(TAG, "Falha ao criar mutex LVGL");
+    ESP_LOGI(TAG, "Criando lock do LVGL...");
+    // Mutex recursivo com herança de prioridade compartilhado por todos os tasks
+    if (!lvgl_lock_init()) {
+        ESP_LOGE(TAG, "Falha ao criar lock do LVGL");
         return ESP_ERR_NO_MEM;
     }
-    ESP_LOGI(TAG, "Mutex criado: %p", lvgl_mutex);
 
     ESP_LOGI(TAG, "Inicializando LVGL...");
     // Inicializar LVGL
@@ -552,6 +698,7 @@ esp_err_t DisplayDriver::init_lvgl() {
 }
 
 esp_err_t DisplayDriver::add_touch_to_lvgl() {
+    const boot_profile::Scope stage("lvgl_indev");
     if (lv_touch_indev_ != nullptr) {
         return ESP_OK;
     }
@@ -561,22 +708,23 @@ esp_err_t DisplayDriver::add_touch_to_lvgl() {
         return ESP_ERR_INVALID_STATE;
     }
 
-    if (lvgl_mutex != nullptr) {
-        xSemaphoreTake(lvgl_mutex, portMAX_DELAY);
-    }
+    lvgl_lock();
 
     lv_touch_indev_ = lv_indev_create();
     if (lv_touch_indev_ != nullptr) {
         lv_indev_set_type(lv_touch_indev_, LV_INDEV_TYPE_POINTER);
         lv_indev_set_read_cb(lv_touch_indev_, lvgl_touch_read_cb);
+        // Modo evento: lido apenas quando o task do touch publica amostras
+        // (process_touch_events); enquanto pressionado, o task do touch
+        // continua publicando a TOUCH_SAMPLE_PERIOD_MS e o LVGL não lê sozinho
+        lv_indev_set_mode(lv_touch_indev_, LV_INDEV_MODE_EVENT);
         lv_indev_set_disp(lv_touch_indev_, lv_display_);
         lv_indev_set_driver_data(lv_touch_indev_, this);
+        lv_indev_add_event_cb(lv_touch_indev_, lvgl_touch_pressed_cb, LV_EVENT_PRESSED, this);
         ESP_LOGI(TAG, "LVGL indev para touch criado: %p", static_cast<void *>(lv_touch_indev_));
     }
 
-    if (lvgl_mutex != nullptr) {
-        xSemaphoreGive(lvgl_mutex);
-    }
+    lvgl_unlock();
 
     if (lv_touch_indev_ == nullptr) {
         ESP_LOGE(TAG, "Falha ao criar LVGL indev para touch");
@@ -589,13 +737,23 @@ esp_err_t DisplayDriver::add_touch_to_lvgl() {
 
 void DisplayDriver::apply_touch_calibration(const TouchCalibration &calibration) {
     current_touch_calibration_ = calibration;
-    if (touch_controller_ != nullptr) {
-        // Garantir que a inversão está configurada antes da calibração
-        touch_controller_->setInversion(TOUCH_INVERT_X, TOUCH_INVERT_Y);
-        touch_controller_->setCalibration(
-            calibration.xMin, calibration.xMax,
-            calibration.yMin, calibration.yMax);
+    if (touch_controller_ == nullptr) {
+        return;
     }
+    if (touch_task_handle_ != nullptr) {
+        // O task do touch lê o controlador sem lock: ele aplica antes da próxima leitura
+        xQueueOverwrite(touch_calibration_queue_, &calibration);
+        return;
+    }
+    set_controller_calibration(calibration);
+}
+
+void DisplayDriver::set_controller_calibration(const TouchCalibration &calibration) {
+    // Garantir que a inversão está configurada antes da calibração
+    touch_controller_->setInversion(TOUCH_INVERT_X, TOUCH_INVERT_Y);
+    touch_controller_->setCalibration(
+        calibration.xMin, calibration.xMax,
+        calibration.yMin, calibration.yMax);
 }
 
 void DisplayDriver::load_touch_calibration_from_nvs() {
@@ -652,6 +810,7 @@ void DisplayDriver::update_touch_calibration(const TouchCalibration &calibration
 }
 
 esp_err_t DisplayDriver::create_lvgl_display() {
+    const boot_profile::Scope stage("lvgl_display");
     if (lv_display_ != nullptr) {
         return ESP_OK;
     }
@@ -713,8 +872,13 @@ void DisplayDriver::lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
         return;
     }
 
-    TouchPoint point = driver->touch_controller_->getTouch();
-    driver->last_touch_point_ = point;
+    // Consumir uma amostra por leitura; sem amostra nova, repetir o último estado
+    TouchSample sample;
+    if (driver->touch_ring_.pop(sample)) {
+        driver->input_latency_.set_input_timestamp(sample.timestamp_us);
+        driver->last_touch_point_ = sample.point;
+    }
+    TouchPoint point = driver->last_touch_point_;
     if (point.pressure > 0) {
         // A inversão já é aplicada nos valores RAW antes do mapeamento no Xpt2046Bitbang
         // Então point.x e point.y já estão na orientação correta
@@ -731,40 +895,226 @@ void DisplayDriver::lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
         data->point.y = mapped_y;
 
         if (last_state != LV_INDEV_STATE_PRESSED) {
-            ESP_LOGI("TouchLVGL", "press raw=(%u,%u) mapped=(%d,%d) pressure=%u",
-                     point.rawX, point.rawY, mapped_x, mapped_y, point.pressure);
+            trace::emit(trace::Event::TOUCH_PRESS, trace::pack_xy(mapped_x, mapped_y),
+                        trace::pack_xy(point.rawX, point.rawY));
         }
         last_state = LV_INDEV_STATE_PRESSED;
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
         if (last_state != LV_INDEV_STATE_RELEASED) {
-            ESP_LOGI("TouchLVGL", "release");
+            trace::emit(trace::Event::TOUCH_RELEASE);
         }
         last_state = LV_INDEV_STATE_RELEASED;
     }
 }
 
+void DisplayDriver::lvgl_touch_pressed_cb(lv_event_t *e) {
+    // Borda de press: a medição fecha quando o objeto pressionado (estilo PRESSED) é redesenhado
+    auto *driver = static_cast<DisplayDriver *>(lv_event_get_user_data(e));
+    if (driver != nullptr) {
+        driver->input_latency_.arm(InputLatencyKind::Press, lv_indev_get_active_obj());
+    }
+}
+
+void DisplayDriver::process_touch_events() {
+    if (lv_touch_indev_ == nullptr) {
+        return;
+    }
+    // Uma leitura por amostra preserva as transições de press/release
+    while (!touch_ring_.empty()) {
+        lv_indev_read(lv_touch_indev_);
+    }
+}
+
+void DisplayDriver::publish_touch_sample(const TouchPoint &point, int64_t timestamp_us) {
+    TouchSample sample = {point, timestamp_us};
+    if (!touch_ring_.push(sample)) {
+        touch_dropped_samples_++;
+        return;
+    }
+    if (lvgl_task_handle != nullptr) {
+        xTaskNotifyGive(lvgl_task_handle);
+    }
+}
+
+void DisplayDriver::touch_irq_isr(void *arg) {
+    auto *driver = static_cast<DisplayDriver *>(arg);
+    // Nível baixo permanece enquanto pressionado: desabilitar até o task rearmar
+    gpio_intr_disable(PIN_NUM_TOUCH_IRQ);
+    BaseType_t higher_priority_woken = pdFALSE;
+    if (driver->touch_task_handle_ != nullptr) {
+        vTaskNotifyGiveFromISR(driver->touch_task_handle_, &higher_priority_woken);
+    }
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
+void DisplayDriver::touch_sampling_task(void *pvParameters) {
+    auto *driver = static_cast<DisplayDriver *>(pvParameters);
+    const TickType_t period = pdMS_TO_TICKS(TOUCH_SAMPLE_PERIOD_MS);
+    bool pressed = false;
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (true) {
+        // Trace pendente: substitui as leituras do XPT2046 até o fim (só com o dedo solto)
+        const TouchTrace *trace = pressed ? nullptr : driver->pending_trace_.exchange(nullptr);
+        if (trace != nullptr) {
+            driver->replay_touch_trace(trace);
+            last_wake = xTaskGetTickCount();
+            continue;
+        }
+
+        // Sem toque: dormir até o PENIRQ (ou até o próximo poll, se não houver IRQ)
+        if (!pressed && (!driver->touch_irq_enabled_ || gpio_get_level(PIN_NUM_TOUCH_IRQ) != 0)) {
+            if (driver->touch_irq_enabled_) {
+                gpio_intr_enable(PIN_NUM_TOUCH_IRQ);
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            } else {
+                vTaskDelay(pdMS_TO_TICKS(TOUCH_IDLE_POLL_MS));
+            }
+            last_wake = xTaskGetTickCount();
+        }
+
+        TouchCalibration calibration;
+        if (xQueueReceive(driver->touch_calibration_queue_, &calibration, 0) == pdTRUE) {
+            driver->set_controller_calibration(calibration);
+        }
+
+        // Timestamp no início da aquisição: a latência inclui a própria leitura
+        const int64_t timestamp_us = esp_timer_get_time();
+        TouchPoint point = driver->touch_controller_->getTouch();
+        if (point.pressure > 0) {
+            ESP_LOGV(TAG, "touch: x=%u y=%u raw=(%u,%u) pressure=%u",
+                     point.x, point.y, point.rawX, point.rawY, point.pressure);
+        }
+        if (point.pressure > 0 || pressed) {
+            driver->publish_touch_sample(point, timestamp_us);
+            if (driver->touch_recording_.load(std::memory_order_relaxed)) {
+                driver->record_touch_sample(point, timestamp_us);
+            }
+            pressed = point.pressure > 0;
+        }
+
+        // Taxa fixa enquanto pressionado (ou enquanto o PENIRQ ainda indica toque)
+        vTaskDelayUntil(&last_wake, period);
+    }
+}
+
+esp_err_t DisplayDriver::start_touch_recording() {
+    // O buffer é a fonte de uma reprodução em andamento: não sobrescrever
+    if (is_touch_trace_playing()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (touch_recording_samples_ == nullptr) {
+        touch_recording_samples_ = static_cast<TouchTraceSample *>(
+            heap_caps_malloc(TOUCH_RECORDING_CAPACITY * sizeof(TouchTraceSample), MALLOC_CAP_8BIT));
+        if (touch_recording_samples_ == nullptr) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    touch_recording_count_.store(0);
+    touch_recording_.store(true);
+    ESP_LOGI(TOUCH_TRACE_TAG, "Gravação iniciada (buffer de %u amostras)",
+             static_cast<unsigned>(TOUCH_RECORDING_CAPACITY));
+    return ESP_OK;
+}
+
+void DisplayDriver::stop_touch_recording() {
+    if (touch_recording_.exchange(false)) {
+        const size_t count = std::min(touch_recording_count_.load(), TOUCH_RECORDING_CAPACITY);
+        touch_recording_trace_.samples = touch_recording_samples_;
+        touch_recording_trace_.count = count;
+        ESP_LOGI(TOUCH_TRACE_TAG, "Gravação encerrada (%u amostras, %lu ms)", static_cast<unsigned>(count),
+                 static_cast<unsigned long>(count > 0 ? touch_recording_samples_[count - 1].t_ms : 0));
+    }
+}
+
+const TouchTrace *DisplayDriver::last_touch_recording() const {
+    if (touch_recording_.load() || touch_recording_trace_.count == 0) {
+        return nullptr;
+    }
+    return &touch_recording_trace_;
+}
+
+void DisplayDriver::record_touch_sample(const TouchPoint &point, int64_t timestamp_us) {
+    // Tempo relativo à primeira amostra (não ao comando), como no conversor
+    const size_t index = touch_recording_count_.load(std::memory_order_relaxed);
+    if (index == 0) {
+        touch_recording_start_us_ = timestamp_us;
+    }
+    const uint32_t t_ms = static_cast<uint32_t>((timestamp_us - touch_recording_start_us_) / 1000);
+    ESP_LOGI(TOUCH_TRACE_TAG, "TT,%lu,%u,%u,%u,%u,%u",
+             static_cast<unsigned long>(t_ms), point.x, point.y, point.rawX, point.rawY, point.pressure);
+    if (index < TOUCH_RECORDING_CAPACITY) {
+        touch_recording_samples_[index] = TouchTraceSample{t_ms, point.x, point.y, point.pressure};
+        touch_recording_count_.store(index + 1, std::memory_order_release);
+    } else if (index == TOUCH_RECORDING_CAPACITY) {
+        ESP_LOGW(TOUCH_TRACE_TAG, "Buffer cheio: restante da gravação só no log serial");
+        touch_recording_count_.store(index + 1, std::memory_order_release);
+    }
+}
+
+esp_err_t DisplayDriver::play_touch_trace(const TouchTrace *trace) {
+    if (trace == nullptr || trace->count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (touch_task_handle_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    pending_trace_.store(trace);
+    xTaskNotifyGive(touch_task_handle_); // Acordar o task se estiver esperando o PENIRQ
+    return ESP_OK;
+}
+
+void DisplayDriver::replay_touch_trace(const TouchTrace *trace) {
+    ESP_LOGI(TOUCH_TRACE_TAG, "Reproduzindo '%s' (%u amostras, %lu ms)",
+             trace->name, static_cast<unsigned>(trace->count),
+             static_cast<unsigned long>(trace->samples[trace->count - 1].t_ms));
+    touch_trace_playing_.store(true);
+    // Janela de medição só com a reprodução (mesma entrada para comparar builds)
+    frame_times_.snapshot(true);
+
+    TouchTracePlayer player;
+    player.start(trace, esp_timer_get_time());
+    TouchTraceSample sample = {};
+    while (player.active()) {
+        const int64_t wait_us = player.next_due_us() - esp_timer_get_time();
+        if (wait_us > 0) {
+            TickType_t ticks = pdMS_TO_TICKS((wait_us + 999) / 1000);
+            vTaskDelay(ticks > 0 ? ticks : 1);
+        }
+        const int64_t now_us = esp_timer_get_time();
+        while (player.poll(now_us, sample)) {
+            publish_touch_sample(TouchPoint{sample.x, sample.y, 0, 0, sample.pressure}, now_us);
+        }
+    }
+    // Garantir que o indev termine solto mesmo se o trace acabar pressionado
+    if (sample.pressure > 0) {
+        publish_touch_sample(TouchPoint{sample.x, sample.y, 0, 0, 0}, esp_timer_get_time());
+    }
+
+    // Último refresh provocado pelo trace antes de fechar a janela
+    vTaskDelay(pdMS_TO_TICKS(100));
+    const FrameTimeStats frames = frame_times_.snapshot(false);
+    touch_trace_playing_.store(false);
+    ESP_LOGI(TOUCH_TRACE_TAG, "Reprodução de '%s' concluída: %lu quadros, p50 %lu us, p95 %lu us, máx %lu us",
+             trace->name, static_cast<unsigned long>(frames.frames), static_cast<unsigned long>(frames.p50_us),
+             static_cast<unsigned long>(frames.p95_us), static_cast<unsigned long>(frames.max_us));
+    for (size_t i = 0; i < static_cast<size_t>(InputLatencyKind::Count); ++i) {
+        const auto kind = static_cast<InputLatencyKind>(i);
+        const InputLatencyStats latency = input_latency_.stats(kind);
+        if (latency.samples > 0) {
+            ESP_LOGI(TOUCH_TRACE_TAG, "  Latência %s: p50 %lu us, p95 %lu us (%lu medições)",
+                     InputLatencyTracker::kind_name(kind), static_cast<unsigned long>(latency.p50_us),
+                     static_cast<unsigned long>(latency.p95_us), static_cast<unsigned long>(latency.samples));
+        }
+    }
+}
+
 esp_err_t DisplayDriver::set_brightness(uint8_t brightness) {
     // Limitar brilho entre MIN_BRIGHTNESS e MAX_BRIGHTNESS
     if (brightness < MIN_BRIGHTNESS) brightness = MIN_BRIGHTNESS;
     if (brightness > MAX_BRIGHTNESS) brightness = MAX_BRIGHTNESS;
     
-    // Converter porcentagem (0-100) para duty cycle (0-255)
-    uint32_t duty = (brightness * LEDC_MAX_DUTY) / 100;
-    
-    // Aplicar duty cycle no LEDC
-    esp_err_t ret = ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, duty);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Erro ao definir duty cycle: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    ret = ledc_update_duty(LEDC_MODE, LEDC_CHANNEL);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Erro ao atualizar duty cycle: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
     current_brightness_ = brightness;
     
     // Se não estiver em modo automático, atualizar brilho manual também
@@ -773,6 +1123,34 @@ esp_err_t DisplayDriver::set_brightness(uint8_t brightness) {
         // Não salvar aqui - será salvo via debounce após 1s sem modificação
     }
     
+    if (brightness_task_handle_ == nullptr) {
+        // Antes do task de brilho não há fade do automático em andamento
+        return apply_brightness(brightness);
+    }
+    // O ESP32 não interrompe um fade (SOC_LEDC_SUPPORT_FADE_STOP é 0) e
+    // ledc_set_duty_and_update espera o fade corrente terminar, até BRIGHTNESS_FADE_MS:
+    // quem espera é o task de brilho, não o LVGL (o slider chama daqui)
+    pending_brightness_.store(brightness, std::memory_order_relaxed);
+    xTaskNotifyGive(brightness_task_handle_);
+    return ESP_OK;
+}
+
+esp_err_t DisplayDriver::apply_brightness(uint8_t brightness) {
+    // Converter porcentagem (0-100) para duty cycle (0-255)
+    uint32_t duty = (brightness * LEDC_MAX_DUTY) / 100;
+    
+#if SOC_LEDC_SUPPORT_FADE_STOP
+    // Nos chips que permitem, o ajuste manual interrompe o fade do automático
+    ledc_fade_stop(LEDC_MODE, LEDC_CHANNEL);
+#endif
+    
+    // Aplicar duty cycle no LEDC (variante segura com o serviço de fade instalado)
+    esp_err_t ret = ledc_set_duty_and_update(LEDC_MODE, LEDC_CHANNEL, duty, 0);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Erro ao definir duty cycle: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
     ESP_LOGD(TAG, "Brilho definido para %d%% (duty: %lu)", brightness, duty);
     
     return ESP_OK;
@@ -787,8 +1165,10 @@ esp_err_t DisplayDriver::set_auto_brightness(bool enabled) {
         ESP_LOGI(TAG, "Brilho automático desabilitado. Brilho manual: %d%%", manual_brightness_);
     } else {
         ESP_LOGI(TAG, "Brilho automático habilitado");
-        // Atualizar imediatamente quando habilitar automático
-        update_auto_brightness();
+        // Aplicar o nível atual do LDR sem esperar ele variar (o fade roda no task de brilho)
+        if (brightness_task_handle_ != nullptr) {
+            xTaskNotifyGive(brightness_task_handle_);
+        }
     }
     
     // Salvar configuração
@@ -807,65 +1187,103 @@ void DisplayDriver::brightness_update_task(void *pvParameters) {
     
     ESP_LOGI(TAG, "Task de atualização de brilho iniciada");
     
+    // No boot rápido o LDR é iniciado aqui, no core 0, em paralelo com o resto do boot
+    if (driver->init_ldr() != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao iniciar LDR - brilho automático indisponível");
+    }
+    // O pico da pilha é a instalação do ADC contínuo; a telemetria segue acompanhando depois
+    ESP_LOGI(TAG, "Pilha do task de brilho: %u de %lu bytes livres após iniciar o LDR",
+             static_cast<unsigned>(uxTaskGetStackHighWaterMark(nullptr)),
+             static_cast<unsigned long>(BRIGHTNESS_TASK_STACK_SIZE));
+    
+    // Dorme até um ajuste manual ou até o callback do ADC ver a luz ambiente mudar (ou o automático ser ligado)
     while (true) {
-        if (driver->auto_brightness_enabled_) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        const int16_t manual = driver->pending_brightness_.exchange(-1, std::memory_order_relaxed);
+        if (manual >= 0) {
+            driver->apply_brightness(static_cast<uint8_t>(manual));
+        } else if (driver->auto_brightness_enabled_) {
             driver->update_auto_brightness();
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(BRIGHTNESS_UPDATE_INTERVAL_MS));
     }
 }
 
-void DisplayDriver::update_auto_brightness() {
-    if (this->adc1_handle_ == nullptr) {
-        ESP_LOGW(TAG, "ADC não inicializado");
-        return;
-    }
+bool DisplayDriver::ldr_conv_done_isr(adc_continuous_handle_t, const adc_continuous_evt_data_t *edata,
+                                      void *user_data) {
+    auto *driver = static_cast<DisplayDriver *>(user_data);
     
-    // Ler valor do LDR
-    int adc_raw = 0;
-    esp_err_t ret = adc_oneshot_read(this->adc1_handle_, ADC_LDR_CHANNEL, &adc_raw);
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "Erro ao ler LDR: %s (ret=%d)", esp_err_to_name(ret), ret);
-        return;
+    // O brilho reage em ~1 s: os outros quadros só custam a entrada no ISR
+    if (driver->ldr_filter_primed_ && ++driver->ldr_frames_skipped_ < LDR_FRAMES_PER_UPDATE) {
+        return false;
     }
+    driver->ldr_frames_skipped_ = 0;
     
-    // Log periódico para debug (a cada 10 leituras = ~5 segundos)
-    static int read_count = 0;
-    read_count++;
-    if (read_count % 10 == 0) {
-        ESP_LOGI(TAG, "LDR leitura: %d (raw=%d)", static_cast<uint16_t>(adc_raw), adc_raw);
+    // Sobreamostragem: a média de conversões espaçadas pelo quadro é uma amostra do filtro, em Q8
+    const auto *results = reinterpret_cast<const adc_digi_output_data_t *>(edata->conv_frame_buffer);
+    const uint32_t count = edata->size / sizeof(adc_digi_output_data_t);
+    const uint32_t stride = std::max<uint32_t>(1, count / LDR_SAMPLES_PER_UPDATE);
+    uint32_t sum = 0;
+    uint32_t valid = 0;
+    for (uint32_t i = 0; i < count; i += stride) {
+        if (results[i].type1.channel == ADC_LDR_CHANNEL) {
+            sum += results[i].type1.data;
+            valid++;
+        }
     }
+    if (valid == 0) {
+        return false;
+    }
+    const int32_t sample_q8 = static_cast<int32_t>((sum << 8) / valid);
     
-    last_ldr_value_ = static_cast<uint16_t>(adc_raw);
-    
-    // Mapear valor do LDR (0-4095) para brilho (MIN_BRIGHTNESS-MAX_BRIGHTNESS)
-    // Usar função exponencial para melhor percepção visual
-    // LDR alto (claro) = brilho alto, LDR baixo (escuro) = brilho baixo
-    
-    // Normalizar LDR para 0.0-1.0
-    float ldr_normalized = static_cast<float>(last_ldr_value_ - LDR_MIN) / 
-                           static_cast<float>(LDR_MAX - LDR_MIN);
+    // Passa-baixa de um polo: y += (x - y) / 2^LDR_FILTER_SHIFT
+    if (!driver->ldr_filter_primed_) {
+        driver->ldr_filter_q8_ = sample_q8;
+        driver->ldr_filter_primed_ = true;
+    } else {
+        driver->ldr_filter_q8_ += (sample_q8 - driver->ldr_filter_q8_) >> LDR_FILTER_SHIFT;
+    }
+    const int32_t level = (driver->ldr_filter_q8_ + 128) >> 8;
+    driver->last_ldr_value_.store(static_cast<uint16_t>(level), std::memory_order_relaxed);
     
-    // Aplicar curva exponencial (gamma ~2.2) para melhor percepção visual
-    // Isso faz com que mudanças pequenas em ambientes escuros sejam mais perceptíveis
-    float gamma = 2.2f;
-    float ldr_gamma = powf(ldr_normalized, 1.0f / gamma);
+    if (!driver->auto_brightness_enabled_ || driver->brightness_task_handle_ == nullptr) {
+        return false;
+    }
+    if (driver->ldr_reported_level_ >= 0 && abs(level - driver->ldr_reported_level_) < LDR_WAKE_DELTA) {
+        return false;
+    }
+    driver->ldr_reported_level_ = level;
+    BaseType_t higher_priority_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(driver->brightness_task_handle_, &higher_priority_woken);
+    return higher_priority_woken == pdTRUE;
+}
+
+void DisplayDriver::update_auto_brightness() {
+    if (ldr_adc_handle_ == nullptr) {
+        ESP_LOGW(TAG, "ADC não inicializado");
+        return;
+    }
     
-    // Mapear para faixa de brilho
-    uint8_t new_brightness = static_cast<uint8_t>(
-        MIN_BRIGHTNESS + (ldr_gamma * (MAX_BRIGHTNESS - MIN_BRIGHTNESS))
-    );
+    const uint16_t ldr = get_ldr_value();
+    trace::emit(trace::Event::LDR_RAW, ldr);
     
-    // Aplicar suavização para evitar mudanças bruscas
-    // Usar média ponderada: 70% novo valor, 30% valor atual
-    new_brightness = static_cast<uint8_t>((new_brightness * 7 + current_brightness_ * 3) / 10);
+    // LDR alto (claro) = brilho alto; a curva gamma já vem pronta na tabela
+    const uint8_t new_brightness = LDR_GAMMA_LUT[ldr >> 4];
+    if (new_brightness == current_brightness_) {
+        return;
+    }
     
-    // Aplicar brilho apenas se mudou significativamente (evitar oscilações)
-    if (abs(static_cast<int>(new_brightness) - static_cast<int>(current_brightness_)) >= 2) {
-        set_brightness(new_brightness);
-        ESP_LOGD(TAG, "Brilho automático: LDR=%d -> %d%%", last_ldr_value_, new_brightness);
+    // O LEDC leva o duty até o alvo sozinho; um fade novo espera o anterior terminar
+    const uint32_t duty = (new_brightness * LEDC_MAX_DUTY) / 100;
+    esp_err_t ret = ledc_set_fade_with_time(LEDC_MODE, LEDC_CHANNEL, duty, BRIGHTNESS_FADE_MS);
+    if (ret == ESP_OK) {
+        ret = ledc_fade_start(LEDC_MODE, LEDC_CHANNEL, LEDC_FADE_NO_WAIT);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Erro ao iniciar fade do backlight: %s", esp_err_to_name(ret));
+        return;
     }
+    current_brightness_ = new_brightness;
+    ESP_LOGD(TAG, "Brilho automático: LDR=%u -> %d%%", ldr, new_brightness);
 }
 
 void DisplayDriver::load_brightness_settings() {
@@ -0,0 +1,80 @@
+#include "frame_time.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+size_t bucket_of(uint32_t us) {
+    return std::min<size_t>(us / 1000, FrameTimeTracker::BUCKETS - 1);
+}
+
+// Limite superior do balde que contém o percentil
+uint32_t percentile_us(const uint32_t *hist, uint32_t count, uint32_t pct) {
+    if (count == 0) {
+        return 0;
+    }
+    const uint32_t target = (count - 1) * pct / 100 + 1;
+    uint32_t seen = 0;
+    for (size_t i = 0; i < FrameTimeTracker::BUCKETS; ++i) {
+        seen += hist[i];
+        if (seen >= target) {
+            return static_cast<uint32_t>(i + 1) * 1000;
+        }
+    }
+    return FrameTimeTracker::BUCKETS * 1000;
+}
+} // namespace
+
+void FrameTimeTracker::on_pass(int64_t start_us, int64_t end_us) {
+    const uint32_t duration_us = static_cast<uint32_t>(end_us - start_us);
+    const uint32_t gap_us = last_start_us_ != 0 ? static_cast<uint32_t>(start_us - last_start_us_) : 0;
+    const bool rendered = rendered_;
+    last_start_us_ = start_us;
+    rendered_ = false;
+
+    portENTER_CRITICAL(&lock_);
+    passes_++;
+    if (gap_us > 0) {
+        gap_hist_[bucket_of(gap_us)]++;
+        gap_max_us_ = std::max(gap_max_us_, gap_us);
+    }
+    if (rendered) {
+        frames_++;
+        render_hist_[bucket_of(duration_us)]++;
+        render_max_us_ = std::max(render_max_us_, duration_us);
+    }
+    portEXIT_CRITICAL(&lock_);
+}
+
+FrameTimeStats FrameTimeTracker::snapshot(bool reset) {
+    uint32_t render_hist[BUCKETS];
+    uint32_t gap_hist[BUCKETS];
+    FrameTimeStats stats = {};
+
+    portENTER_CRITICAL(&lock_);
+    memcpy(render_hist, render_hist_, sizeof(render_hist));
+    memcpy(gap_hist, gap_hist_, sizeof(gap_hist));
+    stats.passes = passes_;
+    stats.frames = frames_;
+    stats.max_us = render_max_us_;
+    stats.gap_max_us = gap_max_us_;
+    if (reset) {
+        memset(render_hist_, 0, sizeof(render_hist_));
+        memset(gap_hist_, 0, sizeof(gap_hist_));
+        passes_ = 0;
+        frames_ = 0;
+        render_max_us_ = 0;
+        gap_max_us_ = 0;
+    }
+    portEXIT_CRITICAL(&lock_);
+
+    stats.p50_us = percentile_us(render_hist, stats.frames, 50);
+    stats.p95_us = percentile_us(render_hist, stats.frames, 95);
+    // O primeiro intervalo após o boot não entra no histograma
+    uint32_t gaps = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        gaps += gap_hist[i];
+    }
+    stats.gap_p95_us = percentile_us(gap_hist, gaps, 95);
+    return stats;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Linha do tempo do boot: duração de cada etapa de inicialização.
+ *
+ * As etapas podem rodar em tasks e cores diferentes (o registro guarda o
+ * core); os tempos são de esp_timer_get_time(), contados do início da
+ * aplicação. O marco final é o primeiro quadro interativo: o primeiro flush
+ * depois que a UI mostra a tela que aceita toque.
+ */
+namespace boot_profile {
+
+constexpr size_t MAX_STAGES = 32;
+
+struct Stage {
+    const char *name;  ///< Literal estático
+    int64_t start_us;
+    int64_t end_us;
+    uint8_t core;
+};
+
+/**
+ * @brief Mede uma etapa do construtor ao destrutor (cobre os retornos antecipados)
+ */
+class Scope {
+public:
+    explicit Scope(const char *name);
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    const char *name_;
+    int64_t start_us_;
+};
+
+void record(const char *name, int64_t start_us, int64_t end_us);
+
+/// Chamado no quadro interativo (task do LVGL, lock tomado); pode postar jobs
+using FirstFrameFn = void (*)(int64_t at_us);
+
+/**
+ * @brief Arma o marco do primeiro quadro interativo
+ *
+ * Chamar com o lock do LVGL tomado, logo após carregar a tela: o próximo
+ * flush fecha a medição e chama on_first_frame uma única vez.
+ */
+void arm_first_frame(FirstFrameFn on_first_frame);
+
+/// Chamado pelo flush do display; custa uma leitura atômica depois do boot
+void on_frame();
+
+/// Instante do primeiro quadro interativo (0 = ainda não houve)
+int64_t first_frame_us();
+
+/// Registra a linha do tempo no log (fora do task do LVGL: são várias linhas na serial)
+void log_timeline();
+
+} // namespace boot_profile
@@ -3,11 +3,25 @@
 #include "esp_err.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
-#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "freertos/task.h"
 #include "lvgl.h"
 #include "Xpt2046Bitbang.hpp"
+#include "frame_time.hpp"
+#include "input_latency.hpp"
+#include "spsc_ring.hpp"
+#include "touch_trace.hpp"
+#include <atomic>
+
+/**
+ * @brief Amostra do touch publicada pelo task de amostragem para o LVGL.
+ */
+struct TouchSample {
+    TouchPoint point;       ///< Ponto mapeado (pressure == 0 indica soltura)
+    int64_t timestamp_us;   ///< esp_timer_get_time() no momento da leitura
+};
 
 /**
  * @brief Driver C++ que encapsula toda a inicialização do display ILI9341 + LVGL + Touch.
@@ -31,6 +45,56 @@ public:
      */
     TouchPoint last_touch_point() const { return last_touch_point_; }
 
+    /**
+     * @brief Entrega ao LVGL as amostras de touch pendentes (indev em modo evento).
+     * Deve ser chamado pelo task do LVGL com o mutex adquirido; sem amostras
+     * pendentes não faz nenhuma leitura.
+     */
+    void process_touch_events();
+
+    /**
+     * @brief Quantidade de amostras de touch descartadas por fila cheia.
+     */
+    uint32_t touch_dropped_samples() const { return touch_dropped_samples_; }
+
+    /**
+     * @brief Medição de latência input-to-photon (arm() nos callbacks de evento, stats() em qualquer task).
+     */
+    InputLatencyTracker &input_latency() { return input_latency_; }
+
+    /**
+     * @brief Duração dos quadros e atraso entre passadas do LVGL (snapshot() em qualquer task).
+     */
+    FrameTimeTracker &frame_times() { return frame_times_; }
+
+    /**
+     * @brief Inicia/para a gravação das amostras reais do touch.
+     *
+     * Cada amostra vai para o log serial (tag TOUCH_TRACE, uma linha
+     * "TT,t_ms,x,y,raw_x,raw_y,pressure", lida por tools/host/touch_trace_player)
+     * e para um buffer em RAM de TOUCH_RECORDING_CAPACITY amostras, que pode ser
+     * reproduzido em seguida com last_touch_recording(). Comandos "touch_rec" do
+     * console de diagnóstico (main/diag_console.cpp).
+     * @return ESP_ERR_INVALID_STATE durante uma reprodução, ESP_ERR_NO_MEM sem buffer
+     */
+    esp_err_t start_touch_recording();
+    void stop_touch_recording();
+    bool is_touch_recording() const { return touch_recording_.load(); }
+
+    /**
+     * @brief Última gravação encerrada (nullptr se não houver ou se ainda estiver gravando).
+     */
+    const TouchTrace *last_touch_recording() const;
+
+    /**
+     * @brief Injeta um trace no indev do LVGL pelo task do touch, no lugar das
+     * leituras do XPT2046 (começa após o dedo real soltar). Ao fim, registra no
+     * log os tempos de quadro e as latências medidos durante a reprodução.
+     * @return ESP_ERR_INVALID_ARG se o trace for vazio, ESP_ERR_INVALID_STATE se o touch não estiver pronto.
+     */
+    esp_err_t play_touch_trace(const TouchTrace *trace);
+    bool is_touch_trace_playing() const { return touch_trace_playing_.load() || pending_trace_.load() != nullptr; }
+
     /**
      * @brief Atualiza e persiste a calibração do touch.
      */
@@ -73,10 +137,10 @@ public:
     bool is_auto_brightness_enabled() const { return auto_brightness_enabled_; }
 
     /**
-     * @brief Obtém a leitura atual do sensor LDR (0-4095).
+     * @brief Obtém o nível filtrado do sensor LDR (0-4095).
      * @return Valor do ADC do LDR (0 = escuro, 4095 = claro).
      */
-    uint16_t get_ldr_value() const { return last_ldr_value_; }
+    uint16_t get_ldr_value() const { return last_ldr_value_.load(std::memory_order_relaxed); }
 
     /**
      * @brief Salva as configurações de brilho no NVS.
@@ -91,14 +155,24 @@ private:
     esp_err_t init_ldr();
     esp_err_t init_spi_bus();
     esp_err_t init_panel_io();
+    esp_err_t reset_panel();
     esp_err_t init_panel_device();
     esp_err_t init_touch();
     esp_err_t init_lvgl();
     esp_err_t create_lvgl_display();
     esp_err_t add_touch_to_lvgl();
     static void lvgl_touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data);
+    static void lvgl_touch_pressed_cb(lv_event_t *e);
+    static void touch_sampling_task(void *pvParameters);
+    static void touch_irq_isr(void *arg);
+    void publish_touch_sample(const TouchPoint &point, int64_t timestamp_us);
+    void record_touch_sample(const TouchPoint &point, int64_t timestamp_us);
+    void replay_touch_trace(const TouchTrace *trace);
     static void brightness_update_task(void *pvParameters);
+    static bool ldr_conv_done_isr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata,
+                                  void *user_data);
     void update_auto_brightness();
+    esp_err_t apply_brightness(uint8_t brightness);
     void load_brightness_settings();
 
     bool initialized_ = false;
@@ -107,6 +181,10 @@ private:
 
     esp_lcd_panel_io_handle_t panel_io_ = nullptr;
     esp_lcd_panel_handle_t panel_handle_ = nullptr;
+    int64_t panel_reset_us_ = 0;
+    bool panel_configured_ = false;
+    static constexpr int64_t PANEL_RESET_SETTLE_MS = 120;
+    Xpt2046Transport *touch_transport_ = nullptr;
     Xpt2046Bitbang *touch_controller_ = nullptr;
     lv_display_t *lv_display_ = nullptr;
     lv_indev_t *lv_touch_indev_ = nullptr;
@@ -114,17 +192,43 @@ private:
     TouchPoint last_touch_point_ = {};
     bool touch_calibration_loaded_ = false;
 
+    // Amostragem do touch em task dedicado (acordado pelo PENIRQ)
+    static constexpr size_t TOUCH_RING_CAPACITY = 16;
+    SpscRing<TouchSample, TOUCH_RING_CAPACITY> touch_ring_;
+    TaskHandle_t touch_task_handle_ = nullptr;
+    // Calibração nova para o task do touch, o único que usa o controlador depois do init
+    QueueHandle_t touch_calibration_queue_ = nullptr;
+    uint32_t touch_dropped_samples_ = 0;
+    bool touch_irq_enabled_ = false;
+    InputLatencyTracker input_latency_;
+    FrameTimeTracker frame_times_;
+
+    // Gravação e reprodução de traces de touch
+    static constexpr size_t TOUCH_RECORDING_CAPACITY = 1024;  // ~10 s pressionado a 100 Hz (12 KB)
+    std::atomic<bool> touch_recording_{false};
+    int64_t touch_recording_start_us_ = 0;
+    TouchTraceSample *touch_recording_samples_ = nullptr;
+    std::atomic<size_t> touch_recording_count_{0};
+    TouchTrace touch_recording_trace_ = {"gravacao", nullptr, 0};
+    std::atomic<const TouchTrace *> pending_trace_{nullptr};
+    std::atomic<bool> touch_trace_playing_{false};
+
     // Controle de brilho
     bool auto_brightness_enabled_ = true;  // Padrão: automático habilitado
     uint8_t current_brightness_ = 50;      // Brilho atual (0-100)
     uint8_t manual_brightness_ = 50;        // Brilho manual salvo (0-100)
-    uint16_t last_ldr_value_ = 0;          // Última leitura do LDR
+    std::atomic<uint16_t> last_ldr_value_{0};  // Nível filtrado do LDR (escrito pelo callback do ADC)
     TaskHandle_t brightness_task_handle_ = nullptr;
-    adc_oneshot_unit_handle_t adc1_handle_ = nullptr;  // Handle do ADC oneshot
+    std::atomic<int16_t> pending_brightness_{-1};  // Ajuste manual esperando o task de brilho (-1 = nenhum)
+    adc_continuous_handle_t ldr_adc_handle_ = nullptr;  // ADC contínuo (DMA) do LDR
+
+    // Passa-baixa do LDR em ponto fixo (Q8); só o callback do ADC mexe nestes
+    int32_t ldr_filter_q8_ = 0;
+    bool ldr_filter_primed_ = false;
+    int32_t ldr_reported_level_ = -1;  // Nível que acordou o task de brilho pela última vez
+    uint8_t ldr_frames_skipped_ = 0;   // Quadros ignorados desde a última atualização do filtro
     static constexpr uint8_t MIN_BRIGHTNESS = 5;   // Brilho mínimo (evita tela completamente apagada)
     static constexpr uint8_t MAX_BRIGHTNESS = 100; // Brilho máximo
-    static constexpr uint16_t LDR_MIN = 0;         // Valor mínimo do LDR (escuro)
-    static constexpr uint16_t LDR_MAX = 4095;      // Valor máximo do LDR (claro)
     static constexpr const char* BRIGHTNESS_NVS_NAMESPACE = "brightness";
     static constexpr const char* BRIGHTNESS_NVS_KEY_AUTO = "auto";
     static constexpr const char* BRIGHTNESS_NVS_KEY_MANUAL = "manual";
@@ -132,5 +236,6 @@ private:
     void load_touch_calibration_from_nvs();
     void save_touch_calibration_to_nvs(const TouchCalibration &calibration);
     void apply_touch_calibration(const TouchCalibration &calibration);
+    void set_controller_calibration(const TouchCalibration &calibration);
 };
 
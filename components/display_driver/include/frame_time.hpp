@@ -0,0 +1,54 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Tempos de quadro do LVGL desde o último reset.
+ */
+struct FrameTimeStats {
+    uint32_t passes;      ///< Passadas do lv_timer_handler
+    uint32_t frames;      ///< Passadas que desenharam (houve flush)
+    uint32_t p50_us;      ///< Duração das passadas que desenharam
+    uint32_t p95_us;
+    uint32_t max_us;
+    uint32_t gap_p95_us;  ///< Intervalo entre inícios de passadas (nominal: 10 ms)
+    uint32_t gap_max_us;
+};
+
+/**
+ * @brief Mede a duração dos quadros e o atraso entre passadas do LVGL.
+ *
+ * Histogramas com baldes de 1 ms: o custo por passada é um incremento e os
+ * percentis saem sem ordenar (resolução de 1 ms, teto no último balde). A
+ * duração mostra o custo de desenhar; o intervalo mostra quanto o task do
+ * LVGL ficou sem rodar (flash apagando, tasks mais prioritários).
+ * mark_rendered()/on_pass() rodam no task do LVGL; snapshot() pode ser chamado
+ * de qualquer task.
+ */
+class FrameTimeTracker {
+public:
+    static constexpr size_t BUCKETS = 128;
+
+    /// Chamado no flush: a passada corrente desenhou
+    void mark_rendered() { rendered_ = true; }
+
+    void on_pass(int64_t start_us, int64_t end_us);
+
+    /**
+     * @param reset Zera os histogramas (início de uma nova janela de medição)
+     */
+    FrameTimeStats snapshot(bool reset);
+
+private:
+    uint32_t render_hist_[BUCKETS] = {};
+    uint32_t gap_hist_[BUCKETS] = {};
+    uint32_t passes_ = 0;
+    uint32_t frames_ = 0;
+    uint32_t render_max_us_ = 0;
+    uint32_t gap_max_us_ = 0;
+    int64_t last_start_us_ = 0;
+    bool rendered_ = false;
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Tipo de interação medida (input-to-photon).
+ */
+enum class InputLatencyKind : uint8_t {
+    Press,     ///< Borda de press em um objeto (até o redesenho do estado pressionado)
+    Rating,    ///< Clique em botão de avaliação
+    Keypad,    ///< Tecla do teclado numérico da tela de senha
+    Keyboard,  ///< Tecla do lv_keyboard (entrada de texto)
+    Count,
+};
+
+/**
+ * @brief Percentis da latência entre a leitura do touch e o fim do flush.
+ */
+struct InputLatencyStats {
+    uint32_t samples;   ///< Medições na janela (até InputLatencyTracker::WINDOW)
+    uint32_t total;     ///< Medições desde o boot
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t max_us;    ///< Máximo desde o boot
+};
+
+/**
+ * @brief Mede a latência input-to-photon por tipo de interação.
+ *
+ * O timestamp da amostra de touch entregue ao LVGL fica disponível durante o
+ * dispatch de eventos; um callback chama arm() com o tipo da interação e a
+ * área que o evento vai redesenhar (o objeto alvo). Só flushes que cruzam essa
+ * área contam: a medição fecha no fim do refresh (lv_display_flush_is_last)
+ * com o horário do último desses flushes, e refreshes de outras áreas
+ * (animações, relógio) não a fecham. Medições sem flush na área em
+ * LATENCY_TIMEOUT_US são descartadas (evento que não invalidou nada).
+ * arm()/on_flush() rodam no task do LVGL; stats() pode ser chamado de
+ * qualquer task.
+ */
+class InputLatencyTracker {
+public:
+    static constexpr size_t WINDOW = 64;
+    static constexpr int64_t LATENCY_TIMEOUT_US = 1000 * 1000;
+
+    /**
+     * @brief Registra o timestamp da amostra que o LVGL está processando.
+     */
+    void set_input_timestamp(int64_t timestamp_us) { input_timestamp_us_ = timestamp_us; }
+
+    /**
+     * @brief Abre uma medição para a amostra corrente (substitui a pendente do mesmo tipo).
+     * @param area Área, em coordenadas do display, cujo flush encerra a medição
+     */
+    void arm(InputLatencyKind kind, const lv_area_t &area);
+
+    /**
+     * @brief arm() com a área atual do objeto que o evento vai atualizar.
+     */
+    void arm(InputLatencyKind kind, const lv_obj_t *obj);
+
+    /**
+     * @brief Chamar ao fim de cada flush com a área enviada ao painel.
+     * @param last true no último flush do refresh (fecha as medições atingidas)
+     */
+    void on_flush(const lv_area_t &area, bool last, int64_t now_us);
+
+    InputLatencyStats stats(InputLatencyKind kind) const;
+
+    static const char *kind_name(InputLatencyKind kind);
+
+private:
+    static constexpr size_t KIND_COUNT = static_cast<size_t>(InputLatencyKind::Count);
+
+    struct Window {
+        uint32_t values_us[WINDOW];
+        uint32_t count;
+        uint32_t next;
+        uint32_t total;
+        uint32_t max_us;
+    };
+
+    struct Pending {
+        int64_t start_us;    ///< 0 = sem medição aberta
+        int64_t flushed_us;  ///< Último flush que cruzou a área neste refresh (0 = nenhum)
+        lv_area_t area;
+    };
+
+    void record(size_t index, int64_t latency_us);
+
+    int64_t input_timestamp_us_ = 0;
+    Pending pending_[KIND_COUNT] = {};
+    Window windows_[KIND_COUNT] = {};
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Métricas de contenção do lock do LVGL
+ */
+struct LvglLockStats {
+    uint32_t frames;             ///< Passadas do task do LVGL que rodaram o handler
+    uint32_t frames_delayed;     ///< Passadas que precisaram esperar o lock
+    uint32_t frames_skipped;     ///< Passadas perdidas (lock não obtido no prazo)
+    uint32_t last_wait_us;       ///< Espera da última passada atrasada
+    uint32_t max_wait_us;        ///< Maior espera do task do LVGL
+    uint64_t total_wait_us;      ///< Soma das esperas do task do LVGL
+    uint32_t external_acquires;  ///< Aquisições por outros tasks
+    uint32_t long_holds;         ///< Retenções externas acima de LVGL_LOCK_HOLD_WARN_US
+    uint32_t max_hold_us;        ///< Maior retenção externa
+    char max_hold_task[16];      ///< Task responsável pela maior retenção externa
+};
+
+/// Retenção externa a partir da qual o lock é registrado como longo (3 frames)
+constexpr uint32_t LVGL_LOCK_HOLD_WARN_US = 30 * 1000;
+
+/**
+ * @brief Cria o lock (mutex recursivo com herança de prioridade)
+ *
+ * Chamado pelo DisplayDriver antes de lv_init().
+ */
+bool lvgl_lock_init();
+
+/**
+ * @brief Toma o lock do LVGL (bloqueia até obter)
+ *
+ * Recursivo: pode ser chamado de novo pelo mesmo task, inclusive de dentro
+ * de callbacks do LVGL. Não fazer I/O bloqueante com o lock; trabalho longo
+ * deve ir para ui::jobs::post_worker().
+ */
+void lvgl_lock();
+void lvgl_unlock();
+
+/**
+ * @brief Lock de uma passada do task do LVGL (uso do display_driver)
+ *
+ * Espera o lock com prazo em vez de pular a passada em silêncio; atrasos e
+ * passadas perdidas entram nas métricas.
+ *
+ * @return false se o lock não foi obtido no prazo
+ */
+bool lvgl_frame_lock();
+void lvgl_frame_unlock();
+
+LvglLockStats lvgl_lock_stats();
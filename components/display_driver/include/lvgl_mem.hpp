@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Back-end de memória do LVGL (CONFIG_LV_USE_CUSTOM_MALLOC)
+ *
+ * Alocações pequenas e de tamanho recorrente (lv_obj_t, labels, descritores
+ * de eventos, lv_draw_task_t de cada frame) vão para slabs estáticos com
+ * blocos de tamanho fixo; o resto, e o que não couber nos slabs, vai para o
+ * heap. A troca de telas deixa de fragmentar a RAM interna com milhares de
+ * blocos pequenos de vida curta.
+ */
+
+/// Número de classes de tamanho dos slabs
+constexpr size_t LVGL_MEM_CLASS_COUNT = 5;
+
+/**
+ * @brief Métricas de uma classe de tamanho
+ */
+struct LvglMemClassStats {
+    uint16_t block_size;  ///< Tamanho do bloco em bytes
+    uint16_t capacity;    ///< Blocos no slab
+    uint16_t in_use;      ///< Blocos alocados agora
+    uint16_t peak;        ///< Maior ocupação observada
+    uint32_t allocs;      ///< Alocações atendidas pelo slab
+    uint32_t fallbacks;   ///< Alocações da classe que foram para o heap (slab cheio)
+};
+
+/**
+ * @brief Métricas do back-end
+ */
+struct LvglMemStats {
+    LvglMemClassStats classes[LVGL_MEM_CLASS_COUNT];
+    uint32_t heap_allocs;  ///< Alocações acima da maior classe ou de slab cheio
+    uint32_t heap_live;    ///< Blocos do heap ainda não liberados
+};
+
+LvglMemStats lvgl_mem_stats();
+
+/**
+ * @brief Bytes de slab em uso (blocos alocados x tamanho do bloco)
+ *
+ * Complementa heap_caps_get_free_size() ao medir o custo de uma tela: o que
+ * cabe nos slabs não aparece no heap.
+ */
+size_t lvgl_mem_slab_used_bytes();
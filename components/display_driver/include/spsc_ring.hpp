@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fila circular lock-free para um produtor e um consumidor.
+ *
+ * O produtor só escreve head_ e o consumidor só escreve tail_, então push()
+ * e pop() podem rodar em tasks diferentes sem mutex. Capacity deve ser
+ * potência de 2; a fila comporta Capacity elementos.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity deve ser potência de 2");
+
+public:
+    /**
+     * @brief Insere um elemento (somente produtor).
+     * @return false se a fila estiver cheia (elemento descartado).
+     */
+    bool push(const T &item) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        items_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove o elemento mais antigo (somente consumidor).
+     * @return false se a fila estiver vazia.
+     */
+    bool pop(T &item) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Indica se há elementos pendentes (seguro em qualquer lado).
+     */
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+private:
+    T items_[Capacity] = {};
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+};
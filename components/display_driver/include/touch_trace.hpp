@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Amostra de um trace de touch (coordenadas já mapeadas para a tela).
+ */
+struct TouchTraceSample {
+    uint32_t t_ms;      ///< Tempo desde o início do trace
+    uint16_t x;
+    uint16_t y;
+    uint16_t pressure;  ///< 0 = soltura
+};
+
+/**
+ * @brief Trace gravado (buffer do gravador do DisplayDriver ou log carregado no host).
+ */
+struct TouchTrace {
+    const char *name;
+    const TouchTraceSample *samples;
+    size_t count;
+};
+
+/**
+ * @brief Reproduz um trace respeitando os tempos gravados.
+ *
+ * Lógica pura (sem ESP-IDF): o chamador informa o relógio e publica as
+ * amostras devolvidas por poll(). No dispositivo roda dentro do task de
+ * amostragem do touch, no lugar das leituras do XPT2046.
+ */
+class TouchTracePlayer {
+public:
+    void start(const TouchTrace *trace, int64_t now_us);
+    void stop() { trace_ = nullptr; }
+    bool active() const { return trace_ != nullptr; }
+    const TouchTrace *trace() const { return trace_; }
+
+    /**
+     * @brief Instante (esp_timer) em que a próxima amostra vence.
+     */
+    int64_t next_due_us() const;
+
+    /**
+     * @brief Devolve a próxima amostra se ela já venceu; encerra ao fim do trace.
+     */
+    bool poll(int64_t now_us, TouchTraceSample &sample);
+
+private:
+    const TouchTrace *trace_ = nullptr;
+    size_t index_ = 0;
+    int64_t start_us_ = 0;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Trace binário para caminhos quentes (flush, touch, callbacks da UI)
+ *
+ * Cada evento grava um registro fixo de 16 bytes num ring por core, sem
+ * formatar texto nem tocar na UART: custa um esp_timer_get_time() e um
+ * fetch_add. trace::dump() escreve os rings no log (tag TRACE) e
+ * tools/trace_decode.py converte para o formato JSON do Chrome/Perfetto.
+ *
+ * Desligado com -DTRACE_ENABLED=OFF (CMake do display_driver): as chamadas
+ * viram no-ops.
+ */
+
+// Lista de eventos: X(nome, fase). O id é a posição na lista (a partir de 1);
+// o decoder lê esta lista do próprio header, então só acrescentar no fim.
+// Fases: BEGIN/END delimitam um intervalo no mesmo task, INSTANT é pontual,
+// COUNTER registra o valor de arg0 como série.
+#define TRACE_EVENT_LIST(X)          \
+    X(LVGL_HANDLER_BEGIN, BEGIN)     \
+    X(LVGL_HANDLER_END, END)         \
+    X(FLUSH_BEGIN, BEGIN)            \
+    X(FLUSH_END, END)                \
+    X(TOUCH_PRESS, INSTANT)          \
+    X(TOUCH_RELEASE, INSTANT)        \
+    X(RATING_CLICK, INSTANT)         \
+    X(QUESTION_BUILD_BEGIN, BEGIN)   \
+    X(QUESTION_BUILD_END, END)       \
+    X(CALIBRATION_POINT, INSTANT)    \
+    X(LDR_RAW, COUNTER)
+
+namespace trace {
+
+enum class Event : uint16_t {
+    None = 0,
+#define TRACE_EVENT_ENUM(name, phase) name,
+    TRACE_EVENT_LIST(TRACE_EVENT_ENUM)
+#undef TRACE_EVENT_ENUM
+    Count,
+};
+
+/**
+ * @brief Registro do ring (layout lido pelo decoder: little-endian, 16 bytes)
+ */
+struct Record {
+    uint32_t timestamp_us;  ///< esp_timer_get_time() truncado (o decoder desfaz a volta)
+    uint16_t event;         ///< trace::Event
+    uint16_t task;          ///< 16 bits baixos do TCB do task que gravou
+    uint32_t arg0;
+    uint32_t arg1;
+};
+static_assert(sizeof(Record) == 16, "layout do registro é lido pelo decoder");
+
+/// Registros por core (potência de 2)
+constexpr uint32_t RING_SIZE = 128;
+
+/// Empacota duas coordenadas de 16 bits num argumento
+constexpr uint32_t pack_xy(int32_t x, int32_t y) {
+    return (static_cast<uint32_t>(y) << 16) | (static_cast<uint32_t>(x) & 0xFFFF);
+}
+
+namespace detail {
+struct Ring {
+    std::atomic<uint32_t> head;
+    Record records[RING_SIZE];
+};
+
+extern Ring rings[portNUM_PROCESSORS];
+extern std::atomic<bool> enabled;
+} // namespace detail
+
+/**
+ * @brief Grava um evento (qualquer task; não usar em ISR)
+ *
+ * Sem lock: o slot é reservado com fetch_add no ring do core corrente. Se o
+ * task migrar de core entre a leitura do id e a reserva, o registro só cai
+ * no ring do outro core.
+ */
+inline void emit(Event event, uint32_t arg0 = 0, uint32_t arg1 = 0) {
+#if TRACE_ENABLED
+    if (!detail::enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    detail::Ring &ring = detail::rings[xPortGetCoreID()];
+    const uint32_t slot = ring.head.fetch_add(1, std::memory_order_relaxed) & (RING_SIZE - 1);
+    Record &record = ring.records[slot];
+    record.timestamp_us = static_cast<uint32_t>(esp_timer_get_time());
+    record.event = static_cast<uint16_t>(event);
+    record.task = static_cast<uint16_t>(reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle()));
+    record.arg0 = arg0;
+    record.arg1 = arg1;
+#else
+    (void)event;
+    (void)arg0;
+    (void)arg1;
+#endif
+}
+
+/**
+ * @brief Escreve os rings no log serial e recomeça a gravação
+ *
+ * Uma linha "TR,<core>,<32 dígitos hex>" por registro (bytes do Record na
+ * memória), do mais antigo para o mais recente, e linhas "TN,<task>,<nome>"
+ * com os nomes dos tasks conhecidos. A gravação fica pausada durante o
+ * dump. Lento (UART): chamar fora de caminhos quentes.
+ */
+void dump();
+
+} // namespace trace
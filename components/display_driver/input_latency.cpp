@@ -0,0 +1,107 @@
+#include "input_latency.hpp"
+
+#include <algorithm>
+
+namespace {
+
+bool areas_intersect(const lv_area_t &a, const lv_area_t &b) {
+    return a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2;
+}
+
+} // namespace
+
+void InputLatencyTracker::arm(InputLatencyKind kind, const lv_area_t &area) {
+    const size_t index = static_cast<size_t>(kind);
+    if (index >= KIND_COUNT || input_timestamp_us_ == 0) {
+        return;
+    }
+    pending_[index] = Pending{input_timestamp_us_, 0, area};
+}
+
+void InputLatencyTracker::arm(InputLatencyKind kind, const lv_obj_t *obj) {
+    if (obj == nullptr) {
+        return;
+    }
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    arm(kind, area);
+}
+
+void InputLatencyTracker::on_flush(const lv_area_t &area, bool last, int64_t now_us) {
+    for (size_t i = 0; i < KIND_COUNT; ++i) {
+        Pending &pending = pending_[i];
+        if (pending.start_us == 0) {
+            continue;
+        }
+        if (areas_intersect(pending.area, area)) {
+            pending.flushed_us = now_us;
+        }
+        if (!last) {
+            continue;
+        }
+        if (pending.flushed_us != 0) {
+            record(i, pending.flushed_us - pending.start_us);
+            pending.start_us = 0;
+        } else if (now_us - pending.start_us > LATENCY_TIMEOUT_US) {
+            // Nenhum refresh redesenhou a área: evento sem efeito visível
+            pending.start_us = 0;
+        }
+    }
+}
+
+void InputLatencyTracker::record(size_t index, int64_t latency_us) {
+    if (latency_us < 0 || latency_us > LATENCY_TIMEOUT_US) {
+        return;
+    }
+
+    Window &window = windows_[index];
+    portENTER_CRITICAL(&lock_);
+    window.values_us[window.next] = static_cast<uint32_t>(latency_us);
+    window.next = (window.next + 1) % WINDOW;
+    if (window.count < WINDOW) {
+        window.count++;
+    }
+    window.total++;
+    window.max_us = std::max(window.max_us, static_cast<uint32_t>(latency_us));
+    portEXIT_CRITICAL(&lock_);
+}
+
+InputLatencyStats InputLatencyTracker::stats(InputLatencyKind kind) const {
+    InputLatencyStats result = {};
+    const size_t index = static_cast<size_t>(kind);
+    if (index >= KIND_COUNT) {
+        return result;
+    }
+
+    uint32_t sorted[WINDOW];
+    portENTER_CRITICAL(&lock_);
+    const Window &window = windows_[index];
+    std::copy(window.values_us, window.values_us + window.count, sorted);
+    result.samples = window.count;
+    result.total = window.total;
+    result.max_us = window.max_us;
+    portEXIT_CRITICAL(&lock_);
+
+    if (result.samples == 0) {
+        return result;
+    }
+    std::sort(sorted, sorted + result.samples);
+    result.p50_us = sorted[(result.samples - 1) * 50 / 100];
+    result.p95_us = sorted[(result.samples - 1) * 95 / 100];
+    return result;
+}
+
+const char *InputLatencyTracker::kind_name(InputLatencyKind kind) {
+    switch (kind) {
+    case InputLatencyKind::Press:
+        return "Toque";
+    case InputLatencyKind::Rating:
+        return "Avaliação";
+    case InputLatencyKind::Keypad:
+        return "Teclado numérico";
+    case InputLatencyKind::Keyboard:
+        return "Teclado";
+    default:
+        return "?";
+    }
+}
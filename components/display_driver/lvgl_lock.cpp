@@ -0,0 +1,141 @@
+#include "lvgl_lock.hpp"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <cstring>
+
+// Task do LVGL (display_driver.cpp)
+extern TaskHandle_t lvgl_task_handle;
+
+namespace {
+constexpr char TAG[] = "LVGL_LOCK";
+
+// Prazo de uma passada do task do LVGL esperando o lock antes de desistir
+constexpr uint32_t FRAME_LOCK_TIMEOUT_MS = 100;
+
+// Mutex recursivo: herança de prioridade e waiters atendidos por prioridade
+SemaphoreHandle_t lvgl_mutex = nullptr;
+
+// Retenção externa corrente (só alterados pelo dono do lock)
+uint32_t hold_depth = 0;
+int64_t hold_start_us = 0;
+
+LvglLockStats lock_stats = {};
+portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+bool is_lvgl_task() {
+    return lvgl_task_handle != nullptr && xTaskGetCurrentTaskHandle() == lvgl_task_handle;
+}
+} // namespace
+
+bool lvgl_lock_init() {
+    if (lvgl_mutex == nullptr) {
+        lvgl_mutex = xSemaphoreCreateRecursiveMutex();
+    }
+    return lvgl_mutex != nullptr;
+}
+
+void lvgl_lock() {
+    if (lvgl_mutex == nullptr) {
+        return;
+    }
+    xSemaphoreTakeRecursive(lvgl_mutex, portMAX_DELAY);
+    if (is_lvgl_task()) {
+        return;
+    }
+    if (hold_depth++ == 0) {
+        hold_start_us = esp_timer_get_time();
+        portENTER_CRITICAL(&stats_lock);
+        lock_stats.external_acquires++;
+        portEXIT_CRITICAL(&stats_lock);
+    }
+}
+
+void lvgl_unlock() {
+    if (lvgl_mutex == nullptr) {
+        return;
+    }
+    if (is_lvgl_task() || hold_depth == 0 || --hold_depth > 0) {
+        xSemaphoreGiveRecursive(lvgl_mutex);
+        return;
+    }
+
+    const uint32_t hold_us = static_cast<uint32_t>(esp_timer_get_time() - hold_start_us);
+    const char *task_name = pcTaskGetName(nullptr);
+    const bool long_hold = hold_us > LVGL_LOCK_HOLD_WARN_US;
+
+    portENTER_CRITICAL(&stats_lock);
+    if (long_hold) {
+        lock_stats.long_holds++;
+    }
+    if (hold_us > lock_stats.max_hold_us) {
+        lock_stats.max_hold_us = hold_us;
+        strncpy(lock_stats.max_hold_task, task_name, sizeof(lock_stats.max_hold_task) - 1);
+        lock_stats.max_hold_task[sizeof(lock_stats.max_hold_task) - 1] = '\0';
+    }
+    portEXIT_CRITICAL(&stats_lock);
+
+    xSemaphoreGiveRecursive(lvgl_mutex);
+
+    if (long_hold) {
+        ESP_LOGW(TAG, "Task %s reteve o lock do LVGL por %lu ms", task_name,
+                 static_cast<unsigned long>(hold_us / 1000));
+    }
+}
+
+bool lvgl_frame_lock() {
+    if (lvgl_mutex == nullptr) {
+        return true;
+    }
+
+    // Caminho comum: lock livre
+    if (xSemaphoreTakeRecursive(lvgl_mutex, 0) == pdTRUE) {
+        portENTER_CRITICAL(&stats_lock);
+        lock_stats.frames++;
+        portEXIT_CRITICAL(&stats_lock);
+        return true;
+    }
+
+    // Contenção: esperar (o dono herda a prioridade do task do LVGL) em vez de pular
+    const int64_t wait_start_us = esp_timer_get_time();
+    const bool acquired = xSemaphoreTakeRecursive(lvgl_mutex, pdMS_TO_TICKS(FRAME_LOCK_TIMEOUT_MS)) == pdTRUE;
+    const uint32_t wait_us = static_cast<uint32_t>(esp_timer_get_time() - wait_start_us);
+
+    portENTER_CRITICAL(&stats_lock);
+    if (acquired) {
+        lock_stats.frames++;
+        lock_stats.frames_delayed++;
+    } else {
+        lock_stats.frames_skipped++;
+    }
+    lock_stats.last_wait_us = wait_us;
+    lock_stats.total_wait_us += wait_us;
+    if (wait_us > lock_stats.max_wait_us) {
+        lock_stats.max_wait_us = wait_us;
+    }
+    portEXIT_CRITICAL(&stats_lock);
+
+    if (!acquired) {
+        // Dono consultado só agora: o de antes da espera pode já ter sido apagado
+        TaskHandle_t holder = xSemaphoreGetMutexHolder(lvgl_mutex);
+        ESP_LOGW(TAG, "Passada do LVGL perdida: lock retido por %s há mais de %lu ms",
+                 holder != nullptr ? pcTaskGetName(holder) : "?", static_cast<unsigned long>(FRAME_LOCK_TIMEOUT_MS));
+    }
+    return acquired;
+}
+
+void lvgl_frame_unlock() {
+    if (lvgl_mutex != nullptr) {
+        xSemaphoreGiveRecursive(lvgl_mutex);
+    }
+}
+
+LvglLockStats lvgl_lock_stats() {
+    portENTER_CRITICAL(&stats_lock);
+    LvglLockStats snapshot = lock_stats;
+    portEXIT_CRITICAL(&stats_lock);
+    return snapshot;
+}
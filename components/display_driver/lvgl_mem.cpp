@@ -0,0 +1,298 @@
+#include "lvgl_mem.hpp"
+
+#include "freertos/FreeRTOS.h"
+#include "lvgl.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Classes dimensionadas pelos tipos do LVGL 9.4 em 32 bits:
+//   16 B  descritores de evento, arrays de estilos e textos curtos
+//   32 B  lv_timer_t, estilos locais pequenos
+//   64 B  lv_obj_t (botões, containers) e lv_obj_spec_attr_t
+//   128 B lv_label_t, lv_anim_t, lv_layer_t
+//   256 B lv_draw_task_t + descritor (retângulo, label, borda) de cada frame
+// Os tipos são quase todos ponteiros: com ponteiros de 64 bits (programas de
+// host em tools/host) as classes dobram para que os mesmos tipos caiam nelas
+constexpr uint16_t POINTER_SCALE = sizeof(void *) / 4;
+constexpr uint16_t CLASS_BLOCK_SIZES[LVGL_MEM_CLASS_COUNT] = {
+    16 * POINTER_SCALE, 32 * POINTER_SCALE, 64 * POINTER_SCALE, 128 * POINTER_SCALE, 256 * POINTER_SCALE,
+};
+// Capacidades: pico de demanda por classe (slab + heap) medido pelo
+// tools/host/lvgl_mem_soak_slab na troca entre a tela de pergunta e uma lista
+// de até 30 redes (as duas telas vivas durante a troca), arredondado para
+// múltiplos de 16: 339, 46, 203, 78 e 2 blocos. A última classe fica em 16
+// para os draw tasks de telas com mais camadas que as do soak. Total de 34 KB.
+// O soak roda com ponteiros de 64 bits; no ESP32 os mesmos tipos se espalham
+// um pouco diferente entre as classes, e os fallbacks aparecem na linha de
+// slabs da tela Sobre
+constexpr uint16_t CLASS_CAPACITIES[LVGL_MEM_CLASS_COUNT] = {352, 48, 208, 80, 16};
+
+constexpr size_t slab_bytes(size_t index) {
+    return static_cast<size_t>(CLASS_BLOCK_SIZES[index]) * CLASS_CAPACITIES[index];
+}
+
+// Armazenamento estático (.bss): os slabs nunca passam pelo heap
+alignas(8) uint8_t slab_16[slab_bytes(0)];
+alignas(8) uint8_t slab_32[slab_bytes(1)];
+alignas(8) uint8_t slab_64[slab_bytes(2)];
+alignas(8) uint8_t slab_128[slab_bytes(3)];
+alignas(8) uint8_t slab_256[slab_bytes(4)];
+
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+struct SlabClass {
+    uint8_t *base;
+    FreeBlock *free_list;
+    LvglMemClassStats stats;
+};
+
+SlabClass slabs[LVGL_MEM_CLASS_COUNT] = {
+    {slab_16, nullptr, {}},
+    {slab_32, nullptr, {}},
+    {slab_64, nullptr, {}},
+    {slab_128, nullptr, {}},
+    {slab_256, nullptr, {}},
+};
+
+bool initialized = false;
+uint32_t heap_allocs = 0;
+uint32_t heap_live = 0;
+
+// Quase todas as chamadas vêm de quem detém lvgl_lock(), mas nada impede um
+// lv_malloc() fora dele; listas e contadores ficam protegidos por spinlock.
+portMUX_TYPE mem_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void init_slabs() {
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        SlabClass &slab = slabs[i];
+        const uint16_t block_size = CLASS_BLOCK_SIZES[i];
+        slab.free_list = nullptr;
+        // Lista montada de trás para frente: a primeira alocação pega o início do slab
+        for (int32_t block = CLASS_CAPACITIES[i] - 1; block >= 0; --block) {
+            FreeBlock *free_block = reinterpret_cast<FreeBlock *>(slab.base + block * block_size);
+            free_block->next = slab.free_list;
+            slab.free_list = free_block;
+        }
+        slab.stats = {};
+        slab.stats.block_size = block_size;
+        slab.stats.capacity = CLASS_CAPACITIES[i];
+    }
+    initialized = true;
+}
+
+// Classe que atende o tamanho pedido, ou LVGL_MEM_CLASS_COUNT se for maior que todas
+size_t class_for_size(size_t size) {
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        if (size <= CLASS_BLOCK_SIZES[i]) {
+            return i;
+        }
+    }
+    return LVGL_MEM_CLASS_COUNT;
+}
+
+// Classe dona do ponteiro, ou LVGL_MEM_CLASS_COUNT se veio do heap
+size_t class_of_pointer(const void *p) {
+    const uint8_t *addr = static_cast<const uint8_t *>(p);
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        if (addr >= slabs[i].base && addr < slabs[i].base + slab_bytes(i)) {
+            return i;
+        }
+    }
+    return LVGL_MEM_CLASS_COUNT;
+}
+
+void *slab_alloc(size_t index) {
+    SlabClass &slab = slabs[index];
+    portENTER_CRITICAL(&mem_lock);
+    FreeBlock *block = slab.free_list;
+    if (block != nullptr) {
+        slab.free_list = block->next;
+        LvglMemClassStats &stats = slab.stats;
+        stats.allocs++;
+        stats.in_use++;
+        if (stats.in_use > stats.peak) {
+            stats.peak = stats.in_use;
+        }
+    } else {
+        slab.stats.fallbacks++;
+    }
+    portEXIT_CRITICAL(&mem_lock);
+    return block;
+}
+
+void slab_free(size_t index, void *p) {
+    SlabClass &slab = slabs[index];
+    FreeBlock *block = static_cast<FreeBlock *>(p);
+    portENTER_CRITICAL(&mem_lock);
+    block->next = slab.free_list;
+    slab.free_list = block;
+    slab.stats.in_use--;
+    portEXIT_CRITICAL(&mem_lock);
+}
+
+void *heap_alloc(size_t size) {
+    void *p = malloc(size);
+    if (p != nullptr) {
+        portENTER_CRITICAL(&mem_lock);
+        heap_allocs++;
+        heap_live++;
+        portEXIT_CRITICAL(&mem_lock);
+    }
+    return p;
+}
+
+void heap_free(void *p) {
+    free(p);
+    portENTER_CRITICAL(&mem_lock);
+    heap_live--;
+    portEXIT_CRITICAL(&mem_lock);
+}
+} // namespace
+
+// Funções exigidas pelo LVGL com LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+void lv_mem_init(void) {
+    if (!initialized) {
+        init_slabs();
+    }
+}
+
+void lv_mem_deinit(void) {
+    // Slabs estáticos: nada a liberar
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+    // Não suportado
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return nullptr;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    // Não suportado
+    LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size) {
+    if (!initialized) {
+        init_slabs();
+    }
+
+    const size_t index = class_for_size(size);
+    if (index < LVGL_MEM_CLASS_COUNT) {
+        void *block = slab_alloc(index);
+        if (block != nullptr) {
+            return block;
+        }
+    }
+    return heap_alloc(size);
+}
+
+void *lv_realloc_core(void *p, size_t new_size) {
+    if (p == nullptr) {
+        return lv_malloc_core(new_size);
+    }
+
+    const size_t index = class_of_pointer(p);
+    if (index == LVGL_MEM_CLASS_COUNT) {
+        // Blocos do heap continuam no heap (arrays que crescem: estilos, filhos)
+        return realloc(p, new_size);
+    }
+
+    // Encolher ou crescer dentro do bloco não muda nada
+    const uint16_t block_size = CLASS_BLOCK_SIZES[index];
+    if (new_size <= block_size) {
+        return p;
+    }
+
+    void *new_p = lv_malloc_core(new_size);
+    if (new_p == nullptr) {
+        return nullptr;
+    }
+    memcpy(new_p, p, block_size);
+    slab_free(index, p);
+    return new_p;
+}
+
+void lv_free_core(void *p) {
+    const size_t index = class_of_pointer(p);
+    if (index < LVGL_MEM_CLASS_COUNT) {
+        slab_free(index, p);
+    } else {
+        heap_free(p);
+    }
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {
+    // Só os slabs: o heap tem as próprias métricas (heap_caps_get_info)
+    portENTER_CRITICAL(&mem_lock);
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        const LvglMemClassStats &stats = slabs[i].stats;
+        const size_t free_blocks = stats.capacity - stats.in_use;
+        mon_p->total_size += slab_bytes(i);
+        mon_p->free_cnt += free_blocks;
+        mon_p->free_size += free_blocks * stats.block_size;
+        mon_p->used_cnt += stats.in_use;
+        mon_p->max_used += static_cast<size_t>(stats.peak) * stats.block_size;
+        if (free_blocks > 0) {
+            mon_p->free_biggest_size = stats.block_size;
+        }
+    }
+    mon_p->used_cnt += heap_live;
+    portEXIT_CRITICAL(&mem_lock);
+
+    // Blocos fixos não fragmentam: frag_pct fica em 0
+    if (mon_p->total_size > 0) {
+        mon_p->used_pct = static_cast<uint8_t>(100 - (100 * mon_p->free_size) / mon_p->total_size);
+    }
+}
+
+lv_result_t lv_mem_test_core(void) {
+    // Toda entrada das listas livres precisa estar alinhada dentro do próprio slab
+    lv_result_t result = LV_RESULT_OK;
+    portENTER_CRITICAL(&mem_lock);
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT && result == LV_RESULT_OK; ++i) {
+        const SlabClass &slab = slabs[i];
+        size_t free_blocks = 0;
+        for (const FreeBlock *block = slab.free_list; block != nullptr; block = block->next) {
+            const uint8_t *addr = reinterpret_cast<const uint8_t *>(block);
+            const bool valid = addr >= slab.base && addr < slab.base + slab_bytes(i) &&
+                               (addr - slab.base) % CLASS_BLOCK_SIZES[i] == 0;
+            if (!valid || ++free_blocks > CLASS_CAPACITIES[i]) {
+                result = LV_RESULT_INVALID;
+                break;
+            }
+        }
+        if (result == LV_RESULT_OK && free_blocks != static_cast<size_t>(slab.stats.capacity - slab.stats.in_use)) {
+            result = LV_RESULT_INVALID;
+        }
+    }
+    portEXIT_CRITICAL(&mem_lock);
+    return result;
+}
+
+LvglMemStats lvgl_mem_stats() {
+    LvglMemStats snapshot = {};
+    portENTER_CRITICAL(&mem_lock);
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        snapshot.classes[i] = slabs[i].stats;
+    }
+    snapshot.heap_allocs = heap_allocs;
+    snapshot.heap_live = heap_live;
+    portEXIT_CRITICAL(&mem_lock);
+    return snapshot;
+}
+
+size_t lvgl_mem_slab_used_bytes() {
+    size_t used = 0;
+    portENTER_CRITICAL(&mem_lock);
+    for (const SlabClass &slab : slabs) {
+        used += static_cast<size_t>(slab.stats.in_use) * slab.stats.block_size;
+    }
+    portEXIT_CRITICAL(&mem_lock);
+    return used;
+}
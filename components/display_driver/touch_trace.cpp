@@ -0,0 +1,25 @@
+#include "touch_trace.hpp"
+
+void TouchTracePlayer::start(const TouchTrace *trace, int64_t now_us) {
+    trace_ = (trace != nullptr && trace->count > 0) ? trace : nullptr;
+    index_ = 0;
+    start_us_ = now_us;
+}
+
+int64_t TouchTracePlayer::next_due_us() const {
+    if (trace_ == nullptr) {
+        return 0;
+    }
+    return start_us_ + static_cast<int64_t>(trace_->samples[index_].t_ms) * 1000;
+}
+
+bool TouchTracePlayer::poll(int64_t now_us, TouchTraceSample &sample) {
+    if (trace_ == nullptr || now_us < next_due_us()) {
+        return false;
+    }
+    sample = trace_->samples[index_++];
+    if (index_ >= trace_->count) {
+        trace_ = nullptr;
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#include "trace.hpp"
+
+#include "esp_log.h"
+#include <algorithm>
+
+namespace trace {
+
+namespace detail {
+Ring rings[portNUM_PROCESSORS] = {};
+std::atomic<bool> enabled{true};
+} // namespace detail
+
+namespace {
+constexpr char TAG[] = "TRACE";
+
+// Tasks nomeados no dump (o registro guarda só 16 bits do TCB)
+constexpr const char *KNOWN_TASKS[] = {
+    "lvgl_timer", "touch_task", "brightness_task", "ui_worker", "main", "esp_timer", "IDLE0", "IDLE1",
+};
+
+void dump_ring(uint32_t core) {
+    detail::Ring &ring = detail::rings[core];
+    const uint32_t head = ring.head.load(std::memory_order_acquire);
+    const uint32_t count = std::min(head, RING_SIZE);
+
+    for (uint32_t i = head - count; i != head; ++i) {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&ring.records[i & (RING_SIZE - 1)]);
+        char hex[sizeof(Record) * 2 + 1];
+        for (size_t b = 0; b < sizeof(Record); ++b) {
+            static constexpr char DIGITS[] = "0123456789abcdef";
+            hex[b * 2] = DIGITS[bytes[b] >> 4];
+            hex[b * 2 + 1] = DIGITS[bytes[b] & 0x0F];
+        }
+        hex[sizeof(hex) - 1] = '\0';
+        ESP_LOGI(TAG, "TR,%lu,%s", static_cast<unsigned long>(core), hex);
+    }
+    ring.head.store(0, std::memory_order_release);
+}
+} // namespace
+
+void dump() {
+#if TRACE_ENABLED
+    detail::enabled.store(false);
+
+    for (const char *name : KNOWN_TASKS) {
+        TaskHandle_t handle = xTaskGetHandle(name);
+        if (handle != nullptr) {
+            ESP_LOGI(TAG, "TN,%u,%s", static_cast<unsigned>(reinterpret_cast<uintptr_t>(handle) & 0xFFFF), name);
+        }
+    }
+    for (uint32_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        dump_ring(core);
+    }
+
+    detail::enabled.store(true);
+#else
+    ESP_LOGW(TAG, "Trace desabilitado na compilação (TRACE_ENABLED)");
+#endif
+}
+
+} // namespace trace
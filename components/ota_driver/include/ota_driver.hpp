@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "esp_err.h"
+#include "esp_partition.h"
+#include "sdkconfig.h"
+
+namespace ota {
+
+/// Blocos verificados por imagem (64 KB por bloco cobre o slot de 0x1C0000)
+constexpr size_t MAX_CHUNKS = 64;
+
+/// Servidor da tela de atualização e da consulta em segundo plano (menuconfig)
+constexpr char DEFAULT_URL[] = CONFIG_HUB_OTA_URL;
+
+/// Pilha mínima do task que chama run_update() (cliente HTTP, SHA-256, inflate e delta)
+constexpr uint32_t RUN_UPDATE_STACK_SIZE = 6144;
+
+/**
+ * @brief O que o servidor vai mandar no download
+ */
+enum class ImageFormat : uint8_t {
+    Full,     ///< Imagem inteira, verificada por bloco
+    Deflate,  ///< Imagem inteira comprimida (deflate cru, flush completo a cada bloco)
+    Delta,    ///< Patch de tools/ota_delta.py contra a imagem que está rodando
+};
+
+/**
+ * @brief Manifesto da imagem servido por tools/ota_server.py (?action=manifest)
+ *
+ * Formato texto, uma chave por linha. Imagem inteira:
+ *
+ *     version 1.0.1
+ *     size 1834512
+ *     chunk_size 65536
+ *     sha256 <64 hex da imagem inteira>
+ *     chunk <64 hex do bloco 0>
+ *     chunk <64 hex do bloco 1>
+ *     ...
+ *
+ * Imagem comprimida (servidor com --compress): as mesmas chaves mais
+ *
+ *     format deflate
+ *     compressed_size 912345
+ *     window_bits 12
+ *     chunk <64 hex do bloco 0> <offset do bloco 0 no fluxo comprimido>
+ *
+ * Delta (quando o servidor tem patch para a versão atual do dispositivo):
+ *
+ *     version 1.0.2
+ *     format delta
+ *     size / sha256           imagem reconstruída
+ *     patch_size / patch_sha256     bytes do download
+ *     source_size / source_sha256   imagem de origem esperada no slot atual
+ */
+struct Manifest {
+    char version[32];
+    ImageFormat format;
+    uint32_t size;         ///< Bytes da imagem
+    uint8_t sha256[32];    ///< Imagem inteira (conferida relendo o slot no fim)
+
+    uint32_t chunk_size;   ///< Bytes por bloco verificado (múltiplo do setor de 4 KB)
+    uint32_t chunk_count;
+    uint8_t chunk_sha256[MAX_CHUNKS][32];
+
+    uint32_t compressed_size;             ///< Bytes do download comprimido
+    uint8_t window_bits;                  ///< Janela do compressor (a RAM do inflate)
+    uint32_t chunk_offset[MAX_CHUNKS];    ///< Início de cada bloco no fluxo comprimido
+
+    uint32_t patch_size;
+    uint8_t patch_sha256[32];
+    uint32_t source_size;
+    uint8_t source_sha256[32];
+};
+
+/**
+ * @brief Notificações do download (chamadas no task que roda run_update())
+ */
+struct UpdateCallbacks {
+    void (*on_start)(uint32_t resume_offset, uint32_t total_size);
+    void (*on_progress)(int percent);
+    void (*on_complete)();
+    void (*on_failed)(esp_err_t err);
+};
+
+/**
+ * @brief Como o download divide o dispositivo com a UI
+ */
+struct UpdatePolicy {
+    uint32_t max_bytes_per_s;  ///< Teto de vazão do download (0 = sem limite)
+    uint32_t yield_ms;         ///< Pausa após cada leitura, para ceder a CPU e a flash (0 = nenhuma)
+    uint8_t progress_step;     ///< on_progress só a cada N pontos percentuais
+    bool activate;             ///< Troca a partição de boot no fim; false só deixa a imagem pronta (activate_staged())
+    bool skip_if_current;      ///< Não baixa se o manifesto é da versão que já está rodando
+};
+
+/// Tela de atualização: tudo o que der, progresso a cada 1%, troca o boot no fim
+constexpr UpdatePolicy FOREGROUND_POLICY = {0, 0, 1, true, false};
+
+/**
+ * @brief Download OTA em streaming, retomável, direto para o slot inativo
+ *
+ * A imagem é gravada no slot ota_0/ota_1 livre à medida que chega. Cada bloco
+ * do manifesto é conferido por SHA-256 assim que termina; só então o offset
+ * verificado vai para o NVS. Uma queda de conexão retoma com "Range:" do byte
+ * exato em que parou; um reboot retoma do último bloco verificado.
+ *
+ * Com o servidor comprimindo (--compress), baixa o fluxo deflate e descomprime
+ * direto no slot; cada bloco começa num ponto de flush completo, então a
+ * retomada após reboot continua valendo.
+ *
+ * Se o servidor tem um patch delta para a versão que está rodando, baixa o
+ * patch e reconstrói a imagem a partir do slot atual (ota_delta.hpp).
+ */
+class OtaDriver {
+public:
+    static OtaDriver& instance();
+
+    /**
+     * @brief Baixa, verifica e marca a nova imagem para o próximo boot (bloqueante)
+     *
+     * @param base_url URL do servidor (ex: http://192.168.0.100:10234/ota)
+     * @param device_id Enviado como parâmetro device_id (pode ser nullptr)
+     * @return ESP_OK com a imagem pronta; o chamador decide quando reiniciar.
+     *         ESP_ERR_INVALID_VERSION com skip_if_current e nada novo no servidor
+     */
+    esp_err_t run_update(const char* base_url, const char* device_id, const UpdateCallbacks& callbacks,
+                         const UpdatePolicy& policy = FOREGROUND_POLICY);
+
+    /**
+     * @brief Troca o boot para a imagem deixada pronta por run_update() sem activate
+     *
+     * O progresso fica no NVS até aqui: se o dispositivo reiniciar antes, o
+     * próximo run_update() só relê e confere o slot, sem baixar de novo.
+     */
+    esp_err_t activate_staged();
+
+    /// Imagem baixada e conferida esperando activate_staged()
+    bool has_staged() const { return staged_ != nullptr; }
+    const char* staged_version() const { return staged_version_; }
+
+    /// Bytes já verificados de um download interrompido (0 se não há)
+    uint32_t resumable_bytes() const;
+
+    /// Descarta o progresso salvo (o próximo download recomeça do zero)
+    void discard_progress();
+
+    bool is_running() const { return running_.load(); }
+
+private:
+    OtaDriver() = default;
+    ~OtaDriver() = default;
+    OtaDriver(const OtaDriver&) = delete;
+    OtaDriver& operator=(const OtaDriver&) = delete;
+
+    std::atomic<bool> running_{false};
+    const esp_partition_t* staged_ = nullptr;
+    char staged_version_[32] = {};
+};
+
+} // namespace ota
@@ -0,0 +1,173 @@
+#include "ota_delta.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "esp_log.h"
+
+namespace {
+constexpr char TAG[] = "OtaDelta";
+
+constexpr uint8_t MAGIC[4] = {'S', 'H', 'D', '1'};
+constexpr size_t HEADER_SIZE = 12;  // assinatura + tamanho destino + tamanho origem
+
+constexpr uint8_t OP_END = 0x00;
+constexpr uint8_t OP_COPY = 0x01;
+constexpr uint8_t OP_ADD = 0x02;
+constexpr uint8_t OP_INSERT = 0x03;
+
+constexpr size_t WORK_SIZE = 2048;
+
+uint32_t read_u32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+} // namespace
+
+namespace ota {
+
+esp_err_t DeltaApplier::begin(const esp_partition_t* source, uint32_t source_size, const esp_partition_t* target,
+                              uint32_t target_size) {
+    end();
+
+    work_ = static_cast<uint8_t*>(malloc(WORK_SIZE));
+    if (work_ == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    source_ = source;
+    source_size_ = source_size;
+    target_size_ = target_size;
+    writer_.begin(target, 0);
+
+    stage_ = Stage::Header;
+    fields_len_ = 0;
+    fields_needed_ = HEADER_SIZE;
+    op_remaining_ = 0;
+    return ESP_OK;
+}
+
+void DeltaApplier::end() {
+    free(work_);
+    work_ = nullptr;
+}
+
+esp_err_t DeltaApplier::consume(const uint8_t* data, size_t len) {
+    if (work_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    while (len > 0) {
+        esp_err_t err = ESP_OK;
+        switch (stage_) {
+            case Stage::Header:
+            case Stage::OpFields: {
+                const size_t take = std::min(len, fields_needed_ - fields_len_);
+                memcpy(fields_ + fields_len_, data, take);
+                fields_len_ += take;
+                data += take;
+                len -= take;
+                if (fields_len_ < fields_needed_) {
+                    break;
+                }
+                if (stage_ == Stage::OpFields) {
+                    err = start_op();
+                } else if (memcmp(fields_, MAGIC, sizeof(MAGIC)) != 0 || read_u32(fields_ + 4) != target_size_ ||
+                           read_u32(fields_ + 8) != source_size_) {
+                    ESP_LOGE(TAG, "Cabeçalho do patch não bate com o manifesto");
+                    err = ESP_ERR_INVALID_RESPONSE;
+                } else {
+                    stage_ = Stage::OpCode;
+                }
+                break;
+            }
+
+            case Stage::OpCode:
+                op_ = *data++;
+                len--;
+                fields_len_ = 0;
+                if (op_ == OP_END) {
+                    stage_ = Stage::Done;
+                } else if (op_ == OP_COPY || op_ == OP_ADD) {
+                    fields_needed_ = 8;
+                    stage_ = Stage::OpFields;
+                } else if (op_ == OP_INSERT) {
+                    fields_needed_ = 4;
+                    stage_ = Stage::OpFields;
+                } else {
+                    ESP_LOGE(TAG, "Operação desconhecida 0x%02x", op_);
+                    err = ESP_ERR_INVALID_RESPONSE;
+                }
+                break;
+
+            case Stage::Payload: {
+                const size_t take = std::min<size_t>(len, op_remaining_);
+                err = op_ == OP_ADD ? copy_from_source(take, data) : writer_.write(data, take);
+                op_remaining_ -= take;
+                data += take;
+                len -= take;
+                if (op_remaining_ == 0) {
+                    stage_ = Stage::OpCode;
+                }
+                break;
+            }
+
+            case Stage::Done:
+                return ESP_ERR_INVALID_SIZE;
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t DeltaApplier::start_op() {
+    if (op_ == OP_INSERT) {
+        op_remaining_ = read_u32(fields_);
+    } else {
+        op_source_ = read_u32(fields_);
+        op_remaining_ = read_u32(fields_ + 4);
+        if (op_source_ > source_size_ || op_remaining_ > source_size_ - op_source_) {
+            ESP_LOGE(TAG, "Operação lê fora da imagem de origem");
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+    if (op_remaining_ > target_size_ - writer_.written()) {
+        ESP_LOGE(TAG, "Operação passa do tamanho da imagem nova");
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (op_ == OP_COPY) {
+        // Sem dados no patch: copia tudo agora
+        const esp_err_t err = copy_from_source(op_remaining_, nullptr);
+        op_remaining_ = 0;
+        stage_ = Stage::OpCode;
+        return err;
+    }
+    stage_ = op_remaining_ > 0 ? Stage::Payload : Stage::OpCode;
+    return ESP_OK;
+}
+
+esp_err_t DeltaApplier::copy_from_source(uint32_t len, const uint8_t* diff) {
+    while (len > 0) {
+        const size_t piece = std::min<size_t>(len, WORK_SIZE);
+        esp_err_t err = esp_partition_read(source_, op_source_, work_, piece);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (diff != nullptr) {
+            for (size_t i = 0; i < piece; ++i) {
+                work_[i] += diff[i];
+            }
+            diff += piece;
+        }
+        err = writer_.write(work_, piece);
+        if (err != ESP_OK) {
+            return err;
+        }
+        op_source_ += piece;
+        len -= piece;
+    }
+    return ESP_OK;
+}
+
+} // namespace ota
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ota_internal.hpp"
+
+namespace ota {
+
+/**
+ * @brief Aplica as operações de um patch de tools/ota_delta.py
+ *
+ * Recebe o patch já descomprimido (InflateSink na frente): as operações leem
+ * a imagem que está rodando como origem e gravam a nova imagem no slot
+ * inativo. RAM: um buffer de trabalho de 2 KB, alocado em begin().
+ *
+ * Como o inflate do patch não é serializável, um reboot recomeça o patch,
+ * que é pequeno.
+ */
+class DeltaApplier : public DownloadSink {
+public:
+    ~DeltaApplier() override { end(); }
+
+    esp_err_t begin(const esp_partition_t* source, uint32_t source_size, const esp_partition_t* target,
+                    uint32_t target_size);
+    void end();
+
+    esp_err_t consume(const uint8_t* data, size_t len) override;
+    uint32_t position() const override { return writer_.written(); }
+
+    /// Patch inteiro aplicado e destino com o tamanho do cabeçalho
+    bool finished() const { return stage_ == Stage::Done && writer_.written() == target_size_; }
+
+private:
+    enum class Stage : uint8_t { Header, OpCode, OpFields, Payload, Done };
+
+    esp_err_t start_op();
+    esp_err_t copy_from_source(uint32_t len, const uint8_t* diff);
+
+    const esp_partition_t* source_ = nullptr;
+    uint32_t source_size_ = 0;
+    uint32_t target_size_ = 0;
+    SlotWriter writer_;
+
+    uint8_t* work_ = nullptr;  ///< Leitura da origem
+
+    // Operação corrente
+    Stage stage_ = Stage::Header;
+    uint8_t op_ = 0;
+    uint8_t fields_[12] = {};
+    size_t fields_len_ = 0;
+    size_t fields_needed_ = 0;
+    uint32_t op_source_ = 0;
+    uint32_t op_remaining_ = 0;
+};
+
+} // namespace ota
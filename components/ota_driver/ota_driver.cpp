@@ -0,0 +1,753 @@
+#include "ota_driver.hpp"
+#include "ota_delta.hpp"
+#include "ota_inflate.hpp"
+#include "ota_internal.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "esp_app_desc.h"
+#include "esp_http_client.h"
+#include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mbedtls/sha256.h"
+#include "nvs.h"
+
+namespace {
+constexpr char TAG[] = "OtaDriver";
+
+constexpr char PROGRESS_NVS_NAMESPACE[] = "ota_stream";
+constexpr char PROGRESS_NVS_KEY[] = "progress";
+constexpr uint32_t PROGRESS_VERSION = 1;
+
+constexpr size_t STREAM_BUFFER_SIZE = 4096;
+constexpr size_t MANIFEST_MAX_BYTES = 6144;
+constexpr int HTTP_TIMEOUT_MS = 15000;
+
+// tools/ota_delta.py comprime o patch com a janela padrão do zlib
+constexpr uint8_t DELTA_WINDOW_BITS = 15;
+
+// Tentativas seguidas sem nenhum byte novo antes de desistir; o backoff
+// dobra até o teto e soma uns 3 min, o bastante para o WiFi do local voltar
+constexpr int MAX_ATTEMPTS_WITHOUT_PROGRESS = 10;
+constexpr uint32_t RETRY_DELAY_MS = 1000;
+constexpr uint32_t RETRY_DELAY_MAX_MS = 30000;
+
+using ota::SECTOR_SIZE;
+
+/**
+ * @brief Progresso salvo no NVS a cada bloco verificado
+ *
+ * O hash da imagem identifica a versão: se o servidor trocar a imagem, o
+ * progresso é descartado.
+ */
+struct Progress {
+    uint32_t version;
+    uint32_t partition_address;
+    uint32_t size;
+    uint32_t verified;  ///< Bytes conferidos (sempre na fronteira de um bloco)
+    uint8_t image_sha256[32];
+};
+
+bool parse_hex(const char* hex, uint8_t* out, size_t out_len) {
+    if (strlen(hex) != out_len * 2) {
+        return false;
+    }
+    for (size_t i = 0; i < out_len; ++i) {
+        char byte[3] = {hex[i * 2], hex[i * 2 + 1], '\0'};
+        char* end = nullptr;
+        out[i] = static_cast<uint8_t>(strtoul(byte, &end, 16));
+        if (end != byte + 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t parse_manifest(char* text, ota::Manifest& manifest) {
+    manifest = {};
+    bool has_hash = false;
+    bool has_patch_hash = false;
+    bool has_source_hash = false;
+    uint32_t offset_count = 0;
+    char* save = nullptr;
+    for (char* line = strtok_r(text, "\r\n", &save); line != nullptr; line = strtok_r(nullptr, "\r\n", &save)) {
+        char key[16];
+        char value[72];
+        char extra[16];
+        const int fields = sscanf(line, "%15s %71s %15s", key, value, extra);
+        if (fields < 2) {
+            continue;
+        }
+        if (strcmp(key, "version") == 0) {
+            strncpy(manifest.version, value, sizeof(manifest.version) - 1);
+        } else if (strcmp(key, "format") == 0) {
+            if (strcmp(value, "delta") == 0) {
+                manifest.format = ota::ImageFormat::Delta;
+            } else if (strcmp(value, "deflate") == 0) {
+                manifest.format = ota::ImageFormat::Deflate;
+            }
+        } else if (strcmp(key, "size") == 0) {
+            manifest.size = strtoul(value, nullptr, 10);
+        } else if (strcmp(key, "sha256") == 0) {
+            has_hash = parse_hex(value, manifest.sha256, sizeof(manifest.sha256));
+        } else if (strcmp(key, "chunk_size") == 0) {
+            manifest.chunk_size = strtoul(value, nullptr, 10);
+        } else if (strcmp(key, "chunk") == 0) {
+            if (manifest.chunk_count >= ota::MAX_CHUNKS ||
+                !parse_hex(value, manifest.chunk_sha256[manifest.chunk_count], 32)) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            if (fields == 3) {
+                manifest.chunk_offset[offset_count++] = strtoul(extra, nullptr, 10);
+            }
+            manifest.chunk_count++;
+        } else if (strcmp(key, "compressed_size") == 0) {
+            manifest.compressed_size = strtoul(value, nullptr, 10);
+        } else if (strcmp(key, "window_bits") == 0) {
+            manifest.window_bits = static_cast<uint8_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(key, "patch_size") == 0) {
+            manifest.patch_size = strtoul(value, nullptr, 10);
+        } else if (strcmp(key, "patch_sha256") == 0) {
+            has_patch_hash = parse_hex(value, manifest.patch_sha256, sizeof(manifest.patch_sha256));
+        } else if (strcmp(key, "source_size") == 0) {
+            manifest.source_size = strtoul(value, nullptr, 10);
+        } else if (strcmp(key, "source_sha256") == 0) {
+            has_source_hash = parse_hex(value, manifest.source_sha256, sizeof(manifest.source_sha256));
+        }
+    }
+
+    if (!has_hash || manifest.size == 0) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    if (manifest.format == ota::ImageFormat::Delta) {
+        return has_patch_hash && has_source_hash && manifest.patch_size > 0 && manifest.source_size > 0
+            ? ESP_OK : ESP_ERR_INVALID_RESPONSE;
+    }
+    if (manifest.chunk_size == 0 || manifest.chunk_size % SECTOR_SIZE != 0) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    const uint32_t expected_chunks = (manifest.size + manifest.chunk_size - 1) / manifest.chunk_size;
+    if (manifest.chunk_count != expected_chunks) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (manifest.format == ota::ImageFormat::Deflate) {
+        // Um offset por bloco, crescente, começando no início do fluxo
+        bool offsets_ok = offset_count == manifest.chunk_count && manifest.chunk_offset[0] == 0;
+        for (uint32_t i = 1; i < offset_count && offsets_ok; ++i) {
+            offsets_ok = manifest.chunk_offset[i] > manifest.chunk_offset[i - 1] &&
+                manifest.chunk_offset[i] < manifest.compressed_size;
+        }
+        if (!offsets_ok || manifest.window_bits < 9 || manifest.window_bits > 15) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+    return ESP_OK;
+}
+
+/// base?device_id=..&current_version=..[&<extra>]
+void build_url(char* out, size_t out_len, const char* base_url, const char* device_id, const char* extra) {
+    const char* separator = strchr(base_url, '?') != nullptr ? "&" : "?";
+    int used = snprintf(out, out_len, "%s%sdevice_id=%s&current_version=%s", base_url, separator,
+                        device_id != nullptr ? device_id : "", esp_app_get_description()->version);
+    if (extra != nullptr && used > 0 && static_cast<size_t>(used) < out_len) {
+        snprintf(out + used, out_len - used, "&%s", extra);
+    }
+}
+
+esp_err_t fetch_manifest(const char* url, ota::Manifest& manifest) {
+    esp_http_client_config_t config = {};
+    config.url = url;
+    config.timeout_ms = HTTP_TIMEOUT_MS;
+
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (client == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    char* text = static_cast<char*>(malloc(MANIFEST_MAX_BYTES));
+    esp_err_t err = text != nullptr ? esp_http_client_open(client, 0) : ESP_ERR_NO_MEM;
+    if (err == ESP_OK) {
+        esp_http_client_fetch_headers(client);
+        const int status = esp_http_client_get_status_code(client);
+        int length = 0;
+        while (length < static_cast<int>(MANIFEST_MAX_BYTES) - 1) {
+            const int n = esp_http_client_read(client, text + length, MANIFEST_MAX_BYTES - 1 - length);
+            if (n <= 0) {
+                break;
+            }
+            length += n;
+        }
+        text[length] = '\0';
+
+        if (status != 200) {
+            ESP_LOGE(TAG, "Manifesto indisponível (HTTP %d)", status);
+            err = ESP_ERR_NOT_FOUND;
+        } else {
+            err = parse_manifest(text, manifest);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Manifesto inválido (%s)", esp_err_to_name(err));
+            }
+        }
+    }
+
+    free(text);
+    esp_http_client_cleanup(client);
+    return err;
+}
+
+bool load_progress(Progress& progress) {
+    nvs_handle_t handle;
+    if (nvs_open(PROGRESS_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    size_t size = sizeof(progress);
+    const esp_err_t err = nvs_get_blob(handle, PROGRESS_NVS_KEY, &progress, &size);
+    nvs_close(handle);
+    return err == ESP_OK && size == sizeof(progress) && progress.version == PROGRESS_VERSION;
+}
+
+void save_progress(const esp_partition_t* partition, const ota::Manifest& manifest, uint32_t verified) {
+    Progress progress = {};
+    progress.version = PROGRESS_VERSION;
+    progress.partition_address = partition->address;
+    progress.size = manifest.size;
+    progress.verified = verified;
+    memcpy(progress.image_sha256, manifest.sha256, sizeof(progress.image_sha256));
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(PROGRESS_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, PROGRESS_NVS_KEY, &progress, sizeof(progress));
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        // Não interrompe o download: só a retomada após reboot fica mais para trás
+        ESP_LOGW(TAG, "Falha ao salvar progresso (%s)", esp_err_to_name(err));
+    }
+}
+
+/**
+ * @brief Imagem inteira: grava no slot e confere cada bloco que se completa
+ *
+ * Um bloco que não bate com o manifesto volta a gravação para o início dele
+ * (ESP_ERR_INVALID_CRC) e o download retoma dali.
+ */
+class FullImageSink : public ota::DownloadSink {
+public:
+    FullImageSink(const esp_partition_t* partition, const ota::Manifest& manifest, uint32_t verified)
+        : partition_(partition), manifest_(manifest), verified_(verified) {
+        writer_.begin(partition, verified);
+        mbedtls_sha256_init(&chunk_hash_);
+        mbedtls_sha256_starts(&chunk_hash_, 0);
+    }
+
+    ~FullImageSink() override { mbedtls_sha256_free(&chunk_hash_); }
+
+    esp_err_t consume(const uint8_t* data, size_t len) override {
+        while (len > 0) {
+            const uint32_t received = writer_.written();
+            if (received >= manifest_.size) {
+                ESP_LOGE(TAG, "Servidor enviou mais que %lu bytes", static_cast<unsigned long>(manifest_.size));
+                return ESP_ERR_INVALID_SIZE;
+            }
+
+            const uint32_t chunk = received / manifest_.chunk_size;
+            const uint32_t chunk_end = std::min(manifest_.size, (chunk + 1) * manifest_.chunk_size);
+            const size_t take = std::min<size_t>(len, chunk_end - received);
+
+            const esp_err_t err = writer_.write(data, take);
+            if (err != ESP_OK) {
+                return err;
+            }
+            mbedtls_sha256_update(&chunk_hash_, data, take);
+            data += take;
+            len -= take;
+
+            if (writer_.written() == chunk_end) {
+                uint8_t digest[32];
+                mbedtls_sha256_finish(&chunk_hash_, digest);
+                mbedtls_sha256_free(&chunk_hash_);
+                mbedtls_sha256_init(&chunk_hash_);
+                mbedtls_sha256_starts(&chunk_hash_, 0);
+
+                if (memcmp(digest, manifest_.chunk_sha256[chunk], sizeof(digest)) != 0) {
+                    ESP_LOGW(TAG, "Bloco %lu com hash divergente, baixando de novo", static_cast<unsigned long>(chunk));
+                    rewind();
+                    return ESP_ERR_INVALID_CRC;
+                }
+                verified_ = chunk_end;
+                save_progress(partition_, manifest_, verified_);
+            }
+        }
+        return ESP_OK;
+    }
+
+    uint32_t position() const override { return writer_.written(); }
+
+    uint32_t verified() const { return verified_; }
+
+    /// Descarta o bloco em andamento: a gravação volta ao último bloco conferido
+    void rewind() {
+        writer_.rewind(verified_);
+        mbedtls_sha256_free(&chunk_hash_);
+        mbedtls_sha256_init(&chunk_hash_);
+        mbedtls_sha256_starts(&chunk_hash_, 0);
+    }
+
+private:
+    const esp_partition_t* partition_;
+    const ota::Manifest& manifest_;
+    uint32_t verified_;  ///< Bytes conferidos e persistidos
+    ota::SlotWriter writer_;
+    mbedtls_sha256_context chunk_hash_;
+};
+
+/**
+ * @brief Imagem comprimida: descomprime para um FullImageSink
+ *
+ * Cada bloco começa num ponto de flush completo do fluxo, então um bloco com
+ * hash divergente (ou que não descomprime) recomeça o inflate no início do
+ * último bloco conferido, e o download retoma dali.
+ */
+class CompressedImageSink : public ota::DownloadSink {
+public:
+    CompressedImageSink(FullImageSink& image, const ota::Manifest& manifest) : image_(image), manifest_(manifest) {}
+
+    esp_err_t begin() {
+        const esp_err_t err = inflate_.begin(image_, manifest_.window_bits, false, false);
+        if (err == ESP_OK) {
+            inflate_.restart(verified_offset());
+        }
+        return err;
+    }
+
+    esp_err_t consume(const uint8_t* data, size_t len) override {
+        const esp_err_t err = inflate_.consume(data, len);
+        if (err == ESP_ERR_INVALID_CRC || err == ESP_ERR_INVALID_RESPONSE) {
+            image_.rewind();
+            inflate_.restart(verified_offset());
+            return ESP_ERR_INVALID_CRC;
+        }
+        return err;
+    }
+
+    uint32_t position() const override { return inflate_.position(); }
+
+private:
+    /// Offset no fluxo comprimido do primeiro bloco ainda não conferido
+    uint32_t verified_offset() const {
+        const uint32_t chunk = image_.verified() / manifest_.chunk_size;
+        return chunk < manifest_.chunk_count ? manifest_.chunk_offset[chunk] : manifest_.compressed_size;
+    }
+
+    FullImageSink& image_;
+    const ota::Manifest& manifest_;
+    ota::InflateSink inflate_;
+};
+
+// Segura a leitura para não passar de max_bytes_per_s e cede a CPU entre leituras
+void throttle(const ota::UpdatePolicy& policy, uint64_t received, int64_t started_us) {
+    uint32_t wait_ms = policy.yield_ms;
+    if (policy.max_bytes_per_s > 0) {
+        const int64_t due_us = started_us + static_cast<int64_t>(received * 1000000ULL / policy.max_bytes_per_s);
+        const int64_t ahead_us = due_us - esp_timer_get_time();
+        if (ahead_us > 0) {
+            wait_ms = std::max(wait_ms, static_cast<uint32_t>(ahead_us / 1000));
+        }
+    }
+    if (wait_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(wait_ms));
+    }
+}
+
+/**
+ * @brief Uma conexão: pede "Range: bytes=<position>-" e consome até o fim ou a queda
+ *
+ * @param fatal true quando o erro veio do destino (nova tentativa não adianta)
+ */
+esp_err_t stream_from(esp_http_client_handle_t client, ota::DownloadSink& sink, uint32_t total, uint8_t* buffer,
+                      const ota::UpdateCallbacks& callbacks, const ota::UpdatePolicy& policy, int& last_percent,
+                      bool& fatal) {
+    fatal = false;
+    char range[32];
+    snprintf(range, sizeof(range), "bytes=%lu-", static_cast<unsigned long>(sink.position()));
+    esp_http_client_set_header(client, "Range", range);
+
+    esp_err_t err = esp_http_client_open(client, 0);
+    if (err != ESP_OK) {
+        return err;
+    }
+    esp_http_client_fetch_headers(client);
+    const int status = esp_http_client_get_status_code(client);
+    if (status == 200 && sink.position() != 0) {
+        ESP_LOGE(TAG, "Servidor ignorou o Range (HTTP 200): sem suporte a retomada");
+        fatal = true;
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (status != 200 && status != 206) {
+        ESP_LOGE(TAG, "Download recusado (HTTP %d)", status);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    // O TCP segura o servidor enquanto a leitura está pausada: o teto vale para o WiFi também
+    const int64_t started_us = esp_timer_get_time();
+    uint64_t received = 0;
+    while (sink.position() < total) {
+        const int n = esp_http_client_read(client, reinterpret_cast<char*>(buffer), STREAM_BUFFER_SIZE);
+        if (n < 0) {
+            return ESP_FAIL;
+        }
+        if (n == 0) {
+            // Fim do corpo antes do tamanho do manifesto: conexão caiu
+            return esp_http_client_is_complete_data_received(client) ? ESP_ERR_INVALID_SIZE : ESP_ERR_TIMEOUT;
+        }
+        err = sink.consume(buffer, n);
+        if (err != ESP_OK) {
+            fatal = err != ESP_ERR_INVALID_CRC;
+            return err;
+        }
+
+        const int percent = static_cast<int>((100ULL * sink.position()) / total);
+        if (percent >= last_percent + policy.progress_step || (percent == 100 && last_percent != 100)) {
+            last_percent = percent;
+            if (callbacks.on_progress != nullptr) {
+                callbacks.on_progress(percent);
+            }
+        }
+
+        received += n;
+        throttle(policy, received, started_us);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Baixa url até o destino receber total bytes, retomando nas quedas
+ */
+esp_err_t download(const char* url, ota::DownloadSink& sink, uint32_t total, uint8_t* buffer,
+                   const ota::UpdateCallbacks& callbacks, const ota::UpdatePolicy& policy) {
+    esp_http_client_config_t config = {};
+    config.url = url;
+    config.timeout_ms = HTTP_TIMEOUT_MS;
+    config.buffer_size = 2048;
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    if (client == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = ESP_OK;
+    int last_percent = -1;
+    int attempts = 0;
+    uint32_t retry_delay_ms = RETRY_DELAY_MS;
+    while (sink.position() < total) {
+        const uint32_t before = sink.position();
+        bool fatal = false;
+        err = stream_from(client, sink, total, buffer, callbacks, policy, last_percent, fatal);
+        esp_http_client_close(client);
+
+        if (err == ESP_OK || fatal || err == ESP_ERR_INVALID_SIZE) {
+            break;  // Nova tentativa não muda o resultado
+        }
+
+        // Progresso (mesmo sem fechar bloco) zera a contagem e o backoff
+        if (sink.position() > before) {
+            attempts = 0;
+            retry_delay_ms = RETRY_DELAY_MS;
+        }
+        if (++attempts >= MAX_ATTEMPTS_WITHOUT_PROGRESS) {
+            ESP_LOGE(TAG, "Sem progresso após %d tentativas", attempts);
+            break;
+        }
+        ESP_LOGW(TAG, "Conexão interrompida em %lu bytes (%s), nova tentativa em %lu ms",
+                 static_cast<unsigned long>(sink.position()), esp_err_to_name(err),
+                 static_cast<unsigned long>(retry_delay_ms));
+        vTaskDelay(pdMS_TO_TICKS(retry_delay_ms));
+        retry_delay_ms = std::min(retry_delay_ms * 2, RETRY_DELAY_MAX_MS);
+    }
+
+    esp_http_client_cleanup(client);
+    return err;
+}
+
+esp_err_t partition_sha256(const esp_partition_t* partition, uint32_t size, uint8_t* buffer, uint8_t digest[32]) {
+    mbedtls_sha256_context hash;
+    mbedtls_sha256_init(&hash);
+    mbedtls_sha256_starts(&hash, 0);
+
+    esp_err_t err = ESP_OK;
+    for (uint32_t offset = 0; offset < size && err == ESP_OK; offset += STREAM_BUFFER_SIZE) {
+        const size_t len = std::min<size_t>(STREAM_BUFFER_SIZE, size - offset);
+        err = esp_partition_read(partition, offset, buffer, len);
+        if (err == ESP_OK) {
+            mbedtls_sha256_update(&hash, buffer, len);
+        }
+    }
+
+    mbedtls_sha256_finish(&hash, digest);
+    mbedtls_sha256_free(&hash);
+    return err;
+}
+
+// Relê o slot inteiro: confere a imagem e, de quebra, a gravação na flash
+esp_err_t verify_image(const esp_partition_t* partition, const ota::Manifest& manifest, uint8_t* buffer) {
+    uint8_t digest[32];
+    const esp_err_t err = partition_sha256(partition, manifest.size, buffer, digest);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return memcmp(digest, manifest.sha256, sizeof(digest)) == 0 ? ESP_OK : ESP_ERR_INVALID_CRC;
+}
+
+// O patch só serve se o slot atual tiver exatamente a imagem de origem dele
+bool delta_source_matches(const ota::Manifest& manifest, uint8_t* buffer) {
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    if (running == nullptr || manifest.source_size > running->size) {
+        return false;
+    }
+    uint8_t digest[32];
+    return partition_sha256(running, manifest.source_size, buffer, digest) == ESP_OK &&
+        memcmp(digest, manifest.source_sha256, sizeof(digest)) == 0;
+}
+
+esp_err_t download_full(const char* base_url, const char* device_id, const esp_partition_t* partition,
+                        const ota::Manifest& manifest, uint8_t* buffer, const ota::UpdateCallbacks& callbacks,
+                        const ota::UpdatePolicy& policy) {
+    uint32_t verified = 0;
+    Progress progress = {};
+    if (load_progress(progress) && progress.partition_address == partition->address &&
+        progress.size == manifest.size && progress.verified <= manifest.size &&
+        (progress.verified % manifest.chunk_size == 0 || progress.verified == manifest.size) &&
+        memcmp(progress.image_sha256, manifest.sha256, sizeof(progress.image_sha256)) == 0) {
+        verified = progress.verified;
+        ESP_LOGI(TAG, "Retomando %s em %lu/%lu bytes", manifest.version, static_cast<unsigned long>(verified),
+                 static_cast<unsigned long>(manifest.size));
+    } else {
+        ESP_LOGI(TAG, "Baixando %s (%lu bytes, %lu blocos) para %s", manifest.version,
+                 static_cast<unsigned long>(manifest.size), static_cast<unsigned long>(manifest.chunk_count),
+                 partition->label);
+    }
+
+    if (verified == manifest.size) {
+        // Já preparada numa consulta anterior: só falta a releitura do slot
+        return ESP_OK;
+    }
+
+    char url[256];
+    FullImageSink sink(partition, manifest, verified);
+    if (manifest.format == ota::ImageFormat::Deflate) {
+        CompressedImageSink compressed(sink, manifest);
+        if (compressed.begin() == ESP_OK) {
+            ESP_LOGI(TAG, "Download comprimido: %lu bytes, janela de %u bytes",
+                     static_cast<unsigned long>(manifest.compressed_size), 1u << manifest.window_bits);
+            if (callbacks.on_start != nullptr) {
+                callbacks.on_start(compressed.position(), manifest.compressed_size);
+            }
+            build_url(url, sizeof(url), base_url, device_id, "format=deflate");
+            esp_err_t err = download(url, compressed, manifest.compressed_size, buffer, callbacks, policy);
+            if (err == ESP_OK && sink.position() != manifest.size) {
+                ESP_LOGE(TAG, "Fluxo comprimido terminou em %lu bytes de imagem",
+                         static_cast<unsigned long>(sink.position()));
+                err = ESP_ERR_INVALID_SIZE;
+            }
+            return err;
+        }
+        ESP_LOGW(TAG, "Sem RAM para descomprimir; baixando a imagem sem compressão");
+    }
+
+    if (callbacks.on_start != nullptr) {
+        callbacks.on_start(verified, manifest.size);
+    }
+
+    build_url(url, sizeof(url), base_url, device_id, "format=full");
+    return download(url, sink, manifest.size, buffer, callbacks, policy);
+}
+
+esp_err_t download_delta(const char* base_url, const char* device_id, const esp_partition_t* partition,
+                         const ota::Manifest& manifest, uint8_t* buffer, const ota::UpdateCallbacks& callbacks,
+                         const ota::UpdatePolicy& policy) {
+    ESP_LOGI(TAG, "Baixando patch %s -> %s (%lu bytes para imagem de %lu)", esp_app_get_description()->version,
+             manifest.version, static_cast<unsigned long>(manifest.patch_size),
+             static_cast<unsigned long>(manifest.size));
+
+    ota::DeltaApplier applier;
+    ota::InflateSink inflate;
+    esp_err_t err = applier.begin(esp_ota_get_running_partition(), manifest.source_size, partition, manifest.size);
+    if (err == ESP_OK) {
+        err = inflate.begin(applier, DELTA_WINDOW_BITS, true, true);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    // Um download de imagem inteira interrompido não vale mais: o slot vai ser sobrescrito
+    ota::OtaDriver::instance().discard_progress();
+
+    if (callbacks.on_start != nullptr) {
+        callbacks.on_start(0, manifest.patch_size);
+    }
+
+    char url[256];
+    build_url(url, sizeof(url), base_url, device_id, "format=delta");
+    err = download(url, inflate, manifest.patch_size, buffer, callbacks, policy);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint8_t digest[32];
+    inflate.input_digest(digest);
+    if (memcmp(digest, manifest.patch_sha256, sizeof(digest)) != 0) {
+        ESP_LOGE(TAG, "Hash do patch não confere com o manifesto");
+        return ESP_ERR_INVALID_CRC;
+    }
+    if (!applier.finished()) {
+        ESP_LOGE(TAG, "Patch terminou antes de reconstruir a imagem inteira");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
+} // namespace
+
+namespace ota {
+
+OtaDriver& OtaDriver::instance() {
+    static OtaDriver driver;
+    return driver;
+}
+
+uint32_t OtaDriver::resumable_bytes() const {
+    Progress progress = {};
+    return load_progress(progress) ? progress.verified : 0;
+}
+
+void OtaDriver::discard_progress() {
+    nvs_handle_t handle;
+    if (nvs_open(PROGRESS_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(handle, PROGRESS_NVS_KEY) == ESP_OK) {
+        nvs_commit(handle);
+    }
+    nvs_close(handle);
+}
+
+esp_err_t OtaDriver::activate_staged() {
+    if (staged_ == nullptr || running_.load()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const esp_err_t err = esp_ota_set_boot_partition(staged_);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao ativar %s: %s", staged_version_, esp_err_to_name(err));
+        return err;
+    }
+    discard_progress();
+    ESP_LOGI(TAG, "%s ativada em %s; pronta para reiniciar", staged_version_, staged_->label);
+    staged_ = nullptr;
+    return ESP_OK;
+}
+
+esp_err_t OtaDriver::run_update(const char* base_url, const char* device_id, const UpdateCallbacks& callbacks,
+                                const UpdatePolicy& policy) {
+    if (base_url == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // A tela e a atualização em segundo plano podem chamar ao mesmo tempo
+    if (running_.exchange(true)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    auto fail = [&](esp_err_t err) {
+        ESP_LOGE(TAG, "Atualização falhou: %s", esp_err_to_name(err));
+        if (callbacks.on_failed != nullptr) {
+            callbacks.on_failed(err);
+        }
+        running_ = false;
+        return err;
+    };
+
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+    if (partition == nullptr) {
+        return fail(ESP_ERR_NOT_FOUND);
+    }
+
+    // ~2,5 KB + 4 KB: só existem durante a atualização
+    auto* manifest = static_cast<Manifest*>(malloc(sizeof(Manifest)));
+    auto* buffer = static_cast<uint8_t*>(malloc(STREAM_BUFFER_SIZE));
+    if (manifest == nullptr || buffer == nullptr) {
+        free(manifest);
+        free(buffer);
+        return fail(ESP_ERR_NO_MEM);
+    }
+
+    char url[256];
+    build_url(url, sizeof(url), base_url, device_id, "action=manifest");
+    esp_err_t err = fetch_manifest(url, *manifest);
+    if (err == ESP_OK && manifest->format == ImageFormat::Delta && !delta_source_matches(*manifest, buffer)) {
+        ESP_LOGW(TAG, "Slot atual não é a origem do patch; pedindo a imagem inteira");
+        build_url(url, sizeof(url), base_url, device_id, "action=manifest&format=full");
+        err = fetch_manifest(url, *manifest);
+    }
+    if (err == ESP_OK && policy.skip_if_current && strcmp(manifest->version, esp_app_get_description()->version) == 0) {
+        ESP_LOGI(TAG, "Já na versão %s do servidor", manifest->version);
+        free(manifest);
+        free(buffer);
+        running_ = false;
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (err == ESP_OK && manifest->size > partition->size) {
+        ESP_LOGE(TAG, "Imagem de %lu bytes não cabe no slot %s", static_cast<unsigned long>(manifest->size),
+                 partition->label);
+        err = ESP_ERR_INVALID_SIZE;
+    }
+
+    if (err == ESP_OK) {
+        staged_ = nullptr;  // O slot vai ser regravado (ou só conferido, se o progresso já cobre a imagem)
+        err = manifest->format == ImageFormat::Delta
+            ? download_delta(base_url, device_id, partition, *manifest, buffer, callbacks, policy)
+            : download_full(base_url, device_id, partition, *manifest, buffer, callbacks, policy);
+    }
+    if (err == ESP_OK) {
+        err = verify_image(partition, *manifest, buffer);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Hash da imagem gravada não confere com o manifesto");
+            discard_progress();
+        }
+    }
+    if (err == ESP_OK && policy.activate) {
+        // Valida o cabeçalho e o SHA anexado da imagem antes de trocar o boot
+        err = esp_ota_set_boot_partition(partition);
+    }
+    if (err == ESP_OK) {
+        strncpy(staged_version_, manifest->version, sizeof(staged_version_) - 1);
+    }
+
+    free(manifest);
+    free(buffer);
+
+    if (err != ESP_OK) {
+        return fail(err);
+    }
+
+    if (policy.activate) {
+        staged_ = nullptr;
+        discard_progress();
+        ESP_LOGI(TAG, "Imagem verificada em %s; pronta para reiniciar", partition->label);
+    } else {
+        staged_ = partition;
+        ESP_LOGI(TAG, "%s verificada em %s; aguardando activate_staged()", staged_version_, partition->label);
+    }
+    if (callbacks.on_complete != nullptr) {
+        callbacks.on_complete();
+    }
+    running_ = false;
+    return ESP_OK;
+}
+
+} // namespace ota
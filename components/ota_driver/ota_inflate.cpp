@@ -0,0 +1,106 @@
+#include "ota_inflate.hpp"
+
+#include <cstdlib>
+#include "esp_log.h"
+
+namespace {
+constexpr char TAG[] = "OtaInflate";
+} // namespace
+
+namespace ota {
+
+esp_err_t InflateSink::begin(DownloadSink& output, uint8_t window_bits, bool zlib_header, bool hash_input) {
+    end();
+    if (window_bits < 9 || window_bits > 15) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // A janela é circular: qualquer potência de 2 que cubra as distâncias do compressor serve
+    window_size_ = static_cast<size_t>(1) << window_bits;
+    inflater_ = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
+    window_ = static_cast<uint8_t*>(malloc(window_size_));
+    if (inflater_ == nullptr || window_ == nullptr) {
+        end();
+        return ESP_ERR_NO_MEM;
+    }
+
+    output_ = &output;
+    flags_ = TINFL_FLAG_HAS_MORE_INPUT | (zlib_header ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0);
+    if (hash_input) {
+        mbedtls_sha256_init(&input_hash_);
+        mbedtls_sha256_starts(&input_hash_, 0);
+        hashing_ = true;
+    }
+    restart(0);
+    return ESP_OK;
+}
+
+void InflateSink::end() {
+    free(inflater_);
+    free(window_);
+    inflater_ = nullptr;
+    window_ = nullptr;
+    output_ = nullptr;
+    if (hashing_) {
+        mbedtls_sha256_free(&input_hash_);
+        hashing_ = false;
+    }
+}
+
+void InflateSink::restart(uint32_t offset) {
+    tinfl_init(inflater_);
+    window_pos_ = 0;
+    done_ = false;
+    received_ = offset;
+}
+
+void InflateSink::input_digest(uint8_t digest[32]) {
+    mbedtls_sha256_finish(&input_hash_, digest);
+    mbedtls_sha256_free(&input_hash_);
+    hashing_ = false;
+}
+
+esp_err_t InflateSink::consume(const uint8_t* data, size_t len) {
+    if (inflater_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (done_) {
+        return len > 0 ? ESP_ERR_INVALID_SIZE : ESP_OK;
+    }
+    if (hashing_) {
+        mbedtls_sha256_update(&input_hash_, data, len);
+    }
+    received_ += len;
+
+    for (;;) {
+        size_t in_bytes = len;
+        size_t out_bytes = window_size_ - window_pos_;
+        const tinfl_status status = tinfl_decompress(inflater_, data, &in_bytes, window_, window_ + window_pos_,
+                                                     &out_bytes, flags_);
+        data += in_bytes;
+        len -= in_bytes;
+
+        if (out_bytes > 0) {
+            const esp_err_t err = output_->consume(window_ + window_pos_, out_bytes);
+            if (err != ESP_OK) {
+                return err;
+            }
+            window_pos_ = (window_pos_ + out_bytes) & (window_size_ - 1);
+        }
+
+        if (status == TINFL_STATUS_DONE) {
+            done_ = true;
+            return len == 0 ? ESP_OK : ESP_ERR_INVALID_SIZE;
+        }
+        if (status < 0) {
+            ESP_LOGE(TAG, "Fluxo comprimido corrompido (inflate %d)", static_cast<int>(status));
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+            return ESP_OK;
+        }
+        // TINFL_STATUS_HAS_MORE_OUTPUT: a janela encheu, continuar
+    }
+}
+
+} // namespace ota
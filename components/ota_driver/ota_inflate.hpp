@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ota_internal.hpp"
+#include "mbedtls/sha256.h"
+
+// tinfl (inflate) da ROM do ESP32: não ocupa flash
+#include "esp32/rom/miniz.h"
+
+namespace ota {
+
+/**
+ * @brief Descomprime o download enquanto ele chega e repassa a outro destino
+ *
+ * position() conta bytes comprimidos (o Range da próxima conexão); a saída
+ * vai em ordem para output.consume(). RAM: tinfl (~11 KB) + janela de
+ * 1 << window_bits, alocados em begin() e liberados em end().
+ *
+ * O estado do inflate não é serializável: uma queda de conexão retoma com o
+ * estado em RAM; depois de um reboot só dá para recomeçar num ponto de flush
+ * completo do fluxo (restart()).
+ */
+class InflateSink : public DownloadSink {
+public:
+    ~InflateSink() override { end(); }
+
+    /**
+     * @param window_bits Janela usada pelo compressor (9..15)
+     * @param zlib_header Fluxo com cabeçalho zlib (patch delta) ou deflate cru (imagem)
+     * @param hash_input Calcula o SHA-256 dos bytes comprimidos (input_digest())
+     */
+    esp_err_t begin(DownloadSink& output, uint8_t window_bits, bool zlib_header, bool hash_input);
+    void end();
+
+    /// Recomeça a descompressão em offset do fluxo cru (deve ser um ponto de flush completo)
+    void restart(uint32_t offset);
+
+    esp_err_t consume(const uint8_t* data, size_t len) override;
+    uint32_t position() const override { return received_; }
+
+    /// Fim do fluxo deflate alcançado
+    bool done() const { return done_; }
+
+    /// SHA-256 dos bytes recebidos desde begin() (só com hash_input)
+    void input_digest(uint8_t digest[32]);
+
+private:
+    DownloadSink* output_ = nullptr;
+    tinfl_decompressor* inflater_ = nullptr;
+    uint8_t* window_ = nullptr;
+    size_t window_size_ = 0;
+    size_t window_pos_ = 0;
+    uint32_t flags_ = 0;
+    bool done_ = false;
+
+    mbedtls_sha256_context input_hash_;
+    bool hashing_ = false;
+    uint32_t received_ = 0;
+};
+
+} // namespace ota
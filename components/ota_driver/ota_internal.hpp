@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_err.h"
+#include "esp_partition.h"
+
+namespace ota {
+
+/// Setor da flash: unidade de apagamento do slot
+constexpr uint32_t SECTOR_SIZE = 4096;
+
+/**
+ * @brief Destino dos bytes baixados (imagem inteira, patch delta...)
+ *
+ * Recebe o corpo em ordem. position() é o byte do download a partir do qual
+ * uma nova conexão deve retomar (Range), então o destino decide até onde o
+ * que já chegou vale.
+ */
+class DownloadSink {
+public:
+    virtual ~DownloadSink() = default;
+
+    /**
+     * @return ESP_ERR_INVALID_CRC para baixar de novo a partir de position();
+     *         outro erro encerra a atualização
+     */
+    virtual esp_err_t consume(const uint8_t* data, size_t len) = 0;
+
+    virtual uint32_t position() const = 0;
+};
+
+/**
+ * @brief Gravação sequencial no slot inativo, apagando setor a setor à frente
+ */
+class SlotWriter {
+public:
+    void begin(const esp_partition_t* partition, uint32_t offset);
+
+    esp_err_t write(const uint8_t* data, size_t len);
+
+    /// Volta a gravação para offset (os setores a partir dele são apagados de novo)
+    void rewind(uint32_t offset);
+
+    uint32_t written() const { return written_; }
+
+private:
+    const esp_partition_t* partition_ = nullptr;
+    uint32_t written_ = 0;
+    uint32_t erased_ = 0;  ///< Slot apagado até aqui (alinhado ao setor)
+};
+
+} // namespace ota
@@ -0,0 +1,47 @@
+#include "ota_internal.hpp"
+
+#include <algorithm>
+#include "esp_log.h"
+
+namespace {
+constexpr char TAG[] = "OtaSlot";
+} // namespace
+
+namespace ota {
+
+void SlotWriter::begin(const esp_partition_t* partition, uint32_t offset) {
+    partition_ = partition;
+    written_ = offset;
+    erased_ = offset;
+}
+
+esp_err_t SlotWriter::write(const uint8_t* data, size_t len) {
+    const uint32_t end = written_ + len;
+    if (end > partition_->size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    esp_err_t err = ESP_OK;
+    if (end > erased_) {
+        const uint32_t erase_end = std::min<uint32_t>((end + SECTOR_SIZE - 1) & ~(SECTOR_SIZE - 1), partition_->size);
+        err = esp_partition_erase_range(partition_, erased_, erase_end - erased_);
+        if (err == ESP_OK) {
+            erased_ = erase_end;
+        }
+    }
+    if (err == ESP_OK) {
+        err = esp_partition_write(partition_, written_, data, len);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao gravar no slot %s (%s)", partition_->label, esp_err_to_name(err));
+        return err;
+    }
+    written_ = end;
+    return ESP_OK;
+}
+
+void SlotWriter::rewind(uint32_t offset) {
+    written_ = offset;
+    erased_ = offset;
+}
+
+} // namespace ota
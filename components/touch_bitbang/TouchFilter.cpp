@@ -0,0 +1,109 @@
+#include "TouchFilter.hpp"
+
+namespace {
+constexpr int32_t Q4_SHIFT = 4;
+constexpr int32_t ALPHA_ONE_Q8 = 256;
+constexpr int32_t SPEED_ALPHA_Q8 = 128;  // Suavização da velocidade do one-euro
+constexpr uint16_t RAW_MAX = 4095;
+} // namespace
+
+TouchFilter::TouchFilter(const TouchFilterConfig &config) {
+    setConfig(config);
+}
+
+void TouchFilter::setConfig(const TouchFilterConfig &config) {
+    config_ = config;
+    if (config_.burst_samples < 1) config_.burst_samples = 1;
+    if (config_.burst_samples > MAX_BURST) config_.burst_samples = MAX_BURST;
+    if (config_.release_threshold < 1) config_.release_threshold = 1;
+    if (config_.press_threshold < config_.release_threshold) {
+        config_.press_threshold = config_.release_threshold;
+    }
+    if (config_.iir_alpha_q8 == 0) config_.iir_alpha_q8 = 1;
+    if (config_.min_alpha_q8 == 0) config_.min_alpha_q8 = 1;
+    pressed_ = false;
+    reset();
+}
+
+bool TouchFilter::updatePressure(uint16_t pressure) {
+    if (pressed_) {
+        pressed_ = pressure >= config_.release_threshold;
+    } else {
+        pressed_ = pressure >= config_.press_threshold;
+    }
+    if (!pressed_) {
+        reset();
+    }
+    return pressed_;
+}
+
+uint16_t TouchFilter::median(uint16_t *samples, uint8_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    // Insertion sort: no máximo MAX_BURST elementos
+    for (uint8_t i = 1; i < count; ++i) {
+        uint16_t value = samples[i];
+        uint8_t j = i;
+        while (j > 0 && samples[j - 1] > value) {
+            samples[j] = samples[j - 1];
+            --j;
+        }
+        samples[j] = value;
+    }
+    return samples[count / 2];
+}
+
+void TouchFilter::filter(uint16_t &x, uint16_t &y) {
+    if (!primed_) {
+        axis_x_ = Axis{static_cast<int32_t>(x) << Q4_SHIFT, 0, static_cast<int32_t>(x) << Q4_SHIFT};
+        axis_y_ = Axis{static_cast<int32_t>(y) << Q4_SHIFT, 0, static_cast<int32_t>(y) << Q4_SHIFT};
+        primed_ = true;
+        return;
+    }
+    x = filterAxis(axis_x_, x);
+    y = filterAxis(axis_y_, y);
+}
+
+void TouchFilter::reset() {
+    axis_x_ = {};
+    axis_y_ = {};
+    primed_ = false;
+}
+
+uint16_t TouchFilter::filterAxis(Axis &axis, uint16_t raw) const {
+    const int32_t raw_q4 = static_cast<int32_t>(raw) << Q4_SHIFT;
+    const int32_t delta = raw_q4 - axis.value_q4;
+
+    int32_t alpha = ALPHA_ONE_Q8;
+    switch (config_.smoothing) {
+    case TouchFilterConfig::Smoothing::None:
+        break;
+    case TouchFilterConfig::Smoothing::Iir:
+        alpha = config_.iir_alpha_q8;
+        break;
+    case TouchFilterConfig::Smoothing::OneEuro: {
+        // Parado: alpha baixo (remove jitter); rápido: alpha alto (remove atraso)
+        axis.speed_q4 += ((delta - axis.speed_q4) * SPEED_ALPHA_Q8) >> 8;
+        const int32_t speed = axis.speed_q4 < 0 ? -axis.speed_q4 : axis.speed_q4;
+        alpha = config_.min_alpha_q8 + ((speed * config_.beta_q8) >> Q4_SHIFT);
+        if (alpha > ALPHA_ONE_Q8) alpha = ALPHA_ONE_Q8;
+        break;
+    }
+    }
+    axis.value_q4 += (delta * alpha) >> 8;
+
+    // Dead-band com folga: a saída só se move quando o valor sai da banda
+    const int32_t band_q4 = static_cast<int32_t>(config_.dead_band) << Q4_SHIFT;
+    const int32_t diff = axis.value_q4 - axis.output_q4;
+    if (diff > band_q4) {
+        axis.output_q4 = axis.value_q4 - band_q4;
+    } else if (diff < -band_q4) {
+        axis.output_q4 = axis.value_q4 + band_q4;
+    }
+
+    int32_t out = (axis.output_q4 + (1 << (Q4_SHIFT - 1))) >> Q4_SHIFT;
+    if (out < 0) out = 0;
+    if (out > RAW_MAX) out = RAW_MAX;
+    return static_cast<uint16_t>(out);
+}
@@ -1,47 +1,18 @@
 #include "Xpt2046Bitbang.hpp"
 
-#include "esp_log.h"
-
-static const char *TAG = "XPT2046_BB";
-
-Xpt2046Bitbang::Xpt2046Bitbang(gpio_num_t mosi,
-                               gpio_num_t miso,
-                               gpio_num_t clk,
-                               gpio_num_t cs,
+Xpt2046Bitbang::Xpt2046Bitbang(Xpt2046Transport &transport,
                                uint16_t screenWidth,
                                uint16_t screenHeight)
-    : mosi_(mosi),
-      miso_(miso),
-      clk_(clk),
-      cs_(cs),
+    : transport_(transport),
       width_(screenWidth),
       height_(screenHeight),
       cal_{0, 4095, 0, 4095},
       invert_x_(false),
-      invert_y_(false) {}
+      invert_y_(false),
+      filter_() {}
 
 void Xpt2046Bitbang::begin() {
-    gpio_config_t cfg = {};
-    cfg.mode = GPIO_MODE_OUTPUT;
-    cfg.pin_bit_mask = BIT64(mosi_) | BIT64(clk_) | BIT64(cs_);
-    ESP_ERROR_CHECK(gpio_config(&cfg));
-
-    cfg.mode = GPIO_MODE_INPUT;
-    cfg.pin_bit_mask = BIT64(miso_);
-    cfg.pull_up_en = GPIO_PULLUP_DISABLE;
-    cfg.pull_down_en = GPIO_PULLDOWN_DISABLE;
-    ESP_ERROR_CHECK(gpio_config(&cfg));
-
-    esp_rom_gpio_pad_select_gpio(mosi_);
-    esp_rom_gpio_pad_select_gpio(miso_);
-    esp_rom_gpio_pad_select_gpio(clk_);
-    esp_rom_gpio_pad_select_gpio(cs_);
-
-    gpio_set_level(cs_, 1);
-    gpio_set_level(clk_, 0);
-
-    ESP_LOGI(TAG, "XPT2046 bit-bang inicializado (MOSI=%d MISO=%d CLK=%d CS=%d)",
-             mosi_, miso_, clk_, cs_);
+    transport_.begin();
 }
 
 void Xpt2046Bitbang::setCalibration(uint16_t xMin, uint16_t xMax,
@@ -54,48 +25,66 @@ void Xpt2046Bitbang::setInversion(bool invertX, bool invertY) {
     invert_y_ = invertY;
 }
 
-void Xpt2046Bitbang::writeSpi(uint8_t command) {
-    for (int i = 7; i >= 0; --i) {
-        gpio_set_level(mosi_, (command >> i) & 0x01);
-        gpio_set_level(clk_, 0);
-        esp_rom_delay_us(DELAY_US);
-        gpio_set_level(clk_, 1);
-        esp_rom_delay_us(DELAY_US);
-    }
-    gpio_set_level(mosi_, 0);
-    gpio_set_level(clk_, 0);
+void Xpt2046Bitbang::setFilterConfig(const TouchFilterConfig &config) {
+    filter_.setConfig(config);
 }
 
-uint16_t Xpt2046Bitbang::readSpi(uint8_t command) {
-    writeSpi(command);
+uint16_t Xpt2046Bitbang::transfer(uint8_t command) {
+    // Comando MSB primeiro: MOSI muda com CLK baixo, o chip amostra na borda de subida
+    for (int i = 7; i >= 0; --i) {
+        transport_.setMosi((command >> i) & 0x01);
+        transport_.setClk(false);
+        transport_.delayHalfPeriod();
+        transport_.setClk(true);
+        transport_.delayHalfPeriod();
+    }
+    transport_.setMosi(false);
+    transport_.setClk(false);
+    transport_.delayHalfPeriod();
 
+    // 16 clocks de leitura: o chip muda DOUT na borda de descida, lido com CLK baixo
     uint16_t result = 0;
     for (int i = 15; i >= 0; --i) {
-        gpio_set_level(clk_, 1);
-        esp_rom_delay_us(DELAY_US);
-        gpio_set_level(clk_, 0);
-        esp_rom_delay_us(DELAY_US);
-        result |= static_cast<uint16_t>(gpio_get_level(miso_)) << i;
+        transport_.setClk(true);
+        transport_.delayHalfPeriod();
+        transport_.setClk(false);
+        transport_.delayHalfPeriod();
+        if (transport_.readMiso()) {
+            result |= static_cast<uint16_t>(1U << i);
+        }
     }
-    return result >> 4;
+    return result;
+}
+
+uint16_t Xpt2046Bitbang::readSpi(uint8_t command) {
+    return transfer(command) >> 4;
 }
 
 TouchPoint Xpt2046Bitbang::getTouch() {
-    gpio_set_level(cs_, 0);
+    transport_.setCs(false);
 
     uint16_t z1 = readSpi(CMD_READ_Z1);
     uint16_t z2 = readSpi(CMD_READ_Z2);
     uint16_t pressure = (z1 + 4095) - z2;
 
-    if (pressure < 100) {
-        ESP_LOGV(TAG, "touch release: z1=%u z2=%u pressure=%u", z1, z2, pressure);
-        gpio_set_level(cs_, 1);
+    // Histerese: limiar de press maior que o de release evita press/release alternados
+    if (!filter_.updatePressure(pressure)) {
+        transport_.setCs(true);
         return TouchPoint{0, 0, 0, 0, 0};
     }
 
-    uint16_t rawX_original = readSpi(CMD_READ_X);
-    uint16_t rawY_original = readSpi(CMD_READ_Y & ~static_cast<uint8_t>(1));
-    gpio_set_level(cs_, 1);
+    // Burst de leituras combinadas por mediana (remove picos isolados)
+    uint16_t samplesX[TouchFilter::MAX_BURST];
+    uint16_t samplesY[TouchFilter::MAX_BURST];
+    const uint8_t burst = filter_.burstSamples();
+    for (uint8_t i = 0; i < burst; ++i) {
+        samplesX[i] = readSpi(CMD_READ_X);
+        samplesY[i] = readSpi(CMD_READ_Y & ~static_cast<uint8_t>(1));
+    }
+    transport_.setCs(true);
+
+    uint16_t rawX_original = TouchFilter::median(samplesX, burst);
+    uint16_t rawY_original = TouchFilter::median(samplesY, burst);
 
     // Salvar valores RAW originais (para calibração)
     uint16_t rawX = rawX_original;
@@ -111,8 +100,8 @@ TouchPoint Xpt2046Bitbang::getTouch() {
         rawY = XPT2046_MAX_RAW - rawY;
     }
 
-    ESP_LOGD(TAG, "touch raw data: z1=%u z2=%u pressure=%u rawX=%u rawY=%u (original: %u,%u)",
-             z1, z2, pressure, rawX, rawY, rawX_original, rawY_original);
+    // Suavização (IIR/one-euro) e dead-band no domínio RAW
+    filter_.filter(rawX, rawY);
 
     int32_t x = mapValue(rawX, cal_.xMin, cal_.xMax, 0, width_);
     int32_t y = mapValue(rawY, cal_.yMin, cal_.yMax, 0, height_);
@@ -137,7 +126,3 @@ int32_t Xpt2046Bitbang::mapValue(int32_t val, int32_t inMin, int32_t inMax,
     }
     return (val - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
 }
-
-
-
-
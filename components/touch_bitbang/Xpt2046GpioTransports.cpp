@@ -0,0 +1,144 @@
+#include "Xpt2046GpioTransports.hpp"
+
+#include "esp_cpu.h"
+#include "esp_rom_gpio.h"
+#include "esp_rom_sys.h"
+#include "soc/gpio_struct.h"
+
+void xpt2046ConfigurePins(const Xpt2046Pins &pins) {
+    gpio_config_t cfg = {};
+    cfg.mode = GPIO_MODE_OUTPUT;
+    cfg.pin_bit_mask = BIT64(pins.mosi) | BIT64(pins.clk) | BIT64(pins.cs);
+    ESP_ERROR_CHECK(gpio_config(&cfg));
+
+    cfg.mode = GPIO_MODE_INPUT;
+    cfg.pin_bit_mask = BIT64(pins.miso);
+    cfg.pull_up_en = GPIO_PULLUP_DISABLE;
+    cfg.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    ESP_ERROR_CHECK(gpio_config(&cfg));
+
+    esp_rom_gpio_pad_select_gpio(pins.mosi);
+    esp_rom_gpio_pad_select_gpio(pins.miso);
+    esp_rom_gpio_pad_select_gpio(pins.clk);
+    esp_rom_gpio_pad_select_gpio(pins.cs);
+
+    gpio_set_level(pins.cs, 1);
+    gpio_set_level(pins.clk, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Xpt2046GpioTransport
+// ---------------------------------------------------------------------------
+
+Xpt2046GpioTransport::Xpt2046GpioTransport(const Xpt2046Pins &pins)
+    : pins_(pins) {}
+
+void Xpt2046GpioTransport::begin() {
+    xpt2046ConfigurePins(pins_);
+}
+
+void Xpt2046GpioTransport::setCs(bool level) {
+    gpio_set_level(pins_.cs, level ? 1 : 0);
+}
+
+void Xpt2046GpioTransport::setClk(bool level) {
+    gpio_set_level(pins_.clk, level ? 1 : 0);
+}
+
+void Xpt2046GpioTransport::setMosi(bool level) {
+    gpio_set_level(pins_.mosi, level ? 1 : 0);
+}
+
+bool Xpt2046GpioTransport::readMiso() {
+    return gpio_get_level(pins_.miso) != 0;
+}
+
+void Xpt2046GpioTransport::delayHalfPeriod() {
+    esp_rom_delay_us(DELAY_US);
+}
+
+// ---------------------------------------------------------------------------
+// Xpt2046RegisterTransport
+// ---------------------------------------------------------------------------
+
+Xpt2046RegisterTransport::Xpt2046RegisterTransport(const Xpt2046Pins &pins, uint32_t clockHz)
+    : pins_(pins),
+      clock_hz_(clockHz) {}
+
+void Xpt2046RegisterTransport::begin() {
+    xpt2046ConfigurePins(pins_);
+    mosi_ = outputPin(pins_.mosi);
+    clk_ = outputPin(pins_.clk);
+    cs_ = outputPin(pins_.cs);
+    miso_ = inputPin(pins_.miso);
+    setClock(clock_hz_);
+}
+
+void Xpt2046RegisterTransport::setClock(uint32_t clockHz) {
+    if (clockHz == 0) {
+        clockHz = DEFAULT_CLOCK_HZ;
+    }
+    clock_hz_ = clockHz;
+    updateHalfPeriod();
+}
+
+void Xpt2046RegisterTransport::updateHalfPeriod() {
+    // Meio período em ciclos de CPU, arredondado para cima (nunca acima do clock alvo)
+    const uint64_t cpu_hz = static_cast<uint64_t>(esp_rom_get_cpu_ticks_per_us()) * 1000000ULL;
+    const uint64_t edge_hz = 2ULL * clock_hz_;
+    half_period_cycles_ = static_cast<uint32_t>((cpu_hz + edge_hz - 1) / edge_hz);
+}
+
+Xpt2046RegisterTransport::OutputPin Xpt2046RegisterTransport::outputPin(gpio_num_t pin) {
+    if (pin < 32) {
+        return OutputPin{&GPIO.out_w1ts, &GPIO.out_w1tc, 1U << pin};
+    }
+    return OutputPin{&GPIO.out1_w1ts.val, &GPIO.out1_w1tc.val, 1U << (pin - 32)};
+}
+
+Xpt2046RegisterTransport::InputPin Xpt2046RegisterTransport::inputPin(gpio_num_t pin) {
+    if (pin < 32) {
+        return InputPin{&GPIO.in, 1U << pin};
+    }
+    return InputPin{&GPIO.in1.val, 1U << (pin - 32)};
+}
+
+inline void Xpt2046RegisterTransport::write(const OutputPin &pin, bool level) {
+    if (level) {
+        *pin.set = pin.mask;
+    } else {
+        *pin.clear = pin.mask;
+    }
+}
+
+void Xpt2046RegisterTransport::setCs(bool level) {
+    if (!level) {
+        // Início de quadro: acompanha o clock atual da CPU e ressincroniza as bordas
+        updateHalfPeriod();
+        edge_ = esp_cpu_get_cycle_count();
+    }
+    write(cs_, level);
+}
+
+void Xpt2046RegisterTransport::setClk(bool level) {
+    write(clk_, level);
+}
+
+void Xpt2046RegisterTransport::setMosi(bool level) {
+    write(mosi_, level);
+}
+
+bool Xpt2046RegisterTransport::readMiso() {
+    return (*miso_.in & miso_.mask) != 0;
+}
+
+void Xpt2046RegisterTransport::delayHalfPeriod() {
+    const uint32_t now = esp_cpu_get_cycle_count();
+    if (static_cast<int32_t>(now - edge_) > static_cast<int32_t>(half_period_cycles_)) {
+        // Atrasado mais de meio período (pausa, preempção): conta a partir de agora
+        edge_ = now;
+    }
+    edge_ += half_period_cycles_;
+    while (static_cast<int32_t>(esp_cpu_get_cycle_count() - edge_) < 0) {
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Parâmetros do pipeline de filtragem do touch resistivo.
+ *
+ * Todas as grandezas de posição estão em unidades RAW do XPT2046 (0–4095);
+ * coeficientes de suavização estão em Q8 (256 = 1,0).
+ */
+struct TouchFilterConfig {
+    enum class Smoothing : uint8_t {
+        None,     ///< Apenas mediana + dead-band
+        Iir,      ///< Passa-baixa de primeira ordem com alpha fixo
+        OneEuro,  ///< Alpha adaptativo à velocidade (one-euro para taxa fixa)
+    };
+
+    uint8_t burst_samples = 5;        ///< Leituras X/Y por amostra, combinadas por mediana (1..MAX_BURST)
+    uint16_t press_threshold = 100;   ///< Pressão mínima para iniciar um toque
+    uint16_t release_threshold = 60;  ///< Abaixo disto um toque em andamento é encerrado
+    Smoothing smoothing = Smoothing::OneEuro;
+    uint8_t iir_alpha_q8 = 96;        ///< Iir: peso da amostra nova
+    uint8_t min_alpha_q8 = 48;        ///< OneEuro: peso da amostra nova com o dedo parado
+    uint8_t beta_q8 = 4;              ///< OneEuro: ganho de alpha por unidade RAW/amostra de velocidade
+    uint16_t dead_band = 12;          ///< Variação RAW absorvida antes de mover a saída (~1 px)
+};
+
+/**
+ * @brief Filtro de amostras do XPT2046 em ponto fixo, sem alocação.
+ *
+ * Etapas: mediana do burst de leituras, histerese de pressão (press/release),
+ * suavização IIR ou one-euro e dead-band com folga (a saída acompanha o
+ * movimento descontando a banda, sem degraus). O estado é reiniciado a cada
+ * novo toque, então o primeiro ponto não herda atraso do toque anterior.
+ * Não depende do ESP-IDF.
+ */
+class TouchFilter {
+public:
+    static constexpr uint8_t MAX_BURST = 7;
+
+    explicit TouchFilter(const TouchFilterConfig &config = TouchFilterConfig{});
+
+    /**
+     * @brief Substitui a configuração (valores fora da faixa são ajustados) e reinicia o estado.
+     */
+    void setConfig(const TouchFilterConfig &config);
+    const TouchFilterConfig &config() const { return config_; }
+
+    /**
+     * @brief Quantidade de leituras X/Y que o chamador deve fazer por amostra.
+     */
+    uint8_t burstSamples() const { return config_.burst_samples; }
+
+    /**
+     * @brief Aplica a histerese de pressão.
+     * @return true se o toque está (ou continua) pressionado.
+     */
+    bool updatePressure(uint16_t pressure);
+    bool pressed() const { return pressed_; }
+
+    /**
+     * @brief Mediana de até MAX_BURST leituras (reordena o vetor).
+     */
+    static uint16_t median(uint16_t *samples, uint8_t count);
+
+    /**
+     * @brief Suaviza um ponto RAW já combinado pela mediana (entrada e saída).
+     */
+    void filter(uint16_t &x, uint16_t &y);
+
+    /**
+     * @brief Esquece o histórico de posição (próximo ponto é usado como está).
+     */
+    void reset();
+
+private:
+    struct Axis {
+        int32_t value_q4;   ///< Saída do IIR/one-euro
+        int32_t speed_q4;   ///< Velocidade suavizada (one-euro)
+        int32_t output_q4;  ///< Saída após dead-band
+    };
+
+    uint16_t filterAxis(Axis &axis, uint16_t raw) const;
+
+    TouchFilterConfig config_;
+    Axis axis_x_ = {};
+    Axis axis_y_ = {};
+    bool pressed_ = false;
+    bool primed_ = false;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "driver/gpio.h"
+#include "Xpt2046Transport.hpp"
+#include <cstdint>
+
+struct Xpt2046Pins {
+    gpio_num_t mosi;
+    gpio_num_t miso;
+    gpio_num_t clk;
+    gpio_num_t cs;
+};
+
+/**
+ * @brief Transporte original: gpio_set_level()/gpio_get_level() e meio período
+ * fixo de DELAY_US via esp_rom_delay_us(). Mantido como fallback.
+ */
+class Xpt2046GpioTransport final : public Xpt2046Transport {
+public:
+    explicit Xpt2046GpioTransport(const Xpt2046Pins &pins);
+
+    void begin() override;
+    void setCs(bool level) override;
+    void setClk(bool level) override;
+    void setMosi(bool level) override;
+    bool readMiso() override;
+    void delayHalfPeriod() override;
+
+private:
+    static constexpr uint32_t DELAY_US = 2;
+
+    Xpt2046Pins pins_;
+};
+
+/**
+ * @brief Transporte rápido: escrita direta em GPIO.out_w1ts/out_w1tc (e
+ * out1_* para GPIO >= 32), leitura direta de GPIO.in/in1 e bordas agendadas
+ * pelo contador de ciclos da CPU a partir do clock alvo.
+ *
+ * delayHalfPeriod() marca cada borda em relação à anterior (não "escrita +
+ * atraso"), de modo que o custo das escritas e das chamadas virtuais não
+ * alonga o período enquanto couber em meio período; depois de uma pausa maior
+ * (entre quadros) a contagem é ressincronizada.
+ *
+ * O meio período em ciclos é recalculado de esp_rom_get_cpu_ticks_per_us() a
+ * cada seleção do chip (setCs(false)), então continua correto se o clock da
+ * CPU mudar entre leituras. Hoje o firmware roda com CONFIG_PM_ENABLE
+ * desligado (CPU fixa em 160 MHz); com DFS ligado, uma troca de frequência no
+ * meio de um quadro ainda alteraria aquele quadro.
+ */
+class Xpt2046RegisterTransport final : public Xpt2046Transport {
+public:
+    static constexpr uint32_t DEFAULT_CLOCK_HZ = 2000000; // XPT2046 aceita até 2,5 MHz
+
+    Xpt2046RegisterTransport(const Xpt2046Pins &pins, uint32_t clockHz = DEFAULT_CLOCK_HZ);
+
+    void begin() override;
+    void setCs(bool level) override;
+    void setClk(bool level) override;
+    void setMosi(bool level) override;
+    bool readMiso() override;
+    void delayHalfPeriod() override;
+
+    void setClock(uint32_t clockHz);
+    uint32_t clockHz() const { return clock_hz_; }
+    uint32_t halfPeriodCycles() const { return half_period_cycles_; }
+
+private:
+    struct OutputPin {
+        volatile uint32_t *set;
+        volatile uint32_t *clear;
+        uint32_t mask;
+    };
+    struct InputPin {
+        volatile uint32_t *in;
+        uint32_t mask;
+    };
+
+    static OutputPin outputPin(gpio_num_t pin);
+    static InputPin inputPin(gpio_num_t pin);
+    static void write(const OutputPin &pin, bool level);
+    void updateHalfPeriod();
+
+    Xpt2046Pins pins_;
+    uint32_t clock_hz_;
+    uint32_t half_period_cycles_ = 0;
+    uint32_t edge_ = 0;  ///< Contador de ciclos da última borda agendada
+    OutputPin mosi_ = {};
+    OutputPin clk_ = {};
+    OutputPin cs_ = {};
+    InputPin miso_ = {};
+};
+
+/**
+ * @brief Configuração de pinos comum aos dois transportes.
+ */
+void xpt2046ConfigurePins(const Xpt2046Pins &pins);
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @brief Camada física do XPT2046 no nível de pino (CS, CLK, MOSI, MISO).
+ *
+ * O protocolo (byte de comando + 16 clocks de leitura) fica em
+ * Xpt2046Bitbang; o transporte só muda níveis e espera meio período. Assim a
+ * implementação dos pinos (gpio_set_level, registradores) pode ser trocada, e
+ * um mock no host consegue registrar e verificar a forma de onda gerada.
+ * Não depende do ESP-IDF.
+ */
+class Xpt2046Transport {
+public:
+    virtual ~Xpt2046Transport() = default;
+
+    /**
+     * @brief Configura os pinos e deixa CS alto e CLK baixo.
+     */
+    virtual void begin() = 0;
+
+    /**
+     * @brief Nível do CS (ativo em nível baixo: false seleciona o chip).
+     */
+    virtual void setCs(bool level) = 0;
+
+    virtual void setClk(bool level) = 0;
+    virtual void setMosi(bool level) = 0;
+    virtual bool readMiso() = 0;
+
+    /**
+     * @brief Espera meio período do clock SPI alvo desde a espera anterior.
+     */
+    virtual void delayHalfPeriod() = 0;
+};
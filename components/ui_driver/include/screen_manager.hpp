@@ -0,0 +1,143 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+/**
+ * @brief Telas gerenciadas pelo ScreenManager
+ */
+enum class ScreenId : uint8_t {
+    Calibration,
+    Question,
+    ThankYou,
+    Configuration,
+    Password,
+    WifiConfig,
+    WifiScan,
+    Input,
+    Brightness,
+    About,
+    Ota,
+    Count,
+};
+
+/**
+ * @brief Política de retenção de uma tela depois que ela deixa de ser a ativa
+ */
+enum class ScreenRetention : uint8_t {
+    Pinned,     ///< Construída uma vez e nunca descartada (tela principal)
+    Cached,     ///< Mantida no cache LRU enquanto couber no orçamento de heap
+    Transient,  ///< Descartada assim que outra tela é carregada
+};
+
+/**
+ * @brief Ganchos de ciclo de vida de uma tela
+ *
+ * Todos rodam no contexto do LVGL (task do LVGL ou com lvgl_lock()).
+ * O descritor deve ter duração estática: o gerenciador guarda o ponteiro.
+ */
+struct ScreenHooks {
+    const char *name;
+    ScreenRetention retention;
+    lv_obj_t *(*build)();   ///< Cria a tela sem carregá-la
+    void (*on_show)();      ///< Atualiza dados dinâmicos antes de cada exibição (opcional)
+    void (*on_release)();   ///< Zera os ponteiros do módulo para os filhos da tela (opcional)
+};
+
+/**
+ * @brief Estatísticas de uma tela (ou agregadas, em totals())
+ */
+struct ScreenStats {
+    uint32_t builds;          ///< Construções (primeira exibição ou após descarte)
+    uint32_t cache_hits;      ///< Exibições servidas por uma tela já construída
+    uint32_t evictions;       ///< Descartes por orçamento de heap ou por ser transitória
+    uint32_t last_build_us;   ///< Duração da última construção
+    uint32_t max_build_us;    ///< Maior duração de construção
+    uint64_t total_build_us;  ///< Soma das durações de construção
+    uint32_t heap_bytes;      ///< Memória (heap + slabs do LVGL) da tela construída (0 se não residente)
+};
+
+/**
+ * @brief Dono de todas as telas da UI
+ *
+ * Constrói cada tela sob demanda na primeira exibição e a mantém conforme a
+ * política de retenção. Telas Cached ficam residentes enquanto a soma do heap
+ * medido na construção couber no orçamento; acima dele a menos usada
+ * recentemente (que não esteja ativa) é descartada. Assim as telas visitadas
+ * com frequência abrem sem reconstrução e sem o ciclo create/delete que
+ * fragmenta o heap.
+ *
+ * Não há invalidação por mudança de dados: toda tela retida que mostra dados
+ * mutáveis (WiFi salvo, brilho, Sobre, senha) os relê em on_show, que roda a
+ * cada exibição; reconstruir a tela só repetiria esse trabalho com alocação.
+ *
+ * Métodos devem ser chamados no contexto do LVGL ou fora de qualquer
+ * lvgl_lock() (o lock é tomado internamente).
+ */
+class ScreenManager {
+public:
+    static constexpr size_t DEFAULT_HEAP_BUDGET = 32 * 1024;
+
+    static ScreenManager &instance();
+
+    /**
+     * @brief Exibe a tela, construindo-a se necessário
+     *
+     * Executa on_show, carrega a tela e descarta as transitórias que deixaram
+     * de estar ativas e as Cached que excederem o orçamento.
+     *
+     * @return Objeto da tela ou nullptr se a construção falhou
+     */
+    lv_obj_t *show(ScreenId id, const ScreenHooks &hooks);
+
+    /**
+     * @brief Tela construída (nullptr se não residente)
+     */
+    lv_obj_t *get(ScreenId id) const;
+
+    /**
+     * @brief Indica se a tela é a ativa no display (requer contexto do LVGL)
+     */
+    bool is_active(ScreenId id) const;
+
+    /**
+     * @brief Descarta a tela já (deleção assíncrona, segura dentro dos seus eventos)
+     */
+    void release(ScreenId id);
+
+    void set_heap_budget(size_t bytes);
+    size_t heap_budget() const { return heap_budget_; }
+
+    /**
+     * @brief Heap ocupado pelas telas Cached residentes
+     */
+    size_t cached_bytes() const;
+
+    ScreenStats stats(ScreenId id) const;
+    ScreenStats totals() const;
+
+private:
+    static constexpr size_t SCREEN_COUNT = static_cast<size_t>(ScreenId::Count);
+
+    struct Entry {
+        const ScreenHooks *hooks = nullptr;
+        lv_obj_t *screen = nullptr;
+        uint32_t last_used = 0;
+        ScreenStats stats = {};
+    };
+
+    ScreenManager() = default;
+
+    bool build(Entry &entry);
+    void drop(Entry &entry);
+    void enforce_budget(const Entry *keep);
+
+    Entry entries_[SCREEN_COUNT];
+    uint32_t use_clock_ = 0;
+    size_t heap_budget_ = DEFAULT_HEAP_BUDGET;
+};
+
+} // namespace ui
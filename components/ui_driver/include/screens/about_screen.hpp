@@ -15,9 +15,4 @@ extern std::function<void()> about_on_back_callback;
  */
 void show_about_screen();
 
-/**
- * @brief Limpa a tela "Sobre"
- */
-void cleanup_about_screen();
-
 } // namespace ui::screens
@@ -8,7 +8,6 @@ namespace screens {
 // Callback para voltar (definido externamente)
 extern void (*on_back_callback)();
 
-void create_wifi_config_screen();
 void show_wifi_config_screen();
 void destroy_wifi_config_screen();
 
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "esp_err.h"
+#include "frame_time.hpp"
+#include "ota_driver.hpp"
+#include "sdkconfig.h"
+#include <cstdint>
+
+namespace ui::background_ota {
+
+/**
+ * @brief Quando procurar, quão rápido baixar e quando aplicar
+ */
+struct Config {
+    const char *url;            ///< Servidor OTA (o mesmo da tela de atualização)
+    uint32_t check_interval_s;  ///< Entre consultas ao manifesto
+    uint32_t max_bytes_per_s;   ///< Teto do download em segundo plano
+    int8_t quiet_hour;          ///< Hora local (0-23) em que pode aplicar; -1 desliga
+    uint16_t idle_minutes;      ///< Aplica após N minutos sem toque em qualquer hora; 0 desliga
+    const char *timezone;       ///< TZ POSIX da hora local (relógio via SNTP)
+    bool auto_apply;            ///< false: a imagem fica pronta até o operador abrir a tela de atualização
+};
+
+#ifdef CONFIG_HUB_BACKGROUND_OTA_AUTO_APPLY
+constexpr bool AUTO_APPLY = true;
+#else
+constexpr bool AUTO_APPLY = false;
+#endif
+
+/// Consulta a cada 6 h, baixa a 48 KB/s e, com CONFIG_HUB_BACKGROUND_OTA_AUTO_APPLY, aplica às 3 h
+/// (horário de Brasília) ou após 45 min sem toque
+constexpr Config DEFAULT_CONFIG = {
+    ota::DEFAULT_URL, 6 * 60 * 60, 48 * 1024, 3, 45, "<-03>3", AUTO_APPLY,
+};
+
+enum class State : uint8_t {
+    Idle,         ///< Nada novo no servidor (ou ainda não consultou)
+    Downloading,
+    Staged,       ///< Imagem conferida no slot inativo, esperando a janela (ou o operador)
+    Applying,
+    Failed,       ///< Última tentativa falhou; repete na próxima consulta
+    Disabled,     ///< Compilado sem CONFIG_HUB_BACKGROUND_OTA
+};
+
+struct Status {
+    State state;
+    int progress;                  ///< % do download corrente (em passos de 10)
+    esp_err_t last_error;
+    char version[32];              ///< Versão preparada
+    uint32_t download_ms;          ///< Duração do último download
+    FrameTimeStats frames_before;  ///< Quadros da UI na janela antes do último download
+    FrameTimeStats frames_during;  ///< Quadros da UI durante o último download
+};
+
+/**
+ * @brief Cria o task de atualização em segundo plano (chamar após o WiFi iniciar)
+ *
+ * Só com CONFIG_HUB_BACKGROUND_OTA (desligado por padrão); sem ele não faz nada.
+ * O task roda com prioridade mínima no core 0 (o LVGL fica no core 1) e
+ * baixa com o teto de vazão de config; a tela de perguntas continua
+ * atendendo durante todo o download. Com auto_apply a imagem é aplicada
+ * (reinício) na janela configurada e com a tela parada, para não cortar uma
+ * avaliação; sem ele fica no slot até o operador abrir a tela de atualização.
+ */
+void start(const Config &config = DEFAULT_CONFIG);
+
+Status status();
+
+const char *state_name(State state);
+
+} // namespace ui::background_ota
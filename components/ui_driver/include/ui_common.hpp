@@ -21,6 +21,7 @@ constexpr int32_t HEADER_HEIGHT = 40;
 constexpr int32_t BUTTON_HEIGHT = 38;
 constexpr int32_t BUTTON_RADIUS = 8;
 constexpr int32_t INPUT_HEIGHT = 40;
+constexpr int32_t RATING_BUTTON_SIZE = 66;  // Botões circulares da tela de avaliação
 
 // Cores padrão (funções inline para evitar problemas com constexpr)
 inline lv_color_t COLOR_BG_WHITE() { return lv_color_hex(0xFFFFFF); }
@@ -58,7 +59,7 @@ constexpr const char* RATING_MESSAGES[] = {
     "Muito Satisfeito",
 };
 
-// Funções auxiliares de estilo e criação de widgets
+// Funções auxiliares de estilo e criação de widgets (estilos compartilhados de ui::theme)
 void apply_common_label_style(lv_obj_t* label);
 void apply_common_button_style(lv_obj_t* button);
 void apply_screen_style(lv_obj_t* screen);
@@ -1,10 +1,10 @@
 #pragma once
 
+// lvgl_lock()/lvgl_unlock(): lock único do LVGL, definido no display_driver
+#include "lvgl_lock.hpp"
+
 // Funções internas do ui_driver exportadas para uso em screens
-void lvgl_lock();
-void lvgl_unlock();
 
 // Funções para resetar timeout automático
 void reset_password_timeout();
 void reset_config_timeout();
-
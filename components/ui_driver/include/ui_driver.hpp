@@ -8,15 +8,13 @@ namespace ui {
 /**
  * @brief Inicializa a aplicação de pesquisa de satisfação.
  *
+ * As transições de tela são dirigidas por eventos e timers do LVGL (rodam
+ * no task do LVGL); não há função de atualização periódica.
+ *
  * @param display Display retornado pelo driver.
  */
 void init(lv_display_t *display);
 
-/**
- * @brief Atualiza a UI (chamado periodicamente no loop principal).
- */
-void update();
-
 /**
  * @brief Obtém a avaliação atual selecionada (0 = nenhuma, 1-5 = avaliação).
  */
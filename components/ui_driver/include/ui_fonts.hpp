@@ -0,0 +1,58 @@
+#pragma once
+
+#include "lvgl.h"
+#include <cstdint>
+
+namespace ui::fonts {
+
+/**
+ * @brief Estatísticas de consulta de glifos da fonte da UI
+ */
+struct GlyphLookupStats {
+    uint32_t lut_hits;       ///< Consultas resolvidas pela tabela direta (U+0000–U+00FF)
+    uint32_t fallbacks;      ///< Consultas delegadas ao lv_font_fmt_txt (code point >= 256)
+    uint16_t latin_glyphs;   ///< Glifos presentes na tabela direta
+};
+
+/**
+ * @brief Estatísticas do cache de bitmaps A8 decodificados
+ */
+struct GlyphCacheStats {
+    uint32_t hits;           ///< Bitmaps servidos do cache
+    uint32_t misses;         ///< Bitmaps decodificados (2 bpp -> A8)
+    uint32_t evictions;      ///< Entradas removidas por falta de orçamento
+    uint32_t uncached;       ///< Glifos decodificados fora do cache (grandes demais ou sem memória)
+    uint32_t bytes_used;     ///< Bytes ocupados pelo cache
+    uint32_t budget_bytes;   ///< Orçamento total do cache
+};
+
+/**
+ * @brief Registra a fonte da UI com tabela direta de glyph id para U+0000–U+00FF
+ *
+ * Copia o descritor da fonte Roboto e substitui get_glyph_dsc por uma versão
+ * que resolve code points < 256 (e o kerning entre eles) sem percorrer os
+ * cmaps. Demais code points caem no caminho padrão do LVGL.
+ *
+ * Os glifos são publicados como A8 e servidos de um cache LRU de bitmaps
+ * decodificados, de modo que o redesenho de texto em regime seja apenas
+ * o blend com máscara do lv_draw_sw_letter.
+ * Deve ser chamada antes de criar qualquer tela.
+ */
+void init();
+
+/**
+ * @brief Fonte Roboto com tabela direta (válida após init())
+ */
+const lv_font_t* roboto();
+
+/**
+ * @brief Obtém estatísticas de consulta de glifos
+ */
+GlyphLookupStats get_lookup_stats();
+
+/**
+ * @brief Obtém estatísticas do cache de bitmaps de glifos
+ */
+GlyphCacheStats get_cache_stats();
+
+} // namespace ui::fonts
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ui::jobs {
+
+/**
+ * @brief Job da fila: função sem captura e um argumento por valor
+ *
+ * O job é copiado para a fila (sem alocação); dados maiores que um
+ * uintptr_t devem ficar em armazenamento estático do módulo que posta.
+ */
+using JobFn = void (*)(uintptr_t arg);
+
+/**
+ * @brief Filas do serviço de UI
+ */
+enum class Lane : uint8_t {
+    Ui,      ///< Executa no task do LVGL, com o lock já tomado
+    Worker,  ///< Executa no worker de longa duração; pode bloquear (HTTP, WiFi)
+    Count,
+};
+
+/**
+ * @brief Métricas de uma fila
+ */
+struct LaneStats {
+    uint32_t posted;            ///< Jobs aceitos
+    uint32_t executed;          ///< Jobs executados
+    uint32_t dropped;           ///< Jobs recusados por fila cheia
+    uint32_t depth;             ///< Jobs aguardando agora
+    uint32_t max_depth;         ///< Maior profundidade observada
+    uint32_t last_latency_us;   ///< Espera do último job (post até o início da execução)
+    uint32_t max_latency_us;    ///< Maior espera
+    uint64_t total_latency_us;  ///< Soma das esperas
+    uint32_t max_run_us;        ///< Maior duração de execução de um job
+};
+
+/**
+ * @brief Cria as filas, o worker e o timer de escoamento no LVGL
+ *
+ * Chamado por ui::init() antes de qualquer post; não tomar lvgl_lock() antes.
+ */
+void init();
+
+/**
+ * @brief Posta um job para o task do LVGL (equivalente a lv_async_call sem malloc)
+ *
+ * Pode ser chamado de qualquer task, inclusive do próprio LVGL. Não bloqueia.
+ *
+ * @return false se a fila estiver cheia ou o serviço não foi iniciado
+ */
+bool post(JobFn fn, uintptr_t arg = 0);
+
+/**
+ * @brief Posta um job bloqueante para o worker da UI
+ *
+ * O job roda fora do lock do LVGL; para atualizar a tela ele deve postar
+ * um job com post().
+ */
+bool post_worker(JobFn fn, uintptr_t arg = 0);
+
+LaneStats stats(Lane lane);
+
+} // namespace ui::jobs
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ui::telemetry {
+
+/**
+ * @brief Tasks com margem de pilha acompanhada
+ */
+enum class WatchedTask : uint8_t {
+    Lvgl,        ///< lvgl_timer (display_driver)
+    Brightness,  ///< brightness_task (display_driver)
+    Touch,       ///< touch_task (display_driver)
+    Main,        ///< main (app_main, suspenso após a inicialização)
+    Worker,      ///< ui_worker (envio ao Supabase, conexão WiFi)
+    Ota,         ///< ota_bg (atualização em segundo plano)
+    Count,
+};
+
+/// Margem de pilha desconhecida (task não encontrado)
+constexpr uint16_t STACK_UNKNOWN = UINT16_MAX;
+
+/**
+ * @brief Amostra de saúde da memória
+ */
+struct Sample {
+    uint32_t uptime_s;           ///< Segundos desde o boot
+    uint32_t internal_free;      ///< Heap interno livre
+    uint32_t internal_largest;   ///< Maior bloco livre do heap interno
+    uint32_t internal_min_free;  ///< Menor heap interno livre desde o boot
+    uint32_t dma_free;           ///< Heap DMA livre (buffers do display, SPI)
+    uint32_t dma_largest;        ///< Maior bloco DMA livre
+    uint8_t lvgl_used_pct;       ///< Ocupação dos slabs do LVGL (lv_mem_monitor)
+    uint8_t internal_frag_pct;   ///< 100 - maior bloco / livre, em %
+    uint16_t stack_free[static_cast<size_t>(WatchedTask::Count)];  ///< Menor pilha livre já vista, em bytes
+};
+
+/// Intervalo entre amostras do histórico (e da linha de log)
+constexpr uint32_t SAMPLE_PERIOD_S = 15 * 60;
+
+/// Amostras guardadas (24 h com o intervalo padrão)
+constexpr size_t HISTORY_LENGTH = 96;
+
+/**
+ * @brief Inicia a amostragem periódica (chamar após ui::jobs::init())
+ *
+ * A primeira amostra é tirada logo em seguida e serve de referência. A
+ * coleta roda no worker da UI, fora do lock do LVGL.
+ */
+void init();
+
+/**
+ * @brief Tira uma amostra agora, sem gravar no histórico
+ *
+ * Percorre o heap (heap_caps_get_info): evitar em caminhos quentes.
+ */
+Sample sample();
+
+/**
+ * @brief Amostras mais antiga e mais recente do histórico (tendência)
+ *
+ * @return false se ainda não há amostras
+ */
+bool history_bounds(Sample &oldest, Sample &newest);
+
+const char *task_name(WatchedTask task);
+
+} // namespace ui::telemetry
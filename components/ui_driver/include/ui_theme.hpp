@@ -0,0 +1,42 @@
+#pragma once
+
+#include "lvgl.h"
+
+namespace ui::theme {
+
+/**
+ * @brief Estilos compartilhados da UI
+ *
+ * Cada estilo é um lv_style_t estático inicializado uma vez e aplicado com
+ * lv_obj_add_style(). Ao contrário de lv_obj_set_style_*(), que cria uma
+ * entrada de estilo local por objeto, os objetos só guardam um ponteiro e a
+ * resolução das propriedades percorre uma lista fixa e curta. Propriedades
+ * que variam por objeto (cor de um botão, posição) continuam locais.
+ */
+
+/**
+ * @brief Inicializa os estilos (contexto do LVGL, antes de criar telas)
+ */
+void init();
+
+lv_style_t *screen();           ///< Fundo branco opaco
+lv_style_t *header();           ///< Barra superior com borda inferior
+lv_style_t *title();            ///< Título centralizado (TITLE_FONT)
+lv_style_t *text();             ///< Label padrão (TEXT_FONT)
+lv_style_t *caption();          ///< Texto secundário centralizado (CAPTION_FONT)
+
+lv_style_t *button();           ///< Base dos botões de texto (cor fica local)
+lv_style_t *button_label();     ///< Texto branco dos botões
+lv_style_t *button_label_small();  ///< Texto branco dos botões baixos (CAPTION_FONT)
+lv_style_t *action_button();    ///< Raio dos botões padrão (ação e Voltar)
+lv_style_t *compact_button();   ///< Raio dos botões compactos
+
+lv_style_t *rating_button(int index);  ///< Botão circular de avaliação (índice 0-4)
+lv_style_t *rating_label();     ///< Número dentro do botão de avaliação
+
+lv_style_t *icon_button();          ///< Botão redondo de ícone (configurações)
+lv_style_t *icon_button_pressed();  ///< Estado pressionado do botão de ícone
+lv_style_t *icon_label();           ///< Símbolo do LVGL (Montserrat 20)
+lv_style_t *icon_row();             ///< Fileira flex de botões de ícone
+
+} // namespace ui::theme
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ui::wifi_link {
+
+/**
+ * @brief Tempos da última conexão, medidos do início da tentativa
+ *
+ * A tentativa começa no boot (WiFiManager::init()) ou na queda da conexão;
+ * enquanto ela não chega ao primeiro envio, as avaliações não saem do aparelho.
+ */
+struct Metrics {
+    uint32_t connections;   ///< Conexões concluídas (IP obtido) desde o boot
+    uint32_t fallbacks;     ///< Vezes em que o cache falhou e a varredura completa assumiu
+    bool last_fast;         ///< A última conexão usou o BSSID/canal do cache
+    bool lease_reused;      ///< O DHCP devolveu o mesmo IP da conexão anterior
+    uint32_t associate_ms;  ///< Até associar ao AP
+    uint32_t ip_ms;         ///< Até o IP
+    uint32_t upload_ms;     ///< Até a primeira requisição ao Supabase concluída (0 = ainda não houve)
+};
+
+/**
+ * @brief Inicializa o WiFiManager tentando primeiro o AP da última conexão
+ *
+ * Substitui a chamada direta a WiFiManager::init(). Com BSSID e canal da
+ * última conexão no NVS (e a mesma rede configurada), a associação varre um
+ * único canal e vai direto ao AP; se ele não responder, o cache é descartado
+ * e a reconexão do WiFiManager segue com a varredura completa.
+ */
+void init();
+
+/// Chamado a cada requisição ao Supabase concluída (teste de conexão ou avaliação)
+void mark_upload();
+
+Metrics metrics();
+
+} // namespace ui::wifi_link
@@ -0,0 +1,196 @@
+#include "screen_manager.hpp"
+#include "ui_common_internal.hpp"
+
+#include "lvgl_mem.hpp"
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+namespace ui {
+
+namespace {
+constexpr char TAG[] = "SCREEN_MGR";
+} // namespace
+
+ScreenManager &ScreenManager::instance() {
+    static ScreenManager manager;
+    return manager;
+}
+
+bool ScreenManager::build(Entry &entry) {
+    // O LVGL aloca nos slabs (lvgl_mem) e, acima deles, no heap: o custo da tela
+    // é a queda do heap livre somada ao crescimento dos slabs durante a
+    // construção. Outros tasks podem alocar no meio, então é uma estimativa;
+    // valores negativos viram zero.
+    const size_t free_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    const size_t slab_before = lvgl_mem_slab_used_bytes();
+    const int64_t start_us = esp_timer_get_time();
+
+    entry.screen = entry.hooks->build();
+
+    const uint32_t elapsed_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    const size_t free_after = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    const size_t slab_after = lvgl_mem_slab_used_bytes();
+
+    if (entry.screen == nullptr) {
+        ESP_LOGE(TAG, "Falha ao construir tela %s", entry.hooks->name);
+        return false;
+    }
+
+    ScreenStats &stats = entry.stats;
+    stats.builds++;
+    stats.last_build_us = elapsed_us;
+    if (elapsed_us > stats.max_build_us) {
+        stats.max_build_us = elapsed_us;
+    }
+    stats.total_build_us += elapsed_us;
+    const int64_t cost = static_cast<int64_t>(free_before) - static_cast<int64_t>(free_after) +
+                         static_cast<int64_t>(slab_after) - static_cast<int64_t>(slab_before);
+    stats.heap_bytes = cost > 0 ? static_cast<uint32_t>(cost) : 0;
+
+    ESP_LOGI(TAG, "Tela %s construída em %lu us (%lu bytes)", entry.hooks->name,
+             static_cast<unsigned long>(elapsed_us), static_cast<unsigned long>(stats.heap_bytes));
+    return true;
+}
+
+void ScreenManager::drop(Entry &entry) {
+    if (entry.screen == nullptr) {
+        return;
+    }
+    if (entry.hooks->on_release != nullptr) {
+        entry.hooks->on_release();
+    }
+    // Assíncrono: a tela pode estar despachando o evento que provocou o descarte
+    lv_obj_delete_async(entry.screen);
+    entry.screen = nullptr;
+    entry.stats.heap_bytes = 0;
+}
+
+void ScreenManager::enforce_budget(const Entry *keep) {
+    lv_obj_t *active = lv_screen_active();
+    while (cached_bytes() > heap_budget_) {
+        Entry *victim = nullptr;
+        for (Entry &entry : entries_) {
+            if (entry.screen == nullptr || &entry == keep || entry.screen == active ||
+                entry.hooks->retention != ScreenRetention::Cached) {
+                continue;
+            }
+            if (victim == nullptr || entry.last_used < victim->last_used) {
+                victim = &entry;
+            }
+        }
+        if (victim == nullptr) {
+            return;
+        }
+        ESP_LOGI(TAG, "Descartando tela %s (orçamento de %u bytes excedido)", victim->hooks->name,
+                 static_cast<unsigned>(heap_budget_));
+        victim->stats.evictions++;
+        drop(*victim);
+    }
+}
+
+lv_obj_t *ScreenManager::show(ScreenId id, const ScreenHooks &hooks) {
+    const size_t index = static_cast<size_t>(id);
+    if (index >= SCREEN_COUNT) {
+        return nullptr;
+    }
+
+    lvgl_lock();
+
+    Entry &entry = entries_[index];
+    entry.hooks = &hooks;
+
+    if (entry.screen != nullptr) {
+        entry.stats.cache_hits++;
+    } else if (!build(entry)) {
+        lvgl_unlock();
+        return nullptr;
+    }
+
+    if (hooks.on_show != nullptr) {
+        hooks.on_show();
+    }
+
+    lv_obj_t *screen = entry.screen;
+    if (lv_screen_active() != screen) {
+        lv_screen_load(screen);
+    }
+    // Não usar lv_refr_now() aqui para evitar stack overflow na task lvgl_timer
+    lv_obj_invalidate(screen);
+    entry.last_used = ++use_clock_;
+
+    // Telas transitórias vivem apenas enquanto estão ativas
+    for (Entry &other : entries_) {
+        if (&other != &entry && other.screen != nullptr &&
+            other.hooks->retention == ScreenRetention::Transient) {
+            other.stats.evictions++;
+            drop(other);
+        }
+    }
+    enforce_budget(&entry);
+
+    lvgl_unlock();
+    return screen;
+}
+
+lv_obj_t *ScreenManager::get(ScreenId id) const {
+    const size_t index = static_cast<size_t>(id);
+    return index < SCREEN_COUNT ? entries_[index].screen : nullptr;
+}
+
+bool ScreenManager::is_active(ScreenId id) const {
+    lv_obj_t *screen = get(id);
+    return screen != nullptr && lv_screen_active() == screen;
+}
+
+void ScreenManager::release(ScreenId id) {
+    const size_t index = static_cast<size_t>(id);
+    if (index >= SCREEN_COUNT) {
+        return;
+    }
+
+    lvgl_lock();
+    drop(entries_[index]);
+    lvgl_unlock();
+}
+
+void ScreenManager::set_heap_budget(size_t bytes) {
+    lvgl_lock();
+    heap_budget_ = bytes;
+    enforce_budget(nullptr);
+    lvgl_unlock();
+}
+
+size_t ScreenManager::cached_bytes() const {
+    size_t total = 0;
+    for (const Entry &entry : entries_) {
+        if (entry.screen != nullptr && entry.hooks->retention == ScreenRetention::Cached) {
+            total += entry.stats.heap_bytes;
+        }
+    }
+    return total;
+}
+
+ScreenStats ScreenManager::stats(ScreenId id) const {
+    const size_t index = static_cast<size_t>(id);
+    return index < SCREEN_COUNT ? entries_[index].stats : ScreenStats{};
+}
+
+ScreenStats ScreenManager::totals() const {
+    ScreenStats total = {};
+    for (const Entry &entry : entries_) {
+        const ScreenStats &stats = entry.stats;
+        total.builds += stats.builds;
+        total.cache_hits += stats.cache_hits;
+        total.evictions += stats.evictions;
+        total.total_build_us += stats.total_build_us;
+        total.heap_bytes += stats.heap_bytes;
+        if (stats.max_build_us > total.max_build_us) {
+            total.max_build_us = stats.max_build_us;
+        }
+    }
+    return total;
+}
+
+} // namespace ui
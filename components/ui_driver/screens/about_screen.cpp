@@ -1,8 +1,15 @@
 #include "screens/about_screen.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp" // Para lvgl_lock() e lvgl_unlock()
+#include "screen_manager.hpp"
+#include "ui_jobs.hpp"
+#include "ui_telemetry.hpp"
+#include "ui_background_ota.hpp"
+#include "ui_wifi_link.hpp"
 #include "OtaManager.h"
 #include "WiFiManager.h"
+#include "display_driver.hpp"
+#include "lvgl_mem.hpp"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_mac.h"
@@ -14,11 +21,10 @@
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "lvgl.h"
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 
-// Declarar fonte Roboto customizada
-LV_FONT_DECLARE(roboto);
 // Declarar fonte Montserrat para ícones
 LV_FONT_DECLARE(lv_font_montserrat_20);
 
@@ -30,6 +36,64 @@ lv_obj_t* about_scroll = nullptr;
 
 // Versão do firmware (pode ser definida via menuconfig ou constante)
 constexpr const char* FIRMWARE_VERSION = "1.0.0";
+
+// Linhas de informação: a tela fica no cache e só os valores mudam a cada exibição
+enum AboutLine {
+    LINE_VERSION,
+    LINE_DEVICE_ID,
+    LINE_MAC,
+    LINE_HEAP,
+    LINE_BLOCK,
+    LINE_HEAP_MIN,
+    LINE_DMA,
+    LINE_STACKS,
+    LINE_MEM_TREND,
+    LINE_WIFI,
+    LINE_WIFI_TIMING,
+    LINE_CHIP,
+    LINE_FLASH,
+    LINE_UPTIME,
+    LINE_LATENCY_PRESS,
+    LINE_LATENCY_RATING,
+    LINE_LATENCY_KEYPAD,
+    LINE_LATENCY_KEYBOARD,
+    LINE_SCREEN_CACHE,
+    LINE_JOBS,
+    LINE_LVGL_LOCK,
+    LINE_LVGL_MEM,
+    LINE_OTA_BACKGROUND,
+    LINE_COUNT,
+};
+
+constexpr const char* ABOUT_LINE_LABELS[LINE_COUNT] = {
+    "Versão",
+    "Device ID",
+    "Endereço MAC",
+    "Memória Livre",
+    "Maior Bloco Livre",
+    "Memória Mínima Desde o Boot",
+    "Heap DMA (livre/maior bloco)",
+    "Pilha Livre (lvgl/brilho/touch/main/worker/ota)",
+    "Tendência (livre/maior bloco)",
+    "Status WiFi",
+    "Conexão WiFi (associar/IP/Supabase)",
+    "Chip",
+    "Memória Flash",
+    "Tempo de Atividade",
+    // Latência input-to-photon (leitura do touch até o fim do flush), em ms
+    "Latência Toque (p50/p95/máx)",
+    "Latência Avaliação (p50/p95/máx)",
+    "Latência Teclado Numérico (p50/p95/máx)",
+    "Latência Teclado (p50/p95/máx)",
+    "Cache de Telas (construções/acertos)",
+    "Jobs UI / Worker (espera média)",
+    "Lock LVGL (passadas atrasadas/perdidas)",
+    "Slabs LVGL (em uso/pico, heap)",
+    "OTA em Segundo Plano (quadro p95 antes/durante)",
+};
+
+char about_values[LINE_COUNT][64];
+lv_obj_t* about_value_labels[LINE_COUNT] = {nullptr};
 } // namespace
 
 namespace ui::screens {
@@ -38,94 +102,7 @@ std::function<void()> about_on_back_callback = nullptr;
 
 namespace ui::screens {
 
-void cleanup_about_screen() {
-    if (about_screen != nullptr) {
-        lvgl_lock();
-        
-        lv_obj_del(about_screen);
-        about_screen = nullptr;
-        about_scroll = nullptr;
-        
-        lvgl_unlock();
-    }
-}
-
-void show_about_screen() {
-    ESP_LOGI(TAG, "Mostrando tela Sobre");
-    
-    // Limpar tela anterior se existir
-    cleanup_about_screen();
-    
-    // OBTER TODAS AS INFORMAÇÕES DO SISTEMA ANTES DE ADQUIRIR O MUTEX LVGL
-    // Isso evita bloqueios durante operações pesadas
-    char info_buffer[128];
-    char device_id_buffer[64];
-    char mac_buffer[32];
-    char heap_buffer[64];
-    char block_buffer[64];
-    char chip_buffer[64];
-    char flash_buffer[64];
-    char uptime_buffer[32];
-    
-    // Device ID (pode ser pesado - fazer antes do lock)
-    auto& otaManager = OtaManager::instance();
-    otaManager.init(); // Garantir inicialização
-    snprintf(device_id_buffer, sizeof(device_id_buffer), "%s", otaManager.getDeviceId());
-    
-    // MAC Address
-    uint8_t mac[6];
-    esp_err_t mac_err = esp_read_mac(mac, ESP_MAC_WIFI_STA);
-    if (mac_err == ESP_OK) {
-        snprintf(mac_buffer, sizeof(mac_buffer), "%02X:%02X:%02X:%02X:%02X:%02X",
-                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-    } else {
-        snprintf(mac_buffer, sizeof(mac_buffer), "N/A");
-    }
-    
-    // Free heap
-    uint32_t free_heap = esp_get_free_heap_size();
-    snprintf(heap_buffer, sizeof(heap_buffer), "%lu bytes (%.1f KB)", 
-             (unsigned long)free_heap, free_heap / 1024.0f);
-    
-    // Largest free block
-    size_t largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
-    snprintf(block_buffer, sizeof(block_buffer), "%zu bytes (%.1f KB)",
-             largest_block, largest_block / 1024.0f);
-    
-    // WiFi Status
-    auto& wifi = WiFiManager::instance();
-    const char* wifi_status = wifi.is_connected() ? "Conectado" : "Desconectado";
-    
-    // Chip Info
-    esp_chip_info_t chip_info;
-    esp_chip_info(&chip_info);
-    snprintf(chip_buffer, sizeof(chip_buffer), "ESP32 Rev %d (%d cores)",
-             chip_info.revision, chip_info.cores);
-    
-    // Flash Size
-    uint32_t flash_size = 4 * 1024 * 1024;
-    #ifdef CONFIG_ESPTOOLPY_FLASHSIZE_4MB
-        flash_size = 4 * 1024 * 1024;
-    #elif defined(CONFIG_ESPTOOLPY_FLASHSIZE_2MB)
-        flash_size = 2 * 1024 * 1024;
-    #elif defined(CONFIG_ESPTOOLPY_FLASHSIZE_8MB)
-        flash_size = 8 * 1024 * 1024;
-    #endif
-    snprintf(flash_buffer, sizeof(flash_buffer), "%lu bytes (%.1f MB)",
-             (unsigned long)flash_size, flash_size / (1024.0f * 1024.0f));
-    
-    // Uptime
-    uint32_t uptime_sec = esp_timer_get_time() / 1000000ULL;
-    uint32_t hours = uptime_sec / 3600;
-    uint32_t minutes = (uptime_sec % 3600) / 60;
-    uint32_t seconds = uptime_sec % 60;
-    snprintf(uptime_buffer, sizeof(uptime_buffer), "%02lu:%02lu:%02lu",
-             (unsigned long)hours, (unsigned long)minutes, (unsigned long)seconds);
-    
-    // AGORA ADQUIRIR O MUTEX LVGL E CRIAR A UI RAPIDAMENTE
-    // IMPORTANTE: Manter o mutex pelo menor tempo possível
-    lvgl_lock();
-    
+static lv_obj_t* build_about_screen() {
     // Criar tela
     about_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(about_screen);
@@ -193,7 +170,7 @@ void show_about_screen() {
     
     // Função helper EMBELEZADA - cria label e valor separados com cores diferentes
     int32_t y_pos = PADDING_TOP + 45; // Posição inicial abaixo do título e separador
-    auto create_info_line = [&](const char* label, const char* value) {
+    auto create_info_line = [&](const char* label) {
         // Label (nome do campo) - cor cinza, fonte menor
         lv_obj_t* lbl = lv_label_create(about_scroll);
         lv_label_set_text(lbl, label);
@@ -205,7 +182,6 @@ void show_about_screen() {
         
         // Valor - cor preta, fonte normal, mais destacado
         lv_obj_t* val = lv_label_create(about_scroll);
-        lv_label_set_text(val, value);
         lv_obj_set_style_text_font(val, ::ui::common::TEXT_FONT, 0);
         lv_obj_set_style_text_color(val, ::ui::common::COLOR_TEXT_BLACK(), 0);
         lv_obj_set_width(val, 320 - (PADDING_HOR * 2));
@@ -215,20 +191,13 @@ void show_about_screen() {
         // Atualizar posição para próxima linha (label + gap + valor + espaçamento)
         y_pos += LINE_SPACING;
         
-        return lbl;
+        return val;
     };
     
-    // Criar todas as linhas rapidamente usando dados já preparados
-    snprintf(info_buffer, sizeof(info_buffer), "%s", FIRMWARE_VERSION);
-    create_info_line("Versão", info_buffer);
-    create_info_line("Device ID", device_id_buffer);
-    create_info_line("Endereço MAC", mac_buffer);
-    create_info_line("Memória Livre", heap_buffer);
-    create_info_line("Maior Bloco Livre", block_buffer);
-    create_info_line("Status WiFi", wifi_status);
-    create_info_line("Chip", chip_buffer);
-    create_info_line("Memória Flash", flash_buffer);
-    create_info_line("Tempo de Atividade", uptime_buffer);
+    // Criar todas as linhas; os valores são preenchidos em refresh_about_screen()
+    for (int line = 0; line < LINE_COUNT; ++line) {
+        about_value_labels[line] = create_info_line(ABOUT_LINE_LABELS[line]);
+    }
     
     // Adicionar padding no fim do conteúdo para não cortar o último item
     y_pos += 10; // Espaço extra após último item
@@ -247,16 +216,211 @@ void show_about_screen() {
     // Desabilitar animações no botão para melhor performance
     lv_obj_set_style_anim_time(back_button, 0, 0);
     
-    // Carregar tela ANTES de liberar mutex
-    lv_screen_load(about_screen);
+    return about_screen;
+}
+
+static void refresh_about_screen() {
+    for (int line = 0; line < LINE_COUNT; ++line) {
+        lv_label_set_text(about_value_labels[line], about_values[line]);
+    }
+    lv_obj_scroll_to_y(about_scroll, 0, LV_ANIM_OFF);
+}
+
+static void release_about_screen() {
+    about_screen = nullptr;
+    about_scroll = nullptr;
+    std::fill(std::begin(about_value_labels), std::end(about_value_labels), nullptr);
+}
+
+static const ScreenHooks ABOUT_SCREEN = {
+    "sobre", ScreenRetention::Cached,
+    build_about_screen, refresh_about_screen, release_about_screen,
+};
+
+// Coleta as informações do sistema no task do LVGL, no clique que abre a tela
+// (com o lock tomado): uma amostra de telemetria e leituras de estado por abertura
+static void collect_about_values() {
+    auto value = [](AboutLine line) { return about_values[line]; };
+    constexpr size_t VALUE_SIZE = sizeof(about_values[0]);
+    
+    snprintf(value(LINE_VERSION), VALUE_SIZE, "%s", FIRMWARE_VERSION);
     
-    // Forçar invalidação uma única vez após criar tudo
-    lv_obj_invalidate(about_scroll);
+    // Device ID
+    auto& otaManager = OtaManager::instance();
+    otaManager.init(); // Garantir inicialização
+    snprintf(value(LINE_DEVICE_ID), VALUE_SIZE, "%s", otaManager.getDeviceId());
+    
+    // MAC Address
+    uint8_t mac[6];
+    esp_err_t mac_err = esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    if (mac_err == ESP_OK) {
+        snprintf(value(LINE_MAC), VALUE_SIZE, "%02X:%02X:%02X:%02X:%02X:%02X",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    } else {
+        snprintf(value(LINE_MAC), VALUE_SIZE, "N/A");
+    }
+    
+    // Free heap
+    uint32_t free_heap = esp_get_free_heap_size();
+    snprintf(value(LINE_HEAP), VALUE_SIZE, "%lu bytes (%.1f KB)", 
+             (unsigned long)free_heap, free_heap / 1024.0f);
+    
+    // Saúde da memória: amostra atual e tendência do histórico da telemetria
+    telemetry::Sample health = telemetry::sample();
+    snprintf(value(LINE_BLOCK), VALUE_SIZE, "%lu bytes (%.1f KB, frag %u%%)",
+             (unsigned long)health.internal_largest, health.internal_largest / 1024.0f,
+             static_cast<unsigned>(health.internal_frag_pct));
+    snprintf(value(LINE_HEAP_MIN), VALUE_SIZE, "%lu bytes (%.1f KB)",
+             (unsigned long)health.internal_min_free, health.internal_min_free / 1024.0f);
+    snprintf(value(LINE_DMA), VALUE_SIZE, "%.1f / %.1f KB",
+             health.dma_free / 1024.0f, health.dma_largest / 1024.0f);
+    
+    int stacks_used = 0;
+    for (size_t i = 0; i < static_cast<size_t>(telemetry::WatchedTask::Count); ++i) {
+        const uint16_t stack_free = health.stack_free[i];
+        stacks_used += snprintf(value(LINE_STACKS) + stacks_used, VALUE_SIZE - stacks_used,
+                                stack_free == telemetry::STACK_UNKNOWN ? "%s-" : "%s%u",
+                                i > 0 ? " / " : "", static_cast<unsigned>(stack_free));
+        if (stacks_used >= static_cast<int>(VALUE_SIZE)) {
+            break;
+        }
+    }
+    
+    telemetry::Sample oldest;
+    telemetry::Sample newest;
+    if (telemetry::history_bounds(oldest, newest) && newest.uptime_s > oldest.uptime_s) {
+        snprintf(value(LINE_MEM_TREND), VALUE_SIZE, "%.1f->%.1f / %.1f->%.1f KB em %.1f h",
+                 oldest.internal_free / 1024.0f, newest.internal_free / 1024.0f,
+                 oldest.internal_largest / 1024.0f, newest.internal_largest / 1024.0f,
+                 (newest.uptime_s - oldest.uptime_s) / 3600.0f);
+    } else {
+        snprintf(value(LINE_MEM_TREND), VALUE_SIZE, "Aguardando amostras");
+    }
+    
+    // WiFi Status
+    auto& wifi = WiFiManager::instance();
+    snprintf(value(LINE_WIFI), VALUE_SIZE, "%s", wifi.is_connected() ? "Conectado" : "Desconectado");
+
+    // Do início da conexão (boot ou queda) até as avaliações poderem sair
+    wifi_link::Metrics link = wifi_link::metrics();
+    if (link.connections == 0) {
+        snprintf(value(LINE_WIFI_TIMING), VALUE_SIZE, "Aguardando conexão");
+    } else {
+        snprintf(value(LINE_WIFI_TIMING), VALUE_SIZE, "%lu / %lu / %lu ms (%s)",
+                 (unsigned long)link.associate_ms, (unsigned long)link.ip_ms, (unsigned long)link.upload_ms,
+                 link.last_fast ? "AP do cache" : "varredura");
+    }
+    
+    // Chip Info
+    esp_chip_info_t chip_info;
+    esp_chip_info(&chip_info);
+    snprintf(value(LINE_CHIP), VALUE_SIZE, "ESP32 Rev %d (%d cores)",
+             chip_info.revision, chip_info.cores);
+    
+    // Flash Size
+    uint32_t flash_size = 4 * 1024 * 1024;
+    #ifdef CONFIG_ESPTOOLPY_FLASHSIZE_4MB
+        flash_size = 4 * 1024 * 1024;
+    #elif defined(CONFIG_ESPTOOLPY_FLASHSIZE_2MB)
+        flash_size = 2 * 1024 * 1024;
+    #elif defined(CONFIG_ESPTOOLPY_FLASHSIZE_8MB)
+        flash_size = 8 * 1024 * 1024;
+    #endif
+    snprintf(value(LINE_FLASH), VALUE_SIZE, "%lu bytes (%.1f MB)",
+             (unsigned long)flash_size, flash_size / (1024.0f * 1024.0f));
+    
+    // Uptime
+    uint32_t uptime_sec = esp_timer_get_time() / 1000000ULL;
+    uint32_t hours = uptime_sec / 3600;
+    uint32_t minutes = (uptime_sec % 3600) / 60;
+    uint32_t seconds = uptime_sec % 60;
+    snprintf(value(LINE_UPTIME), VALUE_SIZE, "%02lu:%02lu:%02lu",
+             (unsigned long)hours, (unsigned long)minutes, (unsigned long)seconds);
+    
+    // Latência input-to-photon por tipo de interação
+    struct LatencyLine {
+        InputLatencyKind kind;
+        AboutLine line;
+    };
+    constexpr LatencyLine latency_lines[] = {
+        {InputLatencyKind::Press, LINE_LATENCY_PRESS},
+        {InputLatencyKind::Rating, LINE_LATENCY_RATING},
+        {InputLatencyKind::Keypad, LINE_LATENCY_KEYPAD},
+        {InputLatencyKind::Keyboard, LINE_LATENCY_KEYBOARD},
+    };
+    auto& latency = DisplayDriver::instance().input_latency();
+    for (const auto& entry : latency_lines) {
+        InputLatencyStats stats = latency.stats(entry.kind);
+        if (stats.samples == 0) {
+            snprintf(value(entry.line), VALUE_SIZE, "Sem medições");
+        } else {
+            snprintf(value(entry.line), VALUE_SIZE, "%.1f / %.1f / %.1f ms (n=%lu)",
+                     stats.p50_us / 1000.0f, stats.p95_us / 1000.0f, stats.max_us / 1000.0f,
+                     (unsigned long)stats.total);
+        }
+    }
+    
+    // Cache de telas do ScreenManager
+    auto& screens = ScreenManager::instance();
+    ScreenStats screen_totals = screens.totals();
+    uint32_t avg_build_us = screen_totals.builds > 0
+        ? static_cast<uint32_t>(screen_totals.total_build_us / screen_totals.builds) : 0;
+    snprintf(value(LINE_SCREEN_CACHE), VALUE_SIZE, "%lu / %lu, %.1f ms médio, %u de %u KB",
+             (unsigned long)screen_totals.builds, (unsigned long)screen_totals.cache_hits,
+             avg_build_us / 1000.0f,
+             static_cast<unsigned>(screens.cached_bytes() / 1024),
+             static_cast<unsigned>(screens.heap_budget() / 1024));
+    
+    // Fila de jobs da UI
+    jobs::LaneStats ui_jobs = jobs::stats(jobs::Lane::Ui);
+    jobs::LaneStats worker_jobs = jobs::stats(jobs::Lane::Worker);
+    auto avg_latency_ms = [](const jobs::LaneStats& stats) {
+        return stats.executed > 0 ? stats.total_latency_us / stats.executed / 1000.0f : 0.0f;
+    };
+    snprintf(value(LINE_JOBS), VALUE_SIZE, "%lu / %lu, %.1f / %.1f ms, fila máx %lu",
+             (unsigned long)ui_jobs.executed, (unsigned long)worker_jobs.executed,
+             avg_latency_ms(ui_jobs), avg_latency_ms(worker_jobs),
+             (unsigned long)std::max(ui_jobs.max_depth, worker_jobs.max_depth));
+    
+    // Contenção do lock do LVGL: passadas do handler atrasadas ou perdidas por outros tasks
+    LvglLockStats lock = lvgl_lock_stats();
+    snprintf(value(LINE_LVGL_LOCK), VALUE_SIZE, "%lu / %lu, máx %.1f ms (%s)",
+             (unsigned long)lock.frames_delayed, (unsigned long)lock.frames_skipped,
+             lock.max_hold_us / 1000.0f, lock.max_hold_task[0] != '\0' ? lock.max_hold_task : "-");
+    
+    // Slabs do alocador do LVGL: blocos em uso e pico somados; fallbacks foram para o heap
+    LvglMemStats mem = lvgl_mem_stats();
+    uint32_t slab_in_use = 0;
+    uint32_t slab_peak = 0;
+    uint32_t slab_fallbacks = 0;
+    for (const LvglMemClassStats& cls : mem.classes) {
+        slab_in_use += cls.in_use;
+        slab_peak += cls.peak;
+        slab_fallbacks += cls.fallbacks;
+    }
+    snprintf(value(LINE_LVGL_MEM), VALUE_SIZE, "%lu / %lu, heap %lu (%lu sem slab)",
+             (unsigned long)slab_in_use, (unsigned long)slab_peak,
+             (unsigned long)mem.heap_live, (unsigned long)slab_fallbacks);
+    
+    // Download em segundo plano: estado e quanto ele pesou nos quadros da UI
+    background_ota::Status ota_bg = background_ota::status();
+    if (ota_bg.frames_during.frames == 0) {
+        snprintf(value(LINE_OTA_BACKGROUND), VALUE_SIZE, "%s", background_ota::state_name(ota_bg.state));
+    } else {
+        snprintf(value(LINE_OTA_BACKGROUND), VALUE_SIZE, "%s %s, %lu / %lu ms (em %.0f s)",
+                 background_ota::state_name(ota_bg.state), ota_bg.version,
+                 (unsigned long)(ota_bg.frames_before.p95_us / 1000),
+                 (unsigned long)(ota_bg.frames_during.p95_us / 1000), ota_bg.download_ms / 1000.0f);
+    }
+}
+
+void show_about_screen() {
+    ESP_LOGI(TAG, "Mostrando tela Sobre");
     
-    // Liberar mutex IMEDIATAMENTE após criar a UI
-    lvgl_unlock();
+    collect_about_values();
+    ScreenManager::instance().show(ScreenId::About, ABOUT_SCREEN);
     
-    ESP_LOGI(TAG, "Tela Sobre criada");
+    ESP_LOGI(TAG, "Tela Sobre exibida");
 }
 
 } // namespace ui::screens
@@ -1,5 +1,7 @@
 #include "screens/brightness_screen.hpp"
 #include "ui_common.hpp"
+#include "ui_common_internal.hpp"
+#include "screen_manager.hpp"
 #include "display_driver.hpp"
 #include "esp_log.h"
 #include "esp_timer.h"
@@ -31,32 +33,6 @@ static lv_obj_t* brightness_value_label = nullptr;
 static lv_obj_t* brightness_ldr_label = nullptr;
 static esp_timer_handle_t brightness_save_timer = nullptr;
 
-// Função helper para lock/unlock LVGL (definidas em ui_driver.cpp)
-// Como estão no namespace anônimo, precisamos usar uma abordagem diferente
-// Vamos usar um mutex externo diretamente ou criar wrappers
-extern "C" {
-    extern SemaphoreHandle_t lvgl_mutex;
-    extern TaskHandle_t lvgl_task_handle;
-}
-
-static void brightness_lvgl_lock() {
-    if (lvgl_mutex != nullptr) {
-        if (xTaskGetCurrentTaskHandle() == lvgl_task_handle) {
-            return; // Já estamos no task do LVGL, não precisa lock
-        }
-        xSemaphoreTake(lvgl_mutex, portMAX_DELAY);
-    }
-}
-
-static void brightness_lvgl_unlock() {
-    if (lvgl_mutex != nullptr) {
-        if (xTaskGetCurrentTaskHandle() == lvgl_task_handle) {
-            return; // Task do LVGL não adquiriu lock, nada a fazer
-        }
-        xSemaphoreGive(lvgl_mutex);
-    }
-}
-
 // Declaração forward
 static void update_brightness_labels();
 
@@ -132,12 +108,12 @@ static void brightness_update_task(void* pvParameters) {
     while (true) {
         vTaskDelay(pdMS_TO_TICKS(500));  // Atualizar a cada 500ms
         
-        // Só atualizar se a tela existir e estiver visível
-        if (brightness_screen != nullptr && brightness_value_label != nullptr && brightness_ldr_label != nullptr) {
-            brightness_lvgl_lock();
+        // Só atualizar se a tela estiver visível (ela permanece no cache quando inativa)
+        lvgl_lock();
+        if (ScreenManager::instance().is_active(ScreenId::Brightness)) {
             update_brightness_labels();
-            brightness_lvgl_unlock();
         }
+        lvgl_unlock();
     }
 }
 
@@ -153,33 +129,7 @@ static void back_button_cb(lv_event_t* e) {
     }
 }
 
-void show_brightness_screen() {
-    ESP_LOGI(TAG, "show_brightness_screen() iniciado");
-    
-    brightness_lvgl_lock();
-    
-    // Criar timer de salvamento se não existir
-    if (brightness_save_timer == nullptr) {
-        esp_timer_create_args_t timer_args = {
-            .callback = brightness_save_timer_cb,
-            .arg = nullptr,
-            .dispatch_method = ESP_TIMER_TASK,
-            .name = "brightness_save",
-            .skip_unhandled_events = false
-        };
-        esp_err_t ret = esp_timer_create(&timer_args, &brightness_save_timer);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Erro ao criar timer de salvamento: %s", esp_err_to_name(ret));
-            brightness_save_timer = nullptr;
-        }
-    }
-    
-    // Limpar tela anterior se existir
-    if (brightness_screen != nullptr) {
-        lv_obj_del(brightness_screen);
-        brightness_screen = nullptr;
-    }
-    
+static lv_obj_t* build_brightness_screen() {
     // Criar nova tela
     brightness_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(brightness_screen);
@@ -202,11 +152,6 @@ void show_brightness_screen() {
     lv_obj_set_size(brightness_auto_switch, 50, 25);
     lv_obj_align(brightness_auto_switch, LV_ALIGN_TOP_RIGHT, -20, current_y);
     
-    // Configurar estado inicial do switch
-    auto &display = DisplayDriver::instance();
-    if (display.is_auto_brightness_enabled()) {
-        lv_obj_add_state(brightness_auto_switch, LV_STATE_CHECKED);
-    }
     lv_obj_add_event_cb(brightness_auto_switch, brightness_auto_switch_cb, LV_EVENT_VALUE_CHANGED, nullptr);
     
     current_y += 45; // Espaço após switch
@@ -216,12 +161,6 @@ void show_brightness_screen() {
     lv_obj_set_size(brightness_slider, 280, 20);
     lv_obj_align(brightness_slider, LV_ALIGN_TOP_MID, 0, current_y);
     lv_slider_set_range(brightness_slider, 5, 100);
-    lv_slider_set_value(brightness_slider, display.get_brightness(), LV_ANIM_OFF);
-    
-    // Ocultar slider se estiver em modo automático
-    if (display.is_auto_brightness_enabled()) {
-        lv_obj_add_flag(brightness_slider, LV_OBJ_FLAG_HIDDEN);
-    }
     
     lv_obj_add_event_cb(brightness_slider, brightness_slider_cb, LV_EVENT_VALUE_CHANGED, nullptr);
     
@@ -242,8 +181,58 @@ void show_brightness_screen() {
     lv_obj_set_style_text_font(brightness_ldr_label, common::CAPTION_FONT, 0);
     lv_obj_align(brightness_ldr_label, LV_ALIGN_TOP_MID, 0, current_y);
     
-    // Atualizar labels iniciais
+    // Botão de voltar usando helper
+    common::create_back_button(brightness_screen, back_button_cb);
+    
+    return brightness_screen;
+}
+
+// Sincroniza switch, slider e labels com o estado atual do DisplayDriver
+static void refresh_brightness_screen() {
+    auto &display = DisplayDriver::instance();
+    const bool is_auto = display.is_auto_brightness_enabled();
+    if (is_auto) {
+        lv_obj_add_state(brightness_auto_switch, LV_STATE_CHECKED);
+        lv_obj_add_flag(brightness_slider, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_remove_state(brightness_auto_switch, LV_STATE_CHECKED);
+        lv_obj_clear_flag(brightness_slider, LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_slider_set_value(brightness_slider, display.get_brightness(), LV_ANIM_OFF);
     update_brightness_labels();
+}
+
+static void release_brightness_screen() {
+    brightness_screen = nullptr;
+    brightness_auto_switch = nullptr;
+    brightness_slider = nullptr;
+    brightness_value_label = nullptr;
+    brightness_ldr_label = nullptr;
+}
+
+static const ScreenHooks BRIGHTNESS_SCREEN = {
+    "brilho", ScreenRetention::Cached,
+    build_brightness_screen, refresh_brightness_screen, release_brightness_screen,
+};
+
+void show_brightness_screen() {
+    ESP_LOGI(TAG, "show_brightness_screen() iniciado");
+    
+    // Criar timer de salvamento se não existir
+    if (brightness_save_timer == nullptr) {
+        esp_timer_create_args_t timer_args = {
+            .callback = brightness_save_timer_cb,
+            .arg = nullptr,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "brightness_save",
+            .skip_unhandled_events = false
+        };
+        esp_err_t ret = esp_timer_create(&timer_args, &brightness_save_timer);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Erro ao criar timer de salvamento: %s", esp_err_to_name(ret));
+            brightness_save_timer = nullptr;
+        }
+    }
     
     // Criar task para atualizar labels periodicamente (apenas uma vez)
     if (brightness_update_task_handle == nullptr) {
@@ -251,16 +240,9 @@ void show_brightness_screen() {
         ESP_LOGI(TAG, "Task de atualização de brilho criada");
     }
     
-    // Botão de voltar usando helper
-    common::create_back_button(brightness_screen, back_button_cb);
-    
-    // Carregar tela
-    lv_screen_load(brightness_screen);
-    lv_obj_invalidate(brightness_screen);
-    
-    brightness_lvgl_unlock();
+    ScreenManager::instance().show(ScreenId::Brightness, BRIGHTNESS_SCREEN);
     
-    ESP_LOGI(TAG, "Tela de brilho criada e carregada");
+    ESP_LOGI(TAG, "Tela de brilho exibida");
 }
 
 } // namespace screens
@@ -1,6 +1,8 @@
 #include "screens/input_screen.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp"
+#include "display_driver.hpp"
+#include "screen_manager.hpp"
 #include "esp_log.h"
 #include "lvgl.h"
 #include "widgets/textarea/lv_textarea.h"
@@ -28,6 +30,16 @@ static InputCallback s_on_confirm = nullptr;
 static CancelCallback s_on_cancel = nullptr;
 static std::function<void()> s_on_close = nullptr;  // Callback para quando a tela fecha
 
+// Parâmetros de show_input_screen() lidos por build_input_screen() (válidos só durante show)
+struct InputParams {
+    const char* title;
+    const char* placeholder;
+    const char* initial_value;
+    size_t max_length;
+    bool password_mode;
+};
+static InputParams s_params = {};
+
 static void ok_button_cb(lv_event_t* e) {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
@@ -66,6 +78,10 @@ static void cancel_button_cb(lv_event_t* e) {
 #if LV_USE_KEYBOARD != 0
 static void keyboard_event_cb(lv_event_t* e) {
     lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_VALUE_CHANGED) {
+        // Tecla pressionada: texto atualizado no textarea
+        DisplayDriver::instance().input_latency().arm(InputLatencyKind::Keyboard, input_textarea);
+    }
     if (code == LV_EVENT_READY || code == LV_EVENT_CANCEL) {
         ESP_LOGI(TAG, "Teclado: Ready/Cancel pressionado");
         if (code == LV_EVENT_READY && s_on_confirm && input_textarea) {
@@ -85,33 +101,14 @@ static void keyboard_event_cb(lv_event_t* e) {
 }
 #endif
 
-void show_input_screen(
-    const char* title,
-    const char* placeholder,
-    const char* initial_value,
-    size_t max_length,
-    bool password_mode,
-    InputCallback on_confirm,
-    CancelCallback on_cancel,
-    std::function<void()> on_close) {
-    
-    ESP_LOGI(TAG, "show_input_screen: title='%s', placeholder='%s'", title ? title : "null", placeholder ? placeholder : "null");
-    
-    lvgl_lock();
-    
-    // Limpar tela anterior se existir
-    if (input_screen != nullptr) {
-        lv_obj_del(input_screen);
-        input_screen = nullptr;
-    }
-    
+static lv_obj_t* build_input_screen() {
     // Criar nova tela
     input_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(input_screen);
     common::apply_screen_style(input_screen);
     
     // Título usando helper
-    title_label = common::create_screen_title(input_screen, title ? title : "Digite");
+    title_label = common::create_screen_title(input_screen, s_params.title ? s_params.title : "Digite");
     
     // Campo de input (abaixo do título)
     input_textarea = lv_textarea_create(input_screen);
@@ -119,16 +116,16 @@ void show_input_screen(
     lv_obj_align(input_textarea, LV_ALIGN_TOP_MID, 0, common::HEADER_HEIGHT + 10);
     
     #if LV_USE_TEXTAREA != 0
-    if (placeholder) {
-        lv_textarea_set_placeholder_text(input_textarea, placeholder);
+    if (s_params.placeholder) {
+        lv_textarea_set_placeholder_text(input_textarea, s_params.placeholder);
     }
-    lv_textarea_set_max_length(input_textarea, max_length);
+    lv_textarea_set_max_length(input_textarea, s_params.max_length);
     lv_textarea_set_one_line(input_textarea, true);
-    if (password_mode) {
+    if (s_params.password_mode) {
         lv_textarea_set_password_mode(input_textarea, true);
     }
-    if (initial_value) {
-        lv_textarea_set_text(input_textarea, initial_value);
+    if (s_params.initial_value) {
+        lv_textarea_set_text(input_textarea, s_params.initial_value);
     }
     #endif
     lv_obj_set_style_bg_color(input_textarea, lv_color_white(), 0);
@@ -138,11 +135,6 @@ void show_input_screen(
     lv_obj_add_flag(input_textarea, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_clear_flag(input_textarea, LV_OBJ_FLAG_SCROLLABLE);
     
-    // Salvar callbacks
-    s_on_confirm = on_confirm;
-    s_on_cancel = on_cancel;
-    s_on_close = on_close;
-    
     // Criar teclado PRIMEIRO (ocupando a parte inferior da tela, começando de baixo)
     #if LV_USE_KEYBOARD != 0
     keyboard = lv_keyboard_create(input_screen);
@@ -194,12 +186,51 @@ void show_input_screen(
         }
     }, LV_EVENT_ALL, nullptr);
     
-    // Carregar a tela
-    lv_screen_load(input_screen);
-    lv_obj_invalidate(input_screen);
+    return input_screen;
+}
+
+static void release_input_screen() {
+    input_screen = nullptr;
+    title_label = nullptr;
+    input_textarea = nullptr;
+    ok_button = nullptr;
+    cancel_button = nullptr;
+    #if LV_USE_KEYBOARD != 0
+    keyboard = nullptr;
+    #endif
+}
+
+// Transitória: cada exibição tem título, limite e modo próprios
+static const ScreenHooks INPUT_SCREEN = {
+    "input", ScreenRetention::Transient, build_input_screen, nullptr, release_input_screen,
+};
+
+void show_input_screen(
+    const char* title,
+    const char* placeholder,
+    const char* initial_value,
+    size_t max_length,
+    bool password_mode,
+    InputCallback on_confirm,
+    CancelCallback on_cancel,
+    std::function<void()> on_close) {
     
+    ESP_LOGI(TAG, "show_input_screen: title='%s', placeholder='%s'", title ? title : "null", placeholder ? placeholder : "null");
+    
+    // Salvar callbacks
+    lvgl_lock();
+    s_on_confirm = on_confirm;
+    s_on_cancel = on_cancel;
+    s_on_close = on_close;
     lvgl_unlock();
     
+    // Uma nova exibição sempre parte de uma tela limpa
+    ScreenManager::instance().release(ScreenId::Input);
+    
+    s_params = {title, placeholder, initial_value, max_length, password_mode};
+    ScreenManager::instance().show(ScreenId::Input, INPUT_SCREEN);
+    s_params = {};
+    
     ESP_LOGI(TAG, "Tela de input criada e exibida");
 }
 
@@ -210,25 +241,14 @@ void hide_input_screen() {
     auto on_close = s_on_close;
     
     lvgl_lock();
-    
-    if (input_screen != nullptr) {
-        lv_obj_del(input_screen);
-        input_screen = nullptr;
-        title_label = nullptr;
-        input_textarea = nullptr;
-        ok_button = nullptr;
-        cancel_button = nullptr;
-        #if LV_USE_KEYBOARD != 0
-        keyboard = nullptr;
-        #endif
-    }
-    
     s_on_confirm = nullptr;
     s_on_cancel = nullptr;
     s_on_close = nullptr;
-    
     lvgl_unlock();
     
+    // Deleção assíncrona: seguro mesmo chamado de dentro dos eventos da própria tela
+    ScreenManager::instance().release(ScreenId::Input);
+    
     ESP_LOGI(TAG, "Tela de input escondida");
     
     // Chamar callback de fechamento se existir (para voltar à tela anterior)
@@ -238,7 +258,7 @@ void hide_input_screen() {
 }
 
 bool is_input_screen_visible() {
-    return input_screen != nullptr;
+    return ScreenManager::instance().is_active(ScreenId::Input);
 }
 
 } // namespace screens
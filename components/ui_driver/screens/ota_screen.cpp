@@ -1,7 +1,10 @@
 #include "screens/ota_screen.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp" // Para lvgl_lock() e lvgl_unlock()
+#include "screen_manager.hpp"
+#include "ui_jobs.hpp"
 #include "OtaManager.h"
+#include "ota_driver.hpp"
 #include "WiFiManager.h"
 #include "esp_log.h"
 #include "esp_err.h"
@@ -12,9 +15,6 @@
 #include "lvgl.h"
 #include <cstring>
 
-// Declarar fonte Roboto customizada (suporta acentuação)
-LV_FONT_DECLARE(roboto);
-
 namespace {
 constexpr char TAG[] = "OTA_SCREEN";
 
@@ -30,13 +30,13 @@ bool ota_in_progress = false;
 
 namespace ui::screens {
 
-void update_ota_progress(int progress) {
+// Job de UI: aplica o progresso na barra (roda no task do LVGL)
+static void apply_ota_progress_job(uintptr_t arg) {
     if (ota_screen == nullptr || ota_progress_bar == nullptr) {
         return;
     }
     
-    lvgl_lock();
-    
+    const int progress = static_cast<int>(arg);
     lv_bar_set_value(ota_progress_bar, progress, LV_ANIM_ON);
     
     if (ota_progress_label != nullptr) {
@@ -44,8 +44,11 @@ void update_ota_progress(int progress) {
         snprintf(progress_text, sizeof(progress_text), "%d%%", progress);
         lv_label_set_text(ota_progress_label, progress_text);
     }
-    
-    lvgl_unlock();
+}
+
+void update_ota_progress(int progress) {
+    // Não bloqueia o download esperando o lock do LVGL
+    jobs::post(apply_ota_progress_job, static_cast<uintptr_t>(progress));
     
     ESP_LOGI(TAG, "Progresso OTA: %d%%", progress);
 }
@@ -75,79 +78,86 @@ void show_ota_error(const char* errorMsg) {
 }
 
 void cleanup_ota_screen() {
-    if (ota_screen != nullptr) {
-        lv_obj_del(ota_screen);
-        ota_screen = nullptr;
-        ota_title_label = nullptr;
-        ota_status_label = nullptr;
-        ota_progress_bar = nullptr;
-        ota_progress_label = nullptr;
-        ota_info_label = nullptr;
-    }
+    ScreenManager::instance().release(ScreenId::Ota);
     ota_in_progress = false;
 }
 
-static void start_ota_update(const char* otaUrl) {
-    auto& wifi = WiFiManager::instance();
-    if (!wifi.is_connected()) {
-        show_ota_error("WiFi não conectado");
-        return;
+static void on_ota_start(uint32_t resume_offset, uint32_t total_size) {
+    ESP_LOGI(TAG, "OTA iniciado");
+    const int progress = total_size > 0 ? static_cast<int>((100ULL * resume_offset) / total_size) : 0;
+    lvgl_lock();
+    if (ota_status_label != nullptr) {
+        lv_label_set_text(ota_status_label, resume_offset > 0 ? "Retomando download..." : "Baixando atualização...");
+        lv_obj_set_style_text_font(ota_status_label, ::ui::common::TEXT_FONT, 0); // Garantir fonte Roboto
+        lv_obj_set_style_text_color(ota_status_label, lv_color_hex(0x00AAFF), 0);
     }
-    
-    auto& otaManager = OtaManager::instance();
-    otaManager.init();
-    
-    ESP_LOGI(TAG, "Iniciando atualização OTA...");
-    
-    // Usar URL padrão se não fornecida
-    // Para desenvolvimento: usar IP da máquina local (ex: http://192.168.0.100:10234/ota)
-    // Para produção: configurar via menuconfig ou storage
-    const char* defaultUrl = otaUrl ? otaUrl : "http://192.168.0.100:10234/ota";
-    
-    ESP_LOGI(TAG, "URL OTA: %s", defaultUrl);
-    
-    ErrorCode result = otaManager.startUpdate(defaultUrl, nullptr);
-    if (result != CommonErrorCodes::None) {
-        char errorMsg[64];
-        snprintf(errorMsg, sizeof(errorMsg), "Erro ao iniciar: %s", result.description().c_str());
-        show_ota_error(errorMsg);
+    if (ota_progress_bar != nullptr) {
+        lv_bar_set_value(ota_progress_bar, progress, LV_ANIM_OFF);
+    }
+    if (ota_progress_label != nullptr) {
+        lv_label_set_text_fmt(ota_progress_label, "%d%%", progress);
     }
+    lvgl_unlock();
+    ota_in_progress = true;
 }
 
-void show_ota_screen(const char* otaUrl) {
-    ESP_LOGI(TAG, "show_ota_screen chamado");
-    
-    if (ota_in_progress && ota_screen != nullptr) {
-        ESP_LOGW(TAG, "OTA já em progresso");
-        return;
+static void on_ota_complete() {
+    ESP_LOGI(TAG, "OTA concluído com sucesso");
+    lvgl_lock();
+    if (ota_status_label != nullptr) {
+        lv_label_set_text(ota_status_label, "Atualização concluída!\nReiniciando...");
+        lv_obj_set_style_text_font(ota_status_label, ::ui::common::TEXT_FONT, 0); // Garantir fonte Roboto
+        lv_obj_set_style_text_color(ota_status_label, lv_color_hex(0x00FF00), 0);
     }
-    
-    // Verificar WiFi
-    ESP_LOGI(TAG, "Verificando WiFi...");
+    if (ota_progress_bar != nullptr) {
+        lv_bar_set_value(ota_progress_bar, 100, LV_ANIM_ON);
+    }
+    if (ota_progress_label != nullptr) {
+        lv_label_set_text(ota_progress_label, "100%");
+    }
+    lvgl_unlock();
+
+    // Reiniciar após 2 segundos
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    esp_restart();
+}
+
+static void on_ota_failed(esp_err_t err) {
+    // O progresso verificado fica no NVS: tentar de novo retoma de onde parou
+    char errorMsg[64];
+    snprintf(errorMsg, sizeof(errorMsg), "Falha na atualização (%s)", esp_err_to_name(err));
+    show_ota_error(errorMsg);
+}
+
+static const ota::UpdateCallbacks OTA_CALLBACKS = {
+    on_ota_start, update_ota_progress, on_ota_complete, on_ota_failed,
+};
+
+static void start_ota_update(const char* otaUrl) {
     auto& wifi = WiFiManager::instance();
     if (!wifi.is_connected()) {
-        ESP_LOGE(TAG, "WiFi não conectado para OTA");
+        show_ota_error("WiFi não conectado");
         return;
     }
-    ESP_LOGI(TAG, "WiFi conectado");
     
-    // Inicializar OtaManager ANTES de pegar o mutex (pode fazer operações bloqueantes)
-    ESP_LOGI(TAG, "Inicializando OtaManager...");
-    auto& otaManager = OtaManager::instance();
-    esp_err_t init_err = otaManager.init();
-    if (init_err != ESP_OK) {
-        ESP_LOGE(TAG, "Erro ao inicializar OtaManager: %s", esp_err_to_name(init_err));
+    if (ota::OtaDriver::instance().is_running()) {
+        // O download em segundo plano continua; ao terminar, a próxima tentativa só confere o slot
+        show_ota_error("Atualização em andamento em segundo plano");
         return;
     }
-    ESP_LOGI(TAG, "OtaManager inicializado, criando tela...");
     
-    // Usar lvgl_lock() que verifica se já estamos na task do LVGL
-    lvgl_lock();
+    ESP_LOGI(TAG, "Iniciando atualização OTA...");
+    
+    // Usar URL padrão se não fornecida (CONFIG_HUB_OTA_URL, a mesma do download em segundo plano)
+    const char* defaultUrl = otaUrl ? otaUrl : ota::DEFAULT_URL;
     
-    // Limpar tela anterior se existir
-    cleanup_ota_screen();
+    ESP_LOGI(TAG, "URL OTA: %s", defaultUrl);
     
-    // Criar nova tela
+    // Bloqueia este task até o fim; falhas chegam por on_ota_failed
+    ota::OtaDriver::instance().run_update(defaultUrl, OtaManager::instance().getDeviceId(), OTA_CALLBACKS);
+}
+
+static lv_obj_t* build_ota_screen() {
     ota_screen = lv_obj_create(nullptr);
     lv_obj_set_size(ota_screen, LV_PCT(100), LV_PCT(100));
     lv_obj_set_style_bg_color(ota_screen, lv_color_hex(0x000000), 0);
@@ -159,14 +169,14 @@ void show_ota_screen(const char* otaUrl) {
     // Título
     ota_title_label = lv_label_create(ota_screen);
     lv_label_set_text(ota_title_label, "Atualização OTA");
-    lv_obj_set_style_text_font(ota_title_label, &roboto, 0);
+    lv_obj_set_style_text_font(ota_title_label, ::ui::common::TEXT_FONT, 0);
     lv_obj_set_style_text_color(ota_title_label, lv_color_hex(0xFFFFFF), 0);
     lv_obj_set_style_text_align(ota_title_label, LV_TEXT_ALIGN_CENTER, 0);
     
     // Status
     ota_status_label = lv_label_create(ota_screen);
     lv_label_set_text(ota_status_label, "Preparando atualização...");
-    lv_obj_set_style_text_font(ota_status_label, &roboto, 0);
+    lv_obj_set_style_text_font(ota_status_label, ::ui::common::TEXT_FONT, 0);
     lv_obj_set_style_text_color(ota_status_label, lv_color_hex(0xFFFFFF), 0);
     lv_obj_set_style_text_align(ota_status_label, LV_TEXT_ALIGN_CENTER, 0);
     lv_obj_set_width(ota_status_label, LV_PCT(90));
@@ -183,7 +193,7 @@ void show_ota_screen(const char* otaUrl) {
     // Label de progresso
     ota_progress_label = lv_label_create(ota_screen);
     lv_label_set_text(ota_progress_label, "0%");
-    lv_obj_set_style_text_font(ota_progress_label, &roboto, 0);
+    lv_obj_set_style_text_font(ota_progress_label, ::ui::common::TEXT_FONT, 0);
     lv_obj_set_style_text_color(ota_progress_label, lv_color_hex(0xFFFFFF), 0);
     lv_obj_set_style_text_align(ota_progress_label, LV_TEXT_ALIGN_CENTER, 0);
     
@@ -191,76 +201,60 @@ void show_ota_screen(const char* otaUrl) {
     ota_info_label = lv_label_create(ota_screen);
     // OtaManager já foi inicializado antes do mutex
     char info_text[128];
-    snprintf(info_text, sizeof(info_text), "Device ID: %s", otaManager.getDeviceId());
+    snprintf(info_text, sizeof(info_text), "Device ID: %s", OtaManager::instance().getDeviceId());
     lv_label_set_text(ota_info_label, info_text);
-    lv_obj_set_style_text_font(ota_info_label, &roboto, 0);
+    lv_obj_set_style_text_font(ota_info_label, ::ui::common::TEXT_FONT, 0);
     lv_obj_set_style_text_color(ota_info_label, lv_color_hex(0xAAAAAA), 0);
     lv_obj_set_style_text_align(ota_info_label, LV_TEXT_ALIGN_CENTER, 0);
     lv_obj_set_width(ota_info_label, LV_PCT(90));
     lv_label_set_long_mode(ota_info_label, LV_LABEL_LONG_WRAP);
     
-    ESP_LOGI(TAG, "Carregando tela OTA...");
-    lv_screen_load(ota_screen);
-    lv_obj_invalidate(ota_screen);
+    return ota_screen;
+}
+
+static void release_ota_screen() {
+    ota_screen = nullptr;
+    ota_title_label = nullptr;
+    ota_status_label = nullptr;
+    ota_progress_bar = nullptr;
+    ota_progress_label = nullptr;
+    ota_info_label = nullptr;
+}
+
+static const ScreenHooks OTA_SCREEN = {
+    "ota", ScreenRetention::Transient,
+    build_ota_screen, nullptr, release_ota_screen,
+};
+
+void show_ota_screen(const char* otaUrl) {
+    ESP_LOGI(TAG, "show_ota_screen chamado");
+    
+    if (ota_in_progress && ota_screen != nullptr) {
+        ESP_LOGW(TAG, "OTA já em progresso");
+        return;
+    }
     
-    ESP_LOGI(TAG, "Liberando mutex LVGL...");
-    lvgl_unlock();
-    ESP_LOGI(TAG, "Mutex LVGL liberado");
+    // Verificar WiFi
+    ESP_LOGI(TAG, "Verificando WiFi...");
+    auto& wifi = WiFiManager::instance();
+    if (!wifi.is_connected()) {
+        ESP_LOGE(TAG, "WiFi não conectado para OTA");
+        return;
+    }
+    ESP_LOGI(TAG, "WiFi conectado");
     
-    // Configurar eventos do OtaManager (apenas uma vez)
-    // IMPORTANTE: Configurar eventos FORA do contexto do mutex LVGL
-    static bool events_configured = false;
-    if (!events_configured) {
-        ESP_LOGI(TAG, "Configurando eventos do OtaManager");
-        otaManager.onUpdateStart.addHandler([]() {
-            ESP_LOGI(TAG, "OTA iniciado");
-            lvgl_lock();
-            if (ota_status_label != nullptr) {
-                lv_label_set_text(ota_status_label, "Baixando atualização...");
-                lv_obj_set_style_text_font(ota_status_label, &roboto, 0); // Garantir fonte Roboto
-                lv_obj_set_style_text_color(ota_status_label, lv_color_hex(0x00AAFF), 0);
-            }
-            if (ota_progress_bar != nullptr) {
-                lv_bar_set_value(ota_progress_bar, 0, LV_ANIM_OFF);
-            }
-            if (ota_progress_label != nullptr) {
-                lv_label_set_text(ota_progress_label, "0%");
-            }
-            lvgl_unlock();
-            ota_in_progress = true;
-        });
-        
-        otaManager.onProgress.addHandler([](int progress) {
-            update_ota_progress(progress);
-        });
-        
-        otaManager.onUpdateComplete.addHandler([]() {
-            ESP_LOGI(TAG, "OTA concluído com sucesso");
-            lvgl_lock();
-            if (ota_status_label != nullptr) {
-                lv_label_set_text(ota_status_label, "Atualização concluída!\nReiniciando...");
-                lv_obj_set_style_text_font(ota_status_label, &roboto, 0); // Garantir fonte Roboto
-                lv_obj_set_style_text_color(ota_status_label, lv_color_hex(0x00FF00), 0);
-            }
-            if (ota_progress_bar != nullptr) {
-                lv_bar_set_value(ota_progress_bar, 100, LV_ANIM_ON);
-            }
-            if (ota_progress_label != nullptr) {
-                lv_label_set_text(ota_progress_label, "100%");
-            }
-            lvgl_unlock();
-            
-            // Reiniciar após 2 segundos
-            vTaskDelay(pdMS_TO_TICKS(2000));
-            esp_restart();
-        });
-        
-        otaManager.onUpdateFailed.addHandler([]() {
-            show_ota_error("Falha na atualização");
-        });
-        
-        events_configured = true;
+    // Inicializar OtaManager ANTES de pegar o mutex (pode fazer operações bloqueantes)
+    ESP_LOGI(TAG, "Inicializando OtaManager...");
+    auto& otaManager = OtaManager::instance();
+    esp_err_t init_err = otaManager.init();
+    if (init_err != ESP_OK) {
+        ESP_LOGE(TAG, "Erro ao inicializar OtaManager: %s", esp_err_to_name(init_err));
+        return;
     }
+    ESP_LOGI(TAG, "OtaManager inicializado, criando tela...");
+    
+    // Transitória: reconstruída a cada atualização e descartada ao sair
+    ScreenManager::instance().show(ScreenId::Ota, OTA_SCREEN);
     
     // Iniciar atualização em uma task separada para não bloquear UI
     // Criar cópia da URL se fornecida, ou usar nullptr
@@ -287,7 +281,7 @@ void show_ota_screen(const char* otaUrl) {
             vPortFree(url);
         }
         vTaskDelete(nullptr);
-    }, "ota_task", 4096, url_copy, 5, nullptr);
+    }, "ota_task", ota::RUN_UPDATE_STACK_SIZE, url_copy, 5, nullptr);
     
     if (task_result != pdPASS) {
         ESP_LOGE(TAG, "Falha ao criar task OTA");
@@ -1,6 +1,8 @@
 #include "screens/password_screen.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp"
+#include "screen_manager.hpp"
+#include "display_driver.hpp"
 #include "Storage.h"
 #include "ErrorCode.h"
 #include "GeneralErrorCodes.h"
@@ -233,6 +235,7 @@ static void check_password() {
 
 static void btn_click_cb(lv_event_t* e) {
     int btn_index = (int)(intptr_t)lv_event_get_user_data(e);
+    DisplayDriver::instance().input_latency().arm(InputLatencyKind::Keypad, display_label);
     
     // Resetar timeout ao interagir
     reset_password_timeout();
@@ -251,6 +254,8 @@ static void btn_click_cb(lv_event_t* e) {
 }
 
 static void del_click_cb(lv_event_t* e) {
+    DisplayDriver::instance().input_latency().arm(InputLatencyKind::Keypad, display_label);
+
     // Resetar timeout ao interagir
     reset_password_timeout();
     
@@ -270,36 +275,15 @@ static void back_click_cb(lv_event_t* e) {
     hide_password_screen();
 }
 
-void show_password_screen(PasswordSuccessCallback on_success, PasswordCancelCallback on_cancel) {
-    ESP_LOGI(TAG, "show_password_screen chamado");
-    
-    // Carregar senha do Storage na primeira vez
-    static bool password_loaded = false;
-    if (!password_loaded) {
-        // Garantir que Storage está inicializado
-        ErrorCode storage_err = Storage::initialize();
-        if (storage_err == CommonErrorCodes::None) {
-            load_password_from_storage();
-            password_loaded = true;
-        } else {
-            ESP_LOGW(TAG, "Storage não inicializado, usando senha padrão");
-        }
-    }
-    
-    s_on_success = on_success;
-    s_on_cancel = on_cancel;
-    s_input_buffer.clear();
-    
-    // Iniciar timeout automático (10 segundos)
-    reset_password_timeout();
-    
-    lvgl_lock();
-    
-    if (password_screen != nullptr) {
-        lv_obj_del(password_screen);
-        password_screen = nullptr;
+static void close_error_dialog() {
+    if (error_overlay != nullptr) {
+        lv_obj_del(error_overlay);
+        error_overlay = nullptr;
+        error_dialog = nullptr;
     }
-    
+}
+
+static lv_obj_t* build_password_screen() {
     password_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(password_screen);
     common::apply_screen_style(password_screen);
@@ -407,31 +391,65 @@ void show_password_screen(PasswordSuccessCallback on_success, PasswordCancelCall
     // Botão Voltar (rodapé)
     common::create_back_button(password_screen, back_click_cb);
     
-    lv_screen_load(password_screen);
     
-    lvgl_unlock();
+    return password_screen;
+}
+
+// Cada exibição começa com o display vazio e sem diálogo de erro
+static void refresh_password_screen() {
+    close_error_dialog();
+    update_display();
+}
+
+static void release_password_screen() {
+    password_screen = nullptr;
+    display_label = nullptr;
+    error_overlay = nullptr;
+    error_dialog = nullptr;
+}
+
+static const ScreenHooks PASSWORD_SCREEN = {
+    "senha", ScreenRetention::Cached,
+    build_password_screen, refresh_password_screen, release_password_screen,
+};
+
+void show_password_screen(PasswordSuccessCallback on_success, PasswordCancelCallback on_cancel) {
+    ESP_LOGI(TAG, "show_password_screen chamado");
+    
+    // Carregar senha do Storage na primeira vez
+    static bool password_loaded = false;
+    if (!password_loaded) {
+        // Garantir que Storage está inicializado
+        ErrorCode storage_err = Storage::initialize();
+        if (storage_err == CommonErrorCodes::None) {
+            load_password_from_storage();
+            password_loaded = true;
+        } else {
+            ESP_LOGW(TAG, "Storage não inicializado, usando senha padrão");
+        }
+    }
+    
+    s_on_success = on_success;
+    s_on_cancel = on_cancel;
+    s_input_buffer.clear();
+    
+    // Iniciar timeout automático (10 segundos)
+    reset_password_timeout();
+    
+    ScreenManager::instance().show(ScreenId::Password, PASSWORD_SCREEN);
 }
 
 void hide_password_screen() {
     lvgl_lock();
-    // Limpar diálogo de erro se existir
-    if (error_overlay != nullptr) {
-        lv_obj_del(error_overlay);
-        error_overlay = nullptr;
-        error_dialog = nullptr;
-    }
-    if (password_screen) {
-        lv_obj_del(password_screen);
-        password_screen = nullptr;
-        display_label = nullptr;
-    }
+    // A tela fica no cache do ScreenManager; apenas limpar diálogo e callbacks
+    close_error_dialog();
     s_on_success = nullptr;
     s_on_cancel = nullptr;
     lvgl_unlock();
 }
 
 bool is_password_screen_visible() {
-    return password_screen != nullptr;
+    return ScreenManager::instance().is_active(ScreenId::Password);
 }
 
 bool set_password(const std::string& new_password) {
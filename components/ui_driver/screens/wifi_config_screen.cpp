@@ -3,6 +3,8 @@
 #include "screens/wifi_scan_screen.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp"
+#include "screen_manager.hpp"
+#include "ui_jobs.hpp"
 #include "WiFiManager.h"
 #include "esp_log.h"
 #include "lvgl.h"
@@ -34,6 +36,58 @@ static lv_obj_t* back_button = nullptr;
 static char current_ssid[33] = {0};
 static char current_password[65] = {0};
 
+// Job de UI: mostra o resultado da conexão
+static void connect_result_job(uintptr_t arg) {
+    const esp_err_t err = static_cast<esp_err_t>(arg);
+    if (status_label == nullptr) {
+        return;
+    }
+    
+    if (err == ESP_OK) {
+        const char* ip = WiFiManager::instance().get_ip();
+        if (ip) {
+            lv_label_set_text_fmt(status_label, "Conectado! IP: %s", ip);
+        } else {
+            lv_label_set_text(status_label, "Conectado!");
+        }
+        lv_obj_set_style_text_color(status_label, common::COLOR_SUCCESS(), 0);
+        // O ícone WiFi da tela principal é atualizado pelo timer periódico da UI
+    } else {
+        if (err == ESP_ERR_TIMEOUT) {
+            lv_label_set_text(status_label, "Timeout ao conectar");
+        } else if (err == ESP_FAIL) {
+            lv_label_set_text(status_label, "Senha incorreta?");
+        } else {
+            lv_label_set_text(status_label, "Erro ao conectar");
+        }
+        lv_obj_set_style_text_color(status_label, common::COLOR_ERROR(), 0);
+    }
+    lv_obj_invalidate(status_label);
+}
+
+// Job do worker: conexão bloqueante com as credenciais atuais
+static void connect_wifi_job(uintptr_t) {
+    char ssid[sizeof(current_ssid)];
+    char password[sizeof(current_password)];
+    lvgl_lock();
+    strncpy(ssid, current_ssid, sizeof(ssid) - 1);
+    ssid[sizeof(ssid) - 1] = '\0';
+    strncpy(password, current_password, sizeof(password) - 1);
+    password[sizeof(password) - 1] = '\0';
+    lvgl_unlock();
+    
+    auto& wifi = WiFiManager::instance();
+    esp_err_t err = wifi.connect(ssid, password);
+    if (err == ESP_OK) {
+        const char* ip = wifi.get_ip();
+        ESP_LOGI(TAG, "Conexão bem-sucedida! IP: %s", ip ? ip : "(null)");
+    } else {
+        ESP_LOGE(TAG, "Erro ao conectar: %s", esp_err_to_name(err));
+    }
+    
+    jobs::post(connect_result_job, static_cast<uintptr_t>(err));
+}
+
 static void connect_button_cb(lv_event_t* e) {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
@@ -59,49 +113,8 @@ static void connect_button_cb(lv_event_t* e) {
         lv_obj_set_style_text_color(status_label, common::COLOR_BUTTON_BLUE(), 0);
         lv_obj_invalidate(status_label);
         
-        // Tentar conectar (em uma task separada para não bloquear a UI)
-        xTaskCreate([](void* arg) {
-            const char* ssid = (const char*)arg;
-            char password[65];
-            strncpy(password, current_password, sizeof(password) - 1);
-            password[sizeof(password) - 1] = '\0';
-            
-            auto& wifi = WiFiManager::instance();
-            esp_err_t err = wifi.connect(ssid, password);
-            
-            lvgl_lock();
-            if (err == ESP_OK) {
-                const char* ip = wifi.get_ip();
-                ESP_LOGI(TAG, "Conexão bem-sucedida! IP: %s", ip ? ip : "(null)");
-                if (status_label) {
-                    if (ip) {
-                        lv_label_set_text_fmt(status_label, "Conectado! IP: %s", ip);
-                    } else {
-                        lv_label_set_text(status_label, "Conectado!");
-                    }
-                    lv_obj_set_style_text_color(status_label, common::COLOR_SUCCESS(), 0);
-                }
-                // Atualizar ícone WiFi na tela principal será feito automaticamente pelo update()
-            } else {
-                ESP_LOGE(TAG, "Erro ao conectar: %s", esp_err_to_name(err));
-                if (status_label) {
-                    if (err == ESP_ERR_TIMEOUT) {
-                        lv_label_set_text(status_label, "Timeout ao conectar");
-                    } else if (err == ESP_FAIL) {
-                        lv_label_set_text(status_label, "Senha incorreta?");
-                    } else {
-                        lv_label_set_text(status_label, "Erro ao conectar");
-                    }
-                    lv_obj_set_style_text_color(status_label, common::COLOR_ERROR(), 0);
-                }
-            }
-            if (status_label) {
-                lv_obj_invalidate(status_label);
-            }
-            lvgl_unlock();
-            
-            vTaskDelete(nullptr);
-        }, "wifi_connect_task", 4096, (void*)ssid, 5, nullptr);
+        // Conectar no worker da UI para não bloquear o task do LVGL
+        jobs::post_worker(connect_wifi_job);
     }
 }
 
@@ -133,13 +146,21 @@ static lv_obj_t* create_input_button(lv_obj_t* parent, lv_obj_t** label_out) {
     return btn;
 }
 
-void create_wifi_config_screen() {
-    ESP_LOGI(TAG, "create_wifi_config_screen() iniciado");
-    if (wifi_screen != nullptr) {
-        ESP_LOGW(TAG, "Tela WiFi já existe, deletando antes de recriar");
-        lv_obj_del(wifi_screen);
+// Reflete SSID e senha escolhidos nos botões (também após reconstrução pelo cache)
+static void refresh_wifi_config_screen() {
+    if (ssid_label_display != nullptr) {
+        lv_label_set_text(ssid_label_display, current_ssid[0] ? current_ssid : "Toque para escanear");
     }
-    
+    if (password_label_display != nullptr) {
+        char display[66] = {0};
+        size_t len = strnlen(current_password, sizeof(display) - 1);
+        memset(display, '*', len);
+        lv_label_set_text(password_label_display, display[0] ? display : "Toque para digitar");
+    }
+}
+
+static lv_obj_t* build_wifi_config_screen() {
+    ESP_LOGI(TAG, "build_wifi_config_screen() iniciado");
     ESP_LOGI(TAG, "Criando objeto wifi_screen...");
     wifi_screen = lv_obj_create(nullptr);
     ESP_LOGI(TAG, "wifi_screen criado: %p", wifi_screen);
@@ -166,11 +187,10 @@ void create_wifi_config_screen() {
     lv_obj_align_to(ssid_button, ssid_label, LV_ALIGN_OUT_RIGHT_MID, 5, -5); // Ajuste fino
     lv_label_set_text(ssid_label_display, "Toque para escanear");
     
-    // Carregar SSID salvo se existir
+    // Carregar SSID salvo se ainda não houver um escolhido
     auto& wifi = WiFiManager::instance();
-    if (wifi.is_connected() || strlen(wifi.config().ssid) > 0) {
+    if (current_ssid[0] == '\0' && (wifi.is_connected() || strlen(wifi.config().ssid) > 0)) {
         strncpy(current_ssid, wifi.config().ssid, sizeof(current_ssid) - 1);
-        lv_label_set_text(ssid_label_display, current_ssid);
     }
     
     // Evento SSID
@@ -261,9 +281,24 @@ void create_wifi_config_screen() {
     // Voltar - usando função unificada com offset X para ficar à direita (caso especial: dois botões)
     back_button = common::create_back_button(wifi_screen, back_button_cb, 75);
     
-    ESP_LOGI(TAG, "create_wifi_config_screen() concluído");
+    ESP_LOGI(TAG, "build_wifi_config_screen() concluído");
+    return wifi_screen;
+}
+
+static void release_wifi_config_screen() {
+    wifi_screen = nullptr;
+    ssid_label_display = nullptr;
+    password_label_display = nullptr;
+    status_label = nullptr;
+    connect_button = nullptr;
+    back_button = nullptr;
 }
 
+static const ScreenHooks WIFI_CONFIG_SCREEN = {
+    "wifi", ScreenRetention::Cached,
+    build_wifi_config_screen, refresh_wifi_config_screen, release_wifi_config_screen,
+};
+
 void show_wifi_config_screen() {
     ESP_LOGI(TAG, "show_wifi_config_screen() chamado");
     
@@ -284,33 +319,15 @@ void show_wifi_config_screen() {
         ESP_LOGW(TAG, "Callback não definido - botão voltar pode não funcionar corretamente");
     }
     
-    lvgl_lock();
-    
-    if (wifi_screen == nullptr) {
-        create_wifi_config_screen();
-    }
-    
-    lv_screen_load(wifi_screen);
-    lv_obj_invalidate(wifi_screen);
-    
-    lvgl_unlock();
+    // Mantida no cache: voltar do scan ou do teclado preserva o status exibido
+    ScreenManager::instance().show(ScreenId::WifiConfig, WIFI_CONFIG_SCREEN);
     ESP_LOGI(TAG, "show_wifi_config_screen() concluído");
 }
 
 void destroy_wifi_config_screen() {
-    if (wifi_screen != nullptr) {
-        lvgl_lock();
-        lv_obj_del(wifi_screen);
-        wifi_screen = nullptr;
-        ssid_label_display = nullptr;
-        password_label_display = nullptr;
-        status_label = nullptr;
-        connect_button = nullptr;
-        back_button = nullptr;
-        current_ssid[0] = '\0';
-        current_password[0] = '\0';
-        lvgl_unlock();
-    }
+    ScreenManager::instance().release(ScreenId::WifiConfig);
+    current_ssid[0] = '\0';
+    current_password[0] = '\0';
 }
 
 } // namespace screens
@@ -1,8 +1,12 @@
 #include "screens/wifi_scan_screen.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp"
+#include "screen_manager.hpp"
+#include "ui_jobs.hpp"
 #include "WiFiManager.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
 #include "lvgl.h"
 #include <cstring>
 #include <algorithm>
@@ -19,9 +23,23 @@ static lv_obj_t* scan_screen = nullptr;
 static lv_obj_t* title_label = nullptr;
 static lv_obj_t* status_label = nullptr;
 static lv_obj_t* list_obj = nullptr;
+static lv_obj_t* list_spacer = nullptr;
 static lv_obj_t* back_button = nullptr;
 static WiFiScanCallback s_on_select = nullptr;
 
+// Geometria da lista: só existem objetos LVGL para as linhas visíveis
+constexpr int32_t LIST_HEIGHT = 115;
+constexpr int32_t LIST_PAD = 6;
+constexpr int32_t ROW_HEIGHT = 34;
+constexpr int32_t ROW_PITCH = ROW_HEIGHT + 6;
+// Linhas que cabem na área visível, mais uma parcialmente coberta em cada borda
+constexpr int ROW_POOL = (LIST_HEIGHT - 2 * LIST_PAD + ROW_PITCH - 1) / ROW_PITCH + 2;
+
+// Varredura canal a canal: cada canal entrega resultados em ~120 ms
+constexpr uint8_t SCAN_CHANNELS = 13;
+constexpr uint16_t SCAN_BATCH = 24;  // Registros lidos por canal
+constexpr int MAX_NETWORKS = 64;     // SSIDs distintos mantidos (os mais fortes)
+
 // Estrutura para armazenar informações das redes
 struct NetworkInfo {
     char ssid[33];
@@ -29,8 +47,26 @@ struct NetworkInfo {
     bool has_password;
 };
 
-static NetworkInfo networks[20];  // Máximo 20 redes
+// Linha reciclada da lista: mostra a rede `index` (-1 = livre)
+struct Row {
+    lv_obj_t* button;
+    lv_obj_t* ssid_label;
+    lv_obj_t* info_label;
+    int index;
+};
+
+// Protegidos pelo lock do LVGL (o worker funde os resultados com o lock tomado)
+static NetworkInfo networks[MAX_NETWORKS];
 static int network_count = 0;
+static Row rows[ROW_POOL];
+static bool rows_dirty = false;      // Redes mudaram desde a última vinculação
+static bool refresh_posted = false;  // Já há um refresh na fila da UI
+static bool scan_finished = false;
+static bool scan_failed = false;
+static uint32_t scan_generation = 0;  // Muda a cada exibição: varreduras antigas desistem
+
+// Só o worker usa
+static wifi_ap_record_t scan_records[SCAN_BATCH];
 
 // Função para comparar redes por RSSI (mais forte primeiro)
 static bool compare_networks(const NetworkInfo& a, const NetworkInfo& b) {
@@ -50,7 +86,8 @@ static void back_button_cb(lv_event_t* e) {
 static void network_button_cb(lv_event_t* e) {
     if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
         lv_obj_t* btn = lv_event_get_target_obj(e);
-        int index = (int)(intptr_t)lv_obj_get_user_data(btn);
+        int slot = (int)(intptr_t)lv_obj_get_user_data(btn);
+        int index = rows[slot].index;
         
         if (index >= 0 && index < network_count && s_on_select) {
             ESP_LOGI(TAG, "Rede selecionada: %s", networks[index].ssid);
@@ -63,26 +100,114 @@ static void network_button_cb(lv_event_t* e) {
     }
 }
 
-void show_wifi_scan_screen(WiFiScanCallback on_select) {
-    ESP_LOGI(TAG, "show_wifi_scan_screen chamado");
+// Só troca o texto quando muda: evita invalidar a linha a cada rolagem
+static void set_label_text(lv_obj_t* label, const char* text) {
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+static void bind_row(Row& row, int index) {
+    const NetworkInfo& network = networks[index];
+    set_label_text(row.ssid_label, network.ssid);
     
-    s_on_select = on_select;
+    // Indicador de senha + força do sinal (RSSI)
+    const char* security_text = network.has_password ? "Senha" : "Aberto";
+    const char* rssi_text = nullptr;
+    if (network.rssi > -50) {
+        rssi_text = "Excelente";
+    } else if (network.rssi > -70) {
+        rssi_text = "Bom";
+    } else {
+        rssi_text = "Fraco";
+    }
     
-    lvgl_lock();
+    char info_text[32];
+    snprintf(info_text, sizeof(info_text), "%s | %s", security_text, rssi_text);
+    set_label_text(row.info_label, info_text);
     
-    // Limpar tela anterior se existir
-    if (scan_screen != nullptr) {
-        lv_obj_del(scan_screen);
-        scan_screen = nullptr;
+    lv_obj_set_y(row.button, index * ROW_PITCH);
+    lv_obj_remove_flag(row.button, LV_OBJ_FLAG_HIDDEN);
+    row.index = index;
+}
+
+/**
+ * @brief Vincula as linhas do pool às redes na área visível
+ *
+ * A rede i sempre usa a linha i % ROW_POOL: numa rolagem, as linhas que
+ * continuam visíveis não mudam e só as que saíram por uma borda são
+ * reaproveitadas na outra.
+ */
+static void bind_visible_rows(bool force) {
+    const int first = std::max<int32_t>(0, lv_obj_get_scroll_y(list_obj) / ROW_PITCH);
+    for (int index = first; index < first + ROW_POOL; ++index) {
+        Row& row = rows[index % ROW_POOL];
+        if (index >= network_count) {
+            lv_obj_add_flag(row.button, LV_OBJ_FLAG_HIDDEN);
+            row.index = -1;
+        } else if (force || row.index != index) {
+            bind_row(row, index);
+        }
     }
+}
+
+static void list_scroll_cb(lv_event_t* e) {
+    bind_visible_rows(false);
+}
+
+static lv_obj_t* create_row(int slot) {
+    // Criar botão para cada linha usando estilo padrão, mas customizado para row
+    lv_obj_t* btn = lv_button_create(list_obj);
+    lv_obj_set_width(btn, lv_pct(100));
+    lv_obj_set_height(btn, ROW_HEIGHT);
+    lv_obj_set_style_bg_color(btn, lv_color_white(), 0);
+    lv_obj_set_style_border_color(btn, common::COLOR_BORDER(), 0);
+    lv_obj_set_style_border_width(btn, 1, 0);
+    lv_obj_set_style_radius(btn, common::BUTTON_RADIUS - 2, 0); // Um pouco menos arredondado na lista
+    lv_obj_set_style_pad_hor(btn, 8, 0);
+    lv_obj_set_style_pad_ver(btn, 4, 0);
+    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
+    lv_obj_set_flex_flow(btn, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(btn,
+                          LV_FLEX_ALIGN_SPACE_BETWEEN,
+                          LV_FLEX_ALIGN_CENTER,
+                          LV_FLEX_ALIGN_CENTER);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_HIDDEN);
+    
+    // Label com SSID
+    lv_obj_t* label = lv_label_create(btn);
+    lv_label_set_text(label, "");
+    lv_obj_set_style_text_color(label, common::COLOR_TEXT_BLACK(), 0);
+    lv_obj_set_style_text_font(label, common::TEXT_FONT, 0);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_obj_set_width(label, lv_pct(65));
+    
+    lv_obj_t* info_label = lv_label_create(btn);
+    lv_label_set_text(info_label, "");
+    lv_obj_set_style_text_color(info_label, common::COLOR_TEXT_GRAY(), 0);
+    lv_obj_set_style_text_font(info_label, common::CAPTION_FONT, 0);
+    lv_label_set_long_mode(info_label, LV_LABEL_LONG_CLIP);
+    lv_obj_set_width(info_label, lv_pct(35));
+    lv_obj_set_style_text_align(info_label, LV_TEXT_ALIGN_RIGHT, 0);
+    
+    // Armazenar a posição no pool como user_data (a rede muda com a rolagem)
+    lv_obj_set_user_data(btn, (void*)(intptr_t)slot);
+    
+    // Callback para seleção
+    lv_obj_add_event_cb(btn, network_button_cb, LV_EVENT_CLICKED, nullptr);
     
+    rows[slot] = {btn, label, info_label, -1};
+    return btn;
+}
+
+static lv_obj_t* build_wifi_scan_screen() {
     // Criar nova tela
     scan_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(scan_screen);
     common::apply_screen_style(scan_screen);
     
     // Usar layout manual para elementos principais (título e botão voltar)
-    // e um container flex para a lista
+    // e posições absolutas na lista (linhas recicladas)
     
     // Título
     title_label = common::create_screen_title(scan_screen, "Escaneando WiFi...");
@@ -104,38 +229,69 @@ void show_wifi_scan_screen(WiFiScanCallback on_select) {
     // Topo: ~65px (40 header + 25 status)
     // Botão Voltar: ~50px altura total com padding
     // Altura disp: 240 - 65 - 50 - 10 = 115px aprox
-    lv_obj_set_height(list_obj, 115);
+    lv_obj_set_height(list_obj, LIST_HEIGHT);
     lv_obj_align(list_obj, LV_ALIGN_TOP_MID, 0, common::HEADER_HEIGHT + 30);
     
     lv_obj_set_style_bg_color(list_obj, lv_color_white(), 0);
     lv_obj_set_style_border_color(list_obj, common::COLOR_BORDER(), 0);
     lv_obj_set_style_border_width(list_obj, 1, 0);
     lv_obj_set_style_radius(list_obj, common::BUTTON_RADIUS, 0);
-    lv_obj_set_style_pad_all(list_obj, 6, 0);
-    lv_obj_set_style_pad_row(list_obj, 6, 0);
-    lv_obj_set_flex_flow(list_obj, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_all(list_obj, LIST_PAD, 0);
     lv_obj_set_scrollbar_mode(list_obj, LV_SCROLLBAR_MODE_ACTIVE);
     lv_obj_set_scroll_dir(list_obj, LV_DIR_VER);
+    lv_obj_add_event_cb(list_obj, list_scroll_cb, LV_EVENT_SCROLL, nullptr);
     
-    // Botão voltar
-    back_button = common::create_back_button(scan_screen, back_button_cb);
-    
-    // Carregar a tela primeiro para mostrar "Escaneando..."
-    lv_screen_load(scan_screen);
-    lv_obj_invalidate(scan_screen);
+    // Marca o fim do conteúdo: a área rolável cobre todas as redes, não só as linhas criadas
+    list_spacer = lv_obj_create(list_obj);
+    lv_obj_remove_style_all(list_spacer);
+    lv_obj_set_size(list_spacer, 1, 1);
+    lv_obj_remove_flag(list_spacer, LV_OBJ_FLAG_CLICKABLE);
     
-    lvgl_unlock();
+    for (int slot = 0; slot < ROW_POOL; ++slot) {
+        create_row(slot);
+    }
     
-    ESP_LOGI(TAG, "Iniciando scan WiFi...");
+    // Botão voltar
+    back_button = common::create_back_button(scan_screen, back_button_cb);
     
-    // Fazer scan
-    wifi_ap_record_t ap_records[20];
-    auto& wifi = WiFiManager::instance();
-    network_count = wifi.scan(ap_records, 20);
+    return scan_screen;
+}
+
+static void release_wifi_scan_screen() {
+    scan_screen = nullptr;
+    title_label = nullptr;
+    status_label = nullptr;
+    list_obj = nullptr;
+    list_spacer = nullptr;
+    back_button = nullptr;
+    for (Row& row : rows) {
+        row = {nullptr, nullptr, nullptr, -1};
+    }
+}
+
+// Transitória: a lista só vale para o scan que a preencheu
+static const ScreenHooks WIFI_SCAN_SCREEN = {
+    "wifi_scan", ScreenRetention::Transient, build_wifi_scan_screen, nullptr, release_wifi_scan_screen,
+};
+
+// Job da UI: mostra o que o worker já fundiu (vários lotes podem chegar num só refresh)
+static void refresh_list_job(uintptr_t) {
+    refresh_posted = false;
+    if (scan_screen == nullptr) {
+        return;
+    }
     
-    lvgl_lock();
+    if (rows_dirty) {
+        rows_dirty = false;
+        lv_obj_set_y(list_spacer, std::max(0, network_count * ROW_PITCH - (ROW_PITCH - ROW_HEIGHT) - 1));
+        bind_visible_rows(true);
+    }
     
-    if (network_count < 0) {
+    char status_text[64];
+    if (!scan_finished) {
+        snprintf(status_text, sizeof(status_text), "Buscando redes... %d encontrada(s)", network_count);
+        lv_label_set_text(status_label, status_text);
+    } else if (scan_failed && network_count == 0) {
         ESP_LOGE(TAG, "Erro ao fazer scan WiFi");
         lv_label_set_text(status_label, "Erro ao escanear redes");
         lv_obj_set_style_text_color(status_label, common::COLOR_ERROR(), 0);
@@ -144,119 +300,154 @@ void show_wifi_scan_screen(WiFiScanCallback on_select) {
         lv_label_set_text(status_label, "Nenhuma rede encontrada");
         lv_obj_set_style_text_color(status_label, common::COLOR_WARNING(), 0);
     } else {
-        ESP_LOGI(TAG, "Encontradas %d redes", network_count);
-        
-        // Copiar informações para array local
-        for (int i = 0; i < network_count; i++) {
-            strncpy(networks[i].ssid, (const char*)ap_records[i].ssid, sizeof(networks[i].ssid) - 1);
-            networks[i].ssid[sizeof(networks[i].ssid) - 1] = '\0';
-            networks[i].rssi = ap_records[i].rssi;
-            networks[i].has_password = (ap_records[i].authmode != WIFI_AUTH_OPEN);
+        snprintf(status_text, sizeof(status_text), "%d rede(s) encontrada(s)", network_count);
+        lv_label_set_text(status_label, status_text);
+    }
+    if (network_count > 0) {
+        lv_label_set_text(title_label, "Selecione uma rede");
+    }
+}
+
+// Mantém um registro por SSID, com o RSSI do AP mais forte; redes ocultas ficam de fora
+static void merge_record(const wifi_ap_record_t& record) {
+    const char* ssid = reinterpret_cast<const char*>(record.ssid);
+    if (ssid[0] == '\0') {
+        return;
+    }
+    for (int i = 0; i < network_count; i++) {
+        if (strncmp(networks[i].ssid, ssid, sizeof(networks[i].ssid)) == 0) {
+            if (record.rssi > networks[i].rssi) {
+                networks[i].rssi = record.rssi;
+                networks[i].has_password = (record.authmode != WIFI_AUTH_OPEN);
+            }
+            return;
+        }
+    }
+    
+    // Lista cheia: a nova rede só entra no lugar da mais fraca
+    int slot = network_count;
+    if (network_count == MAX_NETWORKS) {
+        slot = MAX_NETWORKS - 1;
+        if (record.rssi <= networks[slot].rssi) {
+            return;
+        }
+    } else {
+        network_count++;
+    }
+    strncpy(networks[slot].ssid, ssid, sizeof(networks[slot].ssid) - 1);
+    networks[slot].ssid[sizeof(networks[slot].ssid) - 1] = '\0';
+    networks[slot].rssi = record.rssi;
+    networks[slot].has_password = (record.authmode != WIFI_AUTH_OPEN);
+}
+
+/**
+ * @brief Funde um lote no resultado e agenda o refresh da lista
+ *
+ * @return false se a tela fechou ou outra varredura começou (a atual desiste)
+ */
+static bool publish_batch(uint32_t generation, uint16_t count, bool finished, bool failed) {
+    lvgl_lock();
+    const bool current = generation == scan_generation && scan_screen != nullptr;
+    if (current) {
+        for (uint16_t i = 0; i < count; i++) {
+            merge_record(scan_records[i]);
         }
-        
         // Ordenar por RSSI (mais forte primeiro)
         std::sort(networks, networks + network_count, compare_networks);
-        
-        // Limpar container anterior
-        lv_obj_clean(list_obj);
-        
-        // Adicionar redes ao container
-        for (int i = 0; i < network_count; i++) {
-            // Criar botão para cada rede usando estilo padrão, mas customizado para row
-            lv_obj_t* btn = lv_button_create(list_obj);
-            lv_obj_set_width(btn, lv_pct(100));
-            lv_obj_set_height(btn, 34);
-            lv_obj_set_style_bg_color(btn, lv_color_white(), 0);
-            lv_obj_set_style_border_color(btn, common::COLOR_BORDER(), 0);
-            lv_obj_set_style_border_width(btn, 1, 0);
-            lv_obj_set_style_radius(btn, common::BUTTON_RADIUS - 2, 0); // Um pouco menos arredondado na lista
-            lv_obj_set_style_pad_hor(btn, 8, 0);
-            lv_obj_set_style_pad_ver(btn, 4, 0);
-            lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
-            lv_obj_set_flex_flow(btn, LV_FLEX_FLOW_ROW);
-            lv_obj_set_flex_align(btn,
-                                  LV_FLEX_ALIGN_SPACE_BETWEEN,
-                                  LV_FLEX_ALIGN_CENTER,
-                                  LV_FLEX_ALIGN_CENTER);
-            
-            // Criar label com SSID
-            char ssid_display[50];
-            strncpy(ssid_display, networks[i].ssid, sizeof(ssid_display) - 1);
-            ssid_display[sizeof(ssid_display) - 1] = '\0';
-            
-            lv_obj_t* label = lv_label_create(btn);
-            lv_label_set_text(label, ssid_display);
-            lv_obj_set_style_text_color(label, common::COLOR_TEXT_BLACK(), 0);
-            lv_obj_set_style_text_font(label, common::TEXT_FONT, 0);
-            lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL_CIRCULAR);
-            lv_obj_set_width(label, lv_pct(65));
-            
-            // Indicador de senha + força do sinal (RSSI)
-            const char* security_text = networks[i].has_password ? "Senha" : "Aberto";
-            const char* rssi_text = nullptr;
-            if (networks[i].rssi > -50) {
-                rssi_text = "Excelente";
-            } else if (networks[i].rssi > -70) {
-                rssi_text = "Bom";
-            } else {
-                rssi_text = "Fraco";
-            }
-            
-            char info_text[32];
-            snprintf(info_text, sizeof(info_text), "%s | %s", security_text, rssi_text);
-            
-            lv_obj_t* info_label = lv_label_create(btn);
-            lv_label_set_text(info_label, info_text);
-            lv_obj_set_style_text_color(info_label, common::COLOR_TEXT_GRAY(), 0);
-            lv_obj_set_style_text_font(info_label, common::CAPTION_FONT, 0);
-            lv_label_set_long_mode(info_label, LV_LABEL_LONG_CLIP);
-            lv_obj_set_width(info_label, lv_pct(35));
-            lv_obj_set_style_text_align(info_label, LV_TEXT_ALIGN_RIGHT, 0);
-            
-            // Armazenar índice como user_data
-            lv_obj_set_user_data(btn, (void*)(intptr_t)i);
-            
-            // Callback para seleção
-            lv_obj_add_event_cb(btn, network_button_cb, LV_EVENT_CLICKED, nullptr);
+        rows_dirty = rows_dirty || count > 0;
+        scan_finished = finished;
+        scan_failed = failed;
+        if (!refresh_posted) {
+            refresh_posted = jobs::post(refresh_list_job);
+        }
+    }
+    lvgl_unlock();
+    return current;
+}
+
+// Job do worker: varre um canal por vez e publica cada lote assim que chega
+static void scan_job(uintptr_t arg) {
+    const uint32_t generation = static_cast<uint32_t>(arg);
+    const int64_t started_us = esp_timer_get_time();
+    bool any_ok = false;
+    
+    for (uint8_t channel = 1; channel <= SCAN_CHANNELS; channel++) {
+        wifi_scan_config_t config = {};
+        config.channel = channel;
+        esp_err_t err = esp_wifi_scan_start(&config, true);
+        if (err != ESP_OK && channel == 1) {
+            // Estação ocupada (conectando): a varredura do WiFiManager resolve, mas de uma vez só
+            ESP_LOGW(TAG, "Scan por canal indisponível (%s); usando o scan completo", esp_err_to_name(err));
+            const int found = WiFiManager::instance().scan(scan_records, SCAN_BATCH);
+            publish_batch(generation, found > 0 ? found : 0, true, found < 0);
+            return;
         }
         
-        // Atualizar status
-        char status_text[64];
-        snprintf(status_text, sizeof(status_text), "%d rede(s) encontrada(s)", network_count);
-        lv_label_set_text(status_label, status_text);
-        lv_obj_set_style_text_color(status_label, common::COLOR_TEXT_BLACK(), 0);
-        lv_label_set_text(title_label, "Selecione uma rede");
+        uint16_t found = 0;
+        if (err == ESP_OK) {
+            any_ok = true;
+            found = SCAN_BATCH;
+            esp_wifi_scan_get_ap_records(&found, scan_records);
+        } else {
+            ESP_LOGW(TAG, "Falha no scan do canal %u: %s", channel, esp_err_to_name(err));
+        }
+        const bool last = channel == SCAN_CHANNELS;
+        if (!publish_batch(generation, found, last, last && !any_ok)) {
+            ESP_LOGI(TAG, "Tela de scan fechada durante o scan");
+            return;
+        }
     }
     
-    lv_obj_invalidate(scan_screen);
+    ESP_LOGI(TAG, "Scan WiFi concluído em %lu ms: %d redes",
+             (unsigned long)((esp_timer_get_time() - started_us) / 1000), network_count);
+}
+
+void show_wifi_scan_screen(WiFiScanCallback on_select) {
+    ESP_LOGI(TAG, "show_wifi_scan_screen chamado");
+    
+    s_on_select = on_select;
+    
+    // Uma nova exibição sempre parte de uma tela limpa; carregá-la primeiro mostra "Escaneando..."
+    ScreenManager::instance().release(ScreenId::WifiScan);
     
+    lvgl_lock();
+    scan_generation++;
+    network_count = 0;
+    rows_dirty = false;
+    scan_finished = false;
+    scan_failed = false;
+    const uint32_t generation = scan_generation;
     lvgl_unlock();
     
-    ESP_LOGI(TAG, "Tela de scan WiFi criada");
+    ScreenManager::instance().show(ScreenId::WifiScan, WIFI_SCAN_SCREEN);
+    
+    // O scan roda no worker: a tela responde já no primeiro quadro e a lista cresce canal a canal
+    ESP_LOGI(TAG, "Iniciando scan WiFi...");
+    if (!jobs::post_worker(scan_job, generation)) {
+        ESP_LOGE(TAG, "Fila do worker cheia - scan não iniciado");
+        lvgl_lock();
+        scan_finished = true;
+        scan_failed = true;
+        refresh_list_job(0);
+        lvgl_unlock();
+    }
 }
 
 void hide_wifi_scan_screen() {
     ESP_LOGI(TAG, "hide_wifi_scan_screen chamado");
     
-    lvgl_lock();
-    
-    if (scan_screen != nullptr) {
-        lv_obj_del(scan_screen);
-        scan_screen = nullptr;
-        title_label = nullptr;
-        status_label = nullptr;
-        list_obj = nullptr;
-        back_button = nullptr;
-    }
+    // Deleção assíncrona: seguro mesmo chamado de dentro dos eventos da própria tela
+    ScreenManager::instance().release(ScreenId::WifiScan);
     
+    lvgl_lock();
+    scan_generation++;  // Uma varredura em andamento desiste no próximo canal
     network_count = 0;
     s_on_select = nullptr;
-    
     lvgl_unlock();
 }
 
 bool is_wifi_scan_screen_visible() {
-    return scan_screen != nullptr;
+    return ScreenManager::instance().is_active(ScreenId::WifiScan);
 }
 
 } // namespace screens
@@ -0,0 +1,261 @@
+#include "ui_background_ota.hpp"
+#include "ui_common_internal.hpp"
+
+#include "display_driver.hpp"
+#include "OtaManager.h"
+#include "ota_driver.hpp"
+#include "WiFiManager.h"
+#include "esp_log.h"
+#include "esp_sntp.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lvgl.h"
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+namespace ui::background_ota {
+
+namespace {
+constexpr char TAG[] = "OTA_BG";
+
+// Opt-in: sem ele o dispositivo só atualiza pela tela de atualização
+#ifdef CONFIG_HUB_BACKGROUND_OTA
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+constexpr uint32_t TASK_STACK_SIZE = ota::RUN_UPDATE_STACK_SIZE;
+// Prioridade mínima: só usa a CPU que sobra da UI, do WiFi e do worker
+constexpr UBaseType_t TASK_PRIORITY = tskIDLE_PRIORITY + 1;
+constexpr BaseType_t TASK_CORE = 0;
+
+// Deixa o boot (WiFi, Supabase, primeira tela) assentar antes da primeira consulta
+constexpr uint32_t FIRST_CHECK_DELAY_MS = 2 * 60 * 1000;
+constexpr uint32_t WIFI_POLL_MS = 30 * 1000;
+constexpr uint32_t APPLY_POLL_MS = 30 * 1000;
+
+// Pausa entre leituras de 4 KB: cada uma pode apagar um setor com o cache da flash desligado
+constexpr uint32_t YIELD_MS = 20;
+constexpr uint8_t PROGRESS_STEP = 10;
+
+// Na hora silenciosa ainda espera a tela parada: o reinício não pode cortar uma avaliação
+// (o envio ao Supabase sai logo após o toque)
+constexpr uint32_t QUIET_HOUR_MIN_IDLE_MS = 2 * 60 * 1000;
+
+// Antes disso o relógio ainda não passou pelo SNTP
+constexpr time_t CLOCK_VALID_AFTER = 1700000000;
+
+Config config = DEFAULT_CONFIG;
+TaskHandle_t task_handle = nullptr;
+
+Status current = {};
+portMUX_TYPE status_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void set_state(State state, esp_err_t err = ESP_OK) {
+    portENTER_CRITICAL(&status_lock);
+    current.state = state;
+    current.last_error = err;
+    portEXIT_CRITICAL(&status_lock);
+}
+
+void on_start(uint32_t resume_offset, uint32_t total_size) {
+    ESP_LOGI(TAG, "Baixando em segundo plano: %lu/%lu bytes", static_cast<unsigned long>(resume_offset),
+             static_cast<unsigned long>(total_size));
+}
+
+// Já vem espaçado pelo progress_step da política
+void on_progress(int percent) {
+    portENTER_CRITICAL(&status_lock);
+    current.progress = percent;
+    portEXIT_CRITICAL(&status_lock);
+    ESP_LOGI(TAG, "Download em segundo plano: %d%%", percent);
+}
+
+// Conclusão e falha chegam pelo retorno de run_update()
+const ota::UpdateCallbacks CALLBACKS = {on_start, on_progress, nullptr, nullptr};
+
+void start_clock() {
+    setenv("TZ", config.timezone, 1);
+    tzset();
+    if (!esp_sntp_enabled()) {
+        esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
+        esp_sntp_setservername(0, "pool.ntp.org");
+        esp_sntp_init();
+    }
+}
+
+uint32_t idle_ms() {
+    lvgl_lock();
+    const uint32_t inactive = lv_display_get_inactive_time(nullptr);
+    lvgl_unlock();
+    return inactive;
+}
+
+bool in_quiet_hour() {
+    const time_t now = time(nullptr);
+    if (config.quiet_hour < 0 || now < CLOCK_VALID_AFTER) {
+        return false;
+    }
+    struct tm local = {};
+    localtime_r(&now, &local);
+    return local.tm_hour == config.quiet_hour;
+}
+
+void log_frames(const char *label, const FrameTimeStats &stats) {
+    ESP_LOGI(TAG, "Quadros %s: %lu em %lu passadas, p50 %lu ms, p95 %lu ms, máx %.1f ms | intervalo p95 %lu ms, máx %.1f ms",
+             label, (unsigned long)stats.frames, (unsigned long)stats.passes, (unsigned long)(stats.p50_us / 1000),
+             (unsigned long)(stats.p95_us / 1000), stats.max_us / 1000.0f, (unsigned long)(stats.gap_p95_us / 1000),
+             stats.gap_max_us / 1000.0f);
+}
+
+void check_for_update() {
+    auto &frames = DisplayDriver::instance().frame_times();
+    // Janela "antes": desde a consulta anterior (ou o boot)
+    const FrameTimeStats before = frames.snapshot(true);
+
+    const ota::UpdatePolicy policy = {config.max_bytes_per_s, YIELD_MS, PROGRESS_STEP, false, true};
+    set_state(State::Downloading);
+    const int64_t started_us = esp_timer_get_time();
+    const esp_err_t err =
+        ota::OtaDriver::instance().run_update(config.url, OtaManager::instance().getDeviceId(), CALLBACKS, policy);
+    const uint32_t elapsed_ms = static_cast<uint32_t>((esp_timer_get_time() - started_us) / 1000);
+
+    if (err == ESP_ERR_INVALID_VERSION) {
+        set_state(State::Idle);
+        return;
+    }
+
+    const FrameTimeStats during = frames.snapshot(true);
+    portENTER_CRITICAL(&status_lock);
+    current.download_ms = elapsed_ms;
+    current.frames_before = before;
+    current.frames_during = during;
+    portEXIT_CRITICAL(&status_lock);
+
+    ESP_LOGI(TAG, "Download em segundo plano terminou em %.1f s (%s)", elapsed_ms / 1000.0f, esp_err_to_name(err));
+    log_frames("antes", before);
+    log_frames("durante", during);
+
+    if (err != ESP_OK) {
+        // O progresso conferido fica no NVS: a próxima consulta retoma
+        set_state(State::Failed, err);
+        return;
+    }
+    portENTER_CRITICAL(&status_lock);
+    strncpy(current.version, ota::OtaDriver::instance().staged_version(), sizeof(current.version) - 1);
+    portEXIT_CRITICAL(&status_lock);
+    set_state(State::Staged);
+}
+
+bool apply_window_open() {
+    const uint32_t inactive_ms = idle_ms();
+    if (config.idle_minutes > 0 && inactive_ms >= config.idle_minutes * 60u * 1000u) {
+        ESP_LOGI(TAG, "Aplicando após %lu min sem toque", (unsigned long)(inactive_ms / 60000));
+        return true;
+    }
+    if (inactive_ms >= QUIET_HOUR_MIN_IDLE_MS && in_quiet_hour()) {
+        ESP_LOGI(TAG, "Aplicando na hora silenciosa (%02d h)", config.quiet_hour);
+        return true;
+    }
+    return false;
+}
+
+void apply_staged() {
+    set_state(State::Applying);
+    const esp_err_t err = ota::OtaDriver::instance().activate_staged();
+    if (err != ESP_OK) {
+        set_state(State::Failed, err);
+        return;
+    }
+    ESP_LOGI(TAG, "Reiniciando em %s", current.version);
+    vTaskDelay(pdMS_TO_TICKS(100));  // Deixa o log sair pela serial
+    esp_restart();
+}
+
+void background_task(void *) {
+    vTaskDelay(pdMS_TO_TICKS(FIRST_CHECK_DELAY_MS));
+    OtaManager::instance().init();
+
+    bool clock_started = false;
+    int64_t next_check_us = 0;
+    for (;;) {
+        if (ota::OtaDriver::instance().has_staged()) {
+            // Sem auto_apply só espera: a tela de atualização confere o slot e reinicia
+            if (config.auto_apply && apply_window_open()) {
+                apply_staged();
+            }
+            vTaskDelay(pdMS_TO_TICKS(APPLY_POLL_MS));
+            continue;
+        }
+
+        auto &wifi = WiFiManager::instance();
+        if (!wifi.is_connected()) {
+            vTaskDelay(pdMS_TO_TICKS(WIFI_POLL_MS));
+            continue;
+        }
+        if (!clock_started) {
+            start_clock();
+            clock_started = true;
+        }
+
+        // A tela de atualização tem a vez: run_update() recusa uma segunda chamada
+        if (esp_timer_get_time() >= next_check_us && !ota::OtaDriver::instance().is_running()) {
+            check_for_update();
+            next_check_us = esp_timer_get_time() + static_cast<int64_t>(config.check_interval_s) * 1000000;
+            continue;
+        }
+        vTaskDelay(pdMS_TO_TICKS(WIFI_POLL_MS));
+    }
+}
+} // namespace
+
+void start(const Config &cfg) {
+    if (!ENABLED) {
+        set_state(State::Disabled);
+        ESP_LOGI(TAG, "OTA em segundo plano desligado (CONFIG_HUB_BACKGROUND_OTA)");
+        return;
+    }
+    if (task_handle != nullptr) {
+        return;
+    }
+    config = cfg;
+    if (xTaskCreatePinnedToCore(background_task, "ota_bg", TASK_STACK_SIZE, nullptr, TASK_PRIORITY, &task_handle,
+                                TASK_CORE) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar task de OTA em segundo plano");
+        task_handle = nullptr;
+        return;
+    }
+    if (config.auto_apply) {
+        ESP_LOGI(TAG, "OTA em segundo plano: consulta a cada %lu min, %lu KB/s, hora silenciosa %d h, %u min sem toque",
+                 (unsigned long)(config.check_interval_s / 60), (unsigned long)(config.max_bytes_per_s / 1024),
+                 config.quiet_hour, static_cast<unsigned>(config.idle_minutes));
+    } else {
+        ESP_LOGI(TAG, "OTA em segundo plano: consulta a cada %lu min, %lu KB/s, aplica só pela tela de atualização",
+                 (unsigned long)(config.check_interval_s / 60), (unsigned long)(config.max_bytes_per_s / 1024));
+    }
+}
+
+Status status() {
+    portENTER_CRITICAL(&status_lock);
+    const Status copy = current;
+    portEXIT_CRITICAL(&status_lock);
+    return copy;
+}
+
+const char *state_name(State state) {
+    switch (state) {
+        case State::Idle: return "ocioso";
+        case State::Downloading: return "baixando";
+        case State::Staged: return "pronta";
+        case State::Applying: return "aplicando";
+        case State::Failed: return "falhou";
+        case State::Disabled: return "desligado";
+    }
+    return "?";
+}
+
+} // namespace ui::background_ota
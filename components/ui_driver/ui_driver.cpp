@@ -1,6 +1,13 @@
 #include "ui_driver.hpp"
 #include "ui_common.hpp"
 #include "ui_common_internal.hpp" // Include internal helper definitions
+#include "ui_fonts.hpp"
+#include "screen_manager.hpp"
+#include "ui_jobs.hpp"
+#include "ui_background_ota.hpp"
+#include "ui_telemetry.hpp"
+#include "ui_wifi_link.hpp"
+#include "ui_theme.hpp"
 #include "screens/wifi_config_screen.hpp"
 #include "screens/brightness_screen.hpp"
 #include "screens/password_screen.hpp"
@@ -8,6 +15,7 @@
 #include "screens/about_screen.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <functional>
@@ -16,22 +24,19 @@
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_mac.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "lvgl.h"
 #include "display_driver.hpp"
+#include "boot_profile.hpp"
+#include "trace.hpp"
 #include "WiFiManager.h"
 #include "supabase_driver.hpp"
 
 // Declarar fonte Roboto customizada (suporta acentos portugueses)
 LV_FONT_DECLARE(roboto);
-// Declarar fonte Montserrat para ícones (padrão do LVGL)
-LV_FONT_DECLARE(lv_font_montserrat_20);
-
-// Mutex externo do display_driver
-extern SemaphoreHandle_t lvgl_mutex;
-extern TaskHandle_t lvgl_task_handle;
 
 extern "C" {
 }
@@ -48,37 +53,15 @@ void lv_imgfont_destroy(lv_font_t * font);
 #endif
 
 
-// Helper para lock/unlock LVGL (exportado para uso em outros arquivos)
-void lvgl_lock() {
-    if (lvgl_mutex != nullptr) {
-        if (xTaskGetCurrentTaskHandle() == lvgl_task_handle) {
-            return; // Já estamos no task do LVGL, não precisa lock
-        }
-        xSemaphoreTake(lvgl_mutex, portMAX_DELAY);
-    }
-}
-
-void lvgl_unlock() {
-    if (lvgl_mutex != nullptr) {
-        if (xTaskGetCurrentTaskHandle() == lvgl_task_handle) {
-            return; // Task do LVGL não adquiriu lock, nada a fazer
-        }
-        xSemaphoreGive(lvgl_mutex);
-    }
-}
-
-// Variáveis de timeout (fora do namespace anônimo para acesso externo)
-bool password_timeout_pending = false;
-uint32_t password_timeout_counter = 0;
-constexpr uint32_t PASSWORD_TIMEOUT_CYCLES = 100;  // 100 ciclos (~10s)
-
-bool config_timeout_pending = false;
-uint32_t config_timeout_counter = 0;
-constexpr uint32_t CONFIG_TIMEOUT_CYCLES = 100;  // 100 ciclos (~10s)
-
 namespace {
 constexpr char TAG[] = "UI";
 
+// Prazos da máquina de estados (disparados por lv_timer one-shot)
+constexpr uint32_t THANK_YOU_RETURN_DELAY_MS = 10000;  // Retorno automático após agradecer
+constexpr uint32_t PASSWORD_TIMEOUT_MS = 10000;        // Inatividade na tela de senha
+constexpr uint32_t CONFIG_TIMEOUT_MS = 10000;          // Inatividade na tela de configurações
+constexpr uint32_t WIFI_STATUS_PERIOD_MS = 1000;       // Verificação do ícone WiFi
+
 // Declaração forward
 static void update_wifi_status_icon();
 
@@ -99,19 +82,24 @@ enum class AppState {
     ABOUT,         // Tela "Sobre"
 };
 
+// Eventos que dirigem as transições entre estados
+enum class UiEvent : uintptr_t {
+    RATING_SELECTED,    // Avaliação tocada na tela de pergunta
+    THANK_YOU_ELAPSED,  // Prazo da tela de agradecimento venceu
+    PASSWORD_TIMEOUT,   // Tela de senha ficou ociosa
+    CONFIG_TIMEOUT,     // Tela de configurações ficou ociosa
+};
+
 AppState current_state = AppState::CALIBRATION;
 int selected_rating = 0;  // 0 = nenhuma, 1-5 = avaliação selecionada
-bool pending_screen_transition = false;  // Flag para transição assíncrona de tela
-uint32_t transition_delay_counter = 0;  // Contador para delay antes da transição
-bool thank_you_return_pending = false;  // Controla retorno automático à tela principal
-uint32_t thank_you_return_counter = 0;  // Contador para delay do retorno automático
-constexpr uint32_t THANK_YOU_RETURN_DELAY_CYCLES = 100;  // 100 ciclos (~10s)
 bool wifi_status_last_connected = false;  // Estado conhecido do WiFi para o ícone
-bool wifi_status_update_pending = false;  // Flag para atualizar ícone após mudança de estado
 
-// Flags para transições pendentes de timeout (processadas de forma assíncrona)
-bool password_timeout_transition_pending = false;
-bool config_timeout_transition_pending = false;
+// Timers one-shot dos prazos (pausados quando desarmados) e timer periódico do ícone WiFi.
+// Só são manipulados no contexto do LVGL ou com lvgl_lock().
+lv_timer_t *thank_you_timer = nullptr;
+lv_timer_t *password_timer = nullptr;
+lv_timer_t *config_timer = nullptr;
+lv_timer_t *wifi_status_timer = nullptr;
 
 // Objetos LVGL
 lv_obj_t *question_screen = nullptr;
@@ -131,36 +119,103 @@ void start_calibration();
 void show_question_screen();
 void show_thank_you_screen();
 void show_configuration_screen();
-void create_configuration_screen();
 static void update_wifi_status_icon();  // Atualizar ícone de status WiFi
 
-// Callbacks assíncronos para processar timeouts em contexto seguro do LVGL
-static void password_timeout_async_cb(void *user_data) {
-    ESP_LOGI(TAG, "Processando timeout de senha - voltando para tela principal");
-    ::ui::screens::hide_password_screen();
-    show_question_screen();
-    password_timeout_transition_pending = false;
+// Processa um evento no contexto do LVGL (timers e callbacks assíncronos)
+static void dispatch(UiEvent event) {
+    switch (event) {
+    case UiEvent::RATING_SELECTED:
+        if (current_state == AppState::QUESTION && selected_rating > 0) {
+            show_thank_you_screen();
+        }
+        break;
+    case UiEvent::THANK_YOU_ELAPSED:
+        if (current_state == AppState::THANK_YOU) {
+            show_question_screen();
+        }
+        break;
+    case UiEvent::PASSWORD_TIMEOUT:
+        if (::ui::screens::is_password_screen_visible()) {
+            ESP_LOGI(TAG, "Timeout na tela de senha - voltando para tela principal");
+            ::ui::screens::hide_password_screen();
+            show_question_screen();
+        }
+        break;
+    case UiEvent::CONFIG_TIMEOUT:
+        if (current_state == AppState::CONFIGURATION) {
+            ESP_LOGI(TAG, "Timeout na tela de configurações - voltando para tela principal");
+            show_question_screen();
+        }
+        break;
+    }
 }
 
-static void config_timeout_async_cb(void *user_data) {
-    ESP_LOGI(TAG, "Processando timeout de configurações - voltando para tela principal");
-    show_question_screen();
-    config_timeout_transition_pending = false;
+static void deadline_timer_cb(lv_timer_t *timer) {
+    dispatch(static_cast<UiEvent>(reinterpret_cast<uintptr_t>(lv_timer_get_user_data(timer))));
 }
 
-// Função helper para criar cores
-static lv_color_t make_color(uint32_t hex) {
-    return lv_color_hex(hex);
+static void posted_event_cb(void *user_data) {
+    dispatch(static_cast<UiEvent>(reinterpret_cast<uintptr_t>(user_data)));
 }
 
-// Cores para os botões de avaliação
-static const lv_color_t RATING_COLORS[] = {
-    make_color(0xFF0000),  // Vermelho (1 - Muito Insatisfeito)
-    make_color(0xFF6600),  // Laranja (2 - Insatisfeito)
-    make_color(0xFFCC00),  // Amarelo (3 - Neutro)
-    make_color(0x99FF00),  // Verde claro (4 - Satisfeito)
-    make_color(0x00FF00),  // Verde (5 - Muito Satisfeito)
-};
+// Enfileira o evento para a próxima passada do lv_timer_handler (mesmo frame),
+// fora do callback de evento do objeto que o originou
+static void post_event(UiEvent event) {
+    lv_async_call(posted_event_cb, reinterpret_cast<void *>(static_cast<uintptr_t>(event)));
+}
+
+// Timer one-shot reutilizável: com auto_delete desligado o LVGL apenas pausa
+// o timer quando o repeat_count chega a zero
+static lv_timer_t *create_deadline_timer(UiEvent event) {
+    lv_timer_t *timer = lv_timer_create(deadline_timer_cb, 1000,
+                                        reinterpret_cast<void *>(static_cast<uintptr_t>(event)));
+    lv_timer_set_auto_delete(timer, false);
+    lv_timer_pause(timer);
+    return timer;
+}
+
+static void arm_deadline(lv_timer_t *timer, uint32_t delay_ms) {
+    if (timer == nullptr) {
+        return;
+    }
+    lv_timer_set_period(timer, delay_ms);
+    lv_timer_set_repeat_count(timer, 1);
+    lv_timer_reset(timer);
+    lv_timer_resume(timer);
+}
+
+static void cancel_deadline(lv_timer_t *timer) {
+    if (timer != nullptr) {
+        lv_timer_pause(timer);
+    }
+}
+
+// Troca de estado: desarma os prazos do estado anterior e arma o do novo.
+// O timeout de senha é armado pela própria tela de senha (reset_password_timeout).
+static void enter_state(AppState next) {
+    lvgl_lock();
+    cancel_deadline(thank_you_timer);
+    cancel_deadline(password_timer);
+    cancel_deadline(config_timer);
+    current_state = next;
+    switch (next) {
+    case AppState::THANK_YOU:
+        arm_deadline(thank_you_timer, THANK_YOU_RETURN_DELAY_MS);
+        break;
+    case AppState::CONFIGURATION:
+        arm_deadline(config_timer, CONFIG_TIMEOUT_MS);
+        break;
+    default:
+        break;
+    }
+    lvgl_unlock();
+}
+
+static void wifi_status_timer_cb(lv_timer_t *timer) {
+    if (current_state == AppState::QUESTION) {
+        update_wifi_status_icon();
+    }
+}
 
 // Números grandes para os botões (1 a 5)
 constexpr const char *RATING_NUMBERS[] = {
@@ -230,8 +285,9 @@ static const char* get_device_id_string() {
     return DEVICE_ID_BUFFER;
 }
 
-// Função para enviar avaliação ao Supabase
-static void send_rating_to_supabase(int rating) {
+// Job do worker: envia a avaliação ao Supabase (HTTPS, fora do task do LVGL)
+static void send_rating_to_supabase(uintptr_t arg) {
+    const int rating = static_cast<int>(arg);
     auto& wifi = WiFiManager::instance();
     if (!wifi.is_connected()) {
         ESP_LOGW(TAG, "WiFi não conectado - avaliação não será enviada ao Supabase");
@@ -255,9 +311,9 @@ static void send_rating_to_supabase(int rating) {
     
     ESP_LOGI(TAG, "Enviando avaliação %d (%s) para Supabase...", rating, rating_data.message);
     
-    // Enviar avaliação (não bloqueia - executa em background)
     esp_err_t err = supabase.submit_rating(rating_data);
     if (err == ESP_OK) {
+        ::ui::wifi_link::mark_upload();
         ESP_LOGI(TAG, "Avaliação enviada com sucesso para Supabase!");
     } else {
         ESP_LOGE(TAG, "Erro ao enviar avaliação para Supabase: %s", esp_err_to_name(err));
@@ -268,22 +324,20 @@ static void send_rating_to_supabase(int rating) {
 static void rating_button_cb(lv_event_t *e) {
     lv_event_code_t code = lv_event_get_code(e);
     
-    ESP_LOGI(TAG, "rating_button_cb: evento=%d, estado=%d", code, static_cast<int>(current_state));
+    // Obter o índice do botão (1-5)
+    int rating = reinterpret_cast<intptr_t>(lv_event_get_user_data(e));
+    trace::emit(trace::Event::RATING_CLICK, static_cast<uint32_t>(rating), static_cast<uint32_t>(current_state));
     
     // Processar apenas eventos de clique
     if (code == LV_EVENT_CLICKED && current_state == AppState::QUESTION) {
-        // Obter o índice do botão (1-5)
-        int rating = reinterpret_cast<intptr_t>(lv_event_get_user_data(e));
+        DisplayDriver::instance().input_latency().arm(InputLatencyKind::Rating, lv_event_get_target_obj(e));
         selected_rating = rating;
         
-        ESP_LOGI(TAG, "Avaliação selecionada: %d", rating);
+        // Enviar avaliação ao Supabase pelo worker (se WiFi estiver conectado)
+        ::ui::jobs::post_worker(send_rating_to_supabase, rating);
         
-        // Enviar avaliação ao Supabase (se WiFi estiver conectado)
-        send_rating_to_supabase(rating);
-        
-        // Marcar transição pendente (será processada no update() para evitar problemas de contexto)
-        pending_screen_transition = true;
-        transition_delay_counter = 0;  // Resetar contador de delay
+        // Transição no próximo ciclo do handler, fora do callback do botão
+        post_event(UiEvent::RATING_SELECTED);
     }
 }
 
@@ -353,14 +407,7 @@ static void finish_calibration() {
         return (static_cast<uint32_t>(a) + static_cast<uint32_t>(b)) / 2;
     };
 
-    // Log detalhado dos valores RAW capturados
-    ESP_LOGI(TAG, "=== VALORES RAW CAPTURADOS ===");
-    ESP_LOGI(TAG, "TL: rawX=%u rawY=%u", calibration_samples[CAL_TL].rawX, calibration_samples[CAL_TL].rawY);
-    ESP_LOGI(TAG, "TR: rawX=%u rawY=%u", calibration_samples[CAL_TR].rawX, calibration_samples[CAL_TR].rawY);
-    ESP_LOGI(TAG, "BR: rawX=%u rawY=%u", calibration_samples[CAL_BR].rawX, calibration_samples[CAL_BR].rawY);
-    ESP_LOGI(TAG, "BL: rawX=%u rawY=%u", calibration_samples[CAL_BL].rawX, calibration_samples[CAL_BL].rawY);
-    ESP_LOGI(TAG, "CENTER: rawX=%u rawY=%u", calibration_samples[CAL_CENTER].rawX, calibration_samples[CAL_CENTER].rawY);
-
+    // Valores RAW de cada ponto ficam no trace (CALIBRATION_POINT)
     TouchCalibration new_cal = {};
     
     // Obter as posições reais dos pontos de calibração (não os cantos absolutos)
@@ -483,21 +530,11 @@ static void finish_calibration() {
 
     DisplayDriver::instance().update_touch_calibration(new_cal);
 
-    lvgl_lock();
-    if (calibration_screen != nullptr) {
-        lv_obj_del(calibration_screen);
-        calibration_screen = nullptr;
-        calibration_label = nullptr;
-        calibration_target = nullptr;
-    }
-    lvgl_unlock();
-
-    // Voltar para o estado anterior (configuração ou pergunta)
+    // Voltar para o estado anterior (configuração ou pergunta); a tela de
+    // calibração é transitória e o ScreenManager a descarta ao trocar de tela
     if (state_before_calibration == AppState::CONFIGURATION) {
-        current_state = AppState::CONFIGURATION;
         show_configuration_screen();
     } else {
-        current_state = AppState::QUESTION;
         show_question_screen();
     }
 }
@@ -523,6 +560,8 @@ static void calibration_touch_event_cb(lv_event_t *e) {
     }
 
     calibration_samples[current_calibration_index] = raw;
+    trace::emit(trace::Event::CALIBRATION_POINT, static_cast<uint32_t>(current_calibration_index),
+                trace::pack_xy(raw.rawX, raw.rawY));
     calibration_point_captured = true;
     current_calibration_index++;
 
@@ -533,29 +572,12 @@ static void calibration_touch_event_cb(lv_event_t *e) {
     }
 }
 
-void start_calibration() {
-    ESP_LOGI(TAG, "Iniciando calibração do touch");
-    // Salvar estado atual para voltar após calibração
-    state_before_calibration = current_state;
-    current_state = AppState::CALIBRATION;
-    current_calibration_index = 0;
-    calibration_point_captured = false;
-
-    lvgl_lock();
-
-    if (calibration_screen != nullptr) {
-        lv_obj_del(calibration_screen);
-        calibration_screen = nullptr;
-        calibration_label = nullptr;
-        calibration_target = nullptr;
-    }
-
+static lv_obj_t *build_calibration_screen() {
     calibration_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(calibration_screen);
     ::ui::common::apply_screen_style(calibration_screen);
     lv_obj_add_flag(calibration_screen, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_flag(calibration_screen, LV_OBJ_FLAG_EVENT_BUBBLE);
-    lv_screen_load(calibration_screen);
 
     // Usar helper para título (mas ajustar posição se necessário)
     calibration_label = ::ui::common::create_screen_title(calibration_screen, "Calibrando tela...");
@@ -576,61 +598,55 @@ void start_calibration() {
     lv_obj_add_event_cb(calibration_screen, calibration_touch_event_cb, LV_EVENT_ALL, nullptr);
     lv_obj_add_event_cb(calibration_target, calibration_touch_event_cb, LV_EVENT_ALL, nullptr);
 
-    update_calibration_ui();
-    lvgl_unlock();
+    return calibration_screen;
 }
 
-void create_question_screen() {
-    ESP_LOGI(TAG, "create_question_screen() iniciado");
-    ESP_LOGI(TAG, "Chamando lvgl_lock()...");
-    lvgl_lock();
-    ESP_LOGI(TAG, "Mutex adquirido, continuando criação da tela...");
-    
-    if (question_screen != nullptr) {
-        ESP_LOGI(TAG, "Deletando tela existente...");
-        lv_obj_del(question_screen);
-        question_screen = nullptr;
-    }
-    
-    ESP_LOGI(TAG, "Criando nova tela...");
+static void release_calibration_screen() {
+    calibration_screen = nullptr;
+    calibration_label = nullptr;
+    calibration_target = nullptr;
+}
+
+static const ::ui::ScreenHooks CALIBRATION_SCREEN = {
+    "calibração", ::ui::ScreenRetention::Transient,
+    build_calibration_screen, update_calibration_ui, release_calibration_screen,
+};
+
+void start_calibration() {
+    ESP_LOGI(TAG, "Iniciando calibração do touch");
+    // Salvar estado atual para voltar após calibração
+    state_before_calibration = current_state;
+    enter_state(AppState::CALIBRATION);
+    current_calibration_index = 0;
+    calibration_point_captured = false;
+
+    ::ui::ScreenManager::instance().show(::ui::ScreenId::Calibration, CALIBRATION_SCREEN);
+}
+
+static lv_obj_t *build_question_screen() {
+    // Duração da construção no trace; o ScreenManager já loga o total por tela
+    trace::emit(trace::Event::QUESTION_BUILD_BEGIN);
     // Criar tela base - sem padding, sem estilo extra
     question_screen = lv_obj_create(nullptr);
     if (question_screen == nullptr) {
         ESP_LOGE(TAG, "Falha ao criar question_screen");
-        lvgl_unlock();
-        return;
+        trace::emit(trace::Event::QUESTION_BUILD_END);
+        return nullptr;
     }
-    ESP_LOGI(TAG, "Tela criada: %p", question_screen);
-    
-    ESP_LOGI(TAG, "Carregando tela como ativa...");
-    // Carregar a tela ANTES de criar elementos para garantir que seja a tela ativa
-    lv_screen_load(question_screen);
-    ESP_LOGI(TAG, "Tela carregada");
     
     lv_obj_remove_style_all(question_screen);
     ::ui::common::apply_screen_style(question_screen);
     // Garantir que a tela não bloqueie eventos (deixar eventos passarem para os filhos)
     lv_obj_clear_flag(question_screen, LV_OBJ_FLAG_CLICKABLE);
-    ESP_LOGI(TAG, "Estilos da tela configurados");
     
     // Header Container (Barra de status)
     lv_obj_t* header = lv_obj_create(question_screen);
     lv_obj_set_size(header, LV_PCT(100), ::ui::common::HEADER_HEIGHT);
     lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0xFFFFFF), 0);
-    lv_obj_set_style_bg_opa(header, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(header, 0, 0); // Sem borda padrão
-    lv_obj_set_style_border_side(header, LV_BORDER_SIDE_BOTTOM, 0);
-    lv_obj_set_style_border_width(header, 1, 0);
-    lv_obj_set_style_border_color(header, ::ui::common::COLOR_BORDER(), 0);
-    lv_obj_set_style_radius(header, 0, 0);
+    lv_obj_add_style(header, ::ui::theme::header(), 0);
     lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
 
     // Ícone de status WiFi (dentro do header, à esquerda)
-    if (wifi_status_icon != nullptr) {
-        lv_obj_del(wifi_status_icon);
-        wifi_status_icon = nullptr;
-    }
     // Botão do WiFi (pode ser clicável para abrir config direta no futuro se desejar)
     wifi_status_icon = lv_button_create(header);
     lv_obj_remove_style_all(wifi_status_icon);
@@ -644,20 +660,15 @@ void create_question_screen() {
     lv_label_set_text(wifi_label, LV_SYMBOL_WIFI);
     lv_obj_center(wifi_label);
     // Usar fonte Montserrat para ícones
-    lv_obj_set_style_text_font(wifi_label, &lv_font_montserrat_20, 0);
+    lv_obj_add_style(wifi_label, ::ui::theme::icon_label(), 0);
     // Definir cor inicial conforme estado atual do WiFi
     auto& wifi_mgr = WiFiManager::instance();
     bool wifi_connected = wifi_mgr.is_connected();
     lv_color_t wifi_color = wifi_connected ? ::ui::common::COLOR_SUCCESS() : ::ui::common::COLOR_ERROR();
     lv_obj_set_style_text_color(wifi_label, wifi_color, 0);
     wifi_status_last_connected = wifi_connected;
-    wifi_status_update_pending = false;
 
     // Botão de Configurações (dentro do header, à direita)
-    if (settings_button != nullptr) {
-        lv_obj_del(settings_button);
-        settings_button = nullptr;
-    }
     settings_button = lv_button_create(header);
     lv_obj_set_size(settings_button, 32, 32);
     lv_obj_align(settings_button, LV_ALIGN_RIGHT_MID, -8, 0);
@@ -668,13 +679,12 @@ void create_question_screen() {
     lv_label_set_text(settings_label, LV_SYMBOL_SETTINGS);
     lv_obj_center(settings_label);
     // Usar fonte Montserrat para ícones
-    lv_obj_set_style_text_font(settings_label, &lv_font_montserrat_20, 0);
+    lv_obj_add_style(settings_label, ::ui::theme::icon_label(), 0);
     lv_obj_set_style_text_color(settings_label, ::ui::common::COLOR_SETTINGS_BUTTON(), 0); // Cor original
     
     lv_obj_add_event_cb(settings_button, settings_button_cb, LV_EVENT_CLICKED, nullptr);
     
     // Título simples no topo (agora abaixo do header)
-    ESP_LOGI(TAG, "Criando label...");
     // Usar helper mas ajustar posição manual pois esta tela tem header customizado
     question_label = ::ui::common::create_screen_title(question_screen, "Como você se sentiu hoje?");
     lv_label_set_long_mode(question_label, LV_LABEL_LONG_WRAP);
@@ -686,7 +696,7 @@ void create_question_screen() {
     // Fileira 1: botões 1, 2, 3
     // Fileira 2: botões 4, 5
     // Todos igualmente espaçados
-    constexpr int BTN_SIZE = 66;  // Reduzido de 70 para 60 para caber na vertical
+    constexpr int BTN_SIZE = ::ui::common::RATING_BUTTON_SIZE;
     constexpr int BTN_SPACING = 20;  // Espaçamento reduzido de 30 para 20
     constexpr int ROW_SPACING = 6;  // Espaçamento vertical reduzido de 30 para 15
     
@@ -701,11 +711,6 @@ void create_question_screen() {
     constexpr int ROW2_START_X = (320 - (2 * BTN_SIZE + 1 * BTN_SPACING)) / 2;
     constexpr int ROW2_Y = ROW1_Y + BTN_SIZE + ROW_SPACING; // 90 + 60 + 15 = 165 -> Fim em 225px (dentro dos 240px)
     
-    ESP_LOGI(TAG, "Criando %d botões em 2 fileiras...", 5);
-    ESP_LOGI(TAG, "Botões: tamanho=%d, espaçamento=%d", BTN_SIZE, BTN_SPACING);
-    ESP_LOGI(TAG, "Fileira 1: start_x=%d, y=%d", ROW1_START_X, ROW1_Y);
-    ESP_LOGI(TAG, "Fileira 2: start_x=%d, y=%d", ROW2_START_X, ROW2_Y);
-    
     for (int i = 0; i < 5; i++) {
         int btn_x, btn_y;
         
@@ -719,78 +724,56 @@ void create_question_screen() {
             btn_y = ROW2_Y;
         }
         
-        ESP_LOGI(TAG, "Criando botão %d em posição (%d, %d)...", i, btn_x, btn_y);
         // Criar botão diretamente na tela, sem container intermediário
         rating_buttons[i] = lv_button_create(question_screen);
         
-        // Remover todos os estilos padrão antes de definir tamanho/posição
+        // Remover todos os estilos padrão: tamanho, cor, borda e padding vêm do tema
         lv_obj_remove_style_all(rating_buttons[i]);
-        
-        // Tamanho fixo e posição absoluta
-        lv_obj_set_size(rating_buttons[i], BTN_SIZE, BTN_SIZE);
+        lv_obj_add_style(rating_buttons[i], ::ui::theme::rating_button(i), 0);
         lv_obj_set_pos(rating_buttons[i], btn_x, btn_y);
         
-        // Estilo mínimo: apenas cor de fundo e borda
-        lv_obj_set_style_bg_color(rating_buttons[i], RATING_COLORS[i], 0);
-        lv_obj_set_style_bg_opa(rating_buttons[i], LV_OPA_COVER, 0);
-        lv_obj_set_style_radius(rating_buttons[i], BTN_SIZE / 2, 0); // Círculo perfeito
-        
-        // Borda simples
-        lv_obj_set_style_border_width(rating_buttons[i], 2, 0);
-        lv_obj_set_style_border_color(rating_buttons[i], lv_color_hex(0xFFFFFF), 0);
-        lv_obj_set_style_border_opa(rating_buttons[i], LV_OPA_COVER, 0);
-        
         // Garantir que o botão seja clicável
-        lv_obj_clear_flag(rating_buttons[i], LV_OBJ_FLAG_CLICKABLE);
         lv_obj_add_flag(rating_buttons[i], LV_OBJ_FLAG_CLICKABLE);
         
         // Label com número
         lv_obj_t *btn_label = lv_label_create(rating_buttons[i]);
         lv_label_set_text(btn_label, RATING_NUMBERS[i]);
+        lv_obj_add_style(btn_label, ::ui::theme::rating_label(), 0);
         lv_obj_center(btn_label);
-        // Usar fonte Roboto customizada
-        lv_obj_set_style_text_font(btn_label, ::ui::common::TITLE_FONT, 0);
-        lv_obj_set_style_text_color(btn_label, lv_color_white(), 0);
-        // Adicionar padding ao botão para evitar corte do texto
-        lv_obj_set_style_pad_all(rating_buttons[i], 4, 0);
         
         // Callback apenas para eventos de clique
         lv_obj_add_event_cb(rating_buttons[i], rating_button_cb, LV_EVENT_CLICKED,
                            reinterpret_cast<void*>(static_cast<intptr_t>(i + 1)));
         
-        ESP_LOGI(TAG, "Botão %d criado: %p, posição (%d,%d), tamanho %dx%d", 
-                 i, rating_buttons[i], btn_x, btn_y, BTN_SIZE, BTN_SIZE);
-        
         // Invalidar cada botão para garantir renderização
         lv_obj_invalidate(rating_buttons[i]);
     }
     
-    // Invalidar o label também
-    lv_obj_invalidate(question_label);
-    
-    // Invalidar toda a tela para garantir renderização completa
-    lv_obj_invalidate(question_screen);
-    
-    // Garantir que o layout seja atualizado antes do refresh
+    // Garantir que o layout seja calculado antes do primeiro refresh
     lv_obj_update_layout(question_screen);
     
-    ESP_LOGI(TAG, "Tela de pergunta criada: %p, Label: %p, Botões: %p %p %p %p %p", 
-             question_screen, question_label,
-             rating_buttons[0], rating_buttons[1], rating_buttons[2], 
-             rating_buttons[3], rating_buttons[4]);
+    trace::emit(trace::Event::QUESTION_BUILD_END);
     
-    lvgl_unlock();
-    ESP_LOGI(TAG, "create_question_screen() concluído");
-    
-    // Não atualizar status WiFi aqui - será atualizado automaticamente pelo update() periodicamente
+    // Não atualizar status WiFi aqui - o timer periódico do ícone cuida disso
     // Isso evita chamadas no contexto de eventos WiFi que podem causar stack overflow
+    return question_screen;
 }
 
-void create_thank_you_screen() {
-    if (thank_you_screen != nullptr) {
-        lv_obj_del(thank_you_screen);
-    }
-    
+static void release_question_screen() {
+    question_screen = nullptr;
+    question_label = nullptr;
+    wifi_status_icon = nullptr;
+    settings_button = nullptr;
+    std::fill(std::begin(rating_buttons), std::end(rating_buttons), nullptr);
+}
+
+// Tela principal: fixa no cache, volta instantaneamente após cada avaliação
+static const ::ui::ScreenHooks QUESTION_SCREEN = {
+    "pergunta", ::ui::ScreenRetention::Pinned,
+    build_question_screen, nullptr, release_question_screen,
+};
+
+static lv_obj_t *build_thank_you_screen() {
     thank_you_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(thank_you_screen);
     ::ui::common::apply_screen_style(thank_you_screen);
@@ -801,27 +784,36 @@ void create_thank_you_screen() {
     lv_obj_align(thank_you_label, LV_ALIGN_TOP_MID, 0, 30);
     
     thank_you_summary = lv_label_create(thank_you_screen);
-    lv_label_set_text_fmt(thank_you_summary,
-                          "Você registrou %d de 5 (%s).",
-                          selected_rating,
-                          RATING_MESSAGES[selected_rating - 1]);
-    lv_obj_set_style_text_align(thank_you_summary, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_color(thank_you_summary, ::ui::common::COLOR_TEXT_BLACK(), 0);
-    lv_obj_set_style_text_font(thank_you_summary, ::ui::common::CAPTION_FONT, 0);
+    // Padding vertical do estilo evita corte do texto
+    lv_obj_add_style(thank_you_summary, ::ui::theme::caption(), 0);
     lv_obj_set_width(thank_you_summary, LV_PCT(90));
     lv_label_set_long_mode(thank_you_summary, LV_LABEL_LONG_WRAP);
-    // Adicionar padding vertical ao label para evitar corte do texto
-    lv_obj_set_style_pad_top(thank_you_summary, 4, 0);
-    lv_obj_set_style_pad_bottom(thank_you_summary, 4, 0);
     lv_obj_align(thank_you_summary, LV_ALIGN_CENTER, 0, 0);
     
+    return thank_you_screen;
 }
 
-void create_configuration_screen() {
-    if (configuration_screen != nullptr) {
-        lv_obj_del(configuration_screen);
+static void refresh_thank_you_screen() {
+    if (thank_you_summary != nullptr && selected_rating > 0) {
+        lv_label_set_text_fmt(thank_you_summary,
+                              "Você registrou %d de 5 (%s).",
+                              selected_rating,
+                              RATING_MESSAGES[selected_rating - 1]);
     }
-    
+}
+
+static void release_thank_you_screen() {
+    thank_you_screen = nullptr;
+    thank_you_label = nullptr;
+    thank_you_summary = nullptr;
+}
+
+static const ::ui::ScreenHooks THANK_YOU_SCREEN = {
+    "agradecimento", ::ui::ScreenRetention::Cached,
+    build_thank_you_screen, refresh_thank_you_screen, release_thank_you_screen,
+};
+
+static lv_obj_t *build_configuration_screen() {
     configuration_screen = lv_obj_create(nullptr);
     lv_obj_remove_style_all(configuration_screen);
     ::ui::common::apply_screen_style(configuration_screen);
@@ -829,11 +821,8 @@ void create_configuration_screen() {
     // Título posicionado no topo
     lv_obj_t *title_label = lv_label_create(configuration_screen);
     lv_label_set_text(title_label, "Configurações");
+    lv_obj_add_style(title_label, ::ui::theme::title(), 0);
     lv_obj_set_width(title_label, LV_PCT(100));
-    lv_obj_set_style_text_align(title_label, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_style_text_color(title_label, ::ui::common::COLOR_TEXT_BLACK(), 0);
-    lv_obj_set_style_text_font(title_label, ::ui::common::TITLE_FONT, 0);
-    lv_obj_set_height(title_label, LV_SIZE_CONTENT);
     // Posicionar título no topo, com margem confortável
     lv_obj_align(title_label, LV_ALIGN_TOP_MID, 0, 10);
     
@@ -850,69 +839,17 @@ void create_configuration_screen() {
     // Centralizar container na tela
     lv_obj_align(icons_cont, LV_ALIGN_CENTER, 0, 0);
 
-    // Estilo para botões de ícone (Redondos, Claros, Simétricos)
-    static lv_style_t style_icon_btn;
-    static bool style_icon_init = false;
-    if (!style_icon_init) {
-        lv_style_init(&style_icon_btn);
-        // Botões redondos de 60px (reduzido de 64 para evitar sobreposição)
-        lv_style_set_width(&style_icon_btn, 60); 
-        lv_style_set_height(&style_icon_btn, 60); 
-        lv_style_set_bg_color(&style_icon_btn, lv_color_hex(0xFFFFFF)); // Branco puro
-        lv_style_set_bg_opa(&style_icon_btn, LV_OPA_COVER);
-        lv_style_set_radius(&style_icon_btn, LV_RADIUS_CIRCLE); // Redondo
-        
-        // Sombra suave
-        lv_style_set_shadow_width(&style_icon_btn, 15);
-        lv_style_set_shadow_color(&style_icon_btn, lv_color_hex(0x000000));
-        lv_style_set_shadow_opa(&style_icon_btn, 20);
-        lv_style_set_shadow_offset_y(&style_icon_btn, 3);
-        
-        // Sem borda
-        lv_style_set_border_width(&style_icon_btn, 0);
-
-        // Layout interno: NENHUM (usaremos posicionamento absoluto/center para o label)
-        // Isso evita problemas de alinhamento do flex com fontes de ícones
-        lv_style_set_layout(&style_icon_btn, 0);
-        lv_style_set_pad_all(&style_icon_btn, 0);
-        
-        style_icon_init = true;
-    }
-    
-    // Estilo para fileira de ícones
-    static lv_style_t style_row;
-    static bool style_row_init = false;
-    if (!style_row_init) {
-        lv_style_init(&style_row);
-        lv_style_set_width(&style_row, LV_PCT(100));
-        lv_style_set_pad_all(&style_row, 0);
-        // Adicionar padding inferior grande para acomodar a sombra dos botões sem cortar
-        lv_style_set_pad_bottom(&style_row, 10); 
-        lv_style_set_pad_top(&style_row, 2); // Pequeno padding superior por segurança
-        lv_style_set_margin_all(&style_row, 0);
-        // Gap horizontal entre botões na linha
-        lv_style_set_pad_gap(&style_row, 20); 
-        style_row_init = true;
-    }
-
-    // Helper lambda para criar botão de ícone
-    auto create_icon_btn = [&](lv_obj_t *parent, const char* icon, lv_color_t icon_color, lv_event_cb_t cb) {
+    // Helper lambda para criar botão de ícone (redondo, claro, com sombra - ver ui::theme)
+    auto create_icon_btn = [](lv_obj_t *parent, const char* icon, lv_color_t icon_color, lv_event_cb_t cb) {
         lv_obj_t *btn = lv_button_create(parent);
         lv_obj_remove_style_all(btn);
-        lv_obj_add_style(btn, &style_icon_btn, 0);
-        
-        // Cores de estado
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0xFFFFFF), LV_STATE_DEFAULT);
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0xF0F0F0), LV_STATE_PRESSED);
-        // Efeito de clique: deslocar levemente para baixo (simula pressionar)
-        lv_obj_set_style_translate_y(btn, 2, LV_STATE_PRESSED);
-        lv_obj_set_style_shadow_offset_y(btn, 1, LV_STATE_PRESSED); // Sombra diminui ao pressionar
-
-        // Ícone
+        lv_obj_add_style(btn, ::ui::theme::icon_button(), 0);
+        lv_obj_add_style(btn, ::ui::theme::icon_button_pressed(), LV_STATE_PRESSED);
+
+        // Ícone: apenas a cor é local
         lv_obj_t *lbl_icon = lv_label_create(btn);
         lv_label_set_text(lbl_icon, icon);
-        lv_obj_set_style_text_font(lbl_icon, &lv_font_montserrat_20, 0);
-        lv_obj_set_style_text_align(lbl_icon, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_add_style(lbl_icon, ::ui::theme::icon_label(), 0);
         lv_obj_set_style_text_color(lbl_icon, icon_color, 0);
         // Centralizar perfeitamente o label dentro do botão
         lv_obj_center(lbl_icon);
@@ -924,19 +861,14 @@ void create_configuration_screen() {
     // Primeira fileira (3 ícones)
     lv_obj_t *row1 = lv_obj_create(icons_cont);
     lv_obj_remove_style_all(row1);
-    lv_obj_add_style(row1, &style_row, 0);
-    lv_obj_set_layout(row1, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(row1, LV_FLEX_FLOW_ROW);
-    // Centralizar itens na linha
-    lv_obj_set_flex_align(row1, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_height(row1, LV_SIZE_CONTENT);
+    lv_obj_add_style(row1, ::ui::theme::icon_row(), 0);
     
     // Botão WiFi
     create_icon_btn(row1, LV_SYMBOL_WIFI, ::ui::common::COLOR_BUTTON_BLUE(), [](lv_event_t *e) {
         if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
             reset_config_timeout();
             ESP_LOGI(TAG, "Abrindo configuração WiFi...");
-            current_state = AppState::WIFI_CONFIG;
+            enter_state(AppState::WIFI_CONFIG);
             ::ui::screens::on_back_callback = show_configuration_screen;
             ::ui::screens::show_wifi_config_screen();
         }
@@ -947,7 +879,7 @@ void create_configuration_screen() {
         if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
             reset_config_timeout();
             ESP_LOGI(TAG, "Abrindo configuração de brilho...");
-            current_state = AppState::BRIGHTNESS_CONFIG;
+            enter_state(AppState::BRIGHTNESS_CONFIG);
             ::ui::screens::brightness_on_back_callback = show_configuration_screen;
             ::ui::screens::show_brightness_screen();
         }
@@ -959,19 +891,14 @@ void create_configuration_screen() {
     // Segunda fileira (2 ícones)
     lv_obj_t *row2 = lv_obj_create(icons_cont);
     lv_obj_remove_style_all(row2);
-    lv_obj_add_style(row2, &style_row, 0);
-    lv_obj_set_layout(row2, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(row2, LV_FLEX_FLOW_ROW);
-    // Centralizar itens na linha
-    lv_obj_set_flex_align(row2, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_height(row2, LV_SIZE_CONTENT);
+    lv_obj_add_style(row2, ::ui::theme::icon_row(), 0);
     
     // Botão OTA Update
     create_icon_btn(row2, LV_SYMBOL_REFRESH, ::ui::common::COLOR_SUCCESS(), [](lv_event_t *e) {
         if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
             reset_config_timeout();
             ESP_LOGI(TAG, "Abrindo tela de atualização OTA...");
-            current_state = AppState::OTA_UPDATE;
+            enter_state(AppState::OTA_UPDATE);
             ::ui::screens::show_ota_screen(nullptr);
         }
     });
@@ -981,7 +908,7 @@ void create_configuration_screen() {
         if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
             reset_config_timeout();
             ESP_LOGI(TAG, "Abrindo tela Sobre...");
-            current_state = AppState::ABOUT;
+            enter_state(AppState::ABOUT);
             ::ui::screens::about_on_back_callback = show_configuration_screen;
             ::ui::screens::show_about_screen();
         }
@@ -989,89 +916,72 @@ void create_configuration_screen() {
     
     // Botão de voltar usando função unificada
     ::ui::common::create_back_button(configuration_screen, config_back_button_cb);
+    
+    return configuration_screen;
 }
 
+static void release_configuration_screen() {
+    configuration_screen = nullptr;
+}
+
+static const ::ui::ScreenHooks CONFIGURATION_SCREEN = {
+    "configurações", ::ui::ScreenRetention::Cached,
+    build_configuration_screen, nullptr, release_configuration_screen,
+};
+
 void show_configuration_screen() {
-    current_state = AppState::CONFIGURATION;
-    
-    // Resetar timeout ao mostrar tela de configurações
-    config_timeout_pending = true;
-    config_timeout_counter = 0;
-    
-    lvgl_lock();
-    
-    // Sempre recriar a tela para garantir que os valores estejam atualizados
-    if (configuration_screen != nullptr) {
-        lv_obj_del(configuration_screen);
-        configuration_screen = nullptr;
-    }
-    
-    create_configuration_screen();
-    
-    lv_screen_load(configuration_screen);
-    // Invalidar a tela para forçar refresh no próximo ciclo do timer handler
-    // Não usar lv_refr_now() aqui para evitar stack overflow na task lvgl_timer
-    lv_obj_invalidate(configuration_screen);
+    // Arma o timeout de inatividade da tela de configurações
+    enter_state(AppState::CONFIGURATION);
     
-    lvgl_unlock();
+    // A tela só exibe ícones fixos: reaproveitada do cache enquanto residente
+    ::ui::ScreenManager::instance().show(::ui::ScreenId::Configuration, CONFIGURATION_SCREEN);
 }
 
 void show_thank_you_screen() {
-    current_state = AppState::THANK_YOU;
-    thank_you_return_pending = true;
-    thank_you_return_counter = 0;
-    
-    lvgl_lock();
-    
-    if (thank_you_screen == nullptr) {
-        create_thank_you_screen();
-    }
+    // Arma o retorno automático para a tela de avaliações
+    enter_state(AppState::THANK_YOU);
     
-    if (thank_you_summary != nullptr) {
-        lv_label_set_text_fmt(thank_you_summary,
-                              "Você registrou %d de 5 (%s).",
-                              selected_rating,
-                              RATING_MESSAGES[selected_rating - 1]);
-    }
-    
-    lv_screen_load(thank_you_screen);
-    // Invalidar a tela para forçar refresh no próximo ciclo do timer handler
-    // Não usar lv_refr_now() aqui para evitar stack overflow na task lvgl_timer
-    lv_obj_invalidate(thank_you_screen);
-    
-    lvgl_unlock();
+    ::ui::ScreenManager::instance().show(::ui::ScreenId::ThankYou, THANK_YOU_SCREEN);
 }
 
 void show_question_screen() {
     ESP_LOGI(TAG, "show_question_screen() chamado");
-    current_state = AppState::QUESTION;
+    // Desarma os prazos de agradecimento, senha e configurações
+    enter_state(AppState::QUESTION);
     selected_rating = 0;
-    thank_you_return_pending = false;
-    thank_you_return_counter = 0;
-    
-    // Desativar timeouts de senha e configurações ao voltar para tela principal
-    password_timeout_pending = false;
-    password_timeout_counter = 0;
-    config_timeout_pending = false;
-    config_timeout_counter = 0;
-    // Cancelar qualquer transição pendente agendada
-    password_timeout_transition_pending = false;
-    config_timeout_transition_pending = false;
-    lv_async_call_cancel(password_timeout_async_cb, nullptr);
-    lv_async_call_cancel(config_timeout_async_cb, nullptr);
     
-    // Se a tela já existe, apenas recarregá-la (mais rápido e evita deadlock)
-    if (question_screen != nullptr) {
-        ESP_LOGI(TAG, "Tela de pergunta já existe - apenas recarregando...");
-        lvgl_lock();
-        lv_screen_load(question_screen);
-        lv_obj_invalidate(question_screen);
-        lvgl_unlock();
+    ::ui::ScreenManager::instance().show(::ui::ScreenId::Question, QUESTION_SCREEN);
+}
+
+// Job de UI: recolore o ícone WiFi (verde se conectado, vermelho se desconectado)
+static void apply_wifi_status_job(uintptr_t connected) {
+    if (wifi_status_icon == nullptr) {
         return;
     }
     
-    // Criar nova tela apenas se não existir (create_question_screen() já faz lock internamente)
-    create_question_screen();
+    // Encontrar o label dentro do botão (primeiro filho)
+    lv_obj_t* wifi_label = lv_obj_get_child(wifi_status_icon, 0);
+    if (wifi_label != nullptr) {
+        lv_color_t color = connected ? ::ui::common::COLOR_SUCCESS() : ::ui::common::COLOR_ERROR();
+        lv_obj_set_style_text_color(wifi_label, color, 0);
+        lv_obj_invalidate(wifi_label);
+    }
+    lv_obj_invalidate(wifi_status_icon);
+}
+
+// Job do worker: verifica o Supabase após a conexão WiFi (HTTPS, bloqueante)
+static void test_supabase_job(uintptr_t) {
+    auto& supabase = supabase::SupabaseDriver::instance();
+    if (!supabase.is_configured()) {
+        return;
+    }
+    esp_err_t test_err = supabase.test_connection();
+    if (test_err == ESP_OK) {
+        ::ui::wifi_link::mark_upload();
+        ESP_LOGI(TAG, "Conexão com Supabase verificada com sucesso!");
+    } else {
+        ESP_LOGW(TAG, "Teste de conexão Supabase falhou: %s", esp_err_to_name(test_err));
+    }
 }
 
 static void update_wifi_status_icon() {
@@ -1082,133 +992,113 @@ static void update_wifi_status_icon() {
     // Verificar estado WiFi (operação leve, não precisa de lock)
     auto& wifi = WiFiManager::instance();
     bool connected = wifi.is_connected();
-    
-    // Atualizar UI em task separada para evitar stack overflow no contexto de eventos
-    if (connected != wifi_status_last_connected) {
-        wifi_status_update_pending = true;
-        wifi_status_last_connected = connected;
-        
-        // Se WiFi acabou de conectar, criar task para testar Supabase
-        if (connected) {
-            ESP_LOGI(TAG, "WiFi conectado - verificando Supabase...");
-            // Criar task separada para testar Supabase (evita stack overflow)
-            xTaskCreate([](void* arg) {
-                auto& supabase = supabase::SupabaseDriver::instance();
-                if (supabase.is_configured()) {
-                    // Testar conexão com Supabase
-                    esp_err_t test_err = supabase.test_connection();
-                    if (test_err == ESP_OK) {
-                        ESP_LOGI(TAG, "Conexão com Supabase verificada com sucesso!");
-                    } else {
-                        ESP_LOGW(TAG, "Teste de conexão Supabase falhou: %s", esp_err_to_name(test_err));
-                    }
-                }
-                vTaskDelete(nullptr);
-            }, "supabase_test", 8192, nullptr, 5, nullptr);
-        }
+    if (connected == wifi_status_last_connected) {
+        return;
     }
+    wifi_status_last_connected = connected;
     
-    // Atualizar UI apenas se houver mudança pendente
-    if (wifi_status_update_pending) {
-        // Criar task separada para atualizar UI (evita stack overflow)
-        xTaskCreate([](void* arg) {
-            lvgl_lock();
-            
-            // Encontrar o label dentro do botão (primeiro filho)
-            lv_obj_t* wifi_label = lv_obj_get_child(wifi_status_icon, 0);
-            if (wifi_label != nullptr) {
-                auto& wifi = WiFiManager::instance();
-                bool connected = wifi.is_connected();
-                
-                // Atualizar cor: verde se conectado, vermelho se desconectado
-                if (connected) {
-                    lv_obj_set_style_text_color(wifi_label, ::ui::common::COLOR_SUCCESS(), 0); // Verde
-                } else {
-                    lv_obj_set_style_text_color(wifi_label, ::ui::common::COLOR_ERROR(), 0); // Vermelho
-                }
-                lv_obj_invalidate(wifi_label);
-            }
-            
-            lv_obj_invalidate(wifi_status_icon);
-            lvgl_unlock();
-            
-            vTaskDelete(nullptr);
-        }, "wifi_ui_update", 2048, nullptr, 1, nullptr);
-        
-        wifi_status_update_pending = false;
+    // Recolorir fora do callback do timer, na próxima passada do handler
+    ::ui::jobs::post(apply_wifi_status_job, connected);
+    
+    if (connected) {
+        ESP_LOGI(TAG, "WiFi conectado - verificando Supabase...");
+        ::ui::jobs::post_worker(test_supabase_job);
     }
 }
 
-void update() {
-    // Processar transição de tela pendente (feito de forma assíncrona para evitar problemas de contexto)
-    if (pending_screen_transition && current_state == AppState::QUESTION) {
-        transition_delay_counter++;
-        // Aguardar 5 ciclos (500ms) antes de fazer a transição para garantir que o LVGL processou o evento
-        if (transition_delay_counter >= 5) {
-            pending_screen_transition = false;
-            transition_delay_counter = 0;
-            show_thank_you_screen();
-        }
-    }
-    
-    // Atualizar ícone WiFi periodicamente (a cada 10 ciclos = ~1 segundo)
-    static uint32_t wifi_update_counter = 0;
-    wifi_update_counter++;
-    if (wifi_update_counter >= 10 && current_state == AppState::QUESTION) {
-        wifi_update_counter = 0;
-        update_wifi_status_icon();
+} // namespace
+
+// Funções para resetar timeout automático
+void reset_password_timeout() {
+    lvgl_lock();
+    arm_deadline(password_timer, PASSWORD_TIMEOUT_MS);
+    lvgl_unlock();
+}
+
+void reset_config_timeout() {
+    lvgl_lock();
+    if (current_state == AppState::CONFIGURATION) {
+        arm_deadline(config_timer, CONFIG_TIMEOUT_MS);
     }
-    
-    // Retornar automaticamente para a tela de avaliações após agradecer
-    if (current_state == AppState::THANK_YOU && thank_you_return_pending) {
-        thank_you_return_counter++;
-        if (thank_you_return_counter >= THANK_YOU_RETURN_DELAY_CYCLES) {
-            thank_you_return_pending = false;
-            thank_you_return_counter = 0;
-            show_question_screen();
+    lvgl_unlock();
+}
+
+// Supabase só lê o NVS; o teste de conexão sai pelo worker assim que o WiFi conectar
+static void init_supabase() {
+    const boot_profile::Scope stage("supabase");
+    auto& supabase = supabase::SupabaseDriver::instance();
+    esp_err_t supabase_init_err = supabase.init();
+    if (supabase_init_err == ESP_OK) {
+        ESP_LOGI(TAG, "Supabase Driver inicializado");
+        if (supabase.is_configured()) {
+            ESP_LOGI(TAG, "Supabase configurado e pronto para uso");
+        } else {
+            ESP_LOGW(TAG, "Supabase não configurado - use set_credentials() para configurar");
         }
+    } else {
+        ESP_LOGW(TAG, "Erro ao inicializar Supabase Driver: %s", esp_err_to_name(supabase_init_err));
     }
-    
-    // Timeout automático para tela de senha (10 segundos)
-    if (::ui::screens::is_password_screen_visible() && password_timeout_pending) {
-        password_timeout_counter++;
-        if (password_timeout_counter >= PASSWORD_TIMEOUT_CYCLES) {
-            password_timeout_pending = false;
-            password_timeout_counter = 0;
-            if (!password_timeout_transition_pending) {
-                ESP_LOGI(TAG, "Timeout na tela de senha - agendando transição");
-                password_timeout_transition_pending = true;
-                lv_async_call(password_timeout_async_cb, nullptr);
-            }
-        }
+}
+
+// WiFi direto ao AP da última conexão quando possível; a OTA em segundo plano precisa dele iniciado
+static void init_wifi() {
+    {
+        const boot_profile::Scope stage("wifi");
+        ::ui::wifi_link::init();
     }
-    
-    // Timeout automático para tela de configurações (10 segundos)
-    if (current_state == AppState::CONFIGURATION && config_timeout_pending) {
-        config_timeout_counter++;
-        if (config_timeout_counter >= CONFIG_TIMEOUT_CYCLES) {
-            config_timeout_pending = false;
-            config_timeout_counter = 0;
-            if (!config_timeout_transition_pending) {
-                ESP_LOGI(TAG, "Timeout na tela de configurações - agendando transição");
-                config_timeout_transition_pending = true;
-                lv_async_call(config_timeout_async_cb, nullptr);
-            }
-        }
+    ::ui::background_ota::start();
+}
+
+#if FAST_BOOT
+// Boot rápido: Supabase no worker e WiFi num task próprio, os dois no core 0 (o LVGL fica no core 1).
+// O Supabase entra na fila do worker antes de o WiFi poder conectar, então o
+// test_supabase_job postado na conexão sempre o encontra iniciado.
+constexpr uint32_t BOOT_WIFI_STACK_SIZE = 4096;
+constexpr UBaseType_t BOOT_WIFI_PRIORITY = 5;  // A mesma do worker
+constexpr BaseType_t BOOT_WIFI_CORE = 0;
+
+static std::atomic<int> deferred_stages_left{0};
+
+// A última etapa adiada a terminar registra a linha do tempo
+static void finish_deferred_stage() {
+    if (deferred_stages_left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        boot_profile::log_timeline();
     }
 }
 
-} // namespace
+static void deferred_supabase_job(uintptr_t) {
+    init_supabase();
+    finish_deferred_stage();
+}
 
-// Funções para resetar timeout automático
-void reset_password_timeout() {
-    password_timeout_pending = true;
-    password_timeout_counter = 0;
+static void deferred_wifi_job(uintptr_t) {
+    init_wifi();
+    finish_deferred_stage();
 }
 
-void reset_config_timeout() {
-    config_timeout_pending = true;
-    config_timeout_counter = 0;
+static void deferred_wifi_task(void *) {
+    deferred_wifi_job(0);
+    vTaskDelete(nullptr);
+}
+#endif
+
+static void log_timeline_job(uintptr_t) {
+    boot_profile::log_timeline();
+}
+
+// Primeiro quadro da tela interativa (task do LVGL): o resto sai do core do LVGL
+static void on_first_frame(int64_t) {
+#if FAST_BOOT
+    deferred_stages_left.store(2, std::memory_order_relaxed);
+    ::ui::jobs::post_worker(deferred_supabase_job);
+    if (xTaskCreatePinnedToCore(deferred_wifi_task, "boot_wifi", BOOT_WIFI_STACK_SIZE, nullptr, BOOT_WIFI_PRIORITY,
+                                nullptr, BOOT_WIFI_CORE) != pdPASS) {
+        ESP_LOGW(TAG, "Falha ao criar task do WiFi no boot - iniciando no worker");
+        ::ui::jobs::post_worker(deferred_wifi_job);
+    }
+#else
+    ::ui::jobs::post_worker(log_timeline_job);
+#endif
 }
 
 namespace ui {
@@ -1223,49 +1113,57 @@ void init(lv_display_t *display) {
 
     ESP_LOGI(TAG, "Display recebido: %p", display);
     display_handle = display;
+
+    // Registrar fonte da UI antes de criar qualquer tela
+    ::ui::fonts::init();
+    
+    // Estilos compartilhados (dependem das fontes registradas)
+    lvgl_lock();
+    ::ui::theme::init();
+    lvgl_unlock();
+    
+    // Fila de jobs da UI: substitui tasks criados por atualização
+    ::ui::jobs::init();
+    
+    // Amostragem periódica de heap e pilhas (roda no worker)
+    ::ui::telemetry::init();
     
     ESP_LOGI(TAG, "Definindo display padrão...");
     // Definir display padrão (não precisa de lock para isso)
     lvgl_lock();
     lv_display_set_default(display);
+
+    // Timers da máquina de estados: rodam no task do LVGL, sem polling no task principal
+    thank_you_timer = create_deadline_timer(UiEvent::THANK_YOU_ELAPSED);
+    password_timer = create_deadline_timer(UiEvent::PASSWORD_TIMEOUT);
+    config_timer = create_deadline_timer(UiEvent::CONFIG_TIMEOUT);
+    wifi_status_timer = lv_timer_create(wifi_status_timer_cb, WIFI_STATUS_PERIOD_MS, nullptr);
     lvgl_unlock();
     
-    // Inicializar WiFi Manager
-    auto& wifi = WiFiManager::instance();
-    wifi.init();
-    
-    // Inicializar Supabase Driver
-    auto& supabase = supabase::SupabaseDriver::instance();
-    esp_err_t supabase_init_err = supabase.init();
-    if (supabase_init_err == ESP_OK) {
-        ESP_LOGI(TAG, "Supabase Driver inicializado");
-        if (supabase.is_configured()) {
-            ESP_LOGI(TAG, "Supabase configurado e pronto para uso");
-        } else {
-            ESP_LOGW(TAG, "Supabase não configurado - use set_credentials() para configurar");
-        }
-    } else {
-        ESP_LOGW(TAG, "Erro ao inicializar Supabase Driver: %s", esp_err_to_name(supabase_init_err));
-    }
+#if !FAST_BOOT
+    init_supabase();
+    init_wifi();
+#endif
     
     auto &driver = DisplayDriver::instance();
+    const int64_t first_screen_start_us = esp_timer_get_time();
+    lvgl_lock();
     if (driver.has_custom_calibration()) {
         ESP_LOGI(TAG, "Calibração existente detectada - pulando fluxo de calibração");
-        current_state = AppState::QUESTION;
         show_question_screen();
     } else {
         ESP_LOGI(TAG, "Iniciando fluxo de calibração...");
         start_calibration();
     }
+    // Armado com o lock tomado: o próximo flush já é o da tela carregada
+    boot_profile::arm_first_frame(on_first_frame);
+    lvgl_unlock();
+    boot_profile::record("primeira_tela", first_screen_start_us, esp_timer_get_time());
     
     ESP_LOGI(TAG, "=== UI INICIALIZADA COM SUCESSO ===");
     ESP_LOGI(TAG, "UI de pesquisa de satisfação inicializada");
 }
 
-void update() {
-    ::update(); // Chamar função do namespace anônimo
-}
-
 int get_current_rating() {
     return selected_rating;
 }
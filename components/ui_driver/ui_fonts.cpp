@@ -0,0 +1,411 @@
+#include "ui_fonts.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_log.h"
+
+// Declarar fonte Roboto customizada (definida em roboto.c ou no subconjunto gerado)
+extern const lv_font_t roboto;
+
+namespace ui::fonts {
+
+namespace {
+
+constexpr char TAG[] = "UiFonts";
+
+// Code points resolvidos pela tabela direta (ASCII + Latin-1)
+constexpr uint32_t LATIN_LUT_SIZE = 256;
+
+struct FastFont {
+    lv_font_t font;
+    const lv_font_fmt_txt_dsc_t* fdsc;
+    uint16_t glyph_id[LATIN_LUT_SIZE];    // 0 = glifo ausente
+    uint32_t kern_first[LATIN_LUT_SIZE];  // Primeiro par de kerning com este glifo à esquerda
+    // Quantidade de pares com este glifo à esquerda: um por glifo direito, então
+    // nunca passa do número de glyph ids (16 bits) e nenhum par é descartado
+    uint16_t kern_count[LATIN_LUT_SIZE];
+    bool ready;
+};
+
+FastFont roboto_fast;
+GlyphLookupStats stats = {};
+
+// ============================================
+// CACHE DE BITMAPS A8 DECODIFICADOS
+// ============================================
+
+// Orçamento do cache: cobre os glifos das telas principais (~130 bytes por glifo em 18 px)
+constexpr size_t GLYPH_CACHE_BUDGET_BYTES = 8 * 1024;
+constexpr int GLYPH_CACHE_MAX_ENTRIES = 96;
+constexpr int GLYPH_CACHE_BUCKETS = 32;
+// Glifos maiores que isto não entram no cache (decodificados no buffer temporário)
+constexpr size_t GLYPH_CACHE_MAX_GLYPH_BYTES = GLYPH_CACHE_BUDGET_BYTES / 4;
+
+struct GlyphCacheEntry {
+    const lv_font_t* font;
+    uint32_t gid;
+    uint8_t* data;
+    uint16_t size;
+    int8_t bucket_next;  // Próxima entrada no mesmo bucket
+    int8_t lru_prev;     // Entrada usada mais recentemente
+    int8_t lru_next;     // Entrada usada menos recentemente
+};
+
+struct GlyphCache {
+    GlyphCacheEntry entries[GLYPH_CACHE_MAX_ENTRIES];
+    int8_t buckets[GLYPH_CACHE_BUCKETS];
+    int8_t lru_head;     // Mais recente
+    int8_t lru_tail;     // Menos recente (próxima a ser removida)
+    int8_t free_head;    // Lista de entradas livres (encadeada por lru_next)
+    size_t bytes_used;
+    uint8_t* scratch;    // Buffer para glifos fora do cache
+    size_t scratch_size;
+};
+
+GlyphCache glyph_cache;
+GlyphCacheStats cache_stats = {};
+
+int bucket_of(const lv_font_t* font, uint32_t gid) {
+    return static_cast<int>((gid ^ (reinterpret_cast<uintptr_t>(font) >> 4)) % GLYPH_CACHE_BUCKETS);
+}
+
+void glyph_cache_reset() {
+    GlyphCache& c = glyph_cache;
+    for (int i = 0; i < GLYPH_CACHE_BUCKETS; i++) c.buckets[i] = -1;
+    for (int i = 0; i < GLYPH_CACHE_MAX_ENTRIES; i++) {
+        c.entries[i] = {};
+        c.entries[i].lru_next = static_cast<int8_t>(i + 1 < GLYPH_CACHE_MAX_ENTRIES ? i + 1 : -1);
+    }
+    c.free_head = 0;
+    c.lru_head = -1;
+    c.lru_tail = -1;
+    c.bytes_used = 0;
+}
+
+void lru_unlink(int idx) {
+    GlyphCache& c = glyph_cache;
+    GlyphCacheEntry& e = c.entries[idx];
+    if (e.lru_prev >= 0) c.entries[e.lru_prev].lru_next = e.lru_next;
+    else c.lru_head = e.lru_next;
+    if (e.lru_next >= 0) c.entries[e.lru_next].lru_prev = e.lru_prev;
+    else c.lru_tail = e.lru_prev;
+}
+
+void lru_push_front(int idx) {
+    GlyphCache& c = glyph_cache;
+    GlyphCacheEntry& e = c.entries[idx];
+    e.lru_prev = -1;
+    e.lru_next = c.lru_head;
+    if (c.lru_head >= 0) c.entries[c.lru_head].lru_prev = static_cast<int8_t>(idx);
+    c.lru_head = static_cast<int8_t>(idx);
+    if (c.lru_tail < 0) c.lru_tail = static_cast<int8_t>(idx);
+}
+
+void glyph_cache_evict_lru() {
+    GlyphCache& c = glyph_cache;
+    int idx = c.lru_tail;
+    if (idx < 0) return;
+    GlyphCacheEntry& e = c.entries[idx];
+
+    // Remover do bucket
+    int8_t* link = &c.buckets[bucket_of(e.font, e.gid)];
+    while (*link != idx) link = &c.entries[*link].bucket_next;
+    *link = e.bucket_next;
+
+    lru_unlink(idx);
+    free(e.data);
+    c.bytes_used -= e.size;
+    e = {};
+    e.lru_next = c.free_head;
+    c.free_head = static_cast<int8_t>(idx);
+    cache_stats.evictions++;
+}
+
+// Decodifica o glifo para A8 com stride = lv_draw_buf_width_to_stride(box_w)
+bool decode_glyph_a8(const lv_font_glyph_dsc_t* g_dsc, uint8_t* out, uint32_t out_size) {
+    const lv_font_fmt_txt_dsc_t* fdsc = static_cast<const lv_font_fmt_txt_dsc_t*>(g_dsc->resolved_font->dsc);
+    const lv_font_fmt_txt_glyph_dsc_t* gdsc = &fdsc->glyph_dsc[g_dsc->gid.index];
+
+    // Stride de origem como o lv_font_fmt_txt calcula (o descritor publicado já está em A8)
+    lv_font_glyph_dsc_t src = *g_dsc;
+    src.req_raw_bitmap = 0;
+    src.stride = 0;
+    if (fdsc->stride != 0) {
+        uint32_t width_in_bytes = (gdsc->box_w * fdsc->bpp + 7) >> 3;
+        src.stride = LV_ROUND_UP(width_in_bytes, fdsc->stride);
+    }
+
+    lv_draw_buf_t buf;
+    uint32_t stride = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
+    if (lv_draw_buf_init(&buf, gdsc->box_w, gdsc->box_h, LV_COLOR_FORMAT_A8, stride, out, out_size) != LV_RESULT_OK) {
+        return false;
+    }
+    return lv_font_get_bitmap_fmt_txt(&src, &buf) != nullptr;
+}
+
+// Decodifica fora do cache. O buffer vale até a próxima chamada, o que é seguro
+// porque há uma única unidade de desenho (LV_DRAW_SW_DRAW_UNIT_CNT=1)
+const uint8_t* decode_uncached(const lv_font_glyph_dsc_t* g_dsc, size_t size) {
+    GlyphCache& c = glyph_cache;
+    if (size > c.scratch_size) {
+        uint8_t* grown = static_cast<uint8_t*>(realloc(c.scratch, size));
+        if (grown == nullptr) return nullptr;
+        c.scratch = grown;
+        c.scratch_size = size;
+    }
+    cache_stats.uncached++;
+    return decode_glyph_a8(g_dsc, c.scratch, c.scratch_size) ? c.scratch : nullptr;
+}
+
+// Retorna o bitmap A8 do glifo, decodificando apenas em cache miss
+const uint8_t* glyph_cache_get(const lv_font_glyph_dsc_t* g_dsc) {
+    GlyphCache& c = glyph_cache;
+    const lv_font_t* font = g_dsc->resolved_font;
+    uint32_t gid = g_dsc->gid.index;
+
+    int bucket = bucket_of(font, gid);
+    for (int idx = c.buckets[bucket]; idx >= 0; idx = c.entries[idx].bucket_next) {
+        GlyphCacheEntry& e = c.entries[idx];
+        if (e.gid == gid && e.font == font) {
+            cache_stats.hits++;
+            if (c.lru_head != idx) {
+                lru_unlink(idx);
+                lru_push_front(idx);
+            }
+            return e.data;
+        }
+    }
+    cache_stats.misses++;
+
+    const lv_font_fmt_txt_dsc_t* fdsc = static_cast<const lv_font_fmt_txt_dsc_t*>(font->dsc);
+    const lv_font_fmt_txt_glyph_dsc_t* gdsc = &fdsc->glyph_dsc[gid];
+    size_t size = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h;
+    if (size == 0) return nullptr;
+
+    if (size > GLYPH_CACHE_MAX_GLYPH_BYTES) {
+        return decode_uncached(g_dsc, size);
+    }
+
+    while ((c.bytes_used + size > GLYPH_CACHE_BUDGET_BYTES || c.free_head < 0) && c.lru_tail >= 0) {
+        glyph_cache_evict_lru();
+    }
+
+    uint8_t* data = static_cast<uint8_t*>(malloc(size));
+    if (data == nullptr) {
+        ESP_LOGW(TAG, "Sem memória para cache de glifo (%u bytes)", static_cast<unsigned>(size));
+        return decode_uncached(g_dsc, size);
+    }
+    if (!decode_glyph_a8(g_dsc, data, size)) {
+        free(data);
+        return nullptr;
+    }
+
+    int idx = c.free_head;
+    GlyphCacheEntry& e = c.entries[idx];
+    c.free_head = e.lru_next;
+    e.font = font;
+    e.gid = gid;
+    e.data = data;
+    e.size = static_cast<uint16_t>(size);
+    e.bucket_next = c.buckets[bucket];
+    c.buckets[bucket] = static_cast<int8_t>(idx);
+    lru_push_front(idx);
+    c.bytes_used += size;
+    return data;
+}
+
+const void* cached_get_glyph_bitmap(lv_font_glyph_dsc_t* g_dsc, lv_draw_buf_t* draw_buf) {
+    if (g_dsc->gid.index == 0) return nullptr;
+
+    const uint8_t* a8 = glyph_cache_get(g_dsc);
+    if (a8 == nullptr) return nullptr;
+
+    // Caminho estático (lv_draw_sw_letter): blend direto do bitmap em cache
+    if (g_dsc->req_raw_bitmap) return a8;
+
+    // Demais caminhos (ex.: texto rotacionado): copiar para o draw_buf do LVGL
+    uint32_t stride_in = g_dsc->stride;
+    uint32_t stride_out = draw_buf->header.stride;
+    uint8_t* out = draw_buf->data;
+    for (int32_t y = 0; y < g_dsc->box_h; y++) {
+        memcpy(out, a8, g_dsc->box_w);
+        out += stride_out;
+        a8 += stride_in;
+    }
+    lv_draw_buf_flush_cache(draw_buf, nullptr);
+    return draw_buf;
+}
+
+// Publica o glifo como A8 (formato do cache), habilitando o caminho estático do LVGL
+void publish_as_a8(lv_font_glyph_dsc_t* dsc_out, uint32_t box_w) {
+    dsc_out->format = LV_FONT_GLYPH_FORMAT_A8;
+    dsc_out->stride = lv_draw_buf_width_to_stride(box_w, LV_COLOR_FORMAT_A8);
+}
+
+// glyph_ids_size == 0: ids de 8 bits; == 1: ids de 16 bits
+uint32_t kern_pair_glyph(const lv_font_fmt_txt_kern_pair_t* kdsc, uint32_t index, uint32_t side) {
+    if (kdsc->glyph_ids_size == 0) {
+        return static_cast<const uint8_t*>(kdsc->glyph_ids)[index * 2 + side];
+    }
+    return static_cast<const uint16_t*>(kdsc->glyph_ids)[index * 2 + side];
+}
+
+int8_t latin_kern_value(const FastFont& ff, uint32_t letter, uint32_t gid_left, uint32_t gid_right) {
+    const lv_font_fmt_txt_dsc_t* fdsc = ff.fdsc;
+
+    if (fdsc->kern_classes != 0) {
+        // Classes já são indexadas diretamente pelo glyph id
+        const auto* kdsc = static_cast<const lv_font_fmt_txt_kern_classes_t*>(fdsc->kern_dsc);
+        uint8_t left_class = kdsc->left_class_mapping[gid_left];
+        uint8_t right_class = kdsc->right_class_mapping[gid_right];
+        if (left_class > 0 && right_class > 0) {
+            return kdsc->class_pair_values[(left_class - 1) * kdsc->right_class_cnt + (right_class - 1)];
+        }
+        return 0;
+    }
+
+    // Pares ordenados por glifo direito dentro do bloco do glifo esquerdo
+    const auto* kdsc = static_cast<const lv_font_fmt_txt_kern_pair_t*>(fdsc->kern_dsc);
+    uint32_t lo = ff.kern_first[letter];
+    uint32_t hi = lo + ff.kern_count[letter];
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        uint32_t right = kern_pair_glyph(kdsc, mid, 1);
+        if (right == gid_right) return kdsc->values[mid];
+        if (right < gid_right) lo = mid + 1;
+        else hi = mid;
+    }
+    return 0;
+}
+
+bool fast_get_glyph_dsc(const lv_font_t* font, lv_font_glyph_dsc_t* dsc_out,
+                        uint32_t unicode_letter, uint32_t unicode_letter_next) {
+    const FastFont& ff = roboto_fast;
+
+    // Fora da faixa Latin (ou antes do registro): caminho padrão do LVGL
+    if (!ff.ready || unicode_letter >= LATIN_LUT_SIZE || unicode_letter_next >= LATIN_LUT_SIZE) {
+        stats.fallbacks++;
+        if (!lv_font_get_glyph_dsc_fmt_txt(font, dsc_out, unicode_letter, unicode_letter_next)) return false;
+        publish_as_a8(dsc_out, static_cast<const lv_font_fmt_txt_dsc_t*>(font->dsc)->glyph_dsc[dsc_out->gid.index].box_w);
+        return true;
+    }
+    stats.lut_hits++;
+
+    // Mesmo tratamento de tabulação do lv_font_fmt_txt: espaço com largura dobrada
+    bool is_tab = unicode_letter == '\t';
+    if (is_tab) unicode_letter = ' ';
+
+    uint32_t gid = ff.glyph_id[unicode_letter];
+    if (gid == 0) return false;
+
+    const lv_font_fmt_txt_dsc_t* fdsc = ff.fdsc;
+    int8_t kvalue = 0;
+    if (fdsc->kern_dsc != nullptr) {
+        uint32_t gid_next = ff.glyph_id[unicode_letter_next];
+        if (gid_next != 0) {
+            kvalue = latin_kern_value(ff, unicode_letter, gid, gid_next);
+        }
+    }
+
+    const lv_font_fmt_txt_glyph_dsc_t* gdsc = &fdsc->glyph_dsc[gid];
+    int32_t kv = (static_cast<int32_t>(kvalue) * fdsc->kern_scale) >> 4;
+
+    uint32_t adv_w = gdsc->adv_w;
+    if (is_tab) adv_w *= 2;
+    adv_w += kv;
+    adv_w = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+
+    publish_as_a8(dsc_out, gdsc->box_w);
+    dsc_out->is_placeholder = false;
+    dsc_out->gid.index = gid;
+
+    if (is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+void build_kern_index(FastFont& ff) {
+    const lv_font_fmt_txt_dsc_t* fdsc = ff.fdsc;
+    if (fdsc->kern_dsc == nullptr || fdsc->kern_classes != 0) return;
+
+    // Bloco de pares [kern_first, kern_first + kern_count) de cada glifo Latin
+    const auto* kdsc = static_cast<const lv_font_fmt_txt_kern_pair_t*>(fdsc->kern_dsc);
+    for (uint32_t cp = 0; cp < LATIN_LUT_SIZE; cp++) {
+        uint32_t gid = ff.glyph_id[cp];
+        if (gid == 0) continue;
+
+        // Pares ordenados pelo glifo esquerdo: busca binária pelo início do bloco
+        uint32_t lo = 0;
+        uint32_t hi = kdsc->pair_cnt;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (kern_pair_glyph(kdsc, mid, 0) < gid) lo = mid + 1;
+            else hi = mid;
+        }
+        uint32_t count = 0;
+        while (lo + count < kdsc->pair_cnt) {
+            if (kern_pair_glyph(kdsc, lo + count, 0) != gid) break;
+            count++;
+        }
+        ff.kern_first[cp] = lo;
+        ff.kern_count[cp] = static_cast<uint16_t>(count);
+    }
+}
+
+} // namespace
+
+void init() {
+    if (roboto_fast.ready) return;
+
+    FastFont& ff = roboto_fast;
+    ff.font = ::roboto;
+    ff.fdsc = static_cast<const lv_font_fmt_txt_dsc_t*>(::roboto.dsc);
+    ff.font.get_glyph_dsc = fast_get_glyph_dsc;
+    ff.font.get_glyph_bitmap = cached_get_glyph_bitmap;
+    ff.font.static_bitmap = 1;
+    glyph_cache_reset();
+    memset(ff.glyph_id, 0, sizeof(ff.glyph_id));
+    memset(ff.kern_first, 0, sizeof(ff.kern_first));
+    memset(ff.kern_count, 0, sizeof(ff.kern_count));
+
+    // Consulta o caminho padrão uma única vez por code point
+    uint16_t latin_glyphs = 0;
+    for (uint32_t cp = 1; cp < LATIN_LUT_SIZE; cp++) {
+        if (cp == '\t') continue; // Tratado como espaço em fast_get_glyph_dsc
+        lv_font_glyph_dsc_t dsc = {};
+        if (lv_font_get_glyph_dsc_fmt_txt(&::roboto, &dsc, cp, 0)) {
+            ff.glyph_id[cp] = static_cast<uint16_t>(dsc.gid.index);
+            latin_glyphs++;
+        }
+    }
+    build_kern_index(ff);
+
+    stats.latin_glyphs = latin_glyphs;
+    ff.ready = true;
+    ESP_LOGI(TAG, "Fonte Roboto registrada: %u glifos na tabela direta U+0000-U+00FF, cache A8 de %u bytes",
+             latin_glyphs, static_cast<unsigned>(GLYPH_CACHE_BUDGET_BYTES));
+}
+
+const lv_font_t* roboto() {
+    return &roboto_fast.font;
+}
+
+GlyphLookupStats get_lookup_stats() {
+    return stats;
+}
+
+GlyphCacheStats get_cache_stats() {
+    GlyphCacheStats result = cache_stats;
+    result.bytes_used = static_cast<uint32_t>(glyph_cache.bytes_used);
+    result.budget_bytes = static_cast<uint32_t>(GLYPH_CACHE_BUDGET_BYTES);
+    return result;
+}
+
+} // namespace ui::fonts
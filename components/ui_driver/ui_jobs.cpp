@@ -0,0 +1,174 @@
+#include "ui_jobs.hpp"
+#include "ui_common_internal.hpp"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "lvgl.h"
+
+// Task do LVGL (display_driver): acordado quando um job de UI é postado
+extern TaskHandle_t lvgl_task_handle;
+
+namespace ui::jobs {
+
+namespace {
+constexpr char TAG[] = "UI_JOBS";
+
+constexpr UBaseType_t UI_QUEUE_LENGTH = 16;
+constexpr UBaseType_t WORKER_QUEUE_LENGTH = 8;
+constexpr uint32_t UI_JOBS_PER_PASS = 8;        // Limita o tempo tomado de cada lv_timer_handler
+constexpr uint32_t WORKER_STACK_SIZE = 8192;     // Comporta o cliente HTTPS do Supabase
+constexpr UBaseType_t WORKER_PRIORITY = 5;
+constexpr BaseType_t WORKER_CORE = 0;            // Com o WiFi e o lwIP; o core 1 fica para o LVGL
+
+struct Job {
+    JobFn fn;
+    uintptr_t arg;
+    int64_t posted_us;
+};
+
+// Fila com armazenamento estático: post() nunca aloca
+struct JobLane {
+    const char *name;
+    QueueHandle_t queue;
+    StaticQueue_t queue_buffer;
+    LaneStats stats;
+};
+
+uint8_t ui_queue_storage[UI_QUEUE_LENGTH * sizeof(Job)];
+uint8_t worker_queue_storage[WORKER_QUEUE_LENGTH * sizeof(Job)];
+
+JobLane lanes[static_cast<size_t>(Lane::Count)] = {
+    {"ui", nullptr, {}, {}},
+    {"worker", nullptr, {}, {}},
+};
+
+// Contadores alterados por vários tasks (posters e consumidor)
+portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+StackType_t worker_stack[WORKER_STACK_SIZE];
+StaticTask_t worker_tcb;
+
+JobLane &lane_of(Lane lane) {
+    return lanes[static_cast<size_t>(lane)];
+}
+
+bool enqueue(JobLane &lane, JobFn fn, uintptr_t arg) {
+    if (lane.queue == nullptr || fn == nullptr) {
+        return false;
+    }
+
+    const Job job = {fn, arg, esp_timer_get_time()};
+    const bool accepted = xQueueSend(lane.queue, &job, 0) == pdTRUE;
+    const uint32_t depth = uxQueueMessagesWaiting(lane.queue);
+
+    portENTER_CRITICAL(&stats_lock);
+    if (accepted) {
+        lane.stats.posted++;
+        if (depth > lane.stats.max_depth) {
+            lane.stats.max_depth = depth;
+        }
+    } else {
+        lane.stats.dropped++;
+    }
+    portEXIT_CRITICAL(&stats_lock);
+
+    if (!accepted) {
+        ESP_LOGW(TAG, "Fila %s cheia - job descartado", lane.name);
+    }
+    return accepted;
+}
+
+void run(JobLane &lane, const Job &job) {
+    const int64_t start_us = esp_timer_get_time();
+    job.fn(job.arg);
+    const uint32_t run_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+    const uint32_t latency_us = static_cast<uint32_t>(start_us - job.posted_us);
+
+    portENTER_CRITICAL(&stats_lock);
+    LaneStats &stats = lane.stats;
+    stats.executed++;
+    stats.last_latency_us = latency_us;
+    stats.total_latency_us += latency_us;
+    if (latency_us > stats.max_latency_us) {
+        stats.max_latency_us = latency_us;
+    }
+    if (run_us > stats.max_run_us) {
+        stats.max_run_us = run_us;
+    }
+    portEXIT_CRITICAL(&stats_lock);
+}
+
+// Roda dentro de lv_timer_handler: o task do LVGL já detém o lock
+void drain_timer_cb(lv_timer_t *timer) {
+    JobLane &lane = lane_of(Lane::Ui);
+    Job job;
+    for (uint32_t i = 0; i < UI_JOBS_PER_PASS && xQueueReceive(lane.queue, &job, 0) == pdTRUE; ++i) {
+        run(lane, job);
+    }
+}
+
+void worker_task(void *arg) {
+    JobLane &lane = lane_of(Lane::Worker);
+    Job job;
+    while (true) {
+        if (xQueueReceive(lane.queue, &job, portMAX_DELAY) == pdTRUE) {
+            run(lane, job);
+        }
+    }
+}
+} // namespace
+
+void init() {
+    JobLane &ui_lane = lane_of(Lane::Ui);
+    if (ui_lane.queue != nullptr) {
+        return;
+    }
+
+    ui_lane.queue = xQueueCreateStatic(UI_QUEUE_LENGTH, sizeof(Job), ui_queue_storage, &ui_lane.queue_buffer);
+    JobLane &worker_lane = lane_of(Lane::Worker);
+    worker_lane.queue = xQueueCreateStatic(WORKER_QUEUE_LENGTH, sizeof(Job), worker_queue_storage,
+                                           &worker_lane.queue_buffer);
+
+    xTaskCreateStaticPinnedToCore(worker_task, "ui_worker", WORKER_STACK_SIZE, nullptr, WORKER_PRIORITY,
+                                  worker_stack, &worker_tcb, WORKER_CORE);
+
+    // Período 0: escoa a fila a cada passada do lv_timer_handler
+    lvgl_lock();
+    lv_timer_create(drain_timer_cb, 0, nullptr);
+    lvgl_unlock();
+
+    ESP_LOGI(TAG, "Serviço de jobs da UI iniciado (ui=%u, worker=%u)", static_cast<unsigned>(UI_QUEUE_LENGTH),
+             static_cast<unsigned>(WORKER_QUEUE_LENGTH));
+}
+
+bool post(JobFn fn, uintptr_t arg) {
+    if (!enqueue(lane_of(Lane::Ui), fn, arg)) {
+        return false;
+    }
+    // Acordar o task do LVGL em vez de esperar o próximo ciclo de 10 ms
+    if (lvgl_task_handle != nullptr && xTaskGetCurrentTaskHandle() != lvgl_task_handle) {
+        xTaskNotifyGive(lvgl_task_handle);
+    }
+    return true;
+}
+
+bool post_worker(JobFn fn, uintptr_t arg) {
+    return enqueue(lane_of(Lane::Worker), fn, arg);
+}
+
+LaneStats stats(Lane lane) {
+    if (lane >= Lane::Count) {
+        return {};
+    }
+    JobLane &job_lane = lane_of(lane);
+    portENTER_CRITICAL(&stats_lock);
+    LaneStats snapshot = job_lane.stats;
+    portEXIT_CRITICAL(&stats_lock);
+    snapshot.depth = job_lane.queue != nullptr ? uxQueueMessagesWaiting(job_lane.queue) : 0;
+    return snapshot;
+}
+
+} // namespace ui::jobs
@@ -0,0 +1,151 @@
+#include "ui_telemetry.hpp"
+#include "ui_jobs.hpp"
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lvgl.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace ui::telemetry {
+
+namespace {
+constexpr char TAG[] = "TELEMETRY";
+
+constexpr size_t TASK_COUNT = static_cast<size_t>(WatchedTask::Count);
+
+// Nomes dos tasks no FreeRTOS e rótulos curtos da linha de log
+constexpr const char *TASK_NAMES[TASK_COUNT] = {"lvgl_timer", "brightness_task", "touch_task", "main", "ui_worker",
+                                                   "ota_bg"};
+constexpr const char *TASK_LABELS[TASK_COUNT] = {"lvgl", "brilho", "touch", "main", "worker", "ota"};
+
+// Abaixo disso a margem vira aviso: um frame mais pesado pode estourar a pilha
+constexpr uint16_t STACK_WARN_BYTES = 512;
+// Heap interno livre mas picotado: alocações grandes (TLS, buffers) começam a falhar
+constexpr uint8_t FRAG_WARN_PCT = 50;
+
+constexpr uint32_t INTERNAL_CAPS = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+// Histórico circular: escrito pelo worker, lido pela tela Sobre
+Sample ring[HISTORY_LENGTH];
+size_t ring_head = 0;
+size_t ring_count = 0;
+portMUX_TYPE ring_lock = portMUX_INITIALIZER_UNLOCKED;
+
+esp_timer_handle_t sample_timer = nullptr;
+
+void log_sample(const Sample &s) {
+    char stacks[80];
+    int used = 0;
+    uint16_t min_stack = STACK_UNKNOWN;
+    for (size_t i = 0; i < TASK_COUNT && used < static_cast<int>(sizeof(stacks)); ++i) {
+        used += snprintf(stacks + used, sizeof(stacks) - used, "%s%s=%u", i > 0 ? " " : "", TASK_LABELS[i],
+                         static_cast<unsigned>(s.stack_free[i]));
+        min_stack = std::min(min_stack, s.stack_free[i]);
+    }
+
+    ESP_LOGI(TAG, "int %lu/%lu (mín %lu, frag %u%%) dma %lu/%lu lvgl %u%% pilha %s",
+             (unsigned long)s.internal_free, (unsigned long)s.internal_largest,
+             (unsigned long)s.internal_min_free, static_cast<unsigned>(s.internal_frag_pct),
+             (unsigned long)s.dma_free, (unsigned long)s.dma_largest, static_cast<unsigned>(s.lvgl_used_pct),
+             stacks);
+
+    if (min_stack < STACK_WARN_BYTES) {
+        ESP_LOGW(TAG, "Margem de pilha abaixo de %u bytes", static_cast<unsigned>(STACK_WARN_BYTES));
+    }
+    if (s.internal_frag_pct > FRAG_WARN_PCT) {
+        ESP_LOGW(TAG, "Heap interno fragmentado: maior bloco %lu de %lu livres", (unsigned long)s.internal_largest,
+                 (unsigned long)s.internal_free);
+    }
+}
+
+// Roda no worker da UI: heap_caps_get_info() percorre o heap inteiro
+void sample_job(uintptr_t arg) {
+    const Sample s = sample();
+
+    portENTER_CRITICAL(&ring_lock);
+    ring[ring_head] = s;
+    ring_head = (ring_head + 1) % HISTORY_LENGTH;
+    ring_count = std::min(ring_count + 1, HISTORY_LENGTH);
+    portEXIT_CRITICAL(&ring_lock);
+
+    log_sample(s);
+}
+
+// Contexto do esp_timer: só posta, para não atrasar o tick do LVGL
+void sample_timer_cb(void *arg) {
+    jobs::post_worker(sample_job);
+}
+} // namespace
+
+void init() {
+    if (sample_timer != nullptr) {
+        return;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = &sample_timer_cb,
+        .arg = nullptr,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "telemetry",
+        .skip_unhandled_events = true,
+    };
+    if (esp_timer_create(&timer_args, &sample_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao criar timer de telemetria");
+        return;
+    }
+    esp_timer_start_periodic(sample_timer, static_cast<uint64_t>(SAMPLE_PERIOD_S) * 1000 * 1000);
+
+    // Referência logo após o boot
+    jobs::post_worker(sample_job);
+}
+
+Sample sample() {
+    Sample s = {};
+    s.uptime_s = static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+
+    multi_heap_info_t internal = {};
+    heap_caps_get_info(&internal, INTERNAL_CAPS);
+    s.internal_free = internal.total_free_bytes;
+    s.internal_largest = internal.largest_free_block;
+    s.internal_min_free = internal.minimum_free_bytes;
+    s.internal_frag_pct = internal.total_free_bytes > 0
+        ? static_cast<uint8_t>(100 - (100ULL * internal.largest_free_block) / internal.total_free_bytes) : 0;
+
+    s.dma_free = heap_caps_get_free_size(MALLOC_CAP_DMA);
+    s.dma_largest = heap_caps_get_largest_free_block(MALLOC_CAP_DMA);
+
+    // Seguro fora do lock do LVGL: o back-end (lvgl_mem) tem lock próprio
+    lv_mem_monitor_t lvgl_mem;
+    lv_mem_monitor(&lvgl_mem);
+    s.lvgl_used_pct = lvgl_mem.used_pct;
+
+    // Na ESP-IDF a marca d'água da pilha vem em bytes
+    for (size_t i = 0; i < TASK_COUNT; ++i) {
+        TaskHandle_t handle = xTaskGetHandle(TASK_NAMES[i]);
+        s.stack_free[i] = handle != nullptr
+            ? static_cast<uint16_t>(std::min<UBaseType_t>(uxTaskGetStackHighWaterMark(handle), STACK_UNKNOWN - 1))
+            : STACK_UNKNOWN;
+    }
+    return s;
+}
+
+bool history_bounds(Sample &oldest, Sample &newest) {
+    portENTER_CRITICAL(&ring_lock);
+    const bool has_samples = ring_count > 0;
+    if (has_samples) {
+        oldest = ring[(ring_head + HISTORY_LENGTH - ring_count) % HISTORY_LENGTH];
+        newest = ring[(ring_head + HISTORY_LENGTH - 1) % HISTORY_LENGTH];
+    }
+    portEXIT_CRITICAL(&ring_lock);
+    return has_samples;
+}
+
+const char *task_name(WatchedTask task) {
+    return task < WatchedTask::Count ? TASK_NAMES[static_cast<size_t>(task)] : "?";
+}
+
+} // namespace ui::telemetry
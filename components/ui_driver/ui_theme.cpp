@@ -0,0 +1,204 @@
+#include "ui_theme.hpp"
+#include "ui_common.hpp"
+
+// Fonte de ícones (símbolos do LVGL)
+LV_FONT_DECLARE(lv_font_montserrat_20);
+
+namespace ui::theme {
+
+namespace {
+constexpr int RATING_COUNT = 5;
+constexpr int32_t STANDARD_BUTTON_RADIUS = 18;  // Botões de ação e Voltar (arredondados)
+constexpr int32_t COMPACT_BUTTON_RADIUS = 16;   // Botões compactos
+constexpr int32_t ICON_BUTTON_SIZE = 60;
+
+// Cores dos botões de avaliação (1 = Muito Insatisfeito ... 5 = Muito Satisfeito)
+constexpr uint32_t RATING_COLORS[RATING_COUNT] = {
+    0xFF0000,  // Vermelho
+    0xFF6600,  // Laranja
+    0xFFCC00,  // Amarelo
+    0x99FF00,  // Verde claro
+    0x00FF00,  // Verde
+};
+
+bool initialized = false;
+
+lv_style_t style_screen;
+lv_style_t style_header;
+lv_style_t style_title;
+lv_style_t style_text;
+lv_style_t style_caption;
+lv_style_t style_button;
+lv_style_t style_button_label;
+lv_style_t style_button_label_small;
+lv_style_t style_action_button;
+lv_style_t style_compact_button;
+lv_style_t style_rating_button[RATING_COUNT];
+lv_style_t style_rating_label;
+lv_style_t style_icon_button;
+lv_style_t style_icon_button_pressed;
+lv_style_t style_icon_label;
+lv_style_t style_icon_row;
+
+void init_text_styles() {
+    lv_style_init(&style_title);
+    lv_style_set_text_align(&style_title, LV_TEXT_ALIGN_CENTER);
+    lv_style_set_text_color(&style_title, common::COLOR_TEXT_BLACK());
+    lv_style_set_text_font(&style_title, common::TITLE_FONT);
+    lv_style_set_pad_top(&style_title, 4);
+    lv_style_set_pad_bottom(&style_title, 4);
+
+    lv_style_init(&style_text);
+    lv_style_set_text_color(&style_text, common::COLOR_TEXT_BLACK());
+    lv_style_set_text_font(&style_text, common::TEXT_FONT);
+    lv_style_set_pad_top(&style_text, 4);
+    lv_style_set_pad_bottom(&style_text, 4);
+
+    lv_style_init(&style_caption);
+    lv_style_set_text_align(&style_caption, LV_TEXT_ALIGN_CENTER);
+    lv_style_set_text_color(&style_caption, common::COLOR_TEXT_BLACK());
+    lv_style_set_text_font(&style_caption, common::CAPTION_FONT);
+    lv_style_set_pad_top(&style_caption, 4);
+    lv_style_set_pad_bottom(&style_caption, 4);
+}
+
+void init_button_styles() {
+    lv_style_init(&style_button);
+    lv_style_set_bg_opa(&style_button, LV_OPA_COVER);
+    lv_style_set_text_color(&style_button, lv_color_white());
+    lv_style_set_radius(&style_button, common::BUTTON_RADIUS);
+    lv_style_set_pad_all(&style_button, 4);
+
+    lv_style_init(&style_button_label);
+    lv_style_set_text_color(&style_button_label, lv_color_white());
+    lv_style_set_text_font(&style_button_label, common::TEXT_FONT);
+
+    lv_style_init(&style_button_label_small);
+    lv_style_set_text_color(&style_button_label_small, lv_color_white());
+    lv_style_set_text_font(&style_button_label_small, common::CAPTION_FONT);
+
+    lv_style_init(&style_action_button);
+    lv_style_set_radius(&style_action_button, STANDARD_BUTTON_RADIUS);
+
+    lv_style_init(&style_compact_button);
+    lv_style_set_radius(&style_compact_button, COMPACT_BUTTON_RADIUS);
+}
+
+void init_rating_styles() {
+    for (int i = 0; i < RATING_COUNT; ++i) {
+        lv_style_t *style = &style_rating_button[i];
+        lv_style_init(style);
+        lv_style_set_width(style, common::RATING_BUTTON_SIZE);
+        lv_style_set_height(style, common::RATING_BUTTON_SIZE);
+        lv_style_set_bg_color(style, lv_color_hex(RATING_COLORS[i]));
+        lv_style_set_bg_opa(style, LV_OPA_COVER);
+        lv_style_set_radius(style, LV_RADIUS_CIRCLE);  // Círculo perfeito
+        lv_style_set_border_width(style, 2);
+        lv_style_set_border_color(style, lv_color_white());
+        lv_style_set_border_opa(style, LV_OPA_COVER);
+        // Padding para evitar corte do número
+        lv_style_set_pad_all(style, 4);
+    }
+
+    lv_style_init(&style_rating_label);
+    lv_style_set_text_font(&style_rating_label, common::TITLE_FONT);
+    lv_style_set_text_color(&style_rating_label, lv_color_white());
+}
+
+void init_icon_styles() {
+    // Botões redondos e claros da tela de configurações
+    lv_style_init(&style_icon_button);
+    lv_style_set_width(&style_icon_button, ICON_BUTTON_SIZE);
+    lv_style_set_height(&style_icon_button, ICON_BUTTON_SIZE);
+    lv_style_set_bg_color(&style_icon_button, common::COLOR_BG_WHITE());
+    lv_style_set_bg_opa(&style_icon_button, LV_OPA_COVER);
+    lv_style_set_radius(&style_icon_button, LV_RADIUS_CIRCLE);
+    // Sombra suave
+    lv_style_set_shadow_width(&style_icon_button, 15);
+    lv_style_set_shadow_color(&style_icon_button, lv_color_hex(0x000000));
+    lv_style_set_shadow_opa(&style_icon_button, 20);
+    lv_style_set_shadow_offset_y(&style_icon_button, 3);
+    lv_style_set_border_width(&style_icon_button, 0);
+    // Sem layout: o label do ícone é centralizado (flex desalinha fontes de ícones)
+    lv_style_set_layout(&style_icon_button, 0);
+    lv_style_set_pad_all(&style_icon_button, 0);
+
+    // Efeito de clique: fundo mais escuro e deslocamento para baixo com sombra menor
+    lv_style_init(&style_icon_button_pressed);
+    lv_style_set_bg_color(&style_icon_button_pressed, lv_color_hex(0xF0F0F0));
+    lv_style_set_translate_y(&style_icon_button_pressed, 2);
+    lv_style_set_shadow_offset_y(&style_icon_button_pressed, 1);
+
+    lv_style_init(&style_icon_label);
+    lv_style_set_text_font(&style_icon_label, &lv_font_montserrat_20);
+    lv_style_set_text_align(&style_icon_label, LV_TEXT_ALIGN_CENTER);
+
+    lv_style_init(&style_icon_row);
+    lv_style_set_width(&style_icon_row, LV_PCT(100));
+    lv_style_set_height(&style_icon_row, LV_SIZE_CONTENT);
+    lv_style_set_layout(&style_icon_row, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&style_icon_row, LV_FLEX_FLOW_ROW);
+    lv_style_set_flex_main_place(&style_icon_row, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_cross_place(&style_icon_row, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_track_place(&style_icon_row, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_pad_all(&style_icon_row, 0);
+    // Padding inferior acomoda a sombra dos botões sem cortar
+    lv_style_set_pad_bottom(&style_icon_row, 10);
+    lv_style_set_pad_top(&style_icon_row, 2);
+    lv_style_set_margin_all(&style_icon_row, 0);
+    lv_style_set_pad_gap(&style_icon_row, 20);
+}
+} // namespace
+
+void init() {
+    if (initialized) {
+        return;
+    }
+
+    lv_style_init(&style_screen);
+    lv_style_set_bg_color(&style_screen, common::COLOR_BG_WHITE());
+    lv_style_set_bg_opa(&style_screen, LV_OPA_COVER);
+
+    lv_style_init(&style_header);
+    lv_style_set_bg_color(&style_header, common::COLOR_BG_WHITE());
+    lv_style_set_bg_opa(&style_header, LV_OPA_COVER);
+    lv_style_set_border_side(&style_header, LV_BORDER_SIDE_BOTTOM);
+    lv_style_set_border_width(&style_header, 1);
+    lv_style_set_border_color(&style_header, common::COLOR_BORDER());
+    lv_style_set_radius(&style_header, 0);
+
+    init_text_styles();
+    init_button_styles();
+    init_rating_styles();
+    init_icon_styles();
+
+    initialized = true;
+}
+
+lv_style_t *screen() { return &style_screen; }
+lv_style_t *header() { return &style_header; }
+lv_style_t *title() { return &style_title; }
+lv_style_t *text() { return &style_text; }
+lv_style_t *caption() { return &style_caption; }
+
+lv_style_t *button() { return &style_button; }
+lv_style_t *button_label() { return &style_button_label; }
+lv_style_t *button_label_small() { return &style_button_label_small; }
+lv_style_t *action_button() { return &style_action_button; }
+lv_style_t *compact_button() { return &style_compact_button; }
+
+lv_style_t *rating_button(int index) {
+    if (index < 0 || index >= RATING_COUNT) {
+        index = 0;
+    }
+    return &style_rating_button[index];
+}
+
+lv_style_t *rating_label() { return &style_rating_label; }
+
+lv_style_t *icon_button() { return &style_icon_button; }
+lv_style_t *icon_button_pressed() { return &style_icon_button_pressed; }
+lv_style_t *icon_label() { return &style_icon_label; }
+lv_style_t *icon_row() { return &style_icon_row; }
+
+} // namespace ui::theme
@@ -0,0 +1,321 @@
+#include "ui_wifi_link.hpp"
+
+#include "WiFiManager.h"
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "freertos/FreeRTOS.h"
+#include "nvs.h"
+#include <cstring>
+
+namespace ui::wifi_link {
+
+namespace {
+constexpr char TAG[] = "WIFI_LINK";
+
+constexpr char NVS_NAMESPACE[] = "wifi_link";
+constexpr char NVS_KEY[] = "last_ap";
+constexpr uint32_t CACHE_VERSION = 1;
+
+// Falhas seguidas com o cache antes de voltar à varredura completa (a primeira
+// pode ser só o AP ocupado; AP ausente no canal desiste na hora)
+constexpr uint8_t MAX_FAST_FAILURES = 2;
+
+/**
+ * @brief AP e lease da última conexão, gravados no NVS ao obter IP
+ *
+ * O lease em si é pedido de volta pelo lwIP (CONFIG_LWIP_DHCP_RESTORE_LAST_IP,
+ * que pula o DISCOVER); o IP aqui só mostra se o DHCP devolveu o mesmo.
+ */
+struct Cache {
+    uint32_t version;
+    uint8_t ssid[32];
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+};
+
+// Escritos pelo task de eventos (on_got_ip, on_disconnected) e lidos por init()
+// no worker depois de registrar os handlers: cópias sob cache_lock, NVS e
+// esp_wifi sempre fora dele
+Cache cache = {};
+bool cache_valid = false;
+bool hint_active = false;
+portMUX_TYPE cache_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Só o task de eventos mexe nestes
+uint8_t fast_failures = 0;
+uint8_t pending_bssid[6] = {};
+uint8_t pending_channel = 0;
+
+// Compartilhados com o worker (mark_upload) e a tela Sobre (metrics)
+Metrics current = {};
+int64_t attempt_start_us = 0;
+bool attempt_open = false;
+bool upload_pending = false;
+portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t elapsed_ms(int64_t since_us) {
+    return static_cast<uint32_t>((esp_timer_get_time() - since_us) / 1000);
+}
+
+bool load_cache(Cache &loaded) {
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    size_t size = sizeof(loaded);
+    const esp_err_t err = nvs_get_blob(handle, NVS_KEY, &loaded, &size);
+    nvs_close(handle);
+    return err == ESP_OK && size == sizeof(loaded) && loaded.version == CACHE_VERSION && loaded.channel != 0;
+}
+
+void save_cache(const Cache &next) {
+    // Reconexão ao mesmo AP com o mesmo lease não gasta escrita na flash
+    portENTER_CRITICAL(&cache_lock);
+    const bool unchanged = cache_valid && memcmp(&next, &cache, sizeof(cache)) == 0;
+    portEXIT_CRITICAL(&cache_lock);
+    if (unchanged) {
+        return;
+    }
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, NVS_KEY, &next, sizeof(next));
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Falha ao salvar AP da conexão (%s)", esp_err_to_name(err));
+        return;
+    }
+    portENTER_CRITICAL(&cache_lock);
+    cache = next;
+    cache_valid = true;
+    portEXIT_CRITICAL(&cache_lock);
+}
+
+void erase_cache() {
+    portENTER_CRITICAL(&cache_lock);
+    cache_valid = false;
+    portEXIT_CRITICAL(&cache_lock);
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(handle, NVS_KEY) == ESP_OK) {
+        nvs_commit(handle);
+    }
+    nvs_close(handle);
+}
+
+/**
+ * @brief Liga (com a cópia do cache em hint) ou desliga (nullptr) a dica de BSSID/canal na configuração da estação
+ */
+esp_err_t set_hint(const Cache *hint) {
+    wifi_config_t config = {};
+    esp_err_t err = esp_wifi_get_config(WIFI_IF_STA, &config);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (hint != nullptr) {
+        // Rede trocada na tela de configuração: o cache é de outra rede
+        if (memcmp(config.sta.ssid, hint->ssid, sizeof(config.sta.ssid)) != 0) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        config.sta.channel = hint->channel;
+        config.sta.bssid_set = true;
+        memcpy(config.sta.bssid, hint->bssid, sizeof(config.sta.bssid));
+        config.sta.scan_method = WIFI_FAST_SCAN;
+    } else {
+        config.sta.channel = 0;
+        config.sta.bssid_set = false;
+        config.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+    }
+
+    err = esp_wifi_set_config(WIFI_IF_STA, &config);
+    if (err == ESP_ERR_WIFI_STATE) {
+        // Tentativa em andamento (a do WiFiManager): interrompe e recomeça com a configuração nova
+        esp_wifi_disconnect();
+        err = esp_wifi_set_config(WIFI_IF_STA, &config);
+        if (err == ESP_OK) {
+            err = esp_wifi_connect();
+        }
+    }
+    return err;
+}
+
+void open_attempt() {
+    portENTER_CRITICAL(&lock);
+    if (!attempt_open) {
+        attempt_open = true;
+        attempt_start_us = esp_timer_get_time();
+        upload_pending = false;
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void on_disconnected(const wifi_event_sta_disconnected_t &event) {
+    open_attempt();
+    portENTER_CRITICAL(&cache_lock);
+    const bool hinted = hint_active;
+    portEXIT_CRITICAL(&cache_lock);
+    // A saída pedida por set_hint() não é falha do AP
+    if (!hinted || event.reason == WIFI_REASON_ASSOC_LEAVE) {
+        return;
+    }
+    if (event.reason != WIFI_REASON_NO_AP_FOUND && ++fast_failures < MAX_FAST_FAILURES) {
+        return;
+    }
+
+    ESP_LOGW(TAG, "AP do cache não conectou (motivo %u): voltando à varredura completa", event.reason);
+    portENTER_CRITICAL(&cache_lock);
+    hint_active = false;
+    portEXIT_CRITICAL(&cache_lock);
+    erase_cache();
+    portENTER_CRITICAL(&lock);
+    current.fallbacks++;
+    portEXIT_CRITICAL(&lock);
+    const esp_err_t err = set_hint(nullptr);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Falha ao remover BSSID/canal da configuração (%s)", esp_err_to_name(err));
+    }
+}
+
+void on_connected(const wifi_event_sta_connected_t &event) {
+    // Guardado até o IP: um AP que associa mas não entrega IP não vai para o cache
+    memcpy(pending_bssid, event.bssid, sizeof(pending_bssid));
+    pending_channel = event.channel;
+
+    portENTER_CRITICAL(&lock);
+    if (attempt_open) {
+        current.associate_ms = elapsed_ms(attempt_start_us);
+    }
+    portEXIT_CRITICAL(&lock);
+}
+
+void on_got_ip(const ip_event_got_ip_t &event) {
+    const uint32_t ip = event.ip_info.ip.addr;
+    portENTER_CRITICAL(&cache_lock);
+    const bool fast = hint_active;
+    const bool lease_reused = cache_valid && cache.ip == ip;
+    portEXIT_CRITICAL(&cache_lock);
+    fast_failures = 0;
+
+    portENTER_CRITICAL(&lock);
+    const bool measured = attempt_open;
+    if (measured) {
+        current.ip_ms = elapsed_ms(attempt_start_us);
+        current.upload_ms = 0;
+        upload_pending = true;
+    }
+    attempt_open = false;
+    current.connections++;
+    current.last_fast = fast;
+    current.lease_reused = lease_reused;
+    const Metrics snapshot = current;
+    portEXIT_CRITICAL(&lock);
+
+    if (measured) {
+        ESP_LOGI(TAG, "IP " IPSTR " em %lu ms (associou em %lu ms, %s%s)", IP2STR(&event.ip_info.ip),
+                 (unsigned long)snapshot.ip_ms, (unsigned long)snapshot.associate_ms,
+                 fast ? "AP do cache" : "varredura completa", lease_reused ? ", mesmo lease" : "");
+    }
+
+    wifi_config_t config = {};
+    if (pending_channel == 0 || esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK) {
+        return;
+    }
+    Cache next = {};
+    next.version = CACHE_VERSION;
+    memcpy(next.ssid, config.sta.ssid, sizeof(next.ssid));
+    memcpy(next.bssid, pending_bssid, sizeof(next.bssid));
+    next.channel = pending_channel;
+    next.ip = ip;
+    save_cache(next);
+}
+
+void event_handler(void *, esp_event_base_t base, int32_t id, void *data) {
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        on_disconnected(*static_cast<const wifi_event_sta_disconnected_t *>(data));
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_CONNECTED) {
+        on_connected(*static_cast<const wifi_event_sta_connected_t *>(data));
+    } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        on_got_ip(*static_cast<const ip_event_got_ip_t *>(data));
+    }
+}
+} // namespace
+
+void init() {
+    // Antes de registrar os handlers; daqui em diante init() só usa a cópia loaded
+    Cache loaded = {};
+    const bool loaded_valid = load_cache(loaded);
+    portENTER_CRITICAL(&cache_lock);
+    cache = loaded;
+    cache_valid = loaded_valid;
+    portEXIT_CRITICAL(&cache_lock);
+    open_attempt();
+
+    auto &wifi = WiFiManager::instance();
+    wifi.init();
+
+    // O WiFiManager cria o loop de eventos padrão; os handlers dele rodam antes destes
+    esp_err_t err = esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, event_handler, nullptr, nullptr);
+    if (err == ESP_OK) {
+        err = esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, event_handler, nullptr, nullptr);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao registrar eventos do WiFi (%s): sem reconexão rápida", esp_err_to_name(err));
+        return;
+    }
+
+    if (!loaded_valid || wifi.is_connected()) {
+        return;
+    }
+    // Ligada antes da tentativa: um NO_AP_FOUND logo após set_hint() já conta como falha do cache
+    portENTER_CRITICAL(&cache_lock);
+    hint_active = true;
+    portEXIT_CRITICAL(&cache_lock);
+    err = set_hint(&loaded);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Conectando direto ao AP %02X:%02X:%02X:%02X:%02X:%02X no canal %u", loaded.bssid[0],
+                 loaded.bssid[1], loaded.bssid[2], loaded.bssid[3], loaded.bssid[4], loaded.bssid[5], loaded.channel);
+        return;
+    }
+    portENTER_CRITICAL(&cache_lock);
+    hint_active = false;
+    portEXIT_CRITICAL(&cache_lock);
+    if (err == ESP_ERR_NOT_FOUND) {
+        ESP_LOGI(TAG, "Rede configurada mudou: ignorando o AP do cache");
+    } else {
+        ESP_LOGW(TAG, "Falha ao aplicar o AP do cache (%s): varredura completa", esp_err_to_name(err));
+    }
+}
+
+void mark_upload() {
+    portENTER_CRITICAL(&lock);
+    const bool first = upload_pending;
+    if (first) {
+        current.upload_ms = elapsed_ms(attempt_start_us);
+        upload_pending = false;
+    }
+    const uint32_t upload_ms = current.upload_ms;
+    portEXIT_CRITICAL(&lock);
+
+    if (first) {
+        ESP_LOGI(TAG, "Supabase alcançado %lu ms após o início da conexão", (unsigned long)upload_ms);
+    }
+}
+
+Metrics metrics() {
+    portENTER_CRITICAL(&lock);
+    const Metrics copy = current;
+    portEXIT_CRITICAL(&lock);
+    return copy;
+}
+
+} // namespace ui::wifi_link
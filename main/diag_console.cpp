@@ -0,0 +1,92 @@
+#include "diag_console.hpp"
+
+#include "display_driver.hpp"
+#include "esp_console.h"
+#include "esp_log.h"
+#include "touch_trace.hpp"
+#include "trace.hpp"
+#include <cstdio>
+#include <cstring>
+
+static const char *TAG = "DIAG_CONSOLE";
+
+namespace {
+
+int touch_rec_cmd(int argc, char **argv) {
+    auto &display = DisplayDriver::instance();
+    if (argc == 2 && strcmp(argv[1], "start") == 0) {
+        const esp_err_t err = display.start_touch_recording();
+        if (err != ESP_OK) {
+            printf("Falha ao iniciar gravação: %s\n", esp_err_to_name(err));
+            return 1;
+        }
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+        display.stop_touch_recording();
+        return 0;
+    }
+    printf("Uso: touch_rec start|stop\n");
+    return 1;
+}
+
+int touch_play_cmd(int argc, char **argv) {
+    auto &display = DisplayDriver::instance();
+    const TouchTrace *trace = display.last_touch_recording();
+    if (trace == nullptr) {
+        printf("Nenhuma gravação encerrada (touch_rec start/stop)\n");
+        return 1;
+    }
+    if (display.is_touch_trace_playing()) {
+        printf("Reprodução já em andamento\n");
+        return 1;
+    }
+    const esp_err_t err = display.play_touch_trace(trace);
+    if (err != ESP_OK) {
+        printf("Falha ao reproduzir: %s\n", esp_err_to_name(err));
+        return 1;
+    }
+    return 0;
+}
+
+int trace_dump_cmd(int argc, char **argv) {
+    // Linhas TR/TN no log, para tools/trace_decode.py; sem TRACE_ENABLED só avisa
+    trace::dump();
+    return 0;
+}
+
+} // namespace
+
+namespace diag_console {
+
+esp_err_t start() {
+    esp_console_repl_t *repl = nullptr;
+    esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    repl_config.prompt = "hub>";
+    repl_config.max_cmdline_length = 64;
+    esp_console_dev_uart_config_t uart_config = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+    esp_err_t err = esp_console_new_repl_uart(&uart_config, &repl_config, &repl);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const esp_console_cmd_t commands[] = {
+        {"touch_rec", "Grava as amostras reais do touch (log TT,... e buffer em RAM)", "start|stop",
+         touch_rec_cmd, nullptr},
+        {"touch_play", "Reproduz a última gravação no indev", nullptr, touch_play_cmd, nullptr},
+        {"trace_dump", "Escreve os rings do trace binário no log (tools/trace_decode.py)", nullptr,
+         trace_dump_cmd, nullptr},
+    };
+    for (const auto &command : commands) {
+        err = esp_console_cmd_register(&command);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    esp_console_register_help_command();
+
+    ESP_LOGI(TAG, "Console de diagnóstico pronto (\"help\" lista os comandos)");
+    return esp_console_start_repl(repl);
+}
+
+} // namespace diag_console
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "esp_err.h"
+
+/**
+ * @brief Console de diagnóstico na serial (UART0, junto com o log).
+ *
+ * Comandos para medir a UI com entrada reproduzível:
+ *   touch_rec start|stop   grava as amostras reais do touch (log TT,... e RAM)
+ *   touch_play             reproduz a última gravação no indev do LVGL
+ *   trace_dump             escreve os rings do trace binário no log
+ * "help" lista tudo. Os resultados saem no log (tag TOUCH_TRACE).
+ */
+namespace diag_console {
+
+/**
+ * @brief Registra os comandos e inicia o REPL em um task próprio.
+ */
+esp_err_t start();
+
+} // namespace diag_console
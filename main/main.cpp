@@ -3,9 +3,12 @@ extern "C" {
 #include "freertos/task.h"
 }
 
+#include "boot_profile.hpp"
+#include "diag_console.hpp"
 #include "display_driver.hpp"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "nvs_flash.h"
 #include "ui_driver.hpp"
 
@@ -13,28 +16,43 @@ static const char *TAG = "CYD_APP";
 
 extern "C" void app_main(void) {
     ESP_LOGI(TAG, "Inicializando componentes...");
-
-    esp_err_t nvs_ret = nvs_flash_init();
-    if (nvs_ret == ESP_ERR_NVS_NO_FREE_PAGES || nvs_ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        nvs_ret = nvs_flash_init();
+    // Startup do IDF até o app_main (o relógio do esp_timer começa depois do bootloader)
+    boot_profile::record("startup", 0, esp_timer_get_time());
+
+    {
+        const boot_profile::Scope stage("nvs");
+        esp_err_t nvs_ret = nvs_flash_init();
+        if (nvs_ret == ESP_ERR_NVS_NO_FREE_PAGES || nvs_ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+            ESP_ERROR_CHECK(nvs_flash_erase());
+            nvs_ret = nvs_flash_init();
+        }
+        ESP_ERROR_CHECK(nvs_ret);
     }
-    ESP_ERROR_CHECK(nvs_ret);
 
     auto &display = DisplayDriver::instance();
-    const esp_err_t init_result = display.init();
-    if (init_result != ESP_OK) {
-        ESP_LOGE(TAG, "Falha ao iniciar display: %s", esp_err_to_name(init_result));
-        return;
+    {
+        const boot_profile::Scope stage("display");
+        const esp_err_t init_result = display.init();
+        if (init_result != ESP_OK) {
+            ESP_LOGE(TAG, "Falha ao iniciar display: %s", esp_err_to_name(init_result));
+            return;
+        }
     }
 
-    ui::init(display.lvgl_display());
+    {
+        const boot_profile::Scope stage("ui");
+        ui::init(display.lvgl_display());
+    }
+
+    // Gravação/replay de touch e outros diagnósticos pela serial
+    const esp_err_t console_result = diag_console::start();
+    if (console_result != ESP_OK) {
+        ESP_LOGW(TAG, "Console de diagnóstico indisponível: %s", esp_err_to_name(console_result));
+    }
 
     ESP_LOGI(TAG, "Sistema pronto. Aplicação de pesquisa de satisfação rodando...");
 
-    // Loop principal - atualiza UI periodicamente
-    while (true) {
-        vTaskDelay(pdMS_TO_TICKS(100));
-        ui::update();
-    }
+    // A UI é dirigida por eventos no task do LVGL; o task principal não tem mais
+    // trabalho periódico e fica bloqueado sem acordar
+    vTaskSuspend(nullptr);
 }
@@ -0,0 +1,457 @@
+#!/usr/bin/env python3
+"""
+Gerador de subconjunto da fonte Roboto usada pela UI
+
+Lê a fonte mestre gerada pelo lv_font_conv (components/ui_driver/roboto.c,
+faixa 0-65535), coleta todos os caracteres usados nas strings literais da UI
+e um charset extra configurável, e gera um novo .c contendo apenas esses
+glifos com cmaps densos (FORMAT0_TINY por faixa contígua).
+
+O build falha (código de saída 1) se alguma string da UI usar um caractere
+que não existe na fonte mestre.
+"""
+
+import os
+import re
+import sys
+import argparse
+
+# Macros cujas strings não aparecem na tela (somente log/diagnóstico)
+LOG_MACROS = re.compile(
+    r'^(ESP_LOG[EWIDV]|ESP_EARLY_LOG[EWIDV]|ESP_DRAM_LOG[EWIDV]|ESP_RETURN_ON_ERROR|'
+    r'ESP_RETURN_ON_FALSE|ESP_GOTO_ON_ERROR|ESP_GOTO_ON_FALSE|printf)$'
+)
+
+SOURCE_EXTENSIONS = ('.cpp', '.hpp', '.h', '.c')
+
+
+class SubsetError(Exception):
+    """Erro fatal na geração do subconjunto"""
+
+
+# ============================================
+# EXTRAÇÃO DE STRINGS DA UI
+# ============================================
+
+def _decode_c_string(body):
+    """Decodifica o conteúdo de uma string literal C (sem aspas) para str"""
+    out = bytearray()
+    raw = body.encode('utf-8')
+    i = 0
+    while i < len(raw):
+        c = raw[i]
+        if c != 0x5C:  # '\'
+            out.append(c)
+            i += 1
+            continue
+        i += 1
+        if i >= len(raw):
+            break
+        e = chr(raw[i])
+        simple = {'n': 0x0A, 't': 0x09, 'r': 0x0D, 'a': 0x07, 'b': 0x08,
+                  'f': 0x0C, 'v': 0x0B, '\\': 0x5C, '"': 0x22, "'": 0x27, '?': 0x3F}
+        if e == 'x':
+            m = re.match(rb'[0-9a-fA-F]+', raw[i + 1:])
+            out.append(int(m.group(0), 16) & 0xFF)
+            i += 1 + len(m.group(0))
+        elif e in 'uU':
+            n = 4 if e == 'u' else 8
+            out += chr(int(raw[i + 1:i + 1 + n], 16)).encode('utf-8')
+            i += 1 + n
+        elif e in '01234567':
+            m = re.match(rb'[0-7]{1,3}', raw[i:])
+            out.append(int(m.group(0), 8) & 0xFF)
+            i += len(m.group(0))
+        elif e in simple:
+            out.append(simple[e])
+            i += 1
+        else:
+            out += e.encode('utf-8')
+            i += 1
+    return out.decode('utf-8', errors='strict')
+
+
+def extract_ui_strings(path):
+    """
+    Retorna lista de (linha, texto) com as strings literais de um arquivo fonte,
+    ignorando comentários, literais de caractere e argumentos de macros de log.
+    """
+    with open(path, 'r', encoding='utf-8') as f:
+        src = f.read()
+
+    results = []
+    i = 0
+    line = 1
+    n = len(src)
+    skip_depth = None   # profundidade de parênteses do macro de log em curso
+    depth = 0
+    pending_log = False
+
+    while i < n:
+        c = src[i]
+        if c == '\n':
+            line += 1
+            i += 1
+        elif src.startswith('//', i):
+            end = src.find('\n', i)
+            i = n if end < 0 else end
+        elif src.startswith('/*', i):
+            end = src.find('*/', i + 2)
+            end = n if end < 0 else end + 2
+            line += src.count('\n', i, end)
+            i = end
+        elif c == "'":
+            m = re.compile(r"'(?:[^'\\\n]|\\.)*'").match(src, i)
+            i = m.end() if m else i + 1
+        elif c == '"':
+            m = re.compile(r'"((?:[^"\\\n]|\\.)*)"').match(src, i)
+            if not m:
+                i += 1
+                continue
+            if skip_depth is None:
+                try:
+                    results.append((line, _decode_c_string(m.group(1))))
+                except UnicodeDecodeError as exc:
+                    raise SubsetError(f"{path}:{line}: string literal não é UTF-8 válido ({exc})")
+            i = m.end()
+        elif c.isalpha() or c == '_':
+            m = re.compile(r'[A-Za-z_][A-Za-z0-9_]*').match(src, i)
+            # Prefixos de literal (u8"...", L"...") são tratados como strings normais
+            pending_log = bool(LOG_MACROS.match(m.group(0)))
+            i = m.end()
+            continue
+        elif c == '(':
+            depth += 1
+            if pending_log and skip_depth is None:
+                skip_depth = depth
+            i += 1
+        elif c == ')':
+            if skip_depth is not None and depth == skip_depth:
+                skip_depth = None
+            depth -= 1
+            i += 1
+        else:
+            i += 1
+
+        if not c.isspace():
+            pending_log = False
+
+    return results
+
+
+def collect_ui_chars(source_dirs):
+    """Mapeia cada caractere usado pela UI para a primeira ocorrência (arquivo:linha)"""
+    used = {}
+    for root_dir in source_dirs:
+        for root, _dirs, files in os.walk(root_dir):
+            for name in sorted(files):
+                if not name.endswith(SOURCE_EXTENSIONS):
+                    continue
+                path = os.path.join(root, name)
+                # A própria fonte (mestre ou gerada) não contém strings da UI
+                if name.startswith('roboto'):
+                    continue
+                for line, text in extract_ui_strings(path):
+                    for ch in text:
+                        cp = ord(ch)
+                        if cp < 0x20:
+                            continue  # controle (\n, \t): LVGL não busca glifo
+                        used.setdefault(cp, f"{path}:{line}")
+    return used
+
+
+def load_charset(path):
+    """Lê o arquivo de charset extra (um code point ou faixa 0xAA-0xBB por linha)"""
+    cps = set()
+    if not path:
+        return cps
+    with open(path, 'r', encoding='utf-8') as f:
+        for lineno, raw in enumerate(f, 1):
+            text = raw.split('#', 1)[0].strip()
+            if not text:
+                continue
+            try:
+                if '-' in text:
+                    lo, hi = (int(p.strip(), 0) for p in text.split('-', 1))
+                else:
+                    lo = hi = int(text, 0)
+            except ValueError:
+                raise SubsetError(f"{path}:{lineno}: faixa inválida '{text}'")
+            cps.update(range(lo, hi + 1))
+    return cps
+
+
+# ============================================
+# LEITURA DA FONTE MESTRE (saída do lv_font_conv)
+# ============================================
+
+def _c_array(src, name):
+    m = re.search(r'\b' + re.escape(name) + r'\[\]\s*=\s*\{(.*?)\n\};', src, re.S)
+    if not m:
+        raise SubsetError(f"array '{name}' não encontrado na fonte mestre")
+    return m.group(1)
+
+
+def _c_int(src, pattern, default=None):
+    m = re.search(pattern, src)
+    if not m:
+        if default is not None:
+            return default
+        raise SubsetError(f"campo '{pattern}' não encontrado na fonte mestre")
+    return int(m.group(1), 0)
+
+
+def parse_master(path):
+    with open(path, 'r', encoding='utf-8') as f:
+        src = f.read()
+
+    font = {
+        'bpp': _c_int(src, r'\.bpp\s*=\s*(\d+)'),
+        'bitmap_format': _c_int(src, r'\.bitmap_format\s*=\s*(\d+)'),
+        'kern_scale': _c_int(src, r'\.kern_scale\s*=\s*(\d+)', 16),
+        'line_height': _c_int(src, r'\.line_height\s*=\s*(-?\d+)'),
+        'base_line': _c_int(src, r'\.base_line\s*=\s*(-?\d+)'),
+        'underline_position': _c_int(src, r'\.underline_position\s*=\s*(-?\d+)', 0),
+        'underline_thickness': _c_int(src, r'\.underline_thickness\s*=\s*(-?\d+)', 0),
+        'size': _c_int(src, r'\* Size:\s*(\d+)', 0),
+    }
+    if font['bitmap_format'] != 0:
+        raise SubsetError("fonte mestre comprimida não suportada (gere com --no-compress)")
+    if re.search(r'\.kern_classes\s*=\s*1', src):
+        raise SubsetError("kerning por classes não suportado (gere com pares de kerning)")
+
+    bitmap = [int(v, 0) for v in re.findall(r'0x[0-9a-fA-F]+|\b\d+\b',
+                                            re.sub(r'/\*.*?\*/', '', _c_array(src, 'glyph_bitmap'), flags=re.S))]
+
+    # Ordem dos glifos = ordem dos comentários U+XXXX no bitmap (glyph id 1..N)
+    codepoints = [int(h, 16) for h in re.findall(r'/\* U\+([0-9A-F]+) ', _c_array(src, 'glyph_bitmap'))]
+
+    dsc_re = re.compile(r'\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), '
+                        r'\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}')
+    dscs = [tuple(int(v) for v in m) for m in dsc_re.findall(_c_array(src, 'glyph_dsc'))]
+    if len(dscs) != len(codepoints) + 1:
+        raise SubsetError(f"fonte mestre inconsistente: {len(dscs)} descritores para {len(codepoints)} glifos")
+
+    glyphs = {}
+    for gid, cp in enumerate(codepoints, 1):
+        start = dscs[gid][0]
+        end = dscs[gid + 1][0] if gid + 1 < len(dscs) else len(bitmap)
+        glyphs[cp] = {'gid': gid, 'dsc': dscs[gid], 'bitmap': bitmap[start:end]}
+
+    kerning = []
+    if re.search(r'kern_pair_glyph_ids\[\]', src):
+        ids = [int(v) for v in re.findall(r'-?\d+', _c_array(src, 'kern_pair_glyph_ids'))]
+        vals = [int(v) for v in re.findall(r'-?\d+', _c_array(src, 'kern_pair_values'))]
+        if len(ids) != 2 * len(vals):
+            raise SubsetError("pares de kerning inconsistentes na fonte mestre")
+        kerning = [(ids[2 * k], ids[2 * k + 1], vals[k]) for k in range(len(vals))]
+
+    font['glyphs'] = glyphs
+    font['kerning'] = kerning
+    return font
+
+
+# ============================================
+# GERAÇÃO DO SUBCONJUNTO
+# ============================================
+
+def _char_comment(cp):
+    if cp < 0x20 or cp == 0x7F:
+        return '\\u%04x' % cp
+    ch = chr(cp)
+    if ch in '\\"':
+        return '\\' + ch
+    if ch == '/':
+        return '/'
+    return ch
+
+
+def _ranges(cps):
+    """Agrupa code points ordenados em faixas contíguas [(início, tamanho)]"""
+    ranges = []
+    for cp in cps:
+        if ranges and ranges[-1][0] + ranges[-1][1] == cp:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([cp, 1])
+    return ranges
+
+
+def _wrap(values, per_line=8, indent='    '):
+    lines = []
+    for k in range(0, len(values), per_line):
+        lines.append(indent + ', '.join(values[k:k + per_line]))
+    return ',\n'.join(lines)
+
+
+def render_subset(font, cps, args):
+    cps = sorted(cps)
+    remap = {font['glyphs'][cp]['gid']: new_gid for new_gid, cp in enumerate(cps, 1)}
+
+    out = []
+    ranges = _ranges(cps)
+    range_desc = ','.join(('0x%X' % s) if n == 1 else ('0x%X-0x%X' % (s, s + n - 1)) for s, n in ranges)
+    out.append('/*******************************************************************************\n'
+               f" * Size: {font['size']} px\n"
+               f" * Bpp: {font['bpp']}\n"
+               f" * Subconjunto gerado por tools/font_subset.py a partir de {os.path.basename(args.master)}\n"
+               f" * Glifos: {len(cps)} ({range_desc})\n"
+               ' * NÃO EDITE: arquivo gerado durante o build\n'
+               ' ******************************************************************************/\n')
+    out.append('#ifdef __has_include\n'
+               '    #if __has_include("lvgl.h")\n'
+               '        #ifndef LV_LVGL_H_INCLUDE_SIMPLE\n'
+               '            #define LV_LVGL_H_INCLUDE_SIMPLE\n'
+               '        #endif\n'
+               '    #endif\n'
+               '#endif\n\n'
+               '#ifdef LV_LVGL_H_INCLUDE_SIMPLE\n'
+               '    #include "lvgl.h"\n'
+               '#else\n'
+               '    #include "lvgl/lvgl.h"\n'
+               '#endif\n')
+
+    # Bitmaps
+    out.append('/*-----------------\n *    BITMAPS\n *----------------*/\n\n'
+               '/*Store the image of the glyphs*/\n'
+               'static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {')
+    chunks = []
+    offsets = []
+    offset = 0
+    for cp in cps:
+        data = font['glyphs'][cp]['bitmap']
+        offsets.append(offset)
+        offset += len(data)
+        text = '    /* U+%04X "%s" */\n' % (cp, _char_comment(cp))
+        if data:
+            text += _wrap(['0x%x' % b for b in data])
+        chunks.append((text, bool(data)))
+    body = []
+    for k, (text, has_data) in enumerate(chunks):
+        more_data = any(d for _t, d in chunks[k + 1:])
+        body.append(text + (',' if has_data and more_data else '') + '\n')
+    out.append('\n'.join(body) + '};\n')
+
+    # Descritores
+    out.append('/*---------------------\n *  GLYPH DESCRIPTION\n *--------------------*/\n\n'
+               'static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {\n'
+               '    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,')
+    rows = []
+    for cp, ofs in zip(cps, offsets):
+        _bi, adv_w, box_w, box_h, ofs_x, ofs_y = font['glyphs'][cp]['dsc']
+        rows.append(f'    {{.bitmap_index = {ofs}, .adv_w = {adv_w}, .box_w = {box_w}, .box_h = {box_h}, '
+                    f'.ofs_x = {ofs_x}, .ofs_y = {ofs_y}}}')
+    out.append(',\n'.join(rows) + '\n};\n')
+
+    # Cmaps densos: uma entrada FORMAT0_TINY por faixa contígua
+    out.append('/*---------------------\n *  CHARACTER MAPPING\n *--------------------*/\n\n'
+               '/*Collect the unicode lists and glyph_id offsets*/\n'
+               'static const lv_font_fmt_txt_cmap_t cmaps[] =\n{')
+    entries = []
+    gid = 1
+    for start, length in ranges:
+        entries.append('    {\n'
+                       f'        .range_start = {start}, .range_length = {length}, .glyph_id_start = {gid},\n'
+                       '        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, '
+                       '.type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY\n'
+                       '    }')
+        gid += length
+    out.append(',\n'.join(entries) + '\n};\n\n')
+
+    # Kerning: mantém apenas pares com os dois glifos no subconjunto.
+    # O remapeamento é monotônico, então a ordenação exigida pela busca binária se mantém.
+    pairs = [(remap[l], remap[r], v) for l, r, v in font['kerning'] if l in remap and r in remap]
+    kern_ref = 'NULL'
+    if pairs:
+        wide = max(max(l, r) for l, r, _v in pairs) > 255
+        id_type = 'uint16_t' if wide else 'uint8_t'
+        out.append('/*-----------------\n *    KERNING\n *----------------*/\n\n\n'
+                   '/*Pair left and right glyphs for kerning*/\n'
+                   f'static const {id_type} kern_pair_glyph_ids[] =\n{{\n'
+                   + ',\n'.join(f'    {l}, {r}' for l, r, _v in pairs) + '\n};\n\n'
+                   '/* Kerning between the respective left and right glyphs\n'
+                   ' * 4.4 format which needs to scaled with `kern_scale`*/\n'
+                   'static const int8_t kern_pair_values[] =\n{\n'
+                   + _wrap([str(v) for _l, _r, v in pairs]) + '\n};\n\n'
+                   '/*Collect the kern pair\'s data in one place*/\n'
+                   'static const lv_font_fmt_txt_kern_pair_t kern_pairs =\n{\n'
+                   '    .glyph_ids = kern_pair_glyph_ids,\n'
+                   '    .values = kern_pair_values,\n'
+                   f'    .pair_cnt = {len(pairs)},\n'
+                   f'    .glyph_ids_size = {1 if wide else 0}\n'
+                   '};\n\n')
+        kern_ref = '&kern_pairs'
+
+    out.append('/*--------------------\n *  ALL CUSTOM DATA\n *--------------------*/\n\n'
+               'static const lv_font_fmt_txt_dsc_t font_dsc = {\n'
+               '    .glyph_bitmap = glyph_bitmap,\n'
+               '    .glyph_dsc = glyph_dsc,\n'
+               '    .cmaps = cmaps,\n'
+               f'    .kern_dsc = {kern_ref},\n'
+               f"    .kern_scale = {font['kern_scale']},\n"
+               f'    .cmap_num = {len(ranges)},\n'
+               f"    .bpp = {font['bpp']},\n"
+               '    .kern_classes = 0,\n'
+               '    .bitmap_format = 0,\n'
+               '};\n\n\n')
+
+    out.append('/*-----------------\n *  PUBLIC FONT\n *----------------*/\n\n'
+               '/*Initialize a public general font descriptor*/\n'
+               f'const lv_font_t {args.symbol} = {{\n'
+               '    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph\'s data*/\n'
+               '    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph\'s bitmap*/\n'
+               f"    .line_height = {font['line_height']},          /*The maximum line height required by the font*/\n"
+               f"    .base_line = {font['base_line']},             /*Baseline measured from the bottom of the line*/\n"
+               '    .subpx = LV_FONT_SUBPX_NONE,\n'
+               f"    .underline_position = {font['underline_position']},\n"
+               f"    .underline_thickness = {font['underline_thickness']},\n"
+               '    .static_bitmap = 0,\n'
+               '    .dsc = &font_dsc,          /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */\n'
+               '    .fallback = NULL,\n'
+               '    .user_data = NULL,\n'
+               '};\n')
+
+    return '\n'.join(out), offset
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Gera subconjunto da fonte da UI a partir das strings usadas')
+    parser.add_argument('--master', required=True, help='Fonte mestre gerada pelo lv_font_conv (.c)')
+    parser.add_argument('--sources', nargs='+', required=True, help='Diretórios com o código da UI')
+    parser.add_argument('--charset', help='Arquivo com code points/faixas extras a incluir')
+    parser.add_argument('--output', required=True, help='Arquivo .c de saída')
+    parser.add_argument('--symbol', default='roboto', help='Nome do lv_font_t gerado (padrão: roboto)')
+    args = parser.parse_args()
+
+    try:
+        font = parse_master(args.master)
+        ui_chars = collect_ui_chars(args.sources)
+        extra = load_charset(args.charset)
+    except (OSError, SubsetError) as exc:
+        print(f"[font_subset] ERRO: {exc}", file=sys.stderr)
+        return 1
+
+    missing = sorted(cp for cp in ui_chars if cp not in font['glyphs'])
+    if missing:
+        for cp in missing:
+            print(f"[font_subset] ERRO: {ui_chars[cp]}: caractere U+{cp:04X} '{chr(cp)}' "
+                  f"não existe na fonte {os.path.basename(args.master)}", file=sys.stderr)
+        return 1
+
+    # Faixas do charset extra podem cobrir code points sem glifo na fonte mestre
+    subset = set(ui_chars) | {cp for cp in extra if cp in font['glyphs']}
+
+    text, bitmap_bytes = render_subset(font, subset, args)
+    tmp = args.output + '.tmp'
+    with open(tmp, 'w', encoding='utf-8') as f:
+        f.write(text)
+    os.replace(tmp, args.output)
+
+    print(f"[font_subset] {len(subset)} glifos de {len(font['glyphs'])} "
+          f"({len(ui_chars)} usados pela UI), bitmap {bitmap_bytes} bytes, "
+          f"{len(_ranges(sorted(subset)))} cmaps -> {args.output}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
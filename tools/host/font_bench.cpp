@@ -0,0 +1,165 @@
+/**
+ * @file font_bench.cpp
+ * @brief Micro-benchmark da tabela direta de glyph id (ui::fonts, user-027)
+ *
+ * Compara a fonte registrada por ui::fonts::init() com o caminho padrão
+ * lv_font_fmt_txt na mesma Roboto:
+ *   1. equivalência: descritor idêntico para todo code point até U+2100 e
+ *      avanço idêntico (kerning) para todos os pares Latin-1;
+ *   2. tempo de lv_font_get_glyph_dsc por caractere e de lv_text_get_size
+ *      por string, sobre as strings reais das telas.
+ *
+ * font_bench_master usa a fonte mestre (roboto.c); font_bench_subset, o
+ * subconjunto gerado no build como no firmware.
+ */
+#include "lvgl.h"
+#include "ui_fonts.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern const lv_font_t roboto;
+
+namespace {
+
+// Textos das telas (ui_driver.cpp e screens/); os com formato entram já formatados
+const char *const UI_STRINGS[] = {
+    "Como você se sentiu hoje?",
+    "Obrigado!",
+    "Excelente",
+    "Configurações",
+    "Configurar WiFi",
+    "Atualização OTA",
+    "Baixando atualização...",
+    "Atualização concluída!\nReiniciando...",
+    "Buscando redes... 12 encontrada(s)",
+    "Selecione uma rede",
+    "Nenhuma rede encontrada",
+    "Toque para digitar",
+    "Digite a senha",
+    "Senha incorreta?",
+    "Conectando...",
+    "Timeout ao conectar",
+    "Brilho: 80% (Auto)",
+    "Automático",
+    "Endereço MAC",
+    "Heap DMA (livre/maior bloco)",
+    "Cancelar",
+    "Conectar",
+    "Sobre",
+    "1", "2", "3", "4", "5",
+};
+constexpr size_t STRING_COUNT = sizeof(UI_STRINGS) / sizeof(UI_STRINGS[0]);
+
+// Próximo code point UTF-8 (as strings da UI são UTF-8 válido)
+uint32_t next_code_point(const char *&p) {
+    const uint8_t c = static_cast<uint8_t>(*p++);
+    if (c < 0x80) return c;
+    int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+    uint32_t cp = c & (0x3F >> extra);
+    while (extra-- > 0) cp = (cp << 6) | (static_cast<uint8_t>(*p++) & 0x3F);
+    return cp;
+}
+
+bool same_dsc(const lv_font_glyph_dsc_t &a, const lv_font_glyph_dsc_t &b) {
+    return a.adv_w == b.adv_w && a.box_w == b.box_w && a.box_h == b.box_h && a.ofs_x == b.ofs_x &&
+           a.ofs_y == b.ofs_y && a.gid.index == b.gid.index;
+}
+
+uint32_t check_equivalence(const lv_font_t *fast) {
+    static const uint32_t NEXT[] = {0, ' ', 'A', 'T', 'V', 'a', 'e', 'o', 0xE7, 0xE3, 0x2022};
+    uint32_t mismatches = 0;
+    for (uint32_t letter = 0; letter < 0x2100; ++letter) {
+        for (uint32_t next : NEXT) {
+            lv_font_glyph_dsc_t ref = {};
+            lv_font_glyph_dsc_t got = {};
+            const bool ref_found = lv_font_get_glyph_dsc_fmt_txt(&roboto, &ref, letter, next);
+            const bool got_found = fast->get_glyph_dsc(fast, &got, letter, next);
+            if (ref_found != got_found || (ref_found && !same_dsc(ref, got))) {
+                if (mismatches++ < 5) {
+                    std::printf("  divergência em U+%04X seguido de U+%04X\n", (unsigned)letter, (unsigned)next);
+                }
+            }
+        }
+    }
+    for (uint32_t letter = 0x20; letter < 0x100; ++letter) {
+        for (uint32_t next = 0x20; next < 0x100; ++next) {
+            lv_font_glyph_dsc_t ref = {};
+            lv_font_glyph_dsc_t got = {};
+            lv_font_get_glyph_dsc_fmt_txt(&roboto, &ref, letter, next);
+            fast->get_glyph_dsc(fast, &got, letter, next);
+            if (ref.adv_w != got.adv_w && mismatches++ < 5) {
+                std::printf("  kerning diverge em U+%04X U+%04X\n", (unsigned)letter, (unsigned)next);
+            }
+        }
+    }
+    return mismatches;
+}
+
+struct Timing {
+    double glyph_ns;  ///< Por caractere
+    double text_ns;   ///< Por string
+};
+
+Timing measure(const lv_font_t *font, int rounds) {
+    using clock = std::chrono::steady_clock;
+    volatile uint32_t sink = 0;
+    size_t chars = 0;
+
+    const auto t0 = clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const char *s : UI_STRINGS) {
+            const char *p = s;
+            uint32_t letter = next_code_point(p);
+            while (letter != 0) {
+                const uint32_t next = *p != '\0' ? next_code_point(p) : 0;
+                lv_font_glyph_dsc_t dsc;
+                sink = sink + lv_font_get_glyph_dsc(font, &dsc, letter, next);
+                letter = next;
+                ++chars;
+            }
+        }
+    }
+    const auto t1 = clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const char *s : UI_STRINGS) {
+            lv_point_t size;
+            lv_text_get_size(&size, s, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+            sink = sink + size.x;
+        }
+    }
+    const auto t2 = clock::now();
+
+    const double glyph = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    const double text = std::chrono::duration<double, std::nano>(t2 - t1).count();
+    return Timing{glyph / chars, text / (static_cast<double>(rounds) * STRING_COUNT)};
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    lv_init();
+    ui::fonts::init();
+    const lv_font_t *fast = ui::fonts::roboto();
+
+    const uint32_t mismatches = check_equivalence(fast);
+    std::printf("Equivalência com lv_font_fmt_txt: %s (%u divergências)\n", mismatches == 0 ? "ok" : "FALHOU",
+                (unsigned)mismatches);
+
+    const Timing reference = measure(&roboto, rounds);
+    const Timing lut = measure(fast, rounds);
+    std::printf("%-22s %12s %16s\n", "", "glyph_dsc", "text_get_size");
+    std::printf("%-22s %9.1f ns %13.1f ns\n", "lv_font_fmt_txt", reference.glyph_ns, reference.text_ns);
+    std::printf("%-22s %9.1f ns %13.1f ns\n", "tabela direta", lut.glyph_ns, lut.text_ns);
+    std::printf("(%d rodadas de %zu strings; glyph_dsc por caractere, text_get_size por string)\n", rounds,
+                STRING_COUNT);
+
+    const ui::fonts::GlyphLookupStats stats = ui::fonts::get_lookup_stats();
+    std::printf("Tabela: %u glifos Latin-1, %u consultas na tabela, %u no lv_font_fmt_txt\n",
+                (unsigned)stats.latin_glyphs, (unsigned)stats.lut_hits, (unsigned)stats.fallbacks);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+// tinfl da ROM do ESP32 sobre o zlib do sistema (ligar com ZLIB::ZLIB)
+//
+// Mesma interface usada pelo ota_inflate.cpp: o chamador aloca o
+// tinfl_decompressor, reinicia com tinfl_init() e descomprime para uma janela
+// circular. O zlib guarda a própria janela de 32 KB e o seu estado; os dois
+// moram num arena dentro do tinfl_decompressor, então um free() do chamador
+// libera tudo, como no tinfl. Por isso sizeof(tinfl_decompressor) aqui é o
+// custo do zlib, não o do tinfl da ROM (~11 KB).
+#include <cstddef>
+#include <cstdint>
+#include <zlib.h>
+
+enum {
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+    TINFL_FLAG_COMPUTE_ADLER32 = 8,
+};
+
+typedef enum {
+    TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS = -4,
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2,
+} tinfl_status;
+
+typedef struct {
+    z_stream stream;
+    bool started;
+    size_t arena_used;
+    // inflate_state (~7 KB em 64 bits) + janela de 32 KB do zlib
+    alignas(16) uint8_t arena[44 * 1024];
+} tinfl_decompressor;
+
+inline voidpf tinfl_zlib_alloc(voidpf opaque, uInt items, uInt size) {
+    tinfl_decompressor *r = static_cast<tinfl_decompressor *>(opaque);
+    const size_t bytes = (static_cast<size_t>(items) * size + 15) & ~static_cast<size_t>(15);
+    if (r->arena_used + bytes > sizeof(r->arena)) {
+        return Z_NULL;
+    }
+    voidpf p = r->arena + r->arena_used;
+    r->arena_used += bytes;
+    return p;
+}
+
+inline void tinfl_zlib_free(voidpf opaque, voidpf address) {
+    // Arena: liberado de uma vez por tinfl_init() ou pelo free() do chamador
+}
+
+#define tinfl_init(r)                 \
+    do {                              \
+        (r)->started = false;         \
+        (r)->arena_used = 0;          \
+    } while (0)
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *in_buf, size_t *in_buf_size,
+                                     uint8_t *out_buf_start, uint8_t *out_buf_next, size_t *out_buf_size,
+                                     const uint32_t flags) {
+    z_stream &stream = r->stream;
+    if (!r->started) {
+        stream = {};
+        stream.zalloc = tinfl_zlib_alloc;
+        stream.zfree = tinfl_zlib_free;
+        stream.opaque = r;
+        const int window_bits = (flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? MAX_WBITS : -MAX_WBITS;
+        if (inflateInit2(&stream, window_bits) != Z_OK) {
+            *in_buf_size = 0;
+            *out_buf_size = 0;
+            return TINFL_STATUS_FAILED;
+        }
+        r->started = true;
+    }
+
+    const size_t in_size = *in_buf_size;
+    const size_t out_size = *out_buf_size;
+    stream.next_in = const_cast<Bytef *>(in_buf);
+    stream.avail_in = static_cast<uInt>(in_size);
+    stream.next_out = out_buf_next;
+    stream.avail_out = static_cast<uInt>(out_size);
+    const int ret = inflate(&stream, Z_NO_FLUSH);
+    *in_buf_size = in_size - stream.avail_in;
+    *out_buf_size = out_size - stream.avail_out;
+
+    if (ret == Z_STREAM_END) {
+        return TINFL_STATUS_DONE;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        return TINFL_STATUS_FAILED;
+    }
+    if (stream.avail_out == 0) {
+        return TINFL_STATUS_HAS_MORE_OUTPUT;
+    }
+    if (stream.avail_in == 0) {
+        return (flags & TINFL_FLAG_HAS_MORE_INPUT) ? TINFL_STATUS_NEEDS_MORE_INPUT
+                                                   : TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+    }
+    return TINFL_STATUS_FAILED_CANNOT_MAKE_PROGRESS;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// esp_partition de host: só o tipo, para os headers do ota_driver; nenhum programa grava flash
+typedef struct esp_partition_t esp_partition_t;
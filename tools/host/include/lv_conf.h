@@ -0,0 +1,61 @@
+/**
+ * @file lv_conf.h
+ * @brief Configuração do LVGL para os programas de host
+ *
+ * Espelha as opções do sdkconfig que mudam o custo medido (profundidade de
+ * cor, alocador, cache de estilos, fontes, unidades de desenho); o resto
+ * fica no padrão do LVGL.
+ */
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_COLOR_DEPTH 16
+
+// Mesmo back-end do firmware (CONFIG_LV_USE_CUSTOM_MALLOC): cada programa liga um lvgl_mem.
+// O soak compila o TLSF do LVGL à parte, com LV_STDLIB_BUILTIN, como heap simulado
+#ifndef LV_USE_STDLIB_MALLOC
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_CUSTOM
+#endif
+#define LV_USE_STDLIB_STRING LV_STDLIB_CLIB
+#define LV_USE_STDLIB_SPRINTF LV_STDLIB_CLIB
+
+#define LV_DEF_REFR_PERIOD 33
+#define LV_DPI_DEF 130
+#define LV_USE_OS LV_OS_NONE
+
+#define LV_DRAW_LAYER_SIMPLE_BUF_SIZE (24 * 1024)
+#define LV_DRAW_SW_DRAW_UNIT_CNT 1
+#define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+#define LV_DRAW_SW_CIRCLE_CACHE_SIZE 2
+#define LV_GRADIENT_MAX_STOPS 2
+#define LV_CACHE_DEF_SIZE 0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+// style_cache_bench_off compila outro LVGL com LV_OBJ_STYLE_CACHE=0
+#ifndef LV_OBJ_STYLE_CACHE
+#define LV_OBJ_STYLE_CACHE 1
+#endif
+
+#define LV_USE_LOG 0
+#define LV_USE_ASSERT_NULL 1
+#define LV_USE_ASSERT_MALLOC 1
+
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_26 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+#define LV_FONT_FMT_TXT_LARGE 1
+#define LV_USE_FONT_COMPRESSED 1
+#define LV_USE_FONT_PLACEHOLDER 1
+
+#define LV_TEXTAREA_DEF_PWD_SHOW_TIME 1500
+#define LV_USE_THEME_DEFAULT 1
+#define LV_THEME_DEFAULT_GROW 1
+#define LV_THEME_DEFAULT_TRANSITION_TIME 80
+
+#define LV_BUILD_EXAMPLES 0
+// O demo de widgets do style_cache_bench é compilado à parte, com LV_BUILD_DEMOS=1
+#ifndef LV_BUILD_DEMOS
+#define LV_BUILD_DEMOS 0
+#endif
+
+#endif // LV_CONF_H
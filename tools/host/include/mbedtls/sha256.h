@@ -0,0 +1,29 @@
+#pragma once
+
+// SHA-256 do mbedtls sobre o EVP da OpenSSL (ligar com OpenSSL::Crypto)
+#include <openssl/evp.h>
+
+typedef struct {
+    EVP_MD_CTX *ctx;
+} mbedtls_sha256_context;
+
+inline void mbedtls_sha256_init(mbedtls_sha256_context *context) {
+    context->ctx = EVP_MD_CTX_new();
+}
+
+inline void mbedtls_sha256_free(mbedtls_sha256_context *context) {
+    EVP_MD_CTX_free(context->ctx);
+    context->ctx = nullptr;
+}
+
+inline int mbedtls_sha256_starts(mbedtls_sha256_context *context, int is224) {
+    return EVP_DigestInit_ex(context->ctx, is224 ? EVP_sha224() : EVP_sha256(), nullptr) == 1 ? 0 : -1;
+}
+
+inline int mbedtls_sha256_update(mbedtls_sha256_context *context, const unsigned char *input, size_t len) {
+    return EVP_DigestUpdate(context->ctx, input, len) == 1 ? 0 : -1;
+}
+
+inline int mbedtls_sha256_finish(mbedtls_sha256_context *context, unsigned char output[32]) {
+    return EVP_DigestFinal_ex(context->ctx, output, nullptr) == 1 ? 0 : -1;
+}
@@ -0,0 +1,418 @@
+/**
+ * @file lvgl_mem_soak.cpp
+ * @brief Soak de fragmentação do heap com o back-end de memória do LVGL (user-040)
+ *
+ * Simula o heap interno do ESP32 com um arena TLSF de 132 KB (o TLSF do
+ * próprio LVGL, o mesmo algoritmo do heap do ESP-IDF): malloc/realloc/free
+ * são desviados para ele com -Wl,--wrap, então tanto o fallback do LVGL
+ * quanto o "resto do firmware" disputam o mesmo arena. A cada iteração a
+ * tela de pergunta (fixa, como no ScreenManager) dá lugar a uma lista de
+ * 10 a 30 redes (transitória), com um quadro completo desenhado em cada
+ * troca, enquanto outro "task" aloca e libera blocos de 32 a 432 bytes
+ * (WiFi, HTTP, JSON) com vida aleatória.
+ *
+ * lvgl_mem_soak_clib liga o back-end antigo (CONFIG_LV_USE_CLIB_MALLOC: tudo
+ * no heap); lvgl_mem_soak_slab, o lvgl_mem.cpp do firmware. Relata, em
+ * pontos de controle, o heap livre, o número de fragmentos livres e o maior
+ * bloco livre do arena e, no slab, a ocupação das classes. Sai com 1 se o
+ * arena esgotar ou, no slab, se a fragmentação de algum ponto de controle
+ * passar a do primeiro em mais de FRAG_TOLERANCE_PCT pontos (ela deve ficar
+ * limitada, não crescer com o número de trocas).
+ *
+ * Uso: lvgl_mem_soak_<clib|slab> [trocas]
+ */
+#include "lvgl.h"
+
+#ifndef SOAK_CLIB_BACKEND
+#include "lvgl_mem.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+extern "C" {
+// TLSF do LVGL (stdlib/builtin/lv_tlsf.h só é visível com LV_STDLIB_BUILTIN)
+typedef void *lv_tlsf_t;
+typedef void *lv_pool_t;
+typedef void (*lv_tlsf_walker)(void *ptr, size_t size, int used, void *user);
+lv_tlsf_t lv_tlsf_create_with_pool(void *mem, size_t bytes);
+lv_pool_t lv_tlsf_get_pool(lv_tlsf_t tlsf);
+void *lv_tlsf_malloc(lv_tlsf_t tlsf, size_t bytes);
+void *lv_tlsf_realloc(lv_tlsf_t tlsf, void *ptr, size_t size);
+size_t lv_tlsf_free(lv_tlsf_t tlsf, const void *ptr);
+void lv_tlsf_walk_pool(lv_pool_t pool, lv_tlsf_walker walker, void *user);
+
+void *__real_malloc(size_t size);
+void *__real_realloc(void *p, size_t size);
+void __real_free(void *p);
+
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *p, size_t size);
+void __wrap_free(void *p);
+
+#ifndef SOAK_CLIB_BACKEND
+void *__real_lv_malloc_core(size_t size);
+void *__real_lv_realloc_core(void *p, size_t new_size);
+void __real_lv_free_core(void *p);
+
+void *__wrap_lv_malloc_core(size_t size);
+void *__wrap_lv_realloc_core(void *p, size_t new_size);
+void __wrap_lv_free_core(void *p);
+#endif
+}
+
+namespace {
+
+constexpr int32_t HOR_RES = 320;
+constexpr int32_t VER_RES = 240;
+constexpr size_t ARENA_SIZE = 132 * 1024;
+constexpr int CHECKPOINTS = 5;
+// Ruído do task de fundo entre pontos de controle
+constexpr unsigned FRAG_TOLERANCE_PCT = 10;
+
+// Alocações do "resto do firmware" entre as trocas
+constexpr size_t BACKGROUND_SLOTS = 48;
+constexpr size_t BACKGROUND_MIN = 32;
+constexpr size_t BACKGROUND_MAX = 432;
+constexpr int BACKGROUND_OPS_PER_SWAP = 6;
+
+alignas(16) uint8_t arena[ARENA_SIZE];
+lv_tlsf_t tlsf = nullptr;
+bool arena_exhausted = false;
+
+uint32_t rng_state = 0x2545F491u;
+
+uint32_t next_random() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+uint32_t random_between(uint32_t min, uint32_t max) {
+    return min + next_random() % (max - min + 1);
+}
+
+lv_tlsf_t heap() {
+    if (tlsf == nullptr) {
+        tlsf = lv_tlsf_create_with_pool(arena, sizeof(arena));
+    }
+    return tlsf;
+}
+
+bool in_arena(const void *p) {
+    return p >= arena && p < arena + sizeof(arena);
+}
+
+struct HeapInfo {
+    size_t free_bytes;
+    size_t largest_free;
+    size_t free_blocks;
+};
+
+void walk_block(void *ptr, size_t size, int used, void *user) {
+    if (!used) {
+        HeapInfo *info = static_cast<HeapInfo *>(user);
+        info->free_bytes += size;
+        info->free_blocks++;
+        if (size > info->largest_free) {
+            info->largest_free = size;
+        }
+    }
+}
+
+HeapInfo heap_info() {
+    HeapInfo info = {};
+    lv_tlsf_walk_pool(lv_tlsf_get_pool(heap()), walk_block, &info);
+    return info;
+}
+
+// Fragmentação: parcela do livre que não está no maior bloco
+unsigned fragmentation_pct(const HeapInfo &info) {
+    return info.free_bytes == 0 ? 100 : static_cast<unsigned>(100 - 100 * info.largest_free / info.free_bytes);
+}
+
+void *background[BACKGROUND_SLOTS] = {};
+
+#ifndef SOAK_CLIB_BACKEND
+// Demanda por classe: blocos vivos que pediram o tamanho da classe, no slab ou
+// no heap (slab cheio). O pico é a capacidade que evitaria qualquer fallback
+std::unordered_map<void *, size_t> &block_classes() {
+    static std::unordered_map<void *, size_t> classes;
+    return classes;
+}
+uint32_t class_demand[LVGL_MEM_CLASS_COUNT] = {};
+uint32_t class_demand_peak[LVGL_MEM_CLASS_COUNT] = {};
+
+void track_lv_alloc(void *p, size_t size) {
+    if (p == nullptr) {
+        return;
+    }
+    const LvglMemStats stats = lvgl_mem_stats();
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        if (size <= stats.classes[i].block_size) {
+            block_classes()[p] = i;
+            class_demand_peak[i] = std::max(class_demand_peak[i], ++class_demand[i]);
+            return;
+        }
+    }
+}
+
+void track_lv_free(void *p) {
+    auto it = block_classes().find(p);
+    if (it != block_classes().end()) {
+        class_demand[it->second]--;
+        block_classes().erase(it);
+    }
+}
+#endif
+
+void background_step() {
+    for (int op = 0; op < BACKGROUND_OPS_PER_SWAP; ++op) {
+        void *&slot = background[next_random() % BACKGROUND_SLOTS];
+        if (slot != nullptr) {
+            free(slot);
+            slot = nullptr;
+        } else {
+            slot = malloc(random_between(BACKGROUND_MIN, BACKGROUND_MAX));
+        }
+    }
+}
+
+void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    lv_display_flush_ready(disp);
+}
+
+lv_obj_t *build_question_screen() {
+    lv_obj_t *screen = lv_obj_create(nullptr);
+    lv_obj_t *header = lv_obj_create(screen);
+    lv_obj_set_size(header, LV_PCT(100), 40);
+    lv_obj_t *wifi = lv_label_create(header);
+    lv_label_set_text(wifi, LV_SYMBOL_WIFI);
+    lv_obj_align(wifi, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_obj_t *settings = lv_button_create(header);
+    lv_obj_set_size(settings, 32, 32);
+    lv_obj_align(settings, LV_ALIGN_RIGHT_MID, 0, 0);
+    lv_obj_t *title = lv_label_create(screen);
+    lv_label_set_text(title, "Como você se sentiu hoje?");
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 55);
+    const char *numbers[] = {"1", "2", "3", "4", "5"};
+    for (int i = 0; i < 5; ++i) {
+        lv_obj_t *button = lv_button_create(screen);
+        lv_obj_set_size(button, 66, 66);
+        lv_obj_set_pos(button, i < 3 ? 17 + i * 86 : 60 + (i - 3) * 86, i < 3 ? 96 : 168);
+        lv_obj_set_style_radius(button, LV_RADIUS_CIRCLE, 0);
+        lv_obj_t *label = lv_label_create(button);
+        lv_label_set_text(label, numbers[i]);
+        lv_obj_center(label);
+    }
+    return screen;
+}
+
+// Lista do scan WiFi: cabeçalho, lista de redes e botão Voltar
+lv_obj_t *build_scan_screen(int networks) {
+    lv_obj_t *screen = lv_obj_create(nullptr);
+    lv_obj_t *title = lv_label_create(screen);
+    lv_label_set_text_fmt(title, "Buscando redes... %d encontrada(s)", networks);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 4);
+    lv_obj_t *list = lv_list_create(screen);
+    lv_obj_set_size(list, HOR_RES, VER_RES - 80);
+    lv_obj_align(list, LV_ALIGN_TOP_MID, 0, 28);
+    char name[40];
+    for (int i = 0; i < networks; ++i) {
+        snprintf(name, sizeof(name), "Rede-%04x (-%d dBm)", static_cast<unsigned>(next_random() & 0xFFFF),
+                 static_cast<int>(random_between(35, 90)));
+        lv_list_add_button(list, LV_SYMBOL_WIFI, name);
+    }
+    lv_obj_t *back = lv_button_create(screen);
+    lv_obj_set_size(back, 120, 38);
+    lv_obj_align(back, LV_ALIGN_BOTTOM_MID, 0, -6);
+    lv_obj_t *label = lv_label_create(back);
+    lv_label_set_text(label, "Voltar");
+    lv_obj_center(label);
+    return screen;
+}
+
+void print_checkpoint(uint32_t swaps, const HeapInfo &info) {
+    printf("%8lu %10zu %10zu %10zu %7u%%\n", static_cast<unsigned long>(swaps), info.free_bytes, info.free_blocks,
+           info.largest_free, fragmentation_pct(info));
+}
+
+} // namespace
+
+extern "C" void *__wrap_malloc(size_t size) {
+    void *p = lv_tlsf_malloc(heap(), size);
+    if (p == nullptr && size > 0) {
+        arena_exhausted = true;
+    }
+    return p;
+}
+
+extern "C" void *__wrap_calloc(size_t count, size_t size) {
+    void *p = __wrap_malloc(count * size);
+    if (p != nullptr) {
+        memset(p, 0, count * size);
+    }
+    return p;
+}
+
+extern "C" void *__wrap_realloc(void *p, size_t size) {
+    if (p != nullptr && !in_arena(p)) {
+        return __real_realloc(p, size);
+    }
+    void *new_p = lv_tlsf_realloc(heap(), p, size);
+    if (new_p == nullptr && size > 0) {
+        arena_exhausted = true;
+    }
+    return new_p;
+}
+
+extern "C" void __wrap_free(void *p) {
+    if (p == nullptr) {
+        return;
+    }
+    if (in_arena(p)) {
+        lv_tlsf_free(heap(), p);
+    } else {
+        __real_free(p);
+    }
+}
+
+#ifndef SOAK_CLIB_BACKEND
+extern "C" void *__wrap_lv_malloc_core(size_t size) {
+    void *p = __real_lv_malloc_core(size);
+    track_lv_alloc(p, size);
+    return p;
+}
+
+extern "C" void *__wrap_lv_realloc_core(void *p, size_t new_size) {
+    void *new_p = __real_lv_realloc_core(p, new_size);
+    if (new_p != nullptr) {
+        track_lv_free(p);
+        track_lv_alloc(new_p, new_size);
+    }
+    return new_p;
+}
+
+extern "C" void __wrap_lv_free_core(void *p) {
+    track_lv_free(p);
+    __real_lv_free_core(p);
+}
+#endif
+
+#ifdef SOAK_CLIB_BACKEND
+// Back-end anterior ao lvgl_mem (CONFIG_LV_USE_CLIB_MALLOC): tudo vai para o heap
+
+void lv_mem_init(void) {}
+
+void lv_mem_deinit(void) {}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+    return nullptr;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {}
+
+void *lv_malloc_core(size_t size) {
+    return malloc(size);
+}
+
+void *lv_realloc_core(void *p, size_t new_size) {
+    return realloc(p, new_size);
+}
+
+void lv_free_core(void *p) {
+    free(p);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {}
+
+lv_result_t lv_mem_test_core(void) {
+    return LV_RESULT_OK;
+}
+#endif
+
+int main(int argc, char **argv) {
+    const long swaps_arg = argc > 1 ? atol(argv[1]) : 5000;
+    if (swaps_arg < CHECKPOINTS) {
+        fprintf(stderr, "Uso: %s [trocas >= %d]\n", argv[0], CHECKPOINTS);
+        return 2;
+    }
+    const uint32_t swaps = static_cast<uint32_t>(swaps_arg);
+
+    lv_init();
+    lv_display_t *display = lv_display_create(HOR_RES, VER_RES);
+    static uint8_t draw_buf[HOR_RES * VER_RES / 10 * 2];
+    lv_display_set_buffers(display, draw_buf, nullptr, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flush_cb);
+
+    lv_obj_t *question = build_question_screen();
+    lv_screen_load(question);
+    lv_refr_now(display);
+
+#ifdef SOAK_CLIB_BACKEND
+    printf("Back-end CLIB (tudo no heap), arena de %zu KB\n", ARENA_SIZE / 1024);
+#else
+    printf("Back-end lvgl_mem (slabs + heap), arena de %zu KB\n", ARENA_SIZE / 1024);
+#endif
+    printf("%8s %10s %10s %10s %8s\n", "trocas", "livre (B)", "fragmentos", "maior (B)", "frag");
+
+    // Pontos de controle em número par de trocas
+    const uint32_t checkpoint_every = (swaps / CHECKPOINTS + 1) & ~1u;
+    bool first_checkpoint = true;
+    unsigned first_frag = 0;
+    unsigned worst_frag = 0;
+    // Cada iteração são duas trocas: pergunta -> lista -> pergunta
+    for (uint32_t swap = 2; swap <= swaps && !arena_exhausted; swap += 2) {
+        lv_obj_t *scan = build_scan_screen(static_cast<int>(random_between(10, 30)));
+        lv_screen_load(scan);
+        lv_refr_now(display);
+        background_step();
+
+        lv_screen_load(question);
+        lv_obj_delete(scan);
+        lv_refr_now(display);
+        background_step();
+
+        if (swap % checkpoint_every == 0) {
+            const HeapInfo info = heap_info();
+            print_checkpoint(swap, info);
+            const unsigned frag = fragmentation_pct(info);
+            if (first_checkpoint) {
+                first_frag = frag;
+                first_checkpoint = false;
+            }
+            worst_frag = std::max(worst_frag, frag);
+        }
+    }
+
+    if (arena_exhausted) {
+        printf("ERRO: arena esgotado\n");
+        return 1;
+    }
+    printf("Fragmentação: %u%% no primeiro ponto de controle, pior %u%%\n", first_frag, worst_frag);
+
+#ifndef SOAK_CLIB_BACKEND
+    const LvglMemStats stats = lvgl_mem_stats();
+    printf("%8s %10s %10s %10s %10s %10s\n", "classe", "capacidade", "pico", "demanda", "alocações", "fallbacks");
+    for (size_t i = 0; i < LVGL_MEM_CLASS_COUNT; ++i) {
+        const LvglMemClassStats &cls = stats.classes[i];
+        printf("%7u B %10u %10u %10lu %10lu %10lu\n", cls.block_size, cls.capacity, cls.peak,
+               static_cast<unsigned long>(class_demand_peak[i]), static_cast<unsigned long>(cls.allocs),
+               static_cast<unsigned long>(cls.fallbacks));
+    }
+    printf("Heap: %lu alocações, %lu vivas\n", static_cast<unsigned long>(stats.heap_allocs),
+           static_cast<unsigned long>(stats.heap_live));
+    if (lv_mem_test() != LV_RESULT_OK) {
+        printf("ERRO: listas livres dos slabs inconsistentes\n");
+        return 1;
+    }
+    if (worst_frag > first_frag + FRAG_TOLERANCE_PCT) {
+        printf("ERRO: fragmentação cresceu de %u%% para %u%%\n", first_frag, worst_frag);
+        return 1;
+    }
+#endif
+    return 0;
+}
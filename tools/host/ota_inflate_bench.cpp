@@ -0,0 +1,216 @@
+/**
+ * @file ota_inflate_bench.cpp
+ * @brief Vazão e RAM do inflate da OTA comprimida (ota_driver/ota_inflate.cpp, user-045)
+ *
+ * Comprime a imagem como tools/ota_server.py --compress (deflate cru, nível 9,
+ * flush completo no início de cada bloco de 64 KB) para algumas janelas e a
+ * passa pelo InflateSink do firmware em leituras de 4 KB, como chega do HTTP.
+ * O tinfl da ROM é substituído pelo zlib do sistema (include/esp32/rom/miniz.h).
+ *
+ * Relata, por janela: tamanho no ar, vazão da descompressão (saída e entrada),
+ * pico de RAM medido no host (malloc do InflateSink, com o zlib no lugar do
+ * tinfl) e a RAM no ESP32 (estado do tinfl da ROM + janela). Confere a saída
+ * byte a byte e a retomada num ponto de flush do meio da imagem (restart());
+ * sai com 1 em qualquer divergência.
+ *
+ * Sem argumento usa o próprio executável como imagem (código de máquina x86;
+ * a razão de compressão de uma imagem Xtensa é outra).
+ *
+ * Uso: ota_inflate_bench [imagem.bin] [rodadas]
+ */
+#include "ota_inflate.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <zlib.h>
+
+extern "C" {
+void *__real_malloc(size_t size);
+void __real_free(void *p);
+
+void *__wrap_malloc(size_t size);
+void __wrap_free(void *p);
+}
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 64 * 1024;   // Bloco do manifesto (ota_server.py)
+constexpr size_t HTTP_READ_SIZE = 4096;    // Buffer de leitura do ota_driver
+constexpr uint8_t WINDOW_BITS[] = {10, 12, 15};
+
+// sizeof(tinfl_decompressor) da ROM do ESP32 (miniz.h do esp_rom, 32 bits):
+// 14 uint32 + bit_buf + size_t + 3 tabelas de Huffman de 3488 B + 461 B de
+// cabeçalho e comprimentos, alinhado a 4
+constexpr size_t ROM_TINFL_SIZE = 10992;
+
+// malloc do código do firmware (o zlib do shim aloca dentro do tinfl_decompressor)
+std::unordered_map<void *, size_t> &live_allocs() {
+    static std::unordered_map<void *, size_t> allocs;
+    return allocs;
+}
+size_t live_bytes = 0;
+size_t peak_bytes = 0;
+
+struct Compressed {
+    std::vector<uint8_t> data;
+    std::vector<uint32_t> offsets;  ///< Início de cada bloco no fluxo comprimido
+};
+
+Compressed compress_image(const std::vector<uint8_t> &image, uint8_t window_bits) {
+    Compressed out;
+    z_stream stream = {};
+    deflateInit2(&stream, 9, Z_DEFLATED, -static_cast<int>(window_bits), 9, Z_DEFAULT_STRATEGY);
+    std::vector<uint8_t> buffer(deflateBound(&stream, image.size()) + 64 * (image.size() / CHUNK_SIZE + 1));
+    stream.next_out = buffer.data();
+    stream.avail_out = static_cast<uInt>(buffer.size());
+    for (size_t offset = 0; offset < image.size(); offset += CHUNK_SIZE) {
+        out.offsets.push_back(static_cast<uint32_t>(stream.total_out));
+        const size_t len = std::min(CHUNK_SIZE, image.size() - offset);
+        stream.next_in = const_cast<Bytef *>(image.data() + offset);
+        stream.avail_in = static_cast<uInt>(len);
+        deflate(&stream, offset + len < image.size() ? Z_FULL_FLUSH : Z_FINISH);
+    }
+    buffer.resize(stream.total_out);
+    deflateEnd(&stream);
+    out.data = std::move(buffer);
+    return out;
+}
+
+/// Confere a saída contra a imagem a partir de start
+class CompareSink : public ota::DownloadSink {
+public:
+    CompareSink(const std::vector<uint8_t> &image, size_t start) : image_(image), position_(start) {}
+
+    esp_err_t consume(const uint8_t *data, size_t len) override {
+        if (position_ + len > image_.size() || memcmp(image_.data() + position_, data, len) != 0) {
+            mismatch_ = true;
+            return ESP_ERR_INVALID_CRC;
+        }
+        position_ += len;
+        return ESP_OK;
+    }
+
+    uint32_t position() const override { return static_cast<uint32_t>(position_); }
+
+    bool matches_to_end() const { return !mismatch_ && position_ == image_.size(); }
+
+private:
+    const std::vector<uint8_t> &image_;
+    size_t position_;
+    bool mismatch_ = false;
+};
+
+bool feed(ota::InflateSink &sink, const std::vector<uint8_t> &data, size_t from) {
+    for (size_t offset = from; offset < data.size(); offset += HTTP_READ_SIZE) {
+        const size_t len = std::min(HTTP_READ_SIZE, data.size() - offset);
+        if (sink.consume(data.data() + offset, len) != ESP_OK) {
+            return false;
+        }
+    }
+    return sink.done();
+}
+
+bool load_file(const char *path, std::vector<uint8_t> &data) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint8_t buffer[16384];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    fclose(file);
+    return !data.empty();
+}
+
+} // namespace
+
+extern "C" void *__wrap_malloc(size_t size) {
+    void *p = __real_malloc(size);
+    if (p != nullptr) {
+        live_allocs()[p] = size;
+        live_bytes += size;
+        peak_bytes = std::max(peak_bytes, live_bytes);
+    }
+    return p;
+}
+
+extern "C" void __wrap_free(void *p) {
+    auto it = live_allocs().find(p);
+    if (it != live_allocs().end()) {
+        live_bytes -= it->second;
+        live_allocs().erase(it);
+    }
+    __real_free(p);
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "/proc/self/exe";
+    const int rounds = argc > 2 ? atoi(argv[2]) : 20;
+    std::vector<uint8_t> image;
+    if (rounds <= 0 || !load_file(path, image)) {
+        fprintf(stderr, "Uso: %s [imagem.bin] [rodadas]\n", argv[0]);
+        return 2;
+    }
+
+    printf("Imagem %s: %zu bytes, %zu blocos de %zu KB; %d rodadas, leituras de %zu B\n", path, image.size(),
+           (image.size() + CHUNK_SIZE - 1) / CHUNK_SIZE, CHUNK_SIZE / 1024, rounds, HTTP_READ_SIZE);
+    printf("%-7s %12s %7s %12s %12s %14s %14s\n", "janela", "no ar (B)", "razão", "saída MB/s", "entrada MB/s",
+           "RAM host (B)", "RAM ESP32 (B)");
+
+    bool ok = true;
+    for (const uint8_t window_bits : WINDOW_BITS) {
+        const Compressed compressed = compress_image(image, window_bits);
+
+        // Correção e retomada num ponto de flush do meio (como depois de um reboot)
+        {
+            ota::InflateSink sink;
+            CompareSink full(image, 0);
+            if (sink.begin(full, window_bits, false, false) != ESP_OK || !feed(sink, compressed.data, 0) ||
+                !full.matches_to_end()) {
+                printf("ERRO: janela %u: saída diverge da imagem\n", 1u << window_bits);
+                ok = false;
+                continue;
+            }
+            const size_t chunk = compressed.offsets.size() / 2;
+            CompareSink resumed(image, chunk * CHUNK_SIZE);
+            sink.begin(resumed, window_bits, false, false);
+            sink.restart(compressed.offsets[chunk]);
+            if (!feed(sink, compressed.data, compressed.offsets[chunk]) || !resumed.matches_to_end()) {
+                printf("ERRO: janela %u: retomada no bloco %zu diverge\n", 1u << window_bits, chunk);
+                ok = false;
+                continue;
+            }
+        }
+
+        peak_bytes = live_bytes;
+        const size_t base_bytes = live_bytes;
+        std::vector<double> seconds;
+        for (int round = 0; round < rounds; ++round) {
+            ota::InflateSink sink;
+            CompareSink output(image, 0);
+            const auto start = std::chrono::steady_clock::now();
+            sink.begin(output, window_bits, false, false);
+            feed(sink, compressed.data, 0);
+            sink.end();
+            seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(seconds.begin(), seconds.end());
+        const double median_s = seconds[seconds.size() / 2];
+
+        printf("%4u KB %12zu %6.1f%% %12.1f %12.1f %14zu %14zu\n", (1u << window_bits) / 1024,
+               compressed.data.size(), 100.0 * compressed.data.size() / image.size(),
+               image.size() / median_s / 1e6, compressed.data.size() / median_s / 1e6, peak_bytes - base_bytes,
+               ROM_TINFL_SIZE + (static_cast<size_t>(1) << window_bits));
+    }
+
+    printf("RAM host: tinfl_decompressor do shim (estado e janela de 32 KB do zlib) + janela do InflateSink\n");
+    printf("RAM ESP32: tinfl da ROM (%zu B) + janela; a saída inclui a comparação com a imagem\n", ROM_TINFL_SIZE);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file style_cache_bench.cpp
+ * @brief Cache de propriedades de estilo do LVGL ligado e desligado (user-039)
+ *
+ * Compilado duas vezes: style_cache_bench_on liga o lvgl_host (com
+ * LV_OBJ_STYLE_CACHE, como o sdkconfig do firmware) e style_cache_bench_off,
+ * um LVGL igual compilado sem a opção. Mede duas cenas no mesmo display de
+ * host de 320x240 com buffer parcial de 1/10 da tela:
+ *   "pergunta" - a tela de pergunta com os estilos de ui::theme (como o
+ *                build_question_screen do firmware);
+ *   "widgets"  - o lv_demo_widgets do LVGL, no layout de tela pequena.
+ *
+ * Para cada cena relata as consultas de lv_obj_get_style_prop por quadro
+ * completo (contadas com -Wl,--wrap), quantas delas o cache respondeu sem
+ * percorrer a lista de estilos do objeto (máscara de propriedades sem o bit;
+ * só na variante com cache), o tempo de desenho do quadro (p50) e o custo
+ * médio de uma consulta, medido chamando lv_obj_get_style_prop para todas as
+ * propriedades internas em todos os objetos da cena (melhor de 5 rodadas). Relata também a
+ * assinatura (FNV-1a) dos pixels do quadro: deve ser a mesma nas duas
+ * variantes.
+ *
+ * Uso: style_cache_bench_<on|off> [quadros]
+ */
+#include "lvgl.h"
+#include "lvgl_private.h"
+#include "demos/lv_demos.h"
+#include "ui_common.hpp"
+#include "ui_fonts.hpp"
+#include "ui_theme.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+lv_style_value_t __real_lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop);
+
+lv_style_value_t __wrap_lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop);
+}
+
+namespace {
+
+constexpr int32_t HOR_RES = 320;
+constexpr int32_t VER_RES = 240;
+constexpr int RATING_COUNT = 5;
+constexpr int LOOKUP_ROUNDS = 200;
+constexpr int LOOKUP_REPEATS = 5;  // Melhor de 5: o custo por consulta sem o ruído do host
+
+const char *const RATING_NUMBERS[RATING_COUNT] = {"1", "2", "3", "4", "5"};
+
+uint32_t style_lookups = 0;
+uint32_t cache_skips = 0;
+uint64_t frame_hash = 0;
+
+void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    // FNV-1a sobre área e pixels: a ordem das faixas é determinística
+    const size_t bytes = lv_area_get_size(area) * 2;
+    frame_hash ^= static_cast<uint64_t>(area->x1) << 16 | static_cast<uint64_t>(area->y1);
+    frame_hash *= 0x100000001B3ull;
+    for (size_t i = 0; i < bytes; ++i) {
+        frame_hash ^= px_map[i];
+        frame_hash *= 0x100000001B3ull;
+    }
+    lv_display_flush_ready(disp);
+}
+
+void noop_cb(lv_event_t *e) {}
+
+// Mesma tela da variante "depois" do theme_bench (build_question_screen do ui_driver.cpp)
+lv_obj_t *build_question() {
+    lv_obj_t *screen = lv_obj_create(nullptr);
+    lv_obj_remove_style_all(screen);
+    ui::common::apply_screen_style(screen);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_CLICKABLE);
+
+    lv_obj_t *header = lv_obj_create(screen);
+    lv_obj_set_size(header, LV_PCT(100), ui::common::HEADER_HEIGHT);
+    lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_add_style(header, ui::theme::header(), 0);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_t *wifi_icon = lv_button_create(header);
+    lv_obj_remove_style_all(wifi_icon);
+    lv_obj_set_size(wifi_icon, 32, 32);
+    lv_obj_align(wifi_icon, LV_ALIGN_LEFT_MID, 8, 0);
+    lv_obj_set_style_bg_opa(wifi_icon, LV_OPA_TRANSP, 0);
+    lv_obj_clear_flag(wifi_icon, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_t *wifi_label = lv_label_create(wifi_icon);
+    lv_label_set_text(wifi_label, LV_SYMBOL_WIFI);
+    lv_obj_center(wifi_label);
+    lv_obj_add_style(wifi_label, ui::theme::icon_label(), 0);
+    lv_obj_set_style_text_color(wifi_label, ui::common::COLOR_ERROR(), 0);
+
+    lv_obj_t *settings = lv_button_create(header);
+    lv_obj_set_size(settings, 32, 32);
+    lv_obj_align(settings, LV_ALIGN_RIGHT_MID, -8, 0);
+    lv_obj_set_style_bg_opa(settings, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_shadow_width(settings, 0, 0);
+    lv_obj_t *settings_label = lv_label_create(settings);
+    lv_label_set_text(settings_label, LV_SYMBOL_SETTINGS);
+    lv_obj_center(settings_label);
+    lv_obj_add_style(settings_label, ui::theme::icon_label(), 0);
+    lv_obj_set_style_text_color(settings_label, ui::common::COLOR_SETTINGS_BUTTON(), 0);
+    lv_obj_add_event_cb(settings, noop_cb, LV_EVENT_CLICKED, nullptr);
+
+    lv_obj_t *title = ui::common::create_screen_title(screen, "Como você se sentiu hoje?");
+    lv_label_set_long_mode(title, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(title, 300);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, ui::common::HEADER_HEIGHT + 15);
+
+    constexpr int BTN_SIZE = ui::common::RATING_BUTTON_SIZE;
+    constexpr int BTN_SPACING = 20;
+    constexpr int ROW1_Y = 96;
+    for (int i = 0; i < RATING_COUNT; ++i) {
+        const int row_count = i < 3 ? 3 : 2;
+        const int col = i < 3 ? i : i - 3;
+        lv_obj_t *button = lv_button_create(screen);
+        lv_obj_remove_style_all(button);
+        lv_obj_add_style(button, ui::theme::rating_button(i), 0);
+        lv_obj_set_pos(button, (HOR_RES - (row_count * BTN_SIZE + (row_count - 1) * BTN_SPACING)) / 2 +
+                                   col * (BTN_SIZE + BTN_SPACING),
+                       i < 3 ? ROW1_Y : ROW1_Y + BTN_SIZE + 6);
+        lv_obj_add_flag(button, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_t *label = lv_label_create(button);
+        lv_label_set_text(label, RATING_NUMBERS[i]);
+        lv_obj_add_style(label, ui::theme::rating_label(), 0);
+        lv_obj_center(label);
+        lv_obj_add_event_cb(button, noop_cb, LV_EVENT_CLICKED, nullptr);
+    }
+    return screen;
+}
+
+lv_obj_t *build_widgets() {
+    // O demo monta a tela ativa: usa uma nova para poder apagá-la depois
+    lv_obj_t *screen = lv_obj_create(nullptr);
+    lv_screen_load(screen);
+    lv_demo_widgets();
+    return screen;
+}
+
+void collect_objects(lv_obj_t *obj, std::vector<lv_obj_t *> &objects) {
+    objects.push_back(obj);
+    const uint32_t count = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < count; ++i) {
+        collect_objects(lv_obj_get_child(obj, static_cast<int32_t>(i)), objects);
+    }
+}
+
+struct Result {
+    size_t objects;
+    uint32_t lookups_per_frame;
+    uint32_t skips_per_frame;
+    uint32_t frame_p50_us;
+    double ns_per_lookup;
+    uint64_t hash;
+};
+
+Result measure(lv_display_t *display, lv_obj_t *(*build)(), int frames) {
+    Result result = {};
+    lv_obj_t *screen = build();
+    lv_screen_load(screen);
+    lv_obj_update_layout(screen);
+    lv_refr_now(display);
+
+    std::vector<uint32_t> render_us;
+    for (int i = 0; i < frames; ++i) {
+        lv_obj_invalidate(screen);
+        style_lookups = 0;
+        cache_skips = 0;
+        frame_hash = 0xCBF29CE484222325ull;
+        const auto start = std::chrono::steady_clock::now();
+        lv_refr_now(display);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        render_us.push_back(static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+    result.lookups_per_frame = style_lookups;
+    result.skips_per_frame = cache_skips;
+    result.hash = frame_hash;
+    std::sort(render_us.begin(), render_us.end());
+    result.frame_p50_us = render_us[render_us.size() / 2];
+
+    // Custo por consulta sem o contador do --wrap: todas as propriedades internas na parte MAIN
+    std::vector<lv_obj_t *> objects;
+    collect_objects(screen, objects);
+    result.objects = objects.size();
+    uint32_t sink = 0;
+    double best_ns = 0;
+    for (int repeat = 0; repeat < LOOKUP_REPEATS; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < LOOKUP_ROUNDS; ++round) {
+            for (lv_obj_t *obj : objects) {
+                for (uint32_t prop = 1; prop < LV_STYLE_NUM_BUILT_IN_PROPS; ++prop) {
+                    sink += __real_lv_obj_get_style_prop(obj, LV_PART_MAIN, static_cast<lv_style_prop_t>(prop)).num;
+                }
+            }
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best_ns = repeat == 0 ? ns : std::min(best_ns, ns);
+    }
+    const double lookups = static_cast<double>(LOOKUP_ROUNDS) * objects.size() * (LV_STYLE_NUM_BUILT_IN_PROPS - 1);
+    result.ns_per_lookup = best_ns / lookups;
+    if (sink == 0x5A5A5A5Au) {
+        printf(" ");  // Impede que o laço seja descartado
+    }
+
+    lv_screen_load(lv_obj_create(nullptr));
+    lv_obj_delete(screen);
+    return result;
+}
+
+} // namespace
+
+extern "C" lv_style_value_t __wrap_lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop) {
+    style_lookups++;
+#if LV_OBJ_STYLE_CACHE
+    // Mesmo teste de get_selector_style_prop: sem o bit, a lista de estilos do objeto não é percorrida
+    const uint32_t mask = part == LV_PART_MAIN ? obj->style_main_prop_is_set : obj->style_other_prop_is_set;
+    if ((mask & (1u << (prop >> 3))) == 0) {
+        cache_skips++;
+    }
+#endif
+    return __real_lv_obj_get_style_prop(obj, part, prop);
+}
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : 200;
+    if (frames <= 0) {
+        fprintf(stderr, "Uso: %s [quadros]\n", argv[0]);
+        return 2;
+    }
+
+    lv_init();
+    lv_display_t *display = lv_display_create(HOR_RES, VER_RES);
+    static uint8_t draw_buf[HOR_RES * VER_RES / 10 * 2];
+    lv_display_set_buffers(display, draw_buf, nullptr, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flush_cb);
+    ui::fonts::init();
+    ui::theme::init();
+
+    const Result question = measure(display, build_question, frames);
+    const Result widgets = measure(display, build_widgets, frames);
+
+    printf("LV_OBJ_STYLE_CACHE=%d, %d quadros completos de %ldx%ld\n", LV_OBJ_STYLE_CACHE, frames,
+           static_cast<long>(HOR_RES), static_cast<long>(VER_RES));
+    printf("%-9s %8s %16s %16s %14s %12s %18s\n", "cena", "objetos", "consultas/quadro", "pelo cache",
+           "quadro p50 us", "ns/consulta", "assinatura");
+    for (const auto &[name, result] : {std::make_pair("pergunta", question), std::make_pair("widgets", widgets)}) {
+        char skips[32] = "-";
+        if (LV_OBJ_STYLE_CACHE) {
+            snprintf(skips, sizeof(skips), "%lu (%lu%%)", static_cast<unsigned long>(result.skips_per_frame),
+                     static_cast<unsigned long>(100ull * result.skips_per_frame /
+                                                std::max<uint32_t>(1, result.lookups_per_frame)));
+        }
+        printf("%-9s %8zu %16lu %16s %14lu %12.1f   %016llx\n", name, result.objects,
+               static_cast<unsigned long>(result.lookups_per_frame), skips,
+               static_cast<unsigned long>(result.frame_p50_us), result.ns_per_lookup,
+               static_cast<unsigned long long>(result.hash));
+    }
+    return 0;
+}
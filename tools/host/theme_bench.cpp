@@ -0,0 +1,377 @@
+/**
+ * @file theme_bench.cpp
+ * @brief Custo do tema ui::theme contra estilos locais por objeto (user-038)
+ *
+ * Constrói a tela de pergunta de duas formas no LVGL de host (320x240, buffer
+ * parcial de 1/10 da tela, lvgl_mem do firmware):
+ *   "antes"  - como era build_question_screen antes do tema: cada objeto
+ *              recebe as propriedades com lv_obj_set_style_* (estilos locais);
+ *   "depois" - o caminho atual: lv_obj_add_style com os lv_style_t estáticos
+ *              de ui::theme (ui_theme.cpp, ui_common.cpp).
+ *
+ * Para cada uma relata o heap por tela: bytes pedidos pelo LVGL e blocos
+ * vivos após a construção (sem o arredondamento dos slabs, que no host de 64
+ * bits não representa o ESP32) e o que os mesmos blocos ocupariam no malloc
+ * da glibc (chunks de 16 B com 8 B de cabeçalho, mínimo 32 B), que mostra o
+ * peso das alocações pequenas de cada estilo local. Relata também as consultas de
+ * lv_obj_get_style_prop por quadro completo e o tempo de desenho do quadro.
+ * Alocações e consultas são contadas com -Wl,--wrap: chamadas de
+ * lv_obj_style.c para si mesmo (transições) não entram, e nenhuma ocorre com
+ * a tela parada.
+ * Confere também que os dois quadros têm os mesmos pixels; sai com 1 se não.
+ *
+ * Uso: theme_bench [quadros]
+ */
+#include "lvgl.h"
+#include "ui_common.hpp"
+#include "ui_fonts.hpp"
+#include "ui_theme.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+lv_style_value_t __real_lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop);
+
+lv_style_value_t __wrap_lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop);
+
+void *__real_lv_malloc_core(size_t size);
+void *__real_lv_realloc_core(void *p, size_t new_size);
+void __real_lv_free_core(void *p);
+
+void *__wrap_lv_malloc_core(size_t size);
+void *__wrap_lv_realloc_core(void *p, size_t new_size);
+void __wrap_lv_free_core(void *p);
+}
+
+namespace {
+
+constexpr int32_t HOR_RES = 320;
+constexpr int32_t VER_RES = 240;
+constexpr int RATING_COUNT = 5;
+
+// Cores e textos de avaliação como no ui_driver.cpp anterior ao tema
+const uint32_t RATING_COLORS[RATING_COUNT] = {0xFF0000, 0xFF6600, 0xFFCC00, 0x99FF00, 0x00FF00};
+const char *const RATING_NUMBERS[RATING_COUNT] = {"1", "2", "3", "4", "5"};
+
+uint32_t style_lookups = 0;
+uint64_t frame_hash = 0;
+
+// Tamanho pedido de cada bloco vivo do LVGL
+std::unordered_map<void *, size_t> &live_blocks() {
+    static std::unordered_map<void *, size_t> blocks;
+    return blocks;
+}
+size_t live_bytes = 0;
+size_t live_chunk_bytes = 0;
+
+size_t glibc_chunk(size_t size) {
+    return std::max<size_t>(32, (size + 8 + 15) & ~static_cast<size_t>(15));
+}
+
+void track_alloc(void *p, size_t size) {
+    if (p != nullptr) {
+        live_blocks()[p] = size;
+        live_bytes += size;
+        live_chunk_bytes += glibc_chunk(size);
+    }
+}
+
+void track_free(void *p) {
+    auto it = live_blocks().find(p);
+    if (it != live_blocks().end()) {
+        live_bytes -= it->second;
+        live_chunk_bytes -= glibc_chunk(it->second);
+        live_blocks().erase(it);
+    }
+}
+
+void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    // FNV-1a sobre área e pixels: a ordem das faixas é determinística
+    const size_t bytes = lv_area_get_size(area) * 2;
+    frame_hash ^= static_cast<uint64_t>(area->x1) << 16 | static_cast<uint64_t>(area->y1);
+    frame_hash *= 0x100000001B3ull;
+    for (size_t i = 0; i < bytes; ++i) {
+        frame_hash ^= px_map[i];
+        frame_hash *= 0x100000001B3ull;
+    }
+    lv_display_flush_ready(disp);
+}
+
+void noop_cb(lv_event_t *e) {}
+
+// Cabeçalho com ícones de WiFi e configurações, comum às duas versões exceto pelos estilos
+void build_header_before(lv_obj_t *screen) {
+    lv_obj_t *header = lv_obj_create(screen);
+    lv_obj_set_size(header, LV_PCT(100), ui::common::HEADER_HEIGHT);
+    lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_set_style_bg_color(header, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_bg_opa(header, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_width(header, 0, 0);
+    lv_obj_set_style_border_side(header, LV_BORDER_SIDE_BOTTOM, 0);
+    lv_obj_set_style_border_width(header, 1, 0);
+    lv_obj_set_style_border_color(header, ui::common::COLOR_BORDER(), 0);
+    lv_obj_set_style_radius(header, 0, 0);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *wifi_icon = lv_button_create(header);
+    lv_obj_remove_style_all(wifi_icon);
+    lv_obj_set_size(wifi_icon, 32, 32);
+    lv_obj_align(wifi_icon, LV_ALIGN_LEFT_MID, 8, 0);
+    lv_obj_set_style_bg_opa(wifi_icon, LV_OPA_TRANSP, 0);
+    lv_obj_clear_flag(wifi_icon, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_t *wifi_label = lv_label_create(wifi_icon);
+    lv_label_set_text(wifi_label, LV_SYMBOL_WIFI);
+    lv_obj_center(wifi_label);
+    lv_obj_set_style_text_font(wifi_label, &lv_font_montserrat_20, 0);
+    lv_obj_set_style_text_color(wifi_label, ui::common::COLOR_ERROR(), 0);
+
+    lv_obj_t *settings = lv_button_create(header);
+    lv_obj_set_size(settings, 32, 32);
+    lv_obj_align(settings, LV_ALIGN_RIGHT_MID, -8, 0);
+    lv_obj_set_style_bg_opa(settings, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_shadow_width(settings, 0, 0);
+    lv_obj_t *settings_label = lv_label_create(settings);
+    lv_label_set_text(settings_label, LV_SYMBOL_SETTINGS);
+    lv_obj_center(settings_label);
+    lv_obj_set_style_text_font(settings_label, &lv_font_montserrat_20, 0);
+    lv_obj_set_style_text_color(settings_label, ui::common::COLOR_SETTINGS_BUTTON(), 0);
+    lv_obj_add_event_cb(settings, noop_cb, LV_EVENT_CLICKED, nullptr);
+}
+
+void build_header_after(lv_obj_t *screen) {
+    lv_obj_t *header = lv_obj_create(screen);
+    lv_obj_set_size(header, LV_PCT(100), ui::common::HEADER_HEIGHT);
+    lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_add_style(header, ui::theme::header(), 0);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *wifi_icon = lv_button_create(header);
+    lv_obj_remove_style_all(wifi_icon);
+    lv_obj_set_size(wifi_icon, 32, 32);
+    lv_obj_align(wifi_icon, LV_ALIGN_LEFT_MID, 8, 0);
+    lv_obj_set_style_bg_opa(wifi_icon, LV_OPA_TRANSP, 0);
+    lv_obj_clear_flag(wifi_icon, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_t *wifi_label = lv_label_create(wifi_icon);
+    lv_label_set_text(wifi_label, LV_SYMBOL_WIFI);
+    lv_obj_center(wifi_label);
+    lv_obj_add_style(wifi_label, ui::theme::icon_label(), 0);
+    lv_obj_set_style_text_color(wifi_label, ui::common::COLOR_ERROR(), 0);
+
+    lv_obj_t *settings = lv_button_create(header);
+    lv_obj_set_size(settings, 32, 32);
+    lv_obj_align(settings, LV_ALIGN_RIGHT_MID, -8, 0);
+    lv_obj_set_style_bg_opa(settings, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_shadow_width(settings, 0, 0);
+    lv_obj_t *settings_label = lv_label_create(settings);
+    lv_label_set_text(settings_label, LV_SYMBOL_SETTINGS);
+    lv_obj_center(settings_label);
+    lv_obj_add_style(settings_label, ui::theme::icon_label(), 0);
+    lv_obj_set_style_text_color(settings_label, ui::common::COLOR_SETTINGS_BUTTON(), 0);
+    lv_obj_add_event_cb(settings, noop_cb, LV_EVENT_CLICKED, nullptr);
+}
+
+void rating_position(int i, int32_t &x, int32_t &y) {
+    constexpr int BTN_SIZE = ui::common::RATING_BUTTON_SIZE;
+    constexpr int BTN_SPACING = 20;
+    constexpr int ROW1_Y = 96;
+    constexpr int ROW2_Y = ROW1_Y + BTN_SIZE + 6;
+    if (i < 3) {
+        x = (HOR_RES - (3 * BTN_SIZE + 2 * BTN_SPACING)) / 2 + i * (BTN_SIZE + BTN_SPACING);
+        y = ROW1_Y;
+    } else {
+        x = (HOR_RES - (2 * BTN_SIZE + BTN_SPACING)) / 2 + (i - 3) * (BTN_SIZE + BTN_SPACING);
+        y = ROW2_Y;
+    }
+}
+
+lv_obj_t *build_before() {
+    lv_obj_t *screen = lv_obj_create(nullptr);
+    lv_obj_remove_style_all(screen);
+    lv_obj_set_style_bg_color(screen, ui::common::COLOR_BG_WHITE(), 0);
+    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_CLICKABLE);
+    build_header_before(screen);
+
+    lv_obj_t *title = lv_label_create(screen);
+    lv_label_set_text(title, "Como você se sentiu hoje?");
+    lv_obj_set_style_text_align(title, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_color(title, ui::common::COLOR_TEXT_BLACK(), 0);
+    lv_obj_set_style_text_font(title, ui::common::TITLE_FONT, 0);
+    lv_obj_set_style_pad_top(title, 4, 0);
+    lv_obj_set_style_pad_bottom(title, 4, 0);
+    lv_label_set_long_mode(title, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(title, 300);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, ui::common::HEADER_HEIGHT + 15);
+
+    constexpr int BTN_SIZE = ui::common::RATING_BUTTON_SIZE;
+    for (int i = 0; i < RATING_COUNT; ++i) {
+        int32_t x, y;
+        rating_position(i, x, y);
+        lv_obj_t *button = lv_button_create(screen);
+        lv_obj_remove_style_all(button);
+        lv_obj_set_size(button, BTN_SIZE, BTN_SIZE);
+        lv_obj_set_pos(button, x, y);
+        lv_obj_set_style_bg_color(button, lv_color_hex(RATING_COLORS[i]), 0);
+        lv_obj_set_style_bg_opa(button, LV_OPA_COVER, 0);
+        lv_obj_set_style_radius(button, BTN_SIZE / 2, 0);
+        lv_obj_set_style_border_width(button, 2, 0);
+        lv_obj_set_style_border_color(button, lv_color_hex(0xFFFFFF), 0);
+        lv_obj_set_style_border_opa(button, LV_OPA_COVER, 0);
+        lv_obj_add_flag(button, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_t *label = lv_label_create(button);
+        lv_label_set_text(label, RATING_NUMBERS[i]);
+        lv_obj_center(label);
+        lv_obj_set_style_text_font(label, ui::common::TITLE_FONT, 0);
+        lv_obj_set_style_text_color(label, lv_color_white(), 0);
+        lv_obj_set_style_pad_all(button, 4, 0);
+        lv_obj_add_event_cb(button, noop_cb, LV_EVENT_CLICKED, nullptr);
+    }
+    lv_obj_update_layout(screen);
+    return screen;
+}
+
+lv_obj_t *build_after() {
+    lv_obj_t *screen = lv_obj_create(nullptr);
+    lv_obj_remove_style_all(screen);
+    ui::common::apply_screen_style(screen);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_CLICKABLE);
+    build_header_after(screen);
+
+    lv_obj_t *title = ui::common::create_screen_title(screen, "Como você se sentiu hoje?");
+    lv_label_set_long_mode(title, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(title, 300);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, ui::common::HEADER_HEIGHT + 15);
+
+    for (int i = 0; i < RATING_COUNT; ++i) {
+        int32_t x, y;
+        rating_position(i, x, y);
+        lv_obj_t *button = lv_button_create(screen);
+        lv_obj_remove_style_all(button);
+        lv_obj_add_style(button, ui::theme::rating_button(i), 0);
+        lv_obj_set_pos(button, x, y);
+        lv_obj_add_flag(button, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_t *label = lv_label_create(button);
+        lv_label_set_text(label, RATING_NUMBERS[i]);
+        lv_obj_add_style(label, ui::theme::rating_label(), 0);
+        lv_obj_center(label);
+        lv_obj_add_event_cb(button, noop_cb, LV_EVENT_CLICKED, nullptr);
+    }
+    lv_obj_update_layout(screen);
+    return screen;
+}
+
+struct Result {
+    size_t heap_bytes;
+    size_t blocks;
+    size_t chunk_bytes;
+    uint32_t lookups_per_frame;
+    uint32_t frame_p50_us;
+    uint64_t hash;
+};
+
+Result measure(lv_display_t *display, lv_obj_t *(*build)(), int frames) {
+    Result result = {};
+
+    // Uma construção de aquecimento: caches de fonte e do LVGL ficam fora da medição
+    lv_obj_delete(build());
+    const size_t bytes_before = live_bytes;
+    const size_t blocks_before = live_blocks().size();
+    const size_t chunks_before = live_chunk_bytes;
+    lv_obj_t *screen = build();
+    result.heap_bytes = live_bytes - bytes_before;
+    result.blocks = live_blocks().size() - blocks_before;
+    result.chunk_bytes = live_chunk_bytes - chunks_before;
+
+    lv_screen_load(screen);
+    lv_refr_now(display);
+
+    std::vector<uint32_t> render_us;
+    for (int i = 0; i < frames; ++i) {
+        lv_obj_invalidate(screen);
+        style_lookups = 0;
+        frame_hash = 0xCBF29CE484222325ull;
+        const auto start = std::chrono::steady_clock::now();
+        lv_refr_now(display);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        render_us.push_back(static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+    result.lookups_per_frame = style_lookups;
+    result.hash = frame_hash;
+    std::sort(render_us.begin(), render_us.end());
+    result.frame_p50_us = render_us[render_us.size() / 2];
+
+    // Tela vazia ativa para a próxima variante partir do mesmo estado
+    lv_screen_load(lv_obj_create(nullptr));
+    lv_obj_delete(screen);
+    return result;
+}
+
+} // namespace
+
+extern "C" lv_style_value_t __wrap_lv_obj_get_style_prop(const lv_obj_t *obj, lv_part_t part, lv_style_prop_t prop) {
+    style_lookups++;
+    return __real_lv_obj_get_style_prop(obj, part, prop);
+}
+
+extern "C" void *__wrap_lv_malloc_core(size_t size) {
+    void *p = __real_lv_malloc_core(size);
+    track_alloc(p, size);
+    return p;
+}
+
+extern "C" void *__wrap_lv_realloc_core(void *p, size_t new_size) {
+    void *new_p = __real_lv_realloc_core(p, new_size);
+    if (new_p != nullptr) {
+        track_free(p);
+        track_alloc(new_p, new_size);
+    }
+    return new_p;
+}
+
+extern "C" void __wrap_lv_free_core(void *p) {
+    track_free(p);
+    __real_lv_free_core(p);
+}
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : 200;
+    if (frames <= 0) {
+        fprintf(stderr, "Uso: %s [quadros]\n", argv[0]);
+        return 2;
+    }
+
+    lv_init();
+    lv_display_t *display = lv_display_create(HOR_RES, VER_RES);
+    static uint8_t draw_buf[HOR_RES * VER_RES / 10 * 2];
+    lv_display_set_buffers(display, draw_buf, nullptr, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flush_cb);
+    ui::fonts::init();
+    ui::theme::init();
+
+    const Result before = measure(display, build_before, frames);
+    const Result after = measure(display, build_after, frames);
+
+    printf("Tela de pergunta, %d quadros completos de %ldx%ld\n", frames, static_cast<long>(HOR_RES),
+           static_cast<long>(VER_RES));
+    printf("%-8s %10s %8s %12s %16s %14s\n", "", "pedido (B)", "blocos", "glibc (B)", "consultas/quadro",
+           "quadro p50 us");
+    for (const auto &[name, result] : {std::make_pair("antes", before), std::make_pair("depois", after)}) {
+        printf("%-8s %10zu %8zu %12zu %16lu %14lu\n", name, result.heap_bytes, result.blocks, result.chunk_bytes,
+               static_cast<unsigned long>(result.lookups_per_frame), static_cast<unsigned long>(result.frame_p50_us));
+    }
+
+    if (before.hash != after.hash) {
+        printf("ERRO: os quadros diferem (%016llx != %016llx)\n", static_cast<unsigned long long>(before.hash),
+               static_cast<unsigned long long>(after.hash));
+        return 1;
+    }
+    printf("Quadros idênticos\n");
+    return 0;
+}
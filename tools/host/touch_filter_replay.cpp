@@ -0,0 +1,354 @@
+/**
+ * @file touch_filter_replay.cpp
+ * @brief Harness de replay do pipeline de filtragem do touch (TouchFilter, user-030)
+ *
+ * Passa amostras pelo mesmo caminho de Xpt2046Bitbang::getTouch(): histerese
+ * de pressão, mediana do burst, suavização (IIR/one-euro) e dead-band, em
+ * três configurações (sem filtro, padrão e IIR), e mede:
+ *   - jitter: RMS do deslocamento da saída entre amostras com o dedo parado;
+ *   - atraso: quanto a saída fica atrás do dedo num arrasto de velocidade
+ *     constante, em ms (amostras a cada 10 ms, como o task do touch);
+ *   - eventos espúrios: press/release a mais que os toques do cenário.
+ *
+ * Cenários embutidos: posição e pressão verdadeiras conhecidas, com ruído de
+ * painel resistivo sintético (gaussiano + picos isolados) em cada leitura do
+ * burst; semente fixa, então a saída é reprodutível. Logs do gravador
+ * ("TT,t_ms,x,y,raw_x,raw_y,pressure", ver DisplayDriver::start_touch_recording)
+ * passados na linha de comando também são reproduzidos: ali raw_x/raw_y já
+ * são a mediana do burst e só amostras pressionadas foram gravadas, então o
+ * replay cobre suavização e dead-band, sem verdade de referência.
+ *
+ * Uso: touch_filter_replay [monitor.log ...]
+ * Sai com código 1 se a configuração padrão gerar eventos espúrios nos cenários.
+ */
+#include "TouchFilter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t SAMPLE_PERIOD_MS = 10;  // TOUCH_SAMPLE_PERIOD_MS do display_driver
+constexpr double RAW_PER_PX = 11.0;        // Calibração padrão: ~3500 RAW em 320 px
+
+// Uma amostra do task do touch: burst de leituras X/Y e a pressão (z1 + 4095 - z2)
+struct Sample {
+    uint16_t x[TouchFilter::MAX_BURST];
+    uint16_t y[TouchFilter::MAX_BURST];
+    uint8_t burst;
+    uint16_t pressure;
+    // Verdade do cenário (só nos embutidos)
+    double true_x;
+    double true_y;
+    bool stationary;  ///< Dedo parado e pressionado
+    bool dragging;    ///< Arrasto em velocidade constante, já em regime
+    double speed;     ///< RAW por amostra durante o arrasto (eixo X)
+};
+
+struct Scenario {
+    std::string name;
+    std::vector<Sample> samples;
+    int touches;  ///< Toques reais (0 = desconhecido, log gravado)
+};
+
+// Gerador determinístico (LCG) com gaussiana por Box-Muller
+class Noise {
+public:
+    explicit Noise(uint32_t seed) : state_(seed) {}
+
+    double uniform() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return ((state_ >> 8) + 0.5) / 16777216.0;
+    }
+
+    double gaussian(double sigma) {
+        const double u1 = uniform();
+        const double u2 = uniform();
+        return sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+private:
+    uint32_t state_;
+};
+
+// Ruído do painel: gaussiano de 8 RAW e 4% de picos de 150-400 RAW por leitura
+constexpr double READ_SIGMA = 8.0;
+constexpr double SPIKE_PROBABILITY = 0.04;
+constexpr double PRESSURE_SIGMA = 10.0;
+
+uint16_t clamp_raw(double value) {
+    if (value < 0) return 0;
+    if (value > 4095) return 4095;
+    return static_cast<uint16_t>(std::lround(value));
+}
+
+uint16_t noisy_read(Noise &noise, double truth) {
+    double value = truth + noise.gaussian(READ_SIGMA);
+    if (noise.uniform() < SPIKE_PROBABILITY) {
+        const double spike = 150 + 250 * noise.uniform();
+        value += noise.uniform() < 0.5 ? -spike : spike;
+    }
+    return clamp_raw(value);
+}
+
+Sample make_sample(Noise &noise, double x, double y, double pressure) {
+    Sample s = {};
+    s.burst = TouchFilter::MAX_BURST;
+    for (uint8_t i = 0; i < s.burst; ++i) {
+        s.x[i] = noisy_read(noise, x);
+        s.y[i] = noisy_read(noise, y);
+    }
+    const double p = pressure > 0 ? pressure + noise.gaussian(PRESSURE_SIGMA) : 0;
+    s.pressure = clamp_raw(p);
+    s.true_x = x;
+    s.true_y = y;
+    return s;
+}
+
+void add_idle(Noise &noise, Scenario &scenario, int count) {
+    for (int i = 0; i < count; ++i) {
+        scenario.samples.push_back(make_sample(noise, 0, 0, 0));
+    }
+}
+
+// Toques parados: 5 toques de 400 ms em pontos da tela de pergunta
+Scenario taps_scenario() {
+    Noise noise(1);
+    Scenario scenario{"toques parados (5 x 400 ms)", {}, 5};
+    const double points[][2] = {{700, 2600}, {1400, 2600}, {2100, 2600}, {2800, 2600}, {3500, 2600}};
+    for (const auto &point : points) {
+        add_idle(noise, scenario, 20);
+        for (int i = 0; i < 40; ++i) {
+            Sample s = make_sample(noise, point[0], point[1], 380);
+            s.stationary = i >= 3;
+            scenario.samples.push_back(s);
+        }
+    }
+    add_idle(noise, scenario, 20);
+    return scenario;
+}
+
+// Arrasto horizontal em velocidade constante, com pausa parada no fim
+Scenario drag_scenario(const char *name, double speed) {
+    Noise noise(2);
+    Scenario scenario{name, {}, 1};
+    add_idle(noise, scenario, 10);
+    double x = 600;
+    const double y = 2000;
+    for (int i = 0; i < 10; ++i) {
+        scenario.samples.push_back(make_sample(noise, x, y, 400));
+    }
+    int moving = 0;
+    while (x + speed < 3400) {
+        x += speed;
+        Sample s = make_sample(noise, x, y, 400);
+        s.dragging = ++moving > 8;
+        s.speed = speed;
+        scenario.samples.push_back(s);
+    }
+    for (int i = 0; i < 30; ++i) {
+        Sample s = make_sample(noise, x, y, 400);
+        s.stationary = i >= 8;
+        scenario.samples.push_back(s);
+    }
+    add_idle(noise, scenario, 10);
+    return scenario;
+}
+
+// Toque leve: pressão oscilando em torno do limiar de press (100 +- 20)
+Scenario light_touch_scenario() {
+    Noise noise(3);
+    Scenario scenario{"toque leve (pressão 80-120)", {}, 1};
+    add_idle(noise, scenario, 10);
+    for (int i = 0; i < 60; ++i) {
+        const double pressure = i < 5 ? 40 + 12 * i : 100 + 20 * std::sin(i * 0.9);
+        Sample s = make_sample(noise, 1800, 1800, pressure);
+        s.stationary = i >= 8;
+        scenario.samples.push_back(s);
+    }
+    add_idle(noise, scenario, 10);
+    return scenario;
+}
+
+// Log do gravador: raw_x/raw_y já passaram pela mediana; soltura = pressão 0
+bool load_recording(const char *path, Scenario &scenario) {
+    FILE *file = std::fopen(path, "r");
+    if (file == nullptr) {
+        std::perror(path);
+        return false;
+    }
+    scenario = Scenario{path, {}, 0};
+    char line[512];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        const char *tt = std::strstr(line, "TT,");
+        unsigned t_ms, x, y, raw_x, raw_y, pressure;
+        if (tt == nullptr ||
+            std::sscanf(tt, "TT,%u,%u,%u,%u,%u,%u", &t_ms, &x, &y, &raw_x, &raw_y, &pressure) != 6) {
+            continue;
+        }
+        Sample s = {};
+        s.burst = 1;
+        s.x[0] = static_cast<uint16_t>(raw_x);
+        s.y[0] = static_cast<uint16_t>(raw_y);
+        s.pressure = static_cast<uint16_t>(pressure);
+        scenario.samples.push_back(s);
+    }
+    std::fclose(file);
+    return !scenario.samples.empty();
+}
+
+struct Result {
+    double jitter_raw;     ///< RMS do passo da saída com o dedo parado
+    double lag_ms;         ///< Atraso médio no arrasto
+    int presses;
+    int releases;
+    double input_step;     ///< Passo médio da entrada (logs gravados)
+    double output_step;    ///< Passo médio da saída (logs gravados)
+};
+
+Result replay(const Scenario &scenario, const TouchFilterConfig &config) {
+    TouchFilter filter(config);
+    Result result = {};
+    double jitter_sum = 0;
+    int jitter_count = 0;
+    double lag_sum = 0;
+    int lag_count = 0;
+    double in_sum = 0;
+    double out_sum = 0;
+    int step_count = 0;
+
+    bool was_pressed = false;
+    bool have_previous = false;
+    uint16_t prev_x = 0, prev_y = 0, prev_in_x = 0, prev_in_y = 0;
+
+    for (const Sample &sample : scenario.samples) {
+        const bool pressed = filter.updatePressure(sample.pressure);
+        if (pressed && !was_pressed) result.presses++;
+        if (!pressed && was_pressed) result.releases++;
+        was_pressed = pressed;
+        if (!pressed) {
+            have_previous = false;
+            continue;
+        }
+
+        // Mesma ordem de getTouch(): mediana do burst, depois suavização e dead-band
+        uint16_t xs[TouchFilter::MAX_BURST];
+        uint16_t ys[TouchFilter::MAX_BURST];
+        const uint8_t burst = sample.burst < filter.burstSamples() ? sample.burst : filter.burstSamples();
+        std::memcpy(xs, sample.x, sizeof(xs));
+        std::memcpy(ys, sample.y, sizeof(ys));
+        const uint16_t in_x = TouchFilter::median(xs, burst);
+        const uint16_t in_y = TouchFilter::median(ys, burst);
+        uint16_t x = in_x;
+        uint16_t y = in_y;
+        filter.filter(x, y);
+
+        if (have_previous) {
+            const double dx = static_cast<double>(x) - prev_x;
+            const double dy = static_cast<double>(y) - prev_y;
+            if (sample.stationary) {
+                jitter_sum += dx * dx + dy * dy;
+                jitter_count++;
+            }
+            in_sum += std::hypot(static_cast<double>(in_x) - prev_in_x, static_cast<double>(in_y) - prev_in_y);
+            out_sum += std::hypot(dx, dy);
+            step_count++;
+        }
+        if (sample.dragging) {
+            lag_sum += (sample.true_x - x) / sample.speed * SAMPLE_PERIOD_MS;
+            lag_count++;
+        }
+        prev_x = x;
+        prev_y = y;
+        prev_in_x = in_x;
+        prev_in_y = in_y;
+        have_previous = true;
+    }
+
+    result.jitter_raw = jitter_count > 0 ? std::sqrt(jitter_sum / jitter_count) : 0;
+    result.lag_ms = lag_count > 0 ? lag_sum / lag_count : 0;
+    result.input_step = step_count > 0 ? in_sum / step_count : 0;
+    result.output_step = step_count > 0 ? out_sum / step_count : 0;
+    return result;
+}
+
+struct NamedConfig {
+    const char *name;
+    TouchFilterConfig config;
+};
+
+std::vector<NamedConfig> configs() {
+    // Sem filtro: o getTouch() anterior (uma leitura, limiar único de 100)
+    TouchFilterConfig raw;
+    raw.burst_samples = 1;
+    raw.press_threshold = 100;
+    raw.release_threshold = 100;
+    raw.smoothing = TouchFilterConfig::Smoothing::None;
+    raw.dead_band = 0;
+
+    TouchFilterConfig iir;
+    iir.smoothing = TouchFilterConfig::Smoothing::Iir;
+
+    return {{"sem filtro", raw}, {"one-euro", TouchFilterConfig{}}, {"iir", iir}};
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<Scenario> scenarios = {
+        taps_scenario(),
+        drag_scenario("arrasto lento (10 RAW/amostra)", 10),
+        drag_scenario("arrasto rápido (40 RAW/amostra)", 40),
+        light_touch_scenario(),
+    };
+    const size_t synthetic = scenarios.size();
+    for (int i = 1; i < argc; ++i) {
+        Scenario recorded;
+        if (load_recording(argv[i], recorded)) {
+            scenarios.push_back(recorded);
+        } else {
+            std::fprintf(stderr, "%s: nenhuma linha TT,... encontrada\n", argv[i]);
+        }
+    }
+
+    const TouchFilterConfig defaults;
+    std::printf("Padrão: burst %u, press %u / release %u, one-euro (min %u/256, beta %u/256), dead-band %u RAW\n",
+                defaults.burst_samples, defaults.press_threshold, defaults.release_threshold,
+                defaults.min_alpha_q8, defaults.beta_q8, defaults.dead_band);
+    std::printf("Ruído sintético: sigma %.0f RAW por leitura, %.0f%% de picos de 150-400 RAW, pressão sigma %.0f\n\n",
+                READ_SIGMA, SPIKE_PROBABILITY * 100, PRESSURE_SIGMA);
+
+    int default_spurious = 0;
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        const Scenario &scenario = scenarios[i];
+        const bool has_truth = i < synthetic;
+        std::printf("%s (%zu amostras, %d toque(s)%s)\n", scenario.name.c_str(), scenario.samples.size(),
+                    scenario.touches, has_truth ? "" : " gravados");
+        for (const NamedConfig &named : configs()) {
+            const Result r = replay(scenario, named.config);
+            if (has_truth) {
+                const int spurious = (r.presses - scenario.touches) + (r.releases - scenario.touches);
+                std::printf("  %-10s jitter %6.2f RAW (%.2f px)  atraso %5.1f ms  espúrios %d\n", named.name,
+                            r.jitter_raw, r.jitter_raw / RAW_PER_PX, r.lag_ms, spurious);
+                if (named.config.smoothing == defaults.smoothing && named.config.burst_samples == defaults.burst_samples &&
+                    spurious != 0) {
+                    default_spurious += spurious;
+                }
+            } else {
+                std::printf("  %-10s passo médio entrada %6.2f RAW -> saída %6.2f RAW  press %d release %d\n",
+                            named.name, r.input_step, r.output_step, r.presses, r.releases);
+            }
+        }
+        std::printf("\n");
+    }
+
+    if (default_spurious != 0) {
+        std::printf("FALHOU: configuração padrão gerou %d eventos espúrios\n", default_spurious);
+        return 1;
+    }
+    return 0;
+}
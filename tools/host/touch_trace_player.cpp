@@ -0,0 +1,221 @@
+/**
+ * @file touch_trace_player.cpp
+ * @brief Player de traces de touch no LVGL de host (user-033)
+ *
+ * Lê um log do gravador do aparelho (linhas "TT,t_ms,x,y,raw_x,raw_y,pressure",
+ * comando "touch_rec" do console de diagnóstico) e o injeta, com o mesmo
+ * TouchTracePlayer do firmware, num indev de um display de host de 320x240 com buffer parcial de
+ * 1/10 da tela. O relógio do LVGL é simulado: o lv_timer_handler roda a cada
+ * 10 ms de trace, como o task do LVGL, e só o tempo de CPU de cada passada é
+ * medido. Relata quadros, tempo de desenho (p50/p95/máx), pixels enviados e
+ * cliques recebidos, para comparar mudanças de LVGL/configuração com a mesma
+ * entrada.
+ *
+ * As cenas aproximam as telas do firmware só com widgets do LVGL (as telas
+ * reais dependem do ESP-IDF): "avaliacao" (5 botões), "senha" (teclado
+ * numérico 3x4), "teclado" (lv_keyboard com textarea) e "lista" (scan WiFi
+ * com 30 redes). Os números servem para comparar variantes no PC; o custo
+ * absoluto no ESP32 é outro.
+ *
+ * Uso: touch_trace_player <cena> <monitor.log>
+ */
+#include "lvgl.h"
+#include "touch_trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int32_t HOR_RES = 320;
+constexpr int32_t VER_RES = 240;
+constexpr uint32_t PASS_PERIOD_MS = 10;  // LVGL_TASK_PERIOD do firmware
+
+uint32_t sim_ms = 0;
+uint32_t flushed_pixels = 0;
+uint32_t clicks = 0;
+TouchTraceSample indev_sample = {};
+
+uint32_t sim_tick() {
+    return sim_ms;
+}
+
+void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    flushed_pixels += lv_area_get_size(area);
+    lv_display_flush_ready(disp);
+}
+
+void read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    data->point.x = indev_sample.x;
+    data->point.y = indev_sample.y;
+    data->state = indev_sample.pressure > 0 ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void click_cb(lv_event_t *e) {
+    clicks++;
+}
+
+lv_obj_t *add_button(lv_obj_t *parent, const char *text, int32_t x, int32_t y, int32_t w, int32_t h) {
+    lv_obj_t *button = lv_button_create(parent);
+    lv_obj_set_pos(button, x, y);
+    lv_obj_set_size(button, w, h);
+    lv_obj_add_event_cb(button, click_cb, LV_EVENT_CLICKED, nullptr);
+    lv_obj_t *label = lv_label_create(button);
+    lv_label_set_text(label, text);
+    lv_obj_center(label);
+    return button;
+}
+
+bool build_scene(const char *scene, lv_obj_t *screen) {
+    if (strcmp(scene, "avaliacao") == 0) {
+        lv_obj_t *title = lv_label_create(screen);
+        lv_label_set_text(title, "Como você se sentiu hoje?");
+        lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 40);
+        const char *labels[] = {"1", "2", "3", "4", "5"};
+        for (int i = 0; i < 5; ++i) {
+            add_button(screen, labels[i], 12 + i * 61, 150, 52, 70);
+        }
+        return true;
+    }
+    if (strcmp(scene, "senha") == 0) {
+        lv_obj_t *display = lv_label_create(screen);
+        lv_label_set_text(display, "Digite a senha");
+        lv_obj_align(display, LV_ALIGN_TOP_MID, 0, 10);
+        const char *keys[] = {"1", "2", "3", "4", "5", "6", "7", "8", "9", "<", "0", "OK"};
+        for (int i = 0; i < 12; ++i) {
+            add_button(screen, keys[i], 40 + (i % 3) * 84, 50 + (i / 3) * 47, 72, 40);
+        }
+        return true;
+    }
+    if (strcmp(scene, "teclado") == 0) {
+        lv_obj_t *textarea = lv_textarea_create(screen);
+        lv_obj_set_size(textarea, 300, 40);
+        lv_obj_align(textarea, LV_ALIGN_TOP_MID, 0, 10);
+        lv_textarea_set_one_line(textarea, true);
+        lv_obj_t *keyboard = lv_keyboard_create(screen);
+        lv_keyboard_set_textarea(keyboard, textarea);
+        lv_obj_add_event_cb(keyboard, click_cb, LV_EVENT_VALUE_CHANGED, nullptr);
+        return true;
+    }
+    if (strcmp(scene, "lista") == 0) {
+        lv_obj_t *list = lv_list_create(screen);
+        lv_obj_set_size(list, HOR_RES, VER_RES - 40);
+        lv_obj_align(list, LV_ALIGN_BOTTOM_MID, 0, 0);
+        char name[32];
+        for (int i = 0; i < 30; ++i) {
+            snprintf(name, sizeof(name), "Rede %02d (-%d dBm)", i + 1, 40 + i * 2);
+            lv_obj_t *item = lv_list_add_button(list, LV_SYMBOL_WIFI, name);
+            lv_obj_add_event_cb(item, click_cb, LV_EVENT_CLICKED, nullptr);
+        }
+        return true;
+    }
+    return false;
+}
+
+// Timestamps rebaseados para começar em 0; termina em soltura
+bool load_log(const char *path, std::vector<TouchTraceSample> &samples) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        const char *tt = strstr(line, "TT,");
+        unsigned t_ms, x, y, raw_x, raw_y, pressure;
+        if (tt == nullptr || sscanf(tt, "TT,%u,%u,%u,%u,%u,%u", &t_ms, &x, &y, &raw_x, &raw_y, &pressure) != 6) {
+            continue;
+        }
+        samples.push_back(TouchTraceSample{t_ms, static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                           static_cast<uint16_t>(pressure)});
+    }
+    fclose(file);
+    if (samples.empty()) {
+        return false;
+    }
+    const uint32_t t0 = samples.front().t_ms;
+    for (auto &sample : samples) {
+        sample.t_ms -= t0;
+    }
+    if (samples.back().pressure != 0) {
+        TouchTraceSample release = samples.back();
+        release.t_ms += PASS_PERIOD_MS;
+        release.pressure = 0;
+        samples.push_back(release);
+    }
+    return true;
+}
+
+uint32_t percentile(std::vector<uint32_t> values, uint32_t pct) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[(values.size() - 1) * pct / 100];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Uso: %s <avaliacao|senha|teclado|lista> <monitor.log>\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<TouchTraceSample> samples;
+    TouchTrace trace = {argv[2], nullptr, 0};
+    if (!load_log(argv[2], samples)) {
+        fprintf(stderr, "%s: nenhuma linha TT,... no log\n", argv[2]);
+        return 2;
+    }
+    trace.samples = samples.data();
+    trace.count = samples.size();
+
+    lv_init();
+    lv_tick_set_cb(sim_tick);
+    lv_display_t *display = lv_display_create(HOR_RES, VER_RES);
+    static uint8_t draw_buf[HOR_RES * VER_RES / 10 * 2];
+    lv_display_set_buffers(display, draw_buf, nullptr, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(display, flush_cb);
+    lv_indev_t *indev = lv_indev_create();
+    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(indev, read_cb);
+
+    if (!build_scene(argv[1], lv_screen_active())) {
+        fprintf(stderr, "Cena desconhecida: %s\n", argv[1]);
+        return 2;
+    }
+    lv_timer_handler();  // Primeiro quadro completo fora da medição
+    flushed_pixels = 0;
+
+    TouchTracePlayer player;
+    player.start(&trace, 0);
+    std::vector<uint32_t> render_us;
+    const uint32_t end_ms = trace.samples[trace.count - 1].t_ms + 500;  // Animações do último toque
+    for (sim_ms = 0; sim_ms <= end_ms; sim_ms += PASS_PERIOD_MS) {
+        TouchTraceSample sample;
+        while (player.poll(static_cast<int64_t>(sim_ms) * 1000, sample)) {
+            indev_sample = sample;
+        }
+        const uint32_t pixels_before = flushed_pixels;
+        const auto start = std::chrono::steady_clock::now();
+        lv_timer_handler();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        if (flushed_pixels != pixels_before) {
+            render_us.push_back(static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        }
+    }
+
+    printf("Trace '%s': %zu amostras, %lu ms; cena %s\n", trace.name, trace.count,
+           static_cast<unsigned long>(trace.samples[trace.count - 1].t_ms), argv[1]);
+    printf("Quadros %zu: desenho p50 %lu us, p95 %lu us, máx %lu us (host)\n", render_us.size(),
+           static_cast<unsigned long>(percentile(render_us, 50)),
+           static_cast<unsigned long>(percentile(render_us, 95)),
+           static_cast<unsigned long>(render_us.empty() ? 0 : *std::max_element(render_us.begin(), render_us.end())));
+    printf("Pixels enviados %lu (%.1f telas), cliques/teclas %lu\n", static_cast<unsigned long>(flushed_pixels),
+           flushed_pixels / static_cast<double>(HOR_RES * VER_RES), static_cast<unsigned long>(clicks));
+    return 0;
+}
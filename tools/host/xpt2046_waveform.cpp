@@ -0,0 +1,279 @@
+/**
+ * @file xpt2046_waveform.cpp
+ * @brief Mock de pinos do XPT2046 que verifica a forma de onda do Xpt2046Bitbang (user-031)
+ *
+ * O mock implementa Xpt2046Transport com tempo simulado (cada delayHalfPeriod()
+ * avança meio período do clock alvo) e um modelo do chip:
+ *   - com CS baixo, amostra MOSI na borda de subida de CLK e monta o comando a
+ *     partir do bit de start (zeros antes dele são ignorados, como no chip);
+ *   - depois do 8º bit, a borda de descida seguinte é o ciclo de busy e as 16
+ *     seguintes colocam em DOUT o resultado de 12 bits (MSB primeiro) e 4 zeros.
+ *
+ * Verifica:
+ *   - o quadro de um comando contra a sequência de referência, borda a borda;
+ *   - MOSI respeita hold (tDH) depois da subida e tem meio período de setup antes dela;
+ *   - cada nível de CLK dura pelo menos meio período;
+ *   - os comandos de getTouch() (Z1, Z2 e o burst X/Y) e os valores decodificados;
+ *   - CS volta alto ao fim de cada leitura.
+ * Também relata o tempo de barramento por getTouch() no clock de 2 MHz.
+ */
+#include "Xpt2046Bitbang.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CLOCK_HZ = 2000000;
+constexpr uint64_t HALF_PERIOD_NS = 1000000000ULL / (2 * CLOCK_HZ);
+constexpr uint64_t HOLD_NS = 10;  // tDH do XPT2046
+
+enum class Pin : uint8_t { Cs, Clk, Mosi };
+
+struct Edge {
+    uint64_t t_ns;
+    Pin pin;
+    bool level;
+
+    bool operator==(const Edge &other) const {
+        return t_ns == other.t_ns && pin == other.pin && level == other.level;
+    }
+};
+
+int failures = 0;
+
+void check(bool condition, const char *what, uint64_t t_ns) {
+    if (!condition) {
+        if (failures < 20) {
+            std::printf("  FALHA em t=%llu ns: %s\n", static_cast<unsigned long long>(t_ns), what);
+        }
+        failures++;
+    }
+}
+
+class MockTransport final : public Xpt2046Transport {
+public:
+    // Resultados de 12 bits por canal (bits A2..A0 do comando)
+    uint16_t x_value = 0x5A3;
+    uint16_t y_value = 0x2C7;
+    uint16_t z1_value = 0x1F0;
+    uint16_t z2_value = 0xE10;
+
+    std::vector<Edge> edges;
+    std::vector<uint8_t> commands;
+
+    void begin() override {
+        cs_ = true;
+        clk_ = false;
+        mosi_ = false;
+        begun_ = true;
+    }
+
+    void setCs(bool level) override {
+        check(begun_, "CS antes de begin()", now_);
+        if (level != cs_) {
+            record(Pin::Cs, level);
+            cs_ = level;
+            if (!cs_) {
+                bits_ = 0;
+                command_ = 0;
+                falls_after_command_ = -1;
+            }
+        }
+    }
+
+    void setClk(bool level) override {
+        if (level == clk_) {
+            return;
+        }
+        check(now_ - last_clk_change_ >= HALF_PERIOD_NS || edges.empty(),
+              "nível de CLK menor que meio período", now_);
+        record(Pin::Clk, level);
+        clk_ = level;
+        last_clk_change_ = now_;
+        if (clk_) {
+            last_clk_rise_ = now_;
+        }
+        if (cs_) {
+            return;
+        }
+        if (clk_) {
+            // Borda de subida: o chip amostra MOSI (tDS >= 100 ns)
+            check(now_ - last_mosi_change_ >= HALF_PERIOD_NS, "MOSI sem meio período de setup", now_);
+            if (bits_ == 0 && !mosi_) {
+                // Aguardando o bit de start
+            } else {
+                command_ = static_cast<uint8_t>((command_ << 1) | (mosi_ ? 1 : 0));
+                if (++bits_ == 8) {
+                    commands.push_back(command_);
+                    result_ = static_cast<uint16_t>(valueFor(command_) << 4);
+                    falls_after_command_ = 0;
+                    bits_ = 0;
+                    command_ = 0;
+                }
+            }
+        } else if (falls_after_command_ >= 0) {
+            // Borda de descida: busy, depois um bit do resultado por borda
+            const int index = falls_after_command_++ - 1;
+            dout_ = index >= 0 && index < 16 && ((result_ >> (15 - index)) & 1);
+            if (index >= 15) {
+                falls_after_command_ = -1;
+            }
+        }
+    }
+
+    void setMosi(bool level) override {
+        if (level == mosi_) {
+            return;
+        }
+        check(now_ - last_clk_rise_ >= HOLD_NS, "MOSI mudou dentro do hold da subida de CLK", now_);
+        record(Pin::Mosi, level);
+        mosi_ = level;
+        last_mosi_change_ = now_;
+    }
+
+    bool readMiso() override {
+        check(!cs_, "MISO lido sem CS", now_);
+        check(!clk_, "MISO lido com CLK alto", now_);
+        return dout_;
+    }
+
+    void delayHalfPeriod() override {
+        now_ += HALF_PERIOD_NS;
+    }
+
+    uint64_t now() const { return now_; }
+    bool csHigh() const { return cs_; }
+
+    void clear() {
+        edges.clear();
+        commands.clear();
+    }
+
+private:
+    uint16_t valueFor(uint8_t command) const {
+        switch ((command >> 4) & 0x07) {
+            case 0b001: return x_value;
+            case 0b101: return y_value;
+            case 0b011: return z1_value;
+            case 0b100: return z2_value;
+            default:
+                check(false, "canal inesperado", now_);
+                return 0;
+        }
+    }
+
+    void record(Pin pin, bool level) {
+        edges.push_back(Edge{now_, pin, level});
+    }
+
+    uint64_t now_ = 1000;
+    uint64_t last_clk_change_ = 0;
+    uint64_t last_clk_rise_ = 0;
+    uint64_t last_mosi_change_ = 0;
+    bool begun_ = false;
+    bool cs_ = true;
+    bool clk_ = false;
+    bool mosi_ = false;
+    bool dout_ = false;
+    int bits_ = 0;
+    uint8_t command_ = 0;
+    uint16_t result_ = 0;
+    int falls_after_command_ = -1;
+};
+
+// Referência do quadro de um comando a partir do CS baixo em t0
+std::vector<Edge> reference_frame(uint64_t t0, uint8_t command) {
+    std::vector<Edge> edges;
+    uint64_t t = t0;
+    bool mosi = false;
+    edges.push_back(Edge{t, Pin::Cs, false});
+    for (int i = 7; i >= 0; --i) {
+        const bool bit = (command >> i) & 1;
+        if (bit != mosi) {
+            edges.push_back(Edge{t, Pin::Mosi, bit});
+            mosi = bit;
+        }
+        if (i != 7) {
+            edges.push_back(Edge{t, Pin::Clk, false});
+        }
+        t += HALF_PERIOD_NS;
+        edges.push_back(Edge{t, Pin::Clk, true});
+        t += HALF_PERIOD_NS;
+    }
+    if (mosi) {
+        edges.push_back(Edge{t, Pin::Mosi, false});
+    }
+    edges.push_back(Edge{t, Pin::Clk, false});
+    t += HALF_PERIOD_NS;
+    for (int i = 0; i < 16; ++i) {
+        edges.push_back(Edge{t, Pin::Clk, true});
+        t += HALF_PERIOD_NS;
+        edges.push_back(Edge{t, Pin::Clk, false});
+        t += HALF_PERIOD_NS;
+    }
+    return edges;
+}
+
+} // namespace
+
+int main() {
+    MockTransport mock;
+    Xpt2046Bitbang touch(mock, 320, 240);
+    touch.begin();
+    touch.setCalibration(0, 4095, 0, 4095);
+
+    const uint64_t start = mock.now();
+    const TouchPoint point = touch.getTouch();
+    const uint64_t frame_ns = mock.now() - start;
+
+    // Primeiro comando (Z1) borda a borda contra a referência
+    const std::vector<Edge> reference = reference_frame(start, 0b10110000);
+    bool frame_ok = mock.edges.size() >= reference.size();
+    for (size_t i = 0; frame_ok && i < reference.size(); ++i) {
+        frame_ok = mock.edges[i] == reference[i];
+        if (!frame_ok) {
+            std::printf("  borda %zu difere da referência (t=%llu ns)\n", i,
+                        static_cast<unsigned long long>(mock.edges[i].t_ns));
+        }
+    }
+    check(frame_ok, "quadro do comando Z1 difere da referência", start);
+
+    // Comandos: Z1, Z2 e o burst padrão de 5 pares X/Y (Y com PD0 = 0)
+    std::vector<uint8_t> expected = {0b10110000, 0b11000000};
+    for (int i = 0; i < 5; ++i) {
+        expected.push_back(0b10010000);
+        expected.push_back(0b11010000);
+    }
+    check(mock.commands == expected, "sequência de comandos de getTouch()", mock.now());
+    check(mock.csHigh(), "CS ficou baixo depois de getTouch()", mock.now());
+
+    const uint16_t pressure = static_cast<uint16_t>((mock.z1_value + 4095) - mock.z2_value);
+    check(point.rawX == mock.x_value && point.rawY == mock.y_value, "RAW X/Y decodificados", mock.now());
+    check(point.pressure == pressure, "pressão decodificada", mock.now());
+    check(point.x == mock.x_value * 320 / 4095 && point.y == mock.y_value * 240 / 4095,
+          "mapeamento para pixels", mock.now());
+
+    // Sem toque: só Z1/Z2 e CS de volta alto
+    mock.clear();
+    mock.z1_value = 0;
+    mock.z2_value = 4095;
+    const TouchPoint released = touch.getTouch();
+    check(released.pressure == 0 && mock.commands.size() == 2, "leitura sem toque", mock.now());
+    check(mock.csHigh(), "CS ficou baixo depois da leitura sem toque", mock.now());
+
+    std::printf("Clock alvo %lu Hz, meio período %llu ns\n", static_cast<unsigned long>(CLOCK_HZ),
+                static_cast<unsigned long long>(HALF_PERIOD_NS));
+    std::printf("getTouch() pressionado: %zu comandos, %.1f us de barramento\n", expected.size(),
+                frame_ns / 1000.0);
+    std::printf("RAW (%u, %u) pressão %u -> (%u, %u) px\n", point.rawX, point.rawY, point.pressure,
+                point.x, point.y);
+
+    if (failures != 0) {
+        std::printf("FALHOU: %d verificações\n", failures);
+        return 1;
+    }
+    std::printf("Forma de onda OK\n");
+    return 0;
+}
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""
+Gerador de patch delta para OTA (lido por components/ota_driver/ota_delta.cpp)
+
+Compara duas imagens de app (a que roda no dispositivo e a nova) e gera um
+patch no estilo bsdiff: trechos da nova imagem que existem na antiga, mesmo
+com bytes trocados (endereços deslocados pelo linker), viram COPY/ADD com
+diferenças quase todas zero; o resto vira INSERT. O fluxo de operações é
+comprimido com zlib (janela de 32 KB), que o firmware descomprime com o
+tinfl da ROM do ESP32.
+
+Formato (antes da compressão, inteiros little-endian):
+
+    "SHD1" u32 tamanho_destino u32 tamanho_origem
+    operações:
+        0x01 COPY   u32 offset_origem u32 n          destino += origem[off:off+n]
+        0x02 ADD    u32 offset_origem u32 n  n bytes destino += origem[off+i] + diff[i]
+        0x03 INSERT u32 n  n bytes                    destino += bytes
+        0x00 END
+
+Uso:
+    python3 tools/ota_delta.py antigo.bin novo.bin -o patch.bin
+    python3 tools/ota_delta.py antigo.bin novo.bin --check   # aplica no host e confere
+"""
+
+import sys
+import zlib
+import struct
+import argparse
+
+MAGIC = b'SHD1'
+OP_END = 0x00
+OP_COPY = 0x01
+OP_ADD = 0x02
+OP_INSERT = 0x03
+
+# Trecho idêntico mínimo para ancorar um COPY/ADD (abaixo disso INSERT sai mais barato)
+MIN_MATCH = 16
+KGRAM = 8
+# A extensão aproximada para quando passa tanto tempo sem melhorar a pontuação
+EXTEND_SLACK = 64
+
+
+def exact_length(old, s, new, t):
+    """Quantos bytes seguidos batem a partir de old[s] e new[t]"""
+    limit = min(len(old) - s, len(new) - t)
+    length = 0
+    step = 256
+    while step >= 1:
+        while length + step <= limit and old[s + length:s + length + step] == new[t + length:t + length + step]:
+            length += step
+        step //= 4
+    return length
+
+
+def extend_approx(old, s, new, t, start):
+    """
+    Estende um casamento além da parte exata enquanto mais da metade dos
+    bytes bate (mesma ideia do bsdiff: código deslocado muda só endereços)
+    """
+    limit = min(len(old) - s, len(new) - t)
+    best_len = start
+    score = 0
+    best_score = 0
+    i = start
+    while i < limit and i - best_len <= EXTEND_SLACK:
+        score += 1 if old[s + i] == new[t + i] else -1
+        i += 1
+        if score > best_score:
+            best_score = score
+            best_len = i
+    return best_len
+
+
+def make_ops(old, new):
+    """Lista de (op, offset_origem, dados ou n)"""
+    index = {}
+    for pos in range(len(old) - KGRAM + 1):
+        index.setdefault(old[pos:pos + KGRAM], pos)
+
+    ops = []
+    insert_start = 0
+    last_shift = 0  # offset_origem - offset_destino do último casamento
+    t = 0
+    while t <= len(new) - KGRAM:
+        best_s, best_len = -1, 0
+        for s in (t + last_shift, index.get(new[t:t + KGRAM], -1)):
+            if 0 <= s < len(old):
+                length = exact_length(old, s, new, t)
+                if length > best_len:
+                    best_s, best_len = s, length
+
+        if best_len < MIN_MATCH:
+            t += 1
+            continue
+
+        if insert_start < t:
+            ops.append((OP_INSERT, 0, new[insert_start:t]))
+        length = extend_approx(old, best_s, new, t, best_len)
+        diff = bytes((new[t + i] - old[best_s + i]) & 0xFF for i in range(best_len, length))
+        if any(diff):
+            ops.append((OP_ADD, best_s, bytes(best_len) + diff))
+        else:
+            ops.append((OP_COPY, best_s, length))
+        last_shift = best_s - t
+        t += length
+        insert_start = t
+
+    if insert_start < len(new):
+        ops.append((OP_INSERT, 0, new[insert_start:]))
+    return ops
+
+
+def encode(ops, old, new):
+    out = bytearray(MAGIC + struct.pack('<II', len(new), len(old)))
+    for op, src, payload in ops:
+        if op == OP_COPY:
+            out += struct.pack('<BII', OP_COPY, src, payload)
+        elif op == OP_ADD:
+            out += struct.pack('<BII', OP_ADD, src, len(payload)) + payload
+        else:
+            out += struct.pack('<BI', OP_INSERT, len(payload)) + payload
+    out.append(OP_END)
+    return bytes(out)
+
+
+def make_patch(old, new):
+    """Patch comprimido (zlib, janela de 32 KB) pronto para servir"""
+    return zlib.compress(encode(make_ops(old, new), old, new), 9)
+
+
+def apply_patch(old, patch):
+    """Aplicador de referência (o mesmo algoritmo de ota_delta.cpp)"""
+    raw = zlib.decompress(patch)
+    if raw[:4] != MAGIC:
+        raise ValueError('assinatura inválida')
+    target_size, source_size = struct.unpack_from('<II', raw, 4)
+    if source_size != len(old):
+        raise ValueError(f'origem de {len(old)} bytes, patch espera {source_size}')
+    out = bytearray()
+    pos = 12
+    while True:
+        op = raw[pos]
+        pos += 1
+        if op == OP_END:
+            break
+        if op == OP_COPY:
+            src, n = struct.unpack_from('<II', raw, pos)
+            pos += 8
+            out += old[src:src + n]
+        elif op == OP_ADD:
+            src, n = struct.unpack_from('<II', raw, pos)
+            pos += 8
+            out += bytes((old[src + i] + raw[pos + i]) & 0xFF for i in range(n))
+            pos += n
+        elif op == OP_INSERT:
+            (n,) = struct.unpack_from('<I', raw, pos)
+            pos += 4
+            out += raw[pos:pos + n]
+            pos += n
+        else:
+            raise ValueError(f'operação desconhecida 0x{op:02x}')
+    if len(out) != target_size:
+        raise ValueError('tamanho final diverge do cabeçalho')
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Gera patch delta entre duas imagens de app para OTA')
+    parser.add_argument('old', help='Imagem que roda no dispositivo')
+    parser.add_argument('new', help='Imagem nova')
+    parser.add_argument('-o', '--output', help='Arquivo do patch')
+    parser.add_argument('--check', action='store_true', help='Aplicar o patch no host e conferir o resultado')
+    args = parser.parse_args()
+
+    with open(args.old, 'rb') as f:
+        old = f.read()
+    with open(args.new, 'rb') as f:
+        new = f.read()
+
+    patch = make_patch(old, new)
+    full = len(zlib.compress(new, 9))
+    print(f'[ota_delta] imagem nova {len(new)} bytes (zlib {full}), patch {len(patch)} bytes '
+          f'({100.0 * len(patch) / len(new):.1f}% da imagem)', file=sys.stderr)
+
+    if args.check:
+        if apply_patch(old, patch) != new:
+            print('[ota_delta] ERRO: patch aplicado não reproduz a imagem nova', file=sys.stderr)
+            return 1
+        print('[ota_delta] patch conferido', file=sys.stderr)
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(patch)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
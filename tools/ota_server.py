@@ -2,6 +2,18 @@
 """
 Servidor OTA simples para desenvolvimento
 Serve atualizações de firmware para dispositivos ESP32 via HTTP/HTTPS
+
+O download aceita "Range: bytes=<início>-[<fim>]" (resposta 206) para o
+firmware retomar de onde parou, e ?action=manifest devolve o manifesto com o
+SHA-256 da imagem e de cada bloco (components/ota_driver).
+
+Com --compress, a imagem inteira vai como deflate cru com flush completo a
+cada bloco do manifesto (o firmware descomprime direto no slot e ainda retoma
+do último bloco conferido).
+
+Com --delta-from VERSÃO=imagem.bin, dispositivos que informam essa versão em
+current_version recebem um patch delta (tools/ota_delta.py) no lugar da
+imagem inteira.
 """
 
 import os
@@ -11,14 +23,138 @@ import hashlib
 import argparse
 from http.server import HTTPServer, BaseHTTPRequestHandler
 from urllib.parse import urlparse, parse_qs
+import re
+import zlib
 import mimetypes
 
+from ota_delta import make_patch
+
+DEFAULT_CHUNK_SIZE = 64 * 1024
+
+# 4 KB de janela: perde ~1,5% de compressão para 32 KB e economiza 28 KB de RAM no dispositivo
+DEFAULT_WINDOW_BITS = 12
+
+RANGE_HEADER = re.compile(r'^bytes=(\d*)-(\d*)$')
+
+
+def compress_image(firmware_path, chunk_size, window_bits):
+    """Deflate cru da imagem, com flush completo no início de cada bloco
+
+    Depois de um flush completo o compressor não referencia nada anterior, então
+    o dispositivo pode recomeçar o inflate no offset de qualquer bloco.
+    """
+    compressor = zlib.compressobj(9, zlib.DEFLATED, -window_bits, 9)
+    data = bytearray()
+    offsets = []
+    with open(firmware_path, 'rb') as f:
+        chunk = f.read(chunk_size)
+        while chunk:
+            offsets.append(len(data))
+            data += compressor.compress(chunk)
+            chunk = f.read(chunk_size)
+            data += compressor.flush(zlib.Z_FULL_FLUSH if chunk else zlib.Z_FINISH)
+    return {'data': bytes(data), 'offsets': offsets, 'window_bits': window_bits}
+
+
+def build_manifest(firmware_path, firmware_version, chunk_size, compressed=None):
+    """Manifesto em texto lido por ota_driver.cpp (parse_manifest)"""
+    image_hash = hashlib.sha256()
+    chunk_hashes = []
+    size = 0
+    with open(firmware_path, 'rb') as f:
+        while True:
+            chunk = f.read(chunk_size)
+            if not chunk:
+                break
+            size += len(chunk)
+            image_hash.update(chunk)
+            chunk_hashes.append(hashlib.sha256(chunk).hexdigest())
+
+    lines = [
+        f'version {firmware_version}',
+        f'size {size}',
+        f'chunk_size {chunk_size}',
+        f'sha256 {image_hash.hexdigest()}',
+    ]
+    if compressed:
+        lines += [
+            'format deflate',
+            f'compressed_size {len(compressed["data"])}',
+            f'window_bits {compressed["window_bits"]}',
+        ]
+        lines += [f'chunk {h} {offset}' for h, offset in zip(chunk_hashes, compressed['offsets'])]
+    else:
+        lines += [f'chunk {h}' for h in chunk_hashes]
+    return '\n'.join(lines) + '\n'
+
+
+def build_delta_manifest(firmware_version, delta):
+    """Manifesto de patch delta (ota_driver.cpp baixa o patch e reconstrói a imagem)"""
+    return '\n'.join([
+        f'version {firmware_version}',
+        'format delta',
+        f'size {delta["size"]}',
+        f'sha256 {delta["sha256"]}',
+        f'patch_size {len(delta["patch"])}',
+        f'patch_sha256 {hashlib.sha256(delta["patch"]).hexdigest()}',
+        f'source_size {delta["source_size"]}',
+        f'source_sha256 {delta["source_sha256"]}',
+    ]) + '\n'
+
+
+def load_deltas(firmware_path, specs):
+    """Gera os patches de cada "VERSÃO=imagem.bin" para a imagem atual"""
+    with open(firmware_path, 'rb') as f:
+        new = f.read()
+    deltas = {}
+    for spec in specs:
+        version, _, path = spec.partition('=')
+        if not version or not path:
+            raise SystemExit(f"[OTA Server] ERRO: --delta-from espera VERSÃO=caminho, recebeu {spec}")
+        with open(path, 'rb') as f:
+            old = f.read()
+        patch = make_patch(old, new)
+        deltas[version] = {
+            'patch': patch,
+            'size': len(new),
+            'sha256': hashlib.sha256(new).hexdigest(),
+            'source_size': len(old),
+            'source_sha256': hashlib.sha256(old).hexdigest(),
+        }
+        print(f"[OTA Server] Delta {version}: {len(patch)} bytes ({100.0 * len(patch) / len(new):.1f}% da imagem)")
+    return deltas
+
+
+def parse_range(header, size):
+    """Retorna (início, fim inclusivo), None sem Range ou 'invalid' se insatisfazível"""
+    if not header:
+        return None
+    m = RANGE_HEADER.match(header.strip())
+    if not m or (not m.group(1) and not m.group(2)):
+        return 'invalid'
+    if m.group(1):
+        start = int(m.group(1))
+        end = int(m.group(2)) if m.group(2) else size - 1
+    else:
+        # "bytes=-N": últimos N bytes
+        start = max(0, size - int(m.group(2)))
+        end = size - 1
+    end = min(end, size - 1)
+    if start > end:
+        return 'invalid'
+    return start, end
+
 class OtaRequestHandler(BaseHTTPRequestHandler):
     """Handler para requisições OTA"""
     
-    def __init__(self, *args, firmware_path=None, firmware_version=None, **kwargs):
+    def __init__(self, *args, firmware_path=None, firmware_version=None, chunk_size=DEFAULT_CHUNK_SIZE,
+                 drop_every=0, deltas=None, compressed=None, **kwargs):
         self.firmware_path = firmware_path
         self.firmware_version = firmware_version
+        self.chunk_size = chunk_size
+        self.drop_every = drop_every
+        self.deltas = deltas or {}
+        self.compressed = compressed
         super().__init__(*args, **kwargs)
     
     def log_message(self, format, *args):
@@ -34,15 +170,26 @@ class OtaRequestHandler(BaseHTTPRequestHandler):
         device_id = query_params.get('device_id', [None])[0]
         action = query_params.get('action', [None])[0]
         current_version = query_params.get('current_version', ['0.0.0'])[0]
+        # "full" força a imagem inteira; "delta" pede o patch para current_version;
+        # "deflate" baixa a imagem comprimida
+        image_format = query_params.get('format', [None])[0]
         
         self.log_message(f"Requisição: {parsed_path.path} | device_id={device_id} | action={action} | current_version={current_version}")
         
         # Rota de verificação de atualização
         if action == 'check':
             self.handle_check_update(device_id, current_version)
-        # Rota de download do firmware
+        # Manifesto com hashes por bloco (download retomável)
+        elif action == 'manifest':
+            self.handle_manifest(device_id, current_version, image_format)
+        # Rota de download do firmware (ou do patch delta)
         elif parsed_path.path == '/ota' or parsed_path.path == '/firmware.bin':
-            self.handle_firmware_download(device_id)
+            if image_format == 'delta':
+                self.handle_delta_download(device_id, current_version)
+            elif image_format == 'deflate':
+                self.handle_compressed_download(device_id)
+            else:
+                self.handle_firmware_download(device_id)
         else:
             self.send_error(404, "Not Found")
     
@@ -71,33 +218,105 @@ class OtaRequestHandler(BaseHTTPRequestHandler):
         self.end_headers()
         self.wfile.write(json.dumps(response).encode('utf-8'))
     
+    def handle_manifest(self, device_id, current_version, image_format):
+        """Serve o manifesto: patch delta se houver para current_version, senão a imagem inteira"""
+        if not self.firmware_path or not os.path.exists(self.firmware_path):
+            self.send_error(404, "Firmware não encontrado")
+            return
+
+        delta = self.deltas.get(current_version) if image_format != 'full' else None
+        if delta:
+            body = build_delta_manifest(self.firmware_version, delta)
+        else:
+            body = build_manifest(self.firmware_path, self.firmware_version, self.chunk_size, self.compressed)
+        body = body.encode('utf-8')
+        self.send_response(200)
+        self.send_header('Content-Type', 'text/plain; charset=utf-8')
+        self.send_header('Content-Length', str(len(body)))
+        self.send_header('Access-Control-Allow-Origin', '*')
+        self.end_headers()
+        self.wfile.write(body)
+        self.log_message(f"Manifesto {'delta' if delta else 'completo'} enviado para device_id={device_id} "
+                         f"| {current_version} -> {self.firmware_version}")
+
     def handle_firmware_download(self, device_id):
-        """Serve o arquivo de firmware"""
+        """Serve o arquivo de firmware (inteiro ou o trecho pedido em Range)"""
         if not self.firmware_path or not os.path.exists(self.firmware_path):
             self.send_error(404, "Firmware não encontrado")
             return
-        
+
+        def read_at(f, offset, n):
+            f.seek(offset)
+            return f.read(n)
+
+        with open(self.firmware_path, 'rb') as f:
+            self.send_ranged(os.path.getsize(self.firmware_path), lambda offset, n: read_at(f, offset, n),
+                             f"firmware_{self.firmware_version}.bin", device_id)
+
+    def handle_compressed_download(self, device_id):
+        """Serve a imagem comprimida (--compress)"""
+        if not self.compressed:
+            self.send_error(404, "Servidor sem --compress")
+            return
+        data = self.compressed['data']
+        self.send_ranged(len(data), lambda offset, n: data[offset:offset + n],
+                         f"firmware_{self.firmware_version}.deflate", device_id)
+
+    def handle_delta_download(self, device_id, current_version):
+        """Serve o patch delta de current_version para a imagem atual"""
+        delta = self.deltas.get(current_version)
+        if not delta:
+            self.send_error(404, f"Sem delta a partir de {current_version}")
+            return
+        patch = delta['patch']
+        self.send_ranged(len(patch), lambda offset, n: patch[offset:offset + n],
+                         f"delta_{current_version}_{self.firmware_version}.bin", device_id)
+
+    def send_ranged(self, size, read_at, filename, device_id):
+        """Resposta 200/206/416 conforme o Range, em blocos de 16 KB"""
         try:
-            # Ler arquivo de firmware
-            with open(self.firmware_path, 'rb') as f:
-                firmware_data = f.read()
-            
-            # Calcular hash MD5 (opcional, para verificação)
-            md5_hash = hashlib.md5(firmware_data).hexdigest()
-            
+            byte_range = parse_range(self.headers.get('Range'), size)
+            if byte_range == 'invalid':
+                self.send_response(416)
+                self.send_header('Content-Range', f'bytes */{size}')
+                self.send_header('Content-Length', '0')
+                self.end_headers()
+                return
+
+            start, end = byte_range if byte_range else (0, size - 1)
+            length = end - start + 1
+
             # Enviar resposta
-            self.send_response(200)
+            self.send_response(206 if byte_range else 200)
             self.send_header('Content-Type', 'application/octet-stream')
-            self.send_header('Content-Length', str(len(firmware_data)))
-            self.send_header('Content-Disposition', f'attachment; filename="firmware_{self.firmware_version}.bin"')
+            self.send_header('Content-Length', str(length))
+            self.send_header('Accept-Ranges', 'bytes')
+            if byte_range:
+                self.send_header('Content-Range', f'bytes {start}-{end}/{size}')
+            self.send_header('Content-Disposition', f'attachment; filename="{filename}"')
             self.send_header('X-Firmware-Version', self.firmware_version)
-            self.send_header('X-Firmware-MD5', md5_hash)
             self.send_header('Access-Control-Allow-Origin', '*')
             self.end_headers()
             
-            self.wfile.write(firmware_data)
-            self.log_message(f"Firmware enviado para device_id={device_id} | size={len(firmware_data)} bytes | version={self.firmware_version}")
+            # --drop-every simula o WiFi instável do local
+            sent = 0
+            while sent < length:
+                block = read_at(start + sent, min(16 * 1024, length - sent))
+                if not block:
+                    break
+                if self.drop_every and sent + len(block) > self.drop_every:
+                    self.wfile.write(block[:self.drop_every - sent])
+                    sent = self.drop_every
+                    self.log_message(f"Conexão derrubada em {start + sent} bytes (--drop-every)")
+                    self.close_connection = True
+                    return
+                self.wfile.write(block)
+                sent += len(block)
+
+            self.log_message(f"{filename} enviado para device_id={device_id} | bytes={start}-{end}/{size}")
             
+        except (BrokenPipeError, ConnectionResetError):
+            self.log_message("Cliente desconectou durante o download")
         except Exception as e:
             self.log_message(f"Erro ao servir firmware: {e}")
             self.send_error(500, f"Erro interno: {e}")
@@ -111,11 +330,14 @@ class OtaRequestHandler(BaseHTTPRequestHandler):
         self.end_headers()
 
 
-def create_handler_class(firmware_path, firmware_version):
+def create_handler_class(firmware_path, firmware_version, chunk_size=DEFAULT_CHUNK_SIZE, drop_every=0, deltas=None,
+                         compressed=None):
     """Factory para criar handler com parâmetros"""
     class Handler(OtaRequestHandler):
         def __init__(self, *args, **kwargs):
-            super().__init__(*args, firmware_path=firmware_path, firmware_version=firmware_version, **kwargs)
+            super().__init__(*args, firmware_path=firmware_path, firmware_version=firmware_version,
+                             chunk_size=chunk_size, drop_every=drop_every, deltas=deltas,
+                             compressed=compressed, **kwargs)
     return Handler
 
 
@@ -147,8 +369,23 @@ def main():
     parser.add_argument('--version', type=str, default='1.0.0', help='Versão do firmware (padrão: 1.0.0)')
     parser.add_argument('--build-dir', type=str, default='build', help='Diretório build para procurar firmware (padrão: build)')
     parser.add_argument('--host', type=str, default='0.0.0.0', help='Host para bind (padrão: 0.0.0.0)')
+    parser.add_argument('--chunk-size', type=int, default=DEFAULT_CHUNK_SIZE,
+                        help='Bytes por bloco verificado no manifesto, múltiplo de 4096 (padrão: 65536)')
+    parser.add_argument('--drop-every', type=int, default=0,
+                        help='Derruba a conexão após N bytes de cada resposta, para testar a retomada (padrão: 0, desligado)')
+    parser.add_argument('--compress', action='store_true',
+                        help='Servir a imagem inteira comprimida (deflate, descomprimida no dispositivo)')
+    parser.add_argument('--window-bits', type=int, default=DEFAULT_WINDOW_BITS, choices=range(9, 16),
+                        metavar='9-15',
+                        help=f'Janela do compressor: RAM de 1 << N bytes no dispositivo (padrão: {DEFAULT_WINDOW_BITS})')
+    parser.add_argument('--delta-from', action='append', default=[], metavar='VERSÃO=IMAGEM',
+                        help='Servir patch delta para dispositivos em VERSÃO (imagem .bin dessa versão); pode repetir')
     
     args = parser.parse_args()
+
+    if args.chunk_size <= 0 or args.chunk_size % 4096 != 0:
+        print("[OTA Server] ERRO: --chunk-size deve ser múltiplo de 4096")
+        sys.exit(1)
     
     # Determinar caminho do firmware
     firmware_path = args.firmware
@@ -169,8 +406,17 @@ def main():
         print(f"[OTA Server] Tamanho: {firmware_size} bytes ({firmware_size / 1024:.2f} KB)")
         print(f"[OTA Server] Versão: {args.version}")
     
+    deltas = load_deltas(firmware_path, args.delta_from) if firmware_path and args.delta_from else {}
+    compressed = None
+    if firmware_path and args.compress:
+        compressed = compress_image(firmware_path, args.chunk_size, args.window_bits)
+        size = os.path.getsize(firmware_path)
+        print(f"[OTA Server] Imagem comprimida: {len(compressed['data'])} bytes "
+              f"({100.0 * len(compressed['data']) / size:.1f}% de {size}), janela de {1 << args.window_bits} bytes")
+
     # Criar handler
-    handler_class = create_handler_class(firmware_path, args.version)
+    handler_class = create_handler_class(firmware_path, args.version, args.chunk_size, args.drop_every, deltas,
+                                         compressed)
     
     # Criar servidor
     server_address = (args.host, args.port)
@@ -178,7 +424,8 @@ def main():
     
     print(f"[OTA Server] Servidor iniciado em http://{args.host}:{args.port}")
     print(f"[OTA Server] Endpoint de verificação: http://{args.host}:{args.port}/ota?action=check&device_id=XXX&current_version=X.X.X")
-    print(f"[OTA Server] Endpoint de download: http://{args.host}:{args.port}/ota?device_id=XXX")
+    print(f"[OTA Server] Endpoint de manifesto: http://{args.host}:{args.port}/ota?action=manifest&device_id=XXX")
+    print(f"[OTA Server] Endpoint de download: http://{args.host}:{args.port}/ota?device_id=XXX (aceita Range)")
     print("[OTA Server] Pressione Ctrl+C para parar")
     
     try:
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""
+Decodificador do trace binário do firmware (components/display_driver/include/trace.hpp)
+
+trace::dump() (comando "trace_dump" do console de diagnóstico) escreve no
+log serial uma linha por registro e os nomes dos tasks conhecidos:
+
+    I (12345) TRACE: TN,<task>,<nome>
+    I (12345) TRACE: TR,<core>,<16 bytes do registro em hex>
+
+Este script extrai essas linhas de um ou mais logs (ex.: saída do
+"idf.py monitor" salva em arquivo), lê a lista de eventos (TRACE_EVENT_LIST)
+do próprio header e gera um JSON no formato Trace Event do Chrome, que abre
+em https://ui.perfetto.dev ou chrome://tracing. Um resumo por evento
+(contagem e duração dos intervalos BEGIN/END) vai para stderr.
+
+Uso:
+    python3 tools/trace_decode.py monitor.log -o trace.json
+"""
+
+import os
+import re
+import sys
+import json
+import struct
+import argparse
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'components',
+                              'display_driver', 'include', 'trace.hpp')
+
+RECORD_LINE = re.compile(r'TR,(\d+),([0-9a-fA-F]{32})')
+TASK_LINE = re.compile(r'TN,(\d+),(\S+)')
+EVENT_ENTRY = re.compile(r'X\((\w+),\s*(BEGIN|END|INSTANT|COUNTER)\)')
+
+# Layout de trace::Record (little-endian)
+RECORD = struct.Struct('<IHHII')
+
+# Argumentos empacotados com trace::pack_xy()
+XY_ARGS = {
+    'FLUSH_BEGIN': ('p1', 'p2'),
+    'TOUCH_PRESS': ('tela', 'raw'),
+    'CALIBRATION_POINT': (None, 'raw'),
+}
+
+SPAN_SUFFIX = re.compile(r'_(BEGIN|END)$')
+
+
+def load_events(header_path):
+    """Retorna {id: (nome, fase)} na ordem de TRACE_EVENT_LIST (ids a partir de 1)"""
+    with open(header_path, encoding='utf-8') as f:
+        text = f.read()
+    start = text.find('#define TRACE_EVENT_LIST')
+    if start < 0:
+        raise SystemExit(f'[trace] TRACE_EVENT_LIST não encontrado em {header_path}')
+    # A macro termina na primeira linha sem continuação
+    lines = []
+    for line in text[start:].splitlines():
+        lines.append(line)
+        if not line.rstrip().endswith('\\'):
+            break
+    entries = EVENT_ENTRY.findall('\n'.join(lines))
+    return {i + 1: entry for i, entry in enumerate(entries)}
+
+
+def parse_log(lines):
+    """Retorna (registros por core, nomes dos tasks)"""
+    records = {}
+    tasks = {}
+    for line in lines:
+        m = RECORD_LINE.search(line)
+        if m:
+            core = int(m.group(1))
+            records.setdefault(core, []).append(RECORD.unpack(bytes.fromhex(m.group(2))))
+            continue
+        m = TASK_LINE.search(line)
+        if m:
+            tasks[int(m.group(1))] = m.group(2)
+    return records, tasks
+
+
+def unwrap(records):
+    """Desfaz a volta do timestamp de 32 bits (a cada ~71 min) dentro da sequência de um core"""
+    out = []
+    offset = 0
+    previous = None
+    for ts, event, task, arg0, arg1 in records:
+        if previous is not None and ts < previous and previous - ts > 1 << 31:
+            offset += 1 << 32
+        previous = ts
+        out.append((ts + offset, event, task, arg0, arg1))
+    return out
+
+
+def unpack_xy(value):
+    x = value & 0xFFFF
+    y = (value >> 16) & 0xFFFF
+    return [x - 0x10000 if x & 0x8000 else x, y - 0x10000 if y & 0x8000 else y]
+
+
+def event_args(name, arg0, arg1):
+    formats = XY_ARGS.get(name)
+    args = {}
+    for value, label, key in ((arg0, formats[0] if formats else None, 'arg0'),
+                              (arg1, formats[1] if formats else None, 'arg1')):
+        if label:
+            args[label] = unpack_xy(value)
+        elif value:
+            args[key] = value
+    return args
+
+
+def build_trace(records, tasks, events):
+    """Converte os registros em eventos do Chrome (pid = core, tid = task)"""
+    trace_events = []
+    stats = {}
+    open_spans = {}
+
+    # Cada core desfaz a volta na própria sequência; depois os cores são
+    # alinhados pelo último registro (todos terminam perto do instante do dump)
+    merged = []
+    reference = None
+    for core, core_records in records.items():
+        core_records = unwrap(core_records)
+        last = core_records[-1][0]
+        if reference is None:
+            reference = last
+        shift = round((reference - last) / (1 << 32)) << 32
+        merged.extend((ts + shift, core, event, task, arg0, arg1)
+                      for ts, event, task, arg0, arg1 in core_records)
+    merged.sort()
+    if not merged:
+        return trace_events, stats
+    t0 = merged[0][0]
+
+    seen_threads = set()
+    for ts, core, event_id, task, arg0, arg1 in merged:
+        name, phase = events.get(event_id, (f'EVENTO_{event_id}', 'INSTANT'))
+        base = SPAN_SUFFIX.sub('', name)
+        ts_rel = ts - t0
+
+        if (core, task) not in seen_threads:
+            seen_threads.add((core, task))
+            trace_events.append({'ph': 'M', 'name': 'thread_name', 'pid': core, 'tid': task,
+                                 'args': {'name': tasks.get(task, f'task {task:04x}')}})
+
+        entry = {'name': base, 'pid': core, 'tid': task, 'ts': ts_rel}
+        summary = stats.setdefault(base, {'count': 0, 'durations': []})
+        if phase == 'BEGIN':
+            entry['ph'] = 'B'
+            entry['args'] = event_args(name, arg0, arg1)
+            open_spans[(core, task, base)] = ts
+        elif phase == 'END':
+            entry['ph'] = 'E'
+            start = open_spans.pop((core, task, base), None)
+            if start is None:
+                continue  # Início sobrescrito no ring
+            summary['count'] += 1
+            summary['durations'].append(ts - start)
+        elif phase == 'COUNTER':
+            entry['ph'] = 'C'
+            entry['args'] = {base.lower(): arg0}
+            summary['count'] += 1
+        else:
+            entry['ph'] = 'i'
+            entry['s'] = 't'
+            entry['args'] = event_args(name, arg0, arg1)
+            summary['count'] += 1
+        trace_events.append(entry)
+
+    return trace_events, stats
+
+
+def print_summary(stats, out):
+    for name, summary in sorted(stats.items()):
+        durations = summary['durations']
+        if durations:
+            durations.sort()
+            p50 = durations[len(durations) // 2]
+            print(f'{name:24s} {summary["count"]:6d}  p50 {p50} us  máx {durations[-1]} us', file=out)
+        else:
+            print(f'{name:24s} {summary["count"]:6d}', file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Converte o dump do trace binário em JSON do Chrome/Perfetto')
+    parser.add_argument('logs', nargs='*', help='Arquivos de log (padrão: stdin)')
+    parser.add_argument('-o', '--output', help='Arquivo JSON de saída (padrão: stdout)')
+    parser.add_argument('--header', default=DEFAULT_HEADER, help='trace.hpp com TRACE_EVENT_LIST')
+    args = parser.parse_args()
+
+    events = load_events(args.header)
+
+    if args.logs:
+        lines = []
+        for path in args.logs:
+            with open(path, encoding='utf-8', errors='replace') as f:
+                lines.extend(f.readlines())
+    else:
+        lines = sys.stdin.readlines()
+
+    records, tasks = parse_log(lines)
+    if not records:
+        print('[trace] nenhuma linha TR,... encontrada', file=sys.stderr)
+        return 1
+
+    trace_events, stats = build_trace(records, tasks, events)
+    document = {'traceEvents': trace_events, 'displayTimeUnit': 'ms'}
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as f:
+            json.dump(document, f)
+    else:
+        json.dump(document, sys.stdout)
+        sys.stdout.write('\n')
+
+    print_summary(stats, sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())